@@ -0,0 +1,76 @@
+#ifndef LIBEMBD_BENCH_H_
+#define LIBEMBD_BENCH_H_
+
+#include <stdio.h>
+#include <time.h>
+#include "libembd/libembd_platform_types.h"
+
+/**
+ * @file bench.h
+ * @brief Timing helpers shared by the benchmark programs.
+ *
+ * Every program times a fixed number of iterations of each variant with a monotonic clock and prints one line per
+ * variant. Results are fed to bench_sink()/bench_clobber() so that the compiler cannot drop the measured work.
+ */
+
+static volatile uint64 g_bench_sink;
+
+static inline float64 bench_now_ns(void)
+{
+    struct timespec ts;
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((float64)ts.tv_sec * 1e9) + (float64)ts.tv_nsec;
+}
+
+//! keeps value alive
+static inline void bench_sink(uint64 value)
+{
+    g_bench_sink += value;
+}
+
+//! forces the memory behind pointer to be considered read and written
+static inline void bench_clobber(void const *pointer)
+{
+    __asm__ volatile("" : : "r"(pointer) : "memory");
+}
+
+static uint32 g_bench_random = 0xC0FFEEu;
+
+//! xorshift32 pseudo random numbers for generating test data, the same sequence on every run
+static inline uint32 bench_random(void)
+{
+    g_bench_random ^= g_bench_random << 13u;
+    g_bench_random ^= g_bench_random >> 17u;
+    g_bench_random ^= g_bench_random << 5u;
+    return g_bench_random;
+}
+
+/**
+ * @brief Prints the time per iteration and, if bytes_per_iteration is not 0, the throughput
+ *
+ * @param label name of the measured variant
+ * @param elapsed_ns total time of all iterations
+ * @param iterations number of iterations
+ * @param bytes_per_iteration bytes processed by one iteration
+ */
+static inline void bench_report(char const *label, float64 elapsed_ns, uint64 iterations, uint64 bytes_per_iteration)
+{
+    float64 const ns = elapsed_ns / (float64)iterations;
+
+    if(bytes_per_iteration != 0u){
+        printf("  %-44s %10.1f ns/op %9.2f GB/s\n", label, ns, (float64)bytes_per_iteration / ns);
+    } else {
+        printf("  %-44s %10.1f ns/op\n", label, ns);
+    }
+}
+
+//! times iterations runs of statement and reports them under label
+#define BENCH_RUN(label, iterations, bytes_per_iteration, statement) \
+    do { \
+        uint64 bench_i_; \
+        float64 const bench_start_ = bench_now_ns(); \
+        for(bench_i_ = 0u; bench_i_ < (uint64)(iterations); bench_i_++) { statement; } \
+        bench_report((label), bench_now_ns() - bench_start_, (uint64)(iterations), (uint64)(bytes_per_iteration)); \
+    } while(0)
+
+#endif /* LIBEMBD_BENCH_H_ */
@@ -0,0 +1,120 @@
+#include "bench.h"
+#include "libembd/libembd_marshalling.h"
+
+// Aligned put/get fast paths against the generic ones, 4096 uint32 samples per frame. The generic APIs are timed both on
+// the aligned frame and one byte into it. On cores with fast unaligned access all variants are expected to be close.
+
+#define SAMPLES     4096u
+#define ITERATIONS  20000u
+
+static uint32 g_u32[SAMPLES];
+static _Alignas(32) uint8 g_frame[SAMPLES * sizeof(uint32) + 32u];
+
+static void put_loop(uint8 *frame)
+{
+    LibEmbd_Serializer_t ser;
+    uint32 i;
+
+    libembd_make_serializer(&ser, frame, SAMPLES * sizeof(uint32));
+    for(i = 0u; i < SAMPLES; i++){
+        libembd_put_uint32_to_network_unsafe(&ser, g_u32[i]);
+    }
+}
+
+static void put_aligned_loop(uint8 *frame)
+{
+    LibEmbd_Serializer_t ser;
+    uint32 i;
+
+    libembd_make_serializer(&ser, frame, SAMPLES * sizeof(uint32));
+    for(i = 0u; i < SAMPLES; i++){
+        libembd_put_uint32_to_network_aligned_unsafe(&ser, g_u32[i]);
+    }
+}
+
+static uint64 get_loop(uint8 const *frame)
+{
+    LibEmbd_Deserializer_t deser;
+    uint64 sum = 0u;
+    uint32 value;
+    uint32 i;
+
+    libembd_make_deserializer(&deser, frame, SAMPLES * sizeof(uint32));
+    for(i = 0u; i < SAMPLES; i++){
+        libembd_get_uint32_from_network_unsafe(&deser, &value);
+        sum += value;
+    }
+    return sum;
+}
+
+static uint64 get_aligned_loop(uint8 const *frame)
+{
+    LibEmbd_Deserializer_t deser;
+    uint64 sum = 0u;
+    uint32 value;
+    uint32 i;
+
+    libembd_make_deserializer(&deser, frame, SAMPLES * sizeof(uint32));
+    for(i = 0u; i < SAMPLES; i++){
+        libembd_get_uint32_from_network_aligned_unsafe(&deser, &value);
+        sum += value;
+    }
+    return sum;
+}
+
+static void put_array(uint8 *frame)
+{
+    LibEmbd_Serializer_t ser;
+    libembd_make_serializer(&ser, frame, SAMPLES * sizeof(uint32));
+    libembd_put_uint32_array_to_network_unsafe(&ser, g_u32, SAMPLES);
+}
+
+static void put_array_aligned(uint8 *frame)
+{
+    LibEmbd_Serializer_t ser;
+    libembd_make_serializer(&ser, frame, SAMPLES * sizeof(uint32));
+    libembd_put_uint32_array_to_network_aligned_unsafe(&ser, g_u32, SAMPLES);
+}
+
+static void get_array(uint8 const *frame)
+{
+    LibEmbd_Deserializer_t deser;
+    libembd_make_deserializer(&deser, frame, SAMPLES * sizeof(uint32));
+    libembd_get_uint32_array_from_network_unsafe(&deser, g_u32, SAMPLES);
+}
+
+static void get_array_aligned(uint8 const *frame)
+{
+    LibEmbd_Deserializer_t deser;
+    libembd_make_deserializer(&deser, frame, SAMPLES * sizeof(uint32));
+    libembd_get_uint32_array_from_network_aligned_unsafe(&deser, g_u32, SAMPLES);
+}
+
+int main(void)
+{
+    uint32 i;
+
+    for(i = 0u; i < SAMPLES; i++){
+        g_u32[i] = i * 2654435761u;
+    }
+    put_array_aligned(g_frame);
+    if(get_aligned_loop(g_frame) != get_loop(g_frame)){
+        printf("round trip failed\n");
+        return 1;
+    }
+
+    printf("aligned vs generic marshalling, %u uint32 samples\n", SAMPLES);
+    BENCH_RUN("put per element, generic, offset 1", ITERATIONS, SAMPLES * sizeof(uint32), put_loop(&g_frame[1]); bench_clobber(g_frame));
+    BENCH_RUN("put per element, generic, aligned", ITERATIONS, SAMPLES * sizeof(uint32), put_loop(g_frame); bench_clobber(g_frame));
+    BENCH_RUN("put per element, aligned", ITERATIONS, SAMPLES * sizeof(uint32), put_aligned_loop(g_frame); bench_clobber(g_frame));
+    BENCH_RUN("get per element, generic, offset 1", ITERATIONS, SAMPLES * sizeof(uint32), bench_sink(get_loop(&g_frame[1])));
+    BENCH_RUN("get per element, generic, aligned", ITERATIONS, SAMPLES * sizeof(uint32), bench_sink(get_loop(g_frame)));
+    BENCH_RUN("get per element, aligned", ITERATIONS, SAMPLES * sizeof(uint32), bench_sink(get_aligned_loop(g_frame)));
+    BENCH_RUN("put array, generic, offset 1", ITERATIONS, SAMPLES * sizeof(uint32), put_array(&g_frame[1]); bench_clobber(g_frame));
+    BENCH_RUN("put array, generic, aligned", ITERATIONS, SAMPLES * sizeof(uint32), put_array(g_frame); bench_clobber(g_frame));
+    BENCH_RUN("put array, aligned", ITERATIONS, SAMPLES * sizeof(uint32), put_array_aligned(g_frame); bench_clobber(g_frame));
+    BENCH_RUN("get array, generic, offset 1", ITERATIONS, SAMPLES * sizeof(uint32), get_array(&g_frame[1]); bench_clobber(g_u32));
+    BENCH_RUN("get array, generic, aligned", ITERATIONS, SAMPLES * sizeof(uint32), get_array(g_frame); bench_clobber(g_u32));
+    BENCH_RUN("get array, aligned", ITERATIONS, SAMPLES * sizeof(uint32), get_array_aligned(g_frame); bench_clobber(g_u32));
+    return 0;
+}
@@ -0,0 +1,80 @@
+#include "bench.h"
+#include "libembd/libembd_marshalling.h"
+
+// Bulk array put/get against the per-element loop, 4096 samples per frame
+
+#define SAMPLES     4096u
+#define ITERATIONS  20000u
+
+static uint16 g_u16[SAMPLES];
+static uint32 g_u32[SAMPLES];
+static float32 g_f32[SAMPLES];
+static uint8 g_frame[SAMPLES * sizeof(uint32)];
+
+static void put_uint32_loop(LibEmbd_Serializer_t *ser)
+{
+    uint32 i;
+    for(i = 0u; i < SAMPLES; i++){
+        libembd_put_uint32_to_network_unsafe(ser, g_u32[i]);
+    }
+}
+
+static void get_uint32_loop(LibEmbd_Deserializer_t *deser)
+{
+    uint32 i;
+    for(i = 0u; i < SAMPLES; i++){
+        libembd_get_uint32_from_network_unsafe(deser, &g_u32[i]);
+    }
+}
+
+static void put_uint16_loop(LibEmbd_Serializer_t *ser)
+{
+    uint32 i;
+    for(i = 0u; i < SAMPLES; i++){
+        libembd_put_uint16_to_network_unsafe(ser, g_u16[i]);
+    }
+}
+
+static void put_float32_loop(LibEmbd_Serializer_t *ser)
+{
+    uint32 i;
+    for(i = 0u; i < SAMPLES; i++){
+        libembd_put_float32_to_network_unsafe(ser, g_f32[i]);
+    }
+}
+
+int main(void)
+{
+    LibEmbd_Serializer_t ser;
+    LibEmbd_Deserializer_t deser;
+    uint32 i;
+
+    for(i = 0u; i < SAMPLES; i++){
+        g_u16[i] = (uint16)(i * 2654435761u);
+        g_u32[i] = i * 2654435761u;
+        g_f32[i] = (float32)i * 0.25f;
+    }
+
+    printf("bulk array marshalling, %u samples\n", SAMPLES);
+    BENCH_RUN("uint32 to network, per element", ITERATIONS, SAMPLES * sizeof(uint32),
+              libembd_make_serializer(&ser, g_frame, sizeof(g_frame)); put_uint32_loop(&ser); bench_clobber(g_frame));
+    BENCH_RUN("uint32 to network, array", ITERATIONS, SAMPLES * sizeof(uint32),
+              libembd_make_serializer(&ser, g_frame, sizeof(g_frame)); libembd_put_uint32_array_to_network_unsafe(&ser, g_u32, SAMPLES);
+              bench_clobber(g_frame));
+    BENCH_RUN("uint32 from network, per element", ITERATIONS, SAMPLES * sizeof(uint32),
+              libembd_make_deserializer(&deser, g_frame, sizeof(g_frame)); get_uint32_loop(&deser); bench_clobber(g_u32));
+    BENCH_RUN("uint32 from network, array", ITERATIONS, SAMPLES * sizeof(uint32),
+              libembd_make_deserializer(&deser, g_frame, sizeof(g_frame)); libembd_get_uint32_array_from_network_unsafe(&deser, g_u32, SAMPLES);
+              bench_clobber(g_u32));
+    BENCH_RUN("uint16 to network, per element", ITERATIONS, SAMPLES * sizeof(uint16),
+              libembd_make_serializer(&ser, g_frame, sizeof(g_frame)); put_uint16_loop(&ser); bench_clobber(g_frame));
+    BENCH_RUN("uint16 to network, array", ITERATIONS, SAMPLES * sizeof(uint16),
+              libembd_make_serializer(&ser, g_frame, sizeof(g_frame)); libembd_put_uint16_array_to_network_unsafe(&ser, g_u16, SAMPLES);
+              bench_clobber(g_frame));
+    BENCH_RUN("float32 to network, per element", ITERATIONS, SAMPLES * sizeof(float32),
+              libembd_make_serializer(&ser, g_frame, sizeof(g_frame)); put_float32_loop(&ser); bench_clobber(g_frame));
+    BENCH_RUN("float32 to network, array", ITERATIONS, SAMPLES * sizeof(float32),
+              libembd_make_serializer(&ser, g_frame, sizeof(g_frame)); libembd_put_float32_array_to_network_unsafe(&ser, g_f32, SAMPLES);
+              bench_clobber(g_frame));
+    return 0;
+}
@@ -0,0 +1,187 @@
+#include "bench.h"
+#include "libembd/libembd_util.h"
+#include "libembd/libembd_message_schema.h"
+
+// 64 byte CAN-FD frame with 30 signals (20 intel, 10 motorola): generated signal frame, bit serializer driven by a
+// runtime signal table, and the per-bit LIBEMBD_ASSIGN_BIT/LIBEMBD_IS_BIT_SET loop
+
+#define FRAME_LENGTH    64u
+#define ITERATIONS      2000000u
+
+#define CANFD_SIGNALS(SIGNAL) \
+    SIGNAL(uint8,  s00,   0,  1, intel) \
+    SIGNAL(uint8,  s01,   1,  3, intel) \
+    SIGNAL(uint8,  s02,   4,  8, intel) \
+    SIGNAL(uint16, s03,  12, 12, intel) \
+    SIGNAL(uint16, s04,  24, 16, intel) \
+    SIGNAL(uint8,  s05,  40,  5, intel) \
+    SIGNAL(sint8,  s06,  45,  7, intel) \
+    SIGNAL(sint16, s07,  52, 14, intel) \
+    SIGNAL(uint32, s08,  66, 24, intel) \
+    SIGNAL(uint8,  s09,  90,  2, intel) \
+    SIGNAL(uint16, s10,  92,  9, intel) \
+    SIGNAL(uint16, s11, 101, 11, intel) \
+    SIGNAL(uint8,  s12, 112,  4, intel) \
+    SIGNAL(uint8,  s13, 116,  6, intel) \
+    SIGNAL(uint16, s14, 122, 10, intel) \
+    SIGNAL(uint16, s15, 132, 13, intel) \
+    SIGNAL(uint16, s16, 145, 15, intel) \
+    SIGNAL(uint32, s17, 160, 20, intel) \
+    SIGNAL(uint32, s18, 180, 32, intel) \
+    SIGNAL(uint8,  s19, 212,  1, intel) \
+    SIGNAL(uint16, s20, 263, 16, motorola) \
+    SIGNAL(uint16, s21, 279, 12, motorola) \
+    SIGNAL(uint8,  s22, 295,  8, motorola) \
+    SIGNAL(uint32, s23, 303, 24, motorola) \
+    SIGNAL(sint16, s24, 327, 10, motorola) \
+    SIGNAL(uint16, s25, 343, 16, motorola) \
+    SIGNAL(uint32, s26, 359, 20, motorola) \
+    SIGNAL(uint8,  s27, 383,  8, motorola) \
+    SIGNAL(uint32, s28, 391, 32, motorola) \
+    SIGNAL(uint16, s29, 423, 14, motorola)
+
+LIBEMBD_DEFINE_SIGNAL_FRAME(CanFdFrame, FRAME_LENGTH, CANFD_SIGNALS)
+
+#define SIGNAL_COUNT    30u
+
+typedef struct {
+    uint32 start_bit;
+    uint32 width;
+    boolean motorola;
+} SignalDesc_t;
+
+#define SIGNAL_DESC(TYPE, NAME, START_BIT, WIDTH, ORDER) { (START_BIT), (WIDTH), SIGNAL_IS_##ORDER },
+#define SIGNAL_IS_intel     FALSE
+#define SIGNAL_IS_motorola  TRUE
+static SignalDesc_t const g_signals[SIGNAL_COUNT] = { CANFD_SIGNALS(SIGNAL_DESC) };
+
+#define SIGNAL_TO_ARRAY(TYPE, NAME, START_BIT, WIDTH, ORDER)   values[i++] = (uint64)(TYPE)sig->NAME;
+#define SIGNAL_FROM_ARRAY(TYPE, NAME, START_BIT, WIDTH, ORDER) sig->NAME = (TYPE)values[i++];
+
+static void signals_to_array(CanFdFrame_t const *sig, uint64 *values)
+{
+    uint32 i = 0u;
+    CANFD_SIGNALS(SIGNAL_TO_ARRAY)
+}
+
+static void signals_from_array(CanFdFrame_t *sig, uint64 const *values)
+{
+    uint32 i = 0u;
+    CANFD_SIGNALS(SIGNAL_FROM_ARRAY)
+}
+
+static void pack_table(uint8 *frame, uint64 const *values)
+{
+    LibEmbd_BitSerializer_t bser;
+    uint32 i;
+
+    LIBEMBD_MEMSET(frame, 0, FRAME_LENGTH);
+    libembd_make_bit_serializer(&bser, frame, FRAME_LENGTH);
+    for(i = 0u; i < SIGNAL_COUNT; i++){
+        if(g_signals[i].motorola){
+            libembd_write_bits_motorola_unsafe(&bser, g_signals[i].start_bit, g_signals[i].width, values[i]);
+        } else {
+            libembd_write_bits_intel_unsafe(&bser, g_signals[i].start_bit, g_signals[i].width, values[i]);
+        }
+    }
+}
+
+static void unpack_table(uint8 const *frame, uint64 *values)
+{
+    LibEmbd_BitDeserializer_t bdeser;
+    uint32 i;
+
+    libembd_make_bit_deserializer(&bdeser, frame, FRAME_LENGTH);
+    for(i = 0u; i < SIGNAL_COUNT; i++){
+        if(g_signals[i].motorola){
+            libembd_read_bits_motorola_unsafe(&bdeser, g_signals[i].start_bit, g_signals[i].width, &values[i]);
+        } else {
+            libembd_read_bits_intel_unsafe(&bdeser, g_signals[i].start_bit, g_signals[i].width, &values[i]);
+        }
+    }
+}
+
+// Intel signals run upwards from the LSB, motorola signals downwards from the MSB in DBC sawtooth numbering
+static uint32 next_bit(uint32 bit, boolean motorola)
+{
+    if(!motorola){
+        return bit + 1u;
+    }
+    return ((bit % 8u) == 0u) ? (bit + 15u) : (bit - 1u);
+}
+
+static void pack_per_bit(uint8 *frame, uint64 const *values)
+{
+    uint32 i;
+    uint32 j;
+    uint32 bit;
+    uint64 value;
+
+    LIBEMBD_MEMSET(frame, 0, FRAME_LENGTH);
+    for(i = 0u; i < SIGNAL_COUNT; i++){
+        bit = g_signals[i].start_bit;
+        for(j = 0u; j < g_signals[i].width; j++){
+            value = g_signals[i].motorola ? (values[i] >> (g_signals[i].width - 1u - j)) : (values[i] >> j);
+            LIBEMBD_ASSIGN_BIT(frame[bit / 8u], bit % 8u, (uint32)(value & 1u));
+            bit = next_bit(bit, g_signals[i].motorola);
+        }
+    }
+}
+
+static void unpack_per_bit(uint8 const *frame, uint64 *values)
+{
+    uint32 i;
+    uint32 j;
+    uint32 bit;
+    uint64 bitval;
+
+    for(i = 0u; i < SIGNAL_COUNT; i++){
+        bit = g_signals[i].start_bit;
+        values[i] = 0u;
+        for(j = 0u; j < g_signals[i].width; j++){
+            bitval = LIBEMBD_IS_BIT_SET(frame[bit / 8u], bit % 8u) ? 1u : 0u;
+            values[i] |= g_signals[i].motorola ? (bitval << (g_signals[i].width - 1u - j)) : (bitval << j);
+            bit = next_bit(bit, g_signals[i].motorola);
+        }
+    }
+}
+
+int main(void)
+{
+    uint8 frames[3][FRAME_LENGTH];
+    uint64 raw[SIGNAL_COUNT];
+    uint64 values[SIGNAL_COUNT];
+    CanFdFrame_t sig;
+    LibEmbd_Serializer_t ser;
+    LibEmbd_Deserializer_t deser;
+    uint64 state = 0x9E3779B97F4A7C15uLL;
+    uint32 i;
+
+    for(i = 0u; i < SIGNAL_COUNT; i++){
+        state ^= state << 13; state ^= state >> 7; state ^= state << 17;
+        raw[i] = (g_signals[i].width == 64u) ? state : (state & ((1uLL << g_signals[i].width) - 1u));
+    }
+    signals_from_array(&sig, raw);
+    signals_to_array(&sig, values); //sign extended where the signal type is signed
+
+    //all three variants must produce the same frame
+    libembd_make_serializer(&ser, frames[0], FRAME_LENGTH);
+    (void)CanFdFrame_pack(&ser, &sig);
+    pack_table(frames[1], values);
+    pack_per_bit(frames[2], values);
+    if((LIBEMBD_MEMCMP(frames[0], frames[1], FRAME_LENGTH) != 0) || (LIBEMBD_MEMCMP(frames[0], frames[2], FRAME_LENGTH) != 0)){
+        printf("frame mismatch\n");
+        return 1;
+    }
+
+    printf("bit packing, %u byte CAN-FD frame with %u signals\n", FRAME_LENGTH, SIGNAL_COUNT);
+    BENCH_RUN("pack, per-bit ASSIGN_BIT loop", ITERATIONS, 0u, bench_clobber(values); pack_per_bit(frames[2], values); bench_clobber(frames[2]));
+    BENCH_RUN("pack, bit serializer with signal table", ITERATIONS, 0u, bench_clobber(values); pack_table(frames[1], values); bench_clobber(frames[1]));
+    BENCH_RUN("pack, generated signal frame", ITERATIONS, 0u,
+              libembd_make_serializer(&ser, frames[0], FRAME_LENGTH); bench_clobber(&sig); (void)CanFdFrame_pack(&ser, &sig); bench_clobber(frames[0]));
+    BENCH_RUN("unpack, per-bit IS_BIT_SET loop", ITERATIONS, 0u, bench_clobber(frames[2]); unpack_per_bit(frames[2], values); bench_clobber(values));
+    BENCH_RUN("unpack, bit deserializer with signal table", ITERATIONS, 0u, bench_clobber(frames[1]); unpack_table(frames[1], values); bench_clobber(values));
+    BENCH_RUN("unpack, generated signal frame", ITERATIONS, 0u,
+              libembd_make_deserializer(&deser, frames[0], FRAME_LENGTH); bench_clobber(frames[0]); (void)CanFdFrame_unpack(&deser, &sig); bench_clobber(&sig));
+    return 0;
+}
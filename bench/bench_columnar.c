@@ -0,0 +1,132 @@
+#include "bench.h"
+#include "libembd/libembd_marshalling.h"
+#include "libembd/libembd_columnar.h"
+
+// Columnar telemetry batch against plain row-wise records (uint64 timestamp, uint32 id, float32 value = 16 bytes):
+// 1024 samples with 1-20 ms timestamp steps, 40 distinct ids and random values. Encoding includes appending the samples
+// to the batch; filtering sums the values of one id straight out of the encoded buffer.
+
+#define SAMPLES    1024u
+#define IDS        40u
+#define ROW_SIZE   16u
+#define ITERATIONS 2000u
+
+static uint64 g_timestamps[SAMPLES];
+static uint32 g_ids[SAMPLES];
+static float32 g_values[SAMPLES];
+
+static uint64 g_batch_timestamps[SAMPLES];
+static uint8 g_batch_indices[SAMPLES];
+static float32 g_batch_values[SAMPLES];
+static LibEmbd_TelemetryBatch_t g_batch;
+
+static uint8 g_columnar[SAMPLES * ROW_SIZE];
+static uint8 g_rows[SAMPLES * ROW_SIZE];
+
+static void generate_samples(void)
+{
+    uint64 timestamp = 1700000000000ull;
+    uint32 i;
+
+    for(i = 0u; i < SAMPLES; i++){
+        timestamp += 1u + (bench_random() % 20u);
+        g_timestamps[i] = timestamp;
+        g_ids[i] = 0x1000u + (bench_random() % IDS);
+        g_values[i] = (float32)bench_random() / 65536.0f;
+    }
+}
+
+static uint32 encode_columnar(void)
+{
+    LibEmbd_Serializer_t ser;
+    uint32 i;
+
+    libembd_reset_telemetry_batch(&g_batch);
+    for(i = 0u; i < SAMPLES; i++){
+        (void)libembd_telemetry_batch_append(&g_batch, g_timestamps[i], g_ids[i], g_values[i]);
+    }
+    libembd_make_serializer(&ser, g_columnar, sizeof(g_columnar));
+    libembd_put_telemetry_batch_checked(&ser, &g_batch);
+    return libembd_serializer_has_overflowed(&ser) ? 0u : ser.position;
+}
+
+static uint32 encode_rows(void)
+{
+    LibEmbd_Serializer_t ser;
+    uint32 i;
+
+    libembd_make_serializer(&ser, g_rows, sizeof(g_rows));
+    for(i = 0u; i < SAMPLES; i++){
+        libembd_put_uint64_to_network_unsafe(&ser, g_timestamps[i]);
+        libembd_put_uint32_to_network_unsafe(&ser, g_ids[i]);
+        libembd_put_float32_to_network_unsafe(&ser, g_values[i]);
+    }
+    return ser.position;
+}
+
+static float32 filter_columnar(uint32 length, uint32 id)
+{
+    LibEmbd_Deserializer_t deser;
+    LibEmbd_TelemetryBatchView_t view;
+    float32 sum = 0.0f;
+    uint8 index;
+    uint32 i;
+
+    libembd_make_deserializer(&deser, g_columnar, length);
+    libembd_get_telemetry_batch_checked(&deser, &view);
+    if(libembd_dictionary_column_find(&view.ids, id, &index)){
+        for(i = 0u; i < view.count; i++){
+            if(view.ids.indices[i] == index){
+                sum += libembd_float32_column_at(&view.values, i);
+            }
+        }
+    }
+    return sum;
+}
+
+static float32 filter_rows(uint32 id)
+{
+    LibEmbd_Deserializer_t deser;
+    float32 sum = 0.0f;
+    uint64 timestamp;
+    uint32 row_id;
+    float32 value;
+    uint32 i;
+
+    libembd_make_deserializer(&deser, g_rows, sizeof(g_rows));
+    for(i = 0u; i < SAMPLES; i++){
+        libembd_get_uint64_from_network_unsafe(&deser, &timestamp);
+        libembd_get_uint32_from_network_unsafe(&deser, &row_id);
+        libembd_get_float32_from_network_unsafe(&deser, &value);
+        if(row_id == id){
+            sum += value;
+        }
+    }
+    bench_sink(timestamp);
+    return sum;
+}
+
+int main(void)
+{
+    uint32 const id = 0x1000u + 7u;
+    uint32 columnar_length;
+    uint32 rows_length;
+
+    generate_samples();
+    libembd_make_telemetry_batch(&g_batch, g_batch_timestamps, g_batch_indices, g_batch_values, SAMPLES);
+    columnar_length = encode_columnar();
+    rows_length = encode_rows();
+    if((columnar_length == 0u) || (filter_columnar(columnar_length, id) != filter_rows(id))){
+        printf("round trip failed\n");
+        return 1;
+    }
+
+    printf("Telemetry batch of %u samples with %u ids, %u samples per op\n", SAMPLES, IDS, SAMPLES);
+    printf("  columnar %u bytes, row-wise %u bytes, %.1f%%\n", columnar_length, rows_length,
+           100.0 * (float64)columnar_length / (float64)rows_length);
+    BENCH_RUN("encode row-wise", ITERATIONS, 0u, bench_sink(encode_rows()); bench_clobber(g_rows));
+    BENCH_RUN("encode columnar", ITERATIONS, 0u, bench_sink(encode_columnar()); bench_clobber(g_columnar));
+    BENCH_RUN("filter by id row-wise", ITERATIONS, 0u, bench_sink((uint64)filter_rows(id)));
+    BENCH_RUN("filter by id columnar", ITERATIONS, 0u, bench_sink((uint64)filter_columnar(columnar_length, id)));
+    return 0;
+}
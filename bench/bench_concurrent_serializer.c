@@ -0,0 +1,126 @@
+#include <pthread.h>
+#include <string.h>
+#include "bench.h"
+#include "libembd/libembd_marshalling.h"
+#include "libembd/libembd_concurrent_serializer.h"
+
+// Producer scaling of the lock-free shared batch against the pattern it replaces: serializing into a private buffer and
+// copying it into the batch under a mutex. Every producer writes RECORDS 24-byte records; the time per record is taken
+// over all producers, from a common start to the last producer finishing. Only meaningful on multi-core target hardware.
+
+#ifndef BENCH_MAX_PRODUCERS
+    #define BENCH_MAX_PRODUCERS 4u
+#endif
+#define RECORDS         100000u
+#define RECORD_SIZE     24u
+#define BATCH_SIZE      (BENCH_MAX_PRODUCERS * RECORDS * LIBEMBD_CONCURRENT_RECORD_SIZE(RECORD_SIZE))
+
+static uint32 g_batch[BATCH_SIZE / sizeof(uint32)]; //4-byte aligned
+static LibEmbd_ConcurrentSerializer_t g_cser;
+static uint32 g_batch_position;
+static pthread_mutex_t g_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_barrier_t g_start;
+
+static void put_record(LibEmbd_Serializer_t *ser, uint32 producer, uint32 i)
+{
+    libembd_put_uint32_to_network_checked(ser, producer);
+    libembd_put_uint32_to_network_checked(ser, i);
+    libembd_put_uint64_to_network_checked(ser, (uint64)i * 1000u);
+    libembd_put_float64_to_network_checked(ser, (float64)i * 0.5);
+}
+
+static void *concurrent_producer(void *argument)
+{
+    uint32 const producer = (uint32)(uintptr_t)argument;
+    LibEmbd_Serializer_t ser;
+    uint32 i;
+
+    (void)pthread_barrier_wait(&g_start);
+    for(i = 0u; i < RECORDS; i++){
+        if(libembd_concurrent_serializer_begin_record(&g_cser, RECORD_SIZE, &ser)){
+            put_record(&ser, producer, i);
+            libembd_concurrent_serializer_commit_record(&g_cser, &ser);
+        }
+    }
+    return NULL;
+}
+
+static void *locked_producer(void *argument)
+{
+    uint32 const producer = (uint32)(uintptr_t)argument;
+    uint8 record[LIBEMBD_CONCURRENT_RECORD_SIZE(RECORD_SIZE)];
+    LibEmbd_Serializer_t ser;
+    uint32 i;
+
+    (void)pthread_barrier_wait(&g_start);
+    for(i = 0u; i < RECORDS; i++){
+        libembd_make_serializer(&ser, record, sizeof(record));
+        libembd_put_uint32_to_network_checked(&ser, RECORD_SIZE);
+        put_record(&ser, producer, i);
+        (void)pthread_mutex_lock(&g_mutex);
+        memcpy(&((uint8 *)g_batch)[g_batch_position], record, ser.position);
+        g_batch_position += ser.position;
+        (void)pthread_mutex_unlock(&g_mutex);
+    }
+    return NULL;
+}
+
+// Runs producers threads of routine and returns the elapsed time from the common start until all have finished
+static float64 run_producers(void *(*routine)(void *), uint32 producers)
+{
+    pthread_t threads[BENCH_MAX_PRODUCERS];
+    float64 start;
+    uint32 i;
+
+    (void)pthread_barrier_init(&g_start, NULL, producers + 1u);
+    for(i = 0u; i < producers; i++){
+        (void)pthread_create(&threads[i], NULL, routine, (void *)(uintptr_t)i);
+    }
+    (void)pthread_barrier_wait(&g_start);
+    start = bench_now_ns();
+    for(i = 0u; i < producers; i++){
+        (void)pthread_join(threads[i], NULL);
+    }
+    start = bench_now_ns() - start;
+    (void)pthread_barrier_destroy(&g_start);
+    return start;
+}
+
+// Number of committed records in the batch, all producers must have finished
+static uint32 count_records(uint32 length)
+{
+    LibEmbd_Deserializer_t deser;
+    LibEmbd_Deserializer_t record;
+    uint32 count = 0u;
+
+    libembd_make_deserializer(&deser, (uint8 const *)g_batch, length);
+    while(libembd_get_concurrent_record_checked(&deser, &record)){
+        count++;
+    }
+    return libembd_deserializer_has_overflowed(&deser) ? 0u : count;
+}
+
+int main(void)
+{
+    char label[64];
+    uint32 producers;
+    float64 elapsed;
+
+    printf("Concurrent serializer, %u records of %u bytes per producer\n", RECORDS, RECORD_SIZE);
+    for(producers = 1u; producers <= BENCH_MAX_PRODUCERS; producers++){
+        libembd_make_concurrent_serializer(&g_cser, (uint8 *)g_batch, sizeof(g_batch));
+        elapsed = run_producers(concurrent_producer, producers);
+        if(count_records(libembd_seal_concurrent_serializer(&g_cser)) != producers * RECORDS){
+            printf("lost records\n");
+            return 1;
+        }
+        (void)snprintf(label, sizeof(label), "%u producers, lock-free batch", producers);
+        bench_report(label, elapsed, (uint64)producers * RECORDS, RECORD_SIZE);
+
+        g_batch_position = 0u;
+        elapsed = run_producers(locked_producer, producers);
+        (void)snprintf(label, sizeof(label), "%u producers, private buffer + mutex", producers);
+        bench_report(label, elapsed, (uint64)producers * RECORDS, RECORD_SIZE);
+    }
+    return 0;
+}
@@ -0,0 +1,97 @@
+#include <string.h>
+#include "bench.h"
+#include "libembd/libembd_marshalling.h"
+#include "libembd/libembd_delta.h"
+
+// Delta encoding of a slowly changing telemetry frame: 64 float32 fields (256 bytes), of which 2 to 4 random fields
+// change from one frame to the next. Reports the average delta size relative to the full frame and the time per frame.
+
+#define FIELDS      64u
+#define FRAME_SIZE  (FIELDS * sizeof(float32))
+#define FRAMES      1000u
+#define ITERATIONS  200u
+
+static uint8 g_frames[FRAMES][FRAME_SIZE];
+static uint8 g_deltas[FRAMES][LIBEMBD_DELTA_MAX_SIZE(FRAME_SIZE)];
+static uint32 g_delta_sizes[FRAMES];
+static uint8 g_receiver[FRAME_SIZE];
+
+static void generate_frames(void)
+{
+    float32 fields[FIELDS];
+    uint32 frame;
+    uint32 i;
+
+    for(i = 0u; i < FIELDS; i++){
+        fields[i] = (float32)(bench_random() % 10000u) * 0.01f;
+    }
+    for(frame = 0u; frame < FRAMES; frame++){
+        LibEmbd_Serializer_t ser;
+        uint32 const changes = 2u + (bench_random() % 3u);
+        for(i = 0u; i < changes; i++){
+            fields[bench_random() % FIELDS] += 0.25f;
+        }
+        libembd_make_serializer(&ser, g_frames[frame], FRAME_SIZE);
+        libembd_put_float32_array_to_network_unsafe(&ser, fields, FIELDS);
+    }
+}
+
+static uint32 encode_all(void)
+{
+    uint32 total = 0u;
+    uint32 frame;
+
+    for(frame = 1u; frame < FRAMES; frame++){
+        LibEmbd_Serializer_t ser;
+        LibEmbd_ConstBufferView_t const previous = { g_frames[frame - 1u], FRAME_SIZE };
+        LibEmbd_ConstBufferView_t const current = { g_frames[frame], FRAME_SIZE };
+        libembd_make_serializer(&ser, g_deltas[frame], sizeof(g_deltas[frame]));
+        (void)libembd_put_delta_checked(&ser, previous, current);
+        g_delta_sizes[frame] = ser.position;
+        total += ser.position;
+    }
+    return total;
+}
+
+static void decode_all(void)
+{
+    LibEmbd_MutableBufferView_t const frame_view = { g_receiver, FRAME_SIZE };
+    uint32 frame;
+
+    memcpy(g_receiver, g_frames[0], FRAME_SIZE);
+    for(frame = 1u; frame < FRAMES; frame++){
+        LibEmbd_Deserializer_t deser;
+        libembd_make_deserializer(&deser, g_deltas[frame], g_delta_sizes[frame]);
+        libembd_get_delta_checked(&deser, frame_view);
+    }
+}
+
+static void copy_all(void)
+{
+    uint32 frame;
+    for(frame = 1u; frame < FRAMES; frame++){
+        memcpy(g_deltas[frame], g_frames[frame], FRAME_SIZE);
+        bench_clobber(g_deltas[frame]);
+    }
+}
+
+int main(void)
+{
+    uint32 total;
+
+    generate_frames();
+    total = encode_all();
+    decode_all();
+    if(memcmp(g_receiver, g_frames[FRAMES - 1u], FRAME_SIZE) != 0){
+        printf("decoded frame differs\n");
+        return 1;
+    }
+
+    printf("delta encoding, %u frames of %u bytes, 2-4 of %u fields changing per frame\n", FRAMES, (uint32)FRAME_SIZE, FIELDS);
+    printf("  average delta %.1f bytes, %.1f%% of the full frame\n",
+           (float64)total / (FRAMES - 1u), 100.0 * (float64)total / ((float64)(FRAMES - 1u) * FRAME_SIZE));
+    BENCH_RUN("full frame copy, all frames", ITERATIONS, (FRAMES - 1u) * FRAME_SIZE, copy_all());
+    BENCH_RUN("delta encode, all frames", ITERATIONS, (FRAMES - 1u) * FRAME_SIZE, bench_sink(encode_all()));
+    BENCH_RUN("delta decode, all frames", ITERATIONS, (FRAMES - 1u) * FRAME_SIZE, decode_all(); bench_clobber(g_receiver));
+    return 0;
+}
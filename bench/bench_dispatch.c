@@ -0,0 +1,103 @@
+#include "bench.h"
+#include "libembd/libembd_dispatch.h"
+
+// Perfect hash dispatcher against a linear search of the message table, the usual hand written dispatch loop: tables of
+// 16 and 300 entries with random ids and sizes, messages for random entries of the table with the expected payload
+// length, one message per op. The handler sums the payload lengths.
+
+#define MAX_ENTRIES 300u
+#define MESSAGES    1024u //power of two
+#define ITERATIONS  4000000u
+
+static LibEmbd_DispatchEntry_t g_entries[MAX_ENTRIES];
+static LibEmbd_Dispatcher_t g_dispatcher;
+static uint8 g_payload[64];
+static uint16 g_ids[MESSAGES];
+static uint16 g_lengths[MESSAGES];
+static uint32 g_next;
+static uint64 g_handled;
+
+static void on_message(void *context, LibEmbd_Deserializer_t *payload)
+{
+    (void)context;
+    g_handled += payload->capacity - payload->position;
+}
+
+static void generate_table(uint32 count)
+{
+    uint32 i;
+    uint32 j;
+
+    for(i = 0u; i < count; i++){
+        do {
+            g_entries[i].id = (uint16)bench_random();
+            for(j = 0u; (j < i) && (g_entries[j].id != g_entries[i].id); j++){
+            }
+        } while(j < i);
+        g_entries[i].size = (uint16)(bench_random() % sizeof(g_payload));
+        g_entries[i].handler = on_message;
+    }
+    for(i = 0u; i < MESSAGES; i++){
+        LibEmbd_DispatchEntry_t const *entry = &g_entries[bench_random() % count];
+        g_ids[i] = entry->id;
+        g_lengths[i] = entry->size;
+    }
+}
+
+static LibEmbd_Std_ReturnType dispatch_linear(LibEmbd_DispatchEntry_t const *entries, uint32 count, uint16 id,
+                                              LibEmbd_Deserializer_t *payload)
+{
+    uint32 i;
+
+    for(i = 0u; i < count; i++){
+        if(entries[i].id == id){
+            if(entries[i].size != (payload->capacity - payload->position)){
+                return E_NOT_OK;
+            }
+            entries[i].handler(NULL, payload);
+            return E_OK;
+        }
+    }
+    return E_NOT_OK;
+}
+
+static LibEmbd_Std_ReturnType next_hashed(void)
+{
+    LibEmbd_Deserializer_t payload;
+    uint32 const i = g_next++ & (MESSAGES - 1u);
+
+    libembd_make_deserializer(&payload, g_payload, g_lengths[i]);
+    return libembd_dispatch_message(&g_dispatcher, g_ids[i], &payload);
+}
+
+static LibEmbd_Std_ReturnType next_linear(uint32 count)
+{
+    LibEmbd_Deserializer_t payload;
+    uint32 const i = g_next++ & (MESSAGES - 1u);
+
+    libembd_make_deserializer(&payload, g_payload, g_lengths[i]);
+    return dispatch_linear(g_entries, count, g_ids[i], &payload);
+}
+
+int main(void)
+{
+    static uint32 const counts[] = { 16u, MAX_ENTRIES };
+    char label[64];
+    uint32 i;
+
+    for(i = 0u; i < sizeof(counts) / sizeof(counts[0]); i++){
+        generate_table(counts[i]);
+        if(libembd_make_dispatcher(&g_dispatcher, g_entries, counts[i], NULL) != E_OK){
+            printf("construction failed\n");
+            return 1;
+        }
+
+        printf("Message table of %u entries, %u messages\n", counts[i], MESSAGES);
+        BENCH_RUN("construction", 100u, 0u, bench_sink(libembd_make_dispatcher(&g_dispatcher, g_entries, counts[i], NULL)));
+        (void)snprintf(label, sizeof(label), "linear search of %u entries", counts[i]);
+        BENCH_RUN(label, ITERATIONS, 0u, bench_sink(next_linear(counts[i])));
+        BENCH_RUN("perfect hash", ITERATIONS, 0u, bench_sink(next_hashed()));
+    }
+    bench_sink(g_handled);
+    return 0;
+}
@@ -0,0 +1,74 @@
+#include <string.h>
+#include "bench.h"
+#include "libembd/libembd_marshalling.h"
+#include "libembd/libembd_lz.h"
+
+// LZ stream compression of a 64KB telemetry log: 4096 records of 16 bytes (timestamp, sensor id, status, reading),
+// compared against copying the log with memcpy.
+
+#define RECORDS     4096u
+#define RECORD_SIZE 16u
+#define LOG_SIZE    (RECORDS * RECORD_SIZE)
+#define ITERATIONS  200u
+
+static uint8 g_log[LOG_SIZE];
+static uint8 g_stream[LOG_SIZE + (LOG_SIZE / LIBEMBD_LZ_BLOCK_SIZE + 1u) * LIBEMBD_LZ_BLOCK_HEADER_SIZE + 4u]; //blocks never grow beyond stored
+static uint8 g_restored[LOG_SIZE];
+static LibEmbd_LzWorkspace_t g_work;
+
+static void generate_log(void)
+{
+    LibEmbd_Serializer_t ser;
+    float32 readings[8] = { 0.0f };
+    uint32 timestamp = 1000000u;
+    uint32 i;
+
+    libembd_make_serializer(&ser, g_log, sizeof(g_log));
+    for(i = 0u; i < RECORDS; i++){
+        uint32 const sensor = bench_random() % 8u;
+        timestamp += 10u + (bench_random() % 4u);
+        readings[sensor] += (float32)((sint32)(bench_random() % 5u) - 2) * 0.5f;
+        libembd_put_uint32_to_network_unsafe(&ser, timestamp);
+        libembd_put_uint16_to_network_unsafe(&ser, (uint16)(0x100u + sensor));
+        libembd_put_uint16_to_network_unsafe(&ser, ((bench_random() % 64u) == 0u) ? 0x0001u : 0x0000u);
+        libembd_put_float32_to_network_unsafe(&ser, readings[sensor]);
+        libembd_put_uint32_to_network_unsafe(&ser, 0u); //reserved
+    }
+}
+
+static uint32 compress_log(void)
+{
+    LibEmbd_Serializer_t ser;
+    libembd_make_serializer(&ser, g_stream, sizeof(g_stream));
+    libembd_put_lz_stream_checked(&ser, &g_work, g_log, LOG_SIZE);
+    return libembd_serializer_has_overflowed(&ser) ? 0u : ser.position;
+}
+
+static uint32 decompress_log(uint32 stream_length)
+{
+    LibEmbd_Deserializer_t deser;
+    uint32 length;
+    libembd_make_deserializer(&deser, g_stream, stream_length);
+    libembd_get_lz_stream_checked(&deser, g_restored, sizeof(g_restored), &length);
+    return length;
+}
+
+int main(void)
+{
+    uint32 stream_length;
+
+    generate_log();
+    stream_length = compress_log();
+    if((stream_length == 0u) || (decompress_log(stream_length) != LOG_SIZE) || (memcmp(g_log, g_restored, LOG_SIZE) != 0)){
+        printf("round trip failed\n");
+        return 1;
+    }
+
+    printf("LZ stream, %u byte telemetry log in %u byte blocks, hash table of %u entries\n",
+           LOG_SIZE, LIBEMBD_LZ_BLOCK_SIZE, LIBEMBD_LZ_HASH_SIZE);
+    printf("  compressed to %u bytes, %.1f%% of the original\n", stream_length, 100.0 * (float64)stream_length / LOG_SIZE);
+    BENCH_RUN("memcpy", ITERATIONS, LOG_SIZE, memcpy(g_restored, g_log, LOG_SIZE); bench_clobber(g_restored));
+    BENCH_RUN("compress", ITERATIONS, LOG_SIZE, bench_sink(compress_log()));
+    BENCH_RUN("decompress", ITERATIONS, LOG_SIZE, bench_sink(decompress_log(stream_length)));
+    return 0;
+}
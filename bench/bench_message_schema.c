@@ -0,0 +1,87 @@
+#include "bench.h"
+#include "libembd/libembd_message_schema.h"
+
+// Generated pack/unpack of a 16-field status message against the equivalent hand-written checked put/get sequence
+
+#define ITERATIONS  10000000u
+
+#define STATUS_MSG_FIELDS(FIELD) \
+    FIELD(uint16,  msg_id,      network) \
+    FIELD(uint16,  sequence,    network) \
+    FIELD(uint64,  timestamp,   network) \
+    FIELD(uint32,  uptime,      network) \
+    FIELD(float32, voltage,     network) \
+    FIELD(float32, current,     network) \
+    FIELD(float32, temperature, network) \
+    FIELD(sint16,  rpm,         network) \
+    FIELD(sint16,  torque,      network) \
+    FIELD(uint32,  error_mask,  network) \
+    FIELD(uint8,   mode,        host) \
+    FIELD(uint8,   flags,       host) \
+    FIELD(float64, latitude,    network) \
+    FIELD(float64, longitude,   network) \
+    FIELD(uint32,  odometer,    network) \
+    FIELD(uint16,  crc,         network)
+
+LIBEMBD_DEFINE_MESSAGE(StatusMsg, STATUS_MSG_FIELDS)
+
+static uint8 g_frame[LIBEMBD_MESSAGE_SIZE(StatusMsg)];
+
+static void pack_by_hand(LibEmbd_Serializer_t *ser, StatusMsg_t const *msg)
+{
+    libembd_put_uint16_to_network_checked(ser, msg->msg_id);
+    libembd_put_uint16_to_network_checked(ser, msg->sequence);
+    libembd_put_uint64_to_network_checked(ser, msg->timestamp);
+    libembd_put_uint32_to_network_checked(ser, msg->uptime);
+    libembd_put_float32_to_network_checked(ser, msg->voltage);
+    libembd_put_float32_to_network_checked(ser, msg->current);
+    libembd_put_float32_to_network_checked(ser, msg->temperature);
+    libembd_put_sint16_to_network_checked(ser, msg->rpm);
+    libembd_put_sint16_to_network_checked(ser, msg->torque);
+    libembd_put_uint32_to_network_checked(ser, msg->error_mask);
+    libembd_put_uint8_checked(ser, msg->mode);
+    libembd_put_uint8_checked(ser, msg->flags);
+    libembd_put_float64_to_network_checked(ser, msg->latitude);
+    libembd_put_float64_to_network_checked(ser, msg->longitude);
+    libembd_put_uint32_to_network_checked(ser, msg->odometer);
+    libembd_put_uint16_to_network_checked(ser, msg->crc);
+}
+
+static void unpack_by_hand(LibEmbd_Deserializer_t *deser, StatusMsg_t *msg)
+{
+    libembd_get_uint16_from_network_checked(deser, &msg->msg_id);
+    libembd_get_uint16_from_network_checked(deser, &msg->sequence);
+    libembd_get_uint64_from_network_checked(deser, &msg->timestamp);
+    libembd_get_uint32_from_network_checked(deser, &msg->uptime);
+    libembd_get_float32_from_network_checked(deser, &msg->voltage);
+    libembd_get_float32_from_network_checked(deser, &msg->current);
+    libembd_get_float32_from_network_checked(deser, &msg->temperature);
+    libembd_get_sint16_from_network_checked(deser, &msg->rpm);
+    libembd_get_sint16_from_network_checked(deser, &msg->torque);
+    libembd_get_uint32_from_network_checked(deser, &msg->error_mask);
+    libembd_get_uint8_checked(deser, &msg->mode);
+    libembd_get_uint8_checked(deser, &msg->flags);
+    libembd_get_float64_from_network_checked(deser, &msg->latitude);
+    libembd_get_float64_from_network_checked(deser, &msg->longitude);
+    libembd_get_uint32_from_network_checked(deser, &msg->odometer);
+    libembd_get_uint16_from_network_checked(deser, &msg->crc);
+}
+
+int main(void)
+{
+    StatusMsg_t msg = { 0x0101u, 7u, 123456789012u, 3600u, 12.5f, 1.25f, 41.0f, -1200, 350, 0x10u, 2u, 0x81u,
+                        48.137154, 11.576124, 123456u, 0xBEEFu };
+    LibEmbd_Serializer_t ser;
+    LibEmbd_Deserializer_t deser;
+
+    printf("message schema, %u byte message with 16 fields\n", LIBEMBD_MESSAGE_SIZE(StatusMsg));
+    BENCH_RUN("pack, hand-written checked puts", ITERATIONS, sizeof(g_frame),
+              libembd_make_serializer(&ser, g_frame, sizeof(g_frame)); bench_clobber(&msg); pack_by_hand(&ser, &msg); bench_clobber(g_frame));
+    BENCH_RUN("pack, generated", ITERATIONS, sizeof(g_frame),
+              libembd_make_serializer(&ser, g_frame, sizeof(g_frame)); bench_clobber(&msg); (void)StatusMsg_pack(&ser, &msg); bench_clobber(g_frame));
+    BENCH_RUN("unpack, hand-written checked gets", ITERATIONS, sizeof(g_frame),
+              libembd_make_deserializer(&deser, g_frame, sizeof(g_frame)); bench_clobber(g_frame); unpack_by_hand(&deser, &msg); bench_clobber(&msg));
+    BENCH_RUN("unpack, generated", ITERATIONS, sizeof(g_frame),
+              libembd_make_deserializer(&deser, g_frame, sizeof(g_frame)); bench_clobber(g_frame); (void)StatusMsg_unpack(&deser, &msg); bench_clobber(&msg));
+    return 0;
+}
@@ -0,0 +1,84 @@
+#include "bench.h"
+#include "libembd/libembd_message_schema.h"
+
+// Full unpack of a 200-field message against a lazy view reading 3 of its fields (first, middle and last group).
+// Each op decodes one of 64 messages in a row, so that the fields read are not the same bytes every time.
+
+#define MESSAGES    64u
+#define ITERATIONS  2000000u
+
+// 10 fields of every type and both byte orders, 42 bytes
+#define FIELD_GROUP(FIELD, G) \
+    FIELD(uint8,   g##G##_a, host) \
+    FIELD(uint16,  g##G##_b, network) \
+    FIELD(uint32,  g##G##_c, network) \
+    FIELD(uint64,  g##G##_d, host) \
+    FIELD(sint16,  g##G##_e, network) \
+    FIELD(sint32,  g##G##_f, host) \
+    FIELD(float32, g##G##_g, network) \
+    FIELD(float64, g##G##_h, network) \
+    FIELD(sint8,   g##G##_i, host) \
+    FIELD(sint64,  g##G##_j, network)
+
+#define BIG_MSG_FIELDS(FIELD) \
+    FIELD_GROUP(FIELD, 0)  FIELD_GROUP(FIELD, 1)  FIELD_GROUP(FIELD, 2)  FIELD_GROUP(FIELD, 3)  FIELD_GROUP(FIELD, 4) \
+    FIELD_GROUP(FIELD, 5)  FIELD_GROUP(FIELD, 6)  FIELD_GROUP(FIELD, 7)  FIELD_GROUP(FIELD, 8)  FIELD_GROUP(FIELD, 9) \
+    FIELD_GROUP(FIELD, 10) FIELD_GROUP(FIELD, 11) FIELD_GROUP(FIELD, 12) FIELD_GROUP(FIELD, 13) FIELD_GROUP(FIELD, 14) \
+    FIELD_GROUP(FIELD, 15) FIELD_GROUP(FIELD, 16) FIELD_GROUP(FIELD, 17) FIELD_GROUP(FIELD, 18) FIELD_GROUP(FIELD, 19)
+
+LIBEMBD_DEFINE_MESSAGE(BigMsg, BIG_MSG_FIELDS)
+
+static uint8 g_frames[MESSAGES * LIBEMBD_MESSAGE_SIZE(BigMsg)];
+static BigMsg_t g_msg;
+
+#define RANDOM_FIELD(TYPE, NAME, ORDER) g_msg.NAME = (TYPE)bench_random();
+
+static uint64 unpack_three(uint32 i)
+{
+    LibEmbd_Deserializer_t deser;
+
+    libembd_make_deserializer(&deser, &g_frames[(i % MESSAGES) * LIBEMBD_MESSAGE_SIZE(BigMsg)], LIBEMBD_MESSAGE_SIZE(BigMsg));
+    (void)BigMsg_unpack(&deser, &g_msg);
+    return g_msg.g0_d + g_msg.g10_b + (uint64)g_msg.g19_j;
+}
+
+static uint64 view_three(uint32 i)
+{
+    LibEmbd_Deserializer_t deser;
+    LibEmbd_Deserializer_t view;
+    uint64 first = 0u;
+    uint16 middle = 0u;
+    sint64 last = 0;
+
+    libembd_make_deserializer(&deser, &g_frames[(i % MESSAGES) * LIBEMBD_MESSAGE_SIZE(BigMsg)], LIBEMBD_MESSAGE_SIZE(BigMsg));
+    if(BigMsg_view(&deser, &view)){
+        LIBEMBD_MESSAGE_VIEW_GET(BigMsg, &view, g0_d, &first);
+        LIBEMBD_MESSAGE_VIEW_GET(BigMsg, &view, g10_b, &middle);
+        LIBEMBD_MESSAGE_VIEW_GET(BigMsg, &view, g19_j, &last);
+    }
+    return first + middle + (uint64)last;
+}
+
+int main(void)
+{
+    LibEmbd_Serializer_t ser;
+    uint32 message = 0u;
+    uint32 i;
+
+    libembd_make_serializer(&ser, g_frames, sizeof(g_frames));
+    for(i = 0u; i < MESSAGES; i++){
+        BIG_MSG_FIELDS(RANDOM_FIELD)
+        (void)BigMsg_pack(&ser, &g_msg);
+    }
+    for(i = 0u; i < MESSAGES; i++){
+        if(unpack_three(i) != view_three(i)){
+            printf("view mismatch\n");
+            return 1;
+        }
+    }
+
+    printf("message view, %u byte message with 200 fields, 3 fields read\n", LIBEMBD_MESSAGE_SIZE(BigMsg));
+    BENCH_RUN("full unpack", ITERATIONS, 0u, bench_sink(unpack_three(message++)));
+    BENCH_RUN("view + 3 gets", ITERATIONS, 0u, bench_sink(view_three(message++)));
+    return 0;
+}
@@ -0,0 +1,72 @@
+#include "bench.h"
+#include "libembd/libembd_marshalling.h"
+#include "libembd/libembd_quantize.h"
+
+// 16-bit encodings of a 4096 sample float32 frame against sending the float32 values as they are. Throughput is given
+// in float32 input bytes per second so that all variants are comparable.
+
+#define SAMPLES     4096u
+#define ITERATIONS  20000u
+
+static float32 g_f32[SAMPLES];
+static uint8 g_frame[SAMPLES * sizeof(float32)];
+
+static void put_float16_loop(LibEmbd_Serializer_t *ser)
+{
+    uint32 i;
+    for(i = 0u; i < SAMPLES; i++){
+        libembd_put_float16_to_network_unsafe(ser, g_f32[i]);
+    }
+}
+
+static void get_float16_loop(LibEmbd_Deserializer_t *deser)
+{
+    uint32 i;
+    for(i = 0u; i < SAMPLES; i++){
+        libembd_get_float16_from_network_unsafe(deser, &g_f32[i]);
+    }
+}
+
+static void put_scaled_int16_loop(LibEmbd_Serializer_t *ser)
+{
+    uint32 i;
+    for(i = 0u; i < SAMPLES; i++){
+        libembd_put_scaled_int16_to_network_unsafe(ser, g_f32[i], 0.01f, 0.0f);
+    }
+}
+
+int main(void)
+{
+    LibEmbd_Serializer_t ser;
+    LibEmbd_Deserializer_t deser;
+    uint32 i;
+
+    for(i = 0u; i < SAMPLES; i++){
+        g_f32[i] = 20.0f + ((float32)(i % 1000u) * 0.137f); //sensor readings well inside the float16 range
+    }
+
+    printf("quantized float encodings, %u samples: float32 %u bytes, 16-bit encodings %u bytes\n",
+           SAMPLES, SAMPLES * (uint32)sizeof(float32), SAMPLES * (uint32)sizeof(uint16));
+    BENCH_RUN("float32 to network, array", ITERATIONS, SAMPLES * sizeof(float32),
+              libembd_make_serializer(&ser, g_frame, sizeof(g_frame)); libembd_put_float32_array_to_network_unsafe(&ser, g_f32, SAMPLES);
+              bench_clobber(g_frame));
+    BENCH_RUN("float16 to network, per element", ITERATIONS, SAMPLES * sizeof(float32),
+              libembd_make_serializer(&ser, g_frame, sizeof(g_frame)); put_float16_loop(&ser); bench_clobber(g_frame));
+    BENCH_RUN("float16 to network, array", ITERATIONS, SAMPLES * sizeof(float32),
+              libembd_make_serializer(&ser, g_frame, sizeof(g_frame)); libembd_put_float16_array_to_network_unsafe(&ser, g_f32, SAMPLES);
+              bench_clobber(g_frame));
+    BENCH_RUN("bfloat16 to network, array", ITERATIONS, SAMPLES * sizeof(float32),
+              libembd_make_serializer(&ser, g_frame, sizeof(g_frame)); libembd_put_bfloat16_array_to_network_unsafe(&ser, g_f32, SAMPLES);
+              bench_clobber(g_frame));
+    BENCH_RUN("scaled int16 to network, per element", ITERATIONS, SAMPLES * sizeof(float32),
+              libembd_make_serializer(&ser, g_frame, sizeof(g_frame)); put_scaled_int16_loop(&ser); bench_clobber(g_frame));
+
+    libembd_make_serializer(&ser, g_frame, sizeof(g_frame));
+    libembd_put_float16_array_to_network_unsafe(&ser, g_f32, SAMPLES);
+    BENCH_RUN("float16 from network, per element", ITERATIONS, SAMPLES * sizeof(float32),
+              libembd_make_deserializer(&deser, g_frame, sizeof(g_frame)); get_float16_loop(&deser); bench_clobber(g_f32));
+    BENCH_RUN("float16 from network, array", ITERATIONS, SAMPLES * sizeof(float32),
+              libembd_make_deserializer(&deser, g_frame, sizeof(g_frame)); libembd_get_float16_array_from_network_unsafe(&deser, g_f32, SAMPLES);
+              bench_clobber(g_f32));
+    return 0;
+}
@@ -0,0 +1,79 @@
+#include <pthread.h>
+#include <unistd.h>
+#include "bench.h"
+#include "libembd/libembd_sg_serializer.h"
+
+// 64KB payloads plus a 16 byte header written to a pipe: scatter-gather writev against copy-then-write
+
+#define PAYLOAD_SIZE    65536u
+#define HEADER_SIZE     16u
+#define ITERATIONS      20000u
+
+static uint8 g_payload[PAYLOAD_SIZE];
+static uint8 g_linear[HEADER_SIZE + PAYLOAD_SIZE];
+
+static void *drain(void *arg)
+{
+    static uint8 sink[PAYLOAD_SIZE];
+    int const fd = *(int const *)arg;
+    while(read(fd, sink, sizeof(sink)) > 0){
+    }
+    return NULL;
+}
+
+static void put_header(LibEmbd_Serializer_t *ser, uint32 sequence)
+{
+    libembd_put_uint16_to_network_checked(ser, 0x0230u);
+    libembd_put_uint16_to_network_checked(ser, 0u);
+    libembd_put_uint32_to_network_checked(ser, sequence);
+    libembd_put_uint32_to_network_checked(ser, PAYLOAD_SIZE);
+    libembd_put_uint32_to_network_checked(ser, 0xA5A5A5A5u);
+}
+
+static void send_copied(int fd, uint32 sequence)
+{
+    LibEmbd_Serializer_t ser;
+    uint32 written = 0u;
+
+    libembd_make_serializer(&ser, g_linear, sizeof(g_linear));
+    put_header(&ser, sequence);
+    libembd_put_buffer_checked(&ser, g_payload, PAYLOAD_SIZE);
+    while(written < ser.position){
+        ssize_t const result = write(fd, &g_linear[written], ser.position - written);
+        if(result <= 0){
+            return;
+        }
+        written += (uint32)result;
+    }
+}
+
+static void send_gathered(int fd, uint32 sequence)
+{
+    uint8 header[HEADER_SIZE];
+    LibEmbd_SgSerializer_t sg;
+
+    libembd_make_sg_serializer(&sg, header, sizeof(header));
+    put_header(libembd_sg_serializer_inline(&sg), sequence);
+    libembd_sg_put_buffer(&sg, g_payload, PAYLOAD_SIZE);
+    (void)libembd_sg_serializer_writev(&sg, fd);
+}
+
+int main(void)
+{
+    pthread_t reader;
+    int fds[2];
+    uint32 sequence = 0u;
+
+    if((pipe(fds) != 0) || (pthread_create(&reader, NULL, drain, &fds[0]) != 0)){
+        return 1;
+    }
+
+    printf("scatter-gather serializer, %u byte payload through a pipe\n", PAYLOAD_SIZE);
+    BENCH_RUN("copy into linear buffer, write()", ITERATIONS, HEADER_SIZE + PAYLOAD_SIZE, send_copied(fds[1], sequence++));
+    BENCH_RUN("scatter-gather, writev()", ITERATIONS, HEADER_SIZE + PAYLOAD_SIZE, send_gathered(fds[1], sequence++));
+
+    (void)close(fds[1]);
+    (void)pthread_join(reader, NULL);
+    (void)close(fds[0]);
+    return 0;
+}
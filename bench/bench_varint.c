@@ -0,0 +1,83 @@
+#include "bench.h"
+#include "libembd/libembd_varint.h"
+
+// Varint encoding of mostly small counters and ids against fixed-width uint32
+
+#define VALUES      4096u
+#define ITERATIONS  20000u
+
+static uint32 g_values[VALUES];
+static uint32 g_decoded[VALUES];
+static uint8 g_fixed[VALUES * sizeof(uint32)];
+static uint8 g_varint[VALUES * 5u];
+
+static void put_fixed(LibEmbd_Serializer_t *ser)
+{
+    uint32 i;
+    for(i = 0u; i < VALUES; i++){
+        libembd_put_uint32_to_network_checked(ser, g_values[i]);
+    }
+}
+
+static void get_fixed(LibEmbd_Deserializer_t *deser)
+{
+    uint32 i;
+    for(i = 0u; i < VALUES; i++){
+        libembd_get_uint32_from_network_checked(deser, &g_decoded[i]);
+    }
+}
+
+static void put_varint(LibEmbd_Serializer_t *ser)
+{
+    uint32 i;
+    for(i = 0u; i < VALUES; i++){
+        libembd_put_varuint32_checked(ser, g_values[i]);
+    }
+}
+
+static void get_varint(LibEmbd_Deserializer_t *deser)
+{
+    uint32 i;
+    for(i = 0u; i < VALUES; i++){
+        libembd_get_varuint32_checked(deser, &g_decoded[i]);
+    }
+}
+
+int main(void)
+{
+    LibEmbd_Serializer_t ser;
+    LibEmbd_Deserializer_t deser;
+    uint32 state = 12345u;
+    uint32 varint_length;
+    uint32 i;
+
+    //80% below 128, 15% below 16384, 5% anywhere in the 32-bit range
+    for(i = 0u; i < VALUES; i++){
+        state = state * 1664525u + 1013904223u;
+        switch((state >> 24) % 20u){
+            case 0u:  g_values[i] = state * 2654435761u;  break;
+            case 1u:
+            case 2u:
+            case 3u:  g_values[i] = (state >> 8) % 16384u; break;
+            default:  g_values[i] = (state >> 8) % 128u;   break;
+        }
+    }
+    libembd_make_serializer(&ser, g_varint, sizeof(g_varint));
+    put_varint(&ser);
+    varint_length = ser.position;
+
+    printf("varint, %u values: %u bytes fixed width, %u bytes varint (%.1f%%)\n", VALUES, (uint32)sizeof(g_fixed), varint_length,
+           100.0 * varint_length / sizeof(g_fixed));
+    BENCH_RUN("put uint32 fixed width, checked", ITERATIONS, 0u,
+              libembd_make_serializer(&ser, g_fixed, sizeof(g_fixed)); put_fixed(&ser); bench_clobber(g_fixed));
+    BENCH_RUN("put varuint32, checked", ITERATIONS, 0u,
+              libembd_make_serializer(&ser, g_varint, sizeof(g_varint)); put_varint(&ser); bench_clobber(g_varint));
+    BENCH_RUN("get uint32 fixed width, checked", ITERATIONS, 0u,
+              libembd_make_deserializer(&deser, g_fixed, sizeof(g_fixed)); get_fixed(&deser); bench_clobber(g_decoded));
+    BENCH_RUN("get varuint32, checked", ITERATIONS, 0u,
+              libembd_make_deserializer(&deser, g_varint, varint_length); get_varint(&deser); bench_clobber(g_decoded));
+    BENCH_RUN("get varuint32 array, checked", ITERATIONS, 0u,
+              libembd_make_deserializer(&deser, g_varint, varint_length);
+              bench_sink(libembd_get_varuint32_array_checked(&deser, g_decoded, VALUES)); bench_clobber(g_decoded));
+    return 0;
+}
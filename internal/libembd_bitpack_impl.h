@@ -0,0 +1,178 @@
+#ifndef LIBEMBD_BITPACK_IMPL_H_
+#define LIBEMBD_BITPACK_IMPL_H_
+
+#include "libembd/libembd_platform_types.h"
+#include "libembd/libembd_common.h"
+#include "libembd/libembd_util.h"
+
+/**
+ * @brief Bit field kernels used by the bit-level marshalling apis
+ *
+ * Fields of 1 to 64 bits are transferred with a single 64-bit load (and store) of the frame whenever the field lies
+ * within one 8-byte window, which covers every field of up to 57 bits. Wider fields that straddle nine bytes are split
+ * at the window boundary. Near the end of the frame the window is assembled byte by byte so that nothing outside
+ * frame_length is ever accessed.
+ *
+ * Two bit numberings are used internally:
+ *  - Intel (little endian): bit i is bit (i % 8) of byte (i / 8), fields are addressed by their LSB
+ *  - Motorola (big endian): bit i is bit (7 - i % 8) of byte (i / 8), fields are addressed by their MSB.
+ *    The DBC start bit of a Motorola signal maps to this numbering via start_bit ^ 7.
+ */
+
+LIBEMBD_LOCAL_INLINE uint64 libembd_bits_mask_internal(uint32 width)
+{
+    return (width >= 64u) ? ~0ull : ((1ull << width) - 1u);
+}
+
+LIBEMBD_LOCAL_INLINE uint64 libembd_bits_load_le_internal(uint8 const *frame, uint32 frame_length, uint32 byte)
+{
+    uint64 word = 0u;
+    if(LIBEMBD_LIKELY(byte + sizeof(word) <= frame_length)){
+        LIBEMBD_MEMCPY(&word, &frame[byte], sizeof(word));
+#if (LIBEMBD_HOST_ENDIANNESS == LIBEMBD_ENDIANNESS_BIG_ENDIAN)
+        word = LIBEMBD_BSWAP64(word);
+#endif
+    } else {
+        uint32 i;
+        for(i = 0u; byte + i < frame_length; i++){
+            word |= (uint64)frame[byte + i] << (8u * i);
+        }
+    }
+    return word;
+}
+
+LIBEMBD_LOCAL_INLINE void libembd_bits_store_le_internal(uint8 *frame, uint32 frame_length, uint32 byte, uint64 word)
+{
+    if(LIBEMBD_LIKELY(byte + sizeof(word) <= frame_length)){
+#if (LIBEMBD_HOST_ENDIANNESS == LIBEMBD_ENDIANNESS_BIG_ENDIAN)
+        word = LIBEMBD_BSWAP64(word);
+#endif
+        LIBEMBD_MEMCPY(&frame[byte], &word, sizeof(word));
+    } else {
+        uint32 i;
+        for(i = 0u; byte + i < frame_length; i++){
+            frame[byte + i] = (uint8)(word >> (8u * i));
+        }
+    }
+}
+
+LIBEMBD_LOCAL_INLINE uint64 libembd_bits_load_be_internal(uint8 const *frame, uint32 frame_length, uint32 byte)
+{
+    uint64 word = 0u;
+    if(LIBEMBD_LIKELY(byte + sizeof(word) <= frame_length)){
+        LIBEMBD_MEMCPY(&word, &frame[byte], sizeof(word));
+#if (LIBEMBD_HOST_ENDIANNESS == LIBEMBD_ENDIANNESS_LITTLE_ENDIAN)
+        word = LIBEMBD_BSWAP64(word);
+#endif
+    } else {
+        uint32 i;
+        for(i = 0u; byte + i < frame_length; i++){
+            word |= (uint64)frame[byte + i] << (56u - 8u * i);
+        }
+    }
+    return word;
+}
+
+LIBEMBD_LOCAL_INLINE void libembd_bits_store_be_internal(uint8 *frame, uint32 frame_length, uint32 byte, uint64 word)
+{
+    if(LIBEMBD_LIKELY(byte + sizeof(word) <= frame_length)){
+#if (LIBEMBD_HOST_ENDIANNESS == LIBEMBD_ENDIANNESS_LITTLE_ENDIAN)
+        word = LIBEMBD_BSWAP64(word);
+#endif
+        LIBEMBD_MEMCPY(&frame[byte], &word, sizeof(word));
+    } else {
+        uint32 i;
+        for(i = 0u; byte + i < frame_length; i++){
+            frame[byte + i] = (uint8)(word >> (56u - 8u * i));
+        }
+    }
+}
+
+// Field must lie within the 8-byte window starting at byte lsb_bit / 8
+LIBEMBD_LOCAL_INLINE void libembd_bits_write_intel_window_internal(uint8 *frame, uint32 frame_length, uint32 lsb_bit, uint32 width, uint64 value)
+{
+    uint32 const byte = lsb_bit >> 3u;
+    uint32 const shift = lsb_bit & 7u;
+    uint64 const mask = libembd_bits_mask_internal(width) << shift;
+    uint64 const word = libembd_bits_load_le_internal(frame, frame_length, byte);
+    libembd_bits_store_le_internal(frame, frame_length, byte, (word & ~mask) | ((value << shift) & mask));
+}
+
+LIBEMBD_LOCAL_INLINE uint64 libembd_bits_read_intel_window_internal(uint8 const *frame, uint32 frame_length, uint32 lsb_bit, uint32 width)
+{
+    uint64 const word = libembd_bits_load_le_internal(frame, frame_length, lsb_bit >> 3u);
+    return (word >> (lsb_bit & 7u)) & libembd_bits_mask_internal(width);
+}
+
+// Field must lie within the 8-byte window starting at byte msb_bit / 8
+LIBEMBD_LOCAL_INLINE void libembd_bits_write_motorola_window_internal(uint8 *frame, uint32 frame_length, uint32 msb_bit, uint32 width, uint64 value)
+{
+    uint32 const byte = msb_bit >> 3u;
+    uint32 const shift = 64u - (msb_bit & 7u) - width;
+    uint64 const mask = libembd_bits_mask_internal(width) << shift;
+    uint64 const word = libembd_bits_load_be_internal(frame, frame_length, byte);
+    libembd_bits_store_be_internal(frame, frame_length, byte, (word & ~mask) | ((value << shift) & mask));
+}
+
+LIBEMBD_LOCAL_INLINE uint64 libembd_bits_read_motorola_window_internal(uint8 const *frame, uint32 frame_length, uint32 msb_bit, uint32 width)
+{
+    uint64 const word = libembd_bits_load_be_internal(frame, frame_length, msb_bit >> 3u);
+    return (word >> (64u - (msb_bit & 7u) - width)) & libembd_bits_mask_internal(width);
+}
+
+LIBEMBD_LOCAL_INLINE void libembd_bits_write_intel_internal(uint8 *frame, uint32 frame_length, uint32 lsb_bit, uint32 width, uint64 value)
+{
+    uint32 const shift = lsb_bit & 7u;
+    if(LIBEMBD_LIKELY(shift + width <= 64u)){
+        libembd_bits_write_intel_window_internal(frame, frame_length, lsb_bit, width, value);
+    } else {
+        uint32 const low_width = 64u - shift;
+        libembd_bits_write_intel_window_internal(frame, frame_length, lsb_bit, low_width, value);
+        libembd_bits_write_intel_window_internal(frame, frame_length, lsb_bit + low_width, width - low_width, value >> low_width);
+    }
+}
+
+LIBEMBD_LOCAL_INLINE uint64 libembd_bits_read_intel_internal(uint8 const *frame, uint32 frame_length, uint32 lsb_bit, uint32 width)
+{
+    uint32 const shift = lsb_bit & 7u;
+    if(LIBEMBD_LIKELY(shift + width <= 64u)){
+        return libembd_bits_read_intel_window_internal(frame, frame_length, lsb_bit, width);
+    } else {
+        uint32 const low_width = 64u - shift;
+        uint64 const low = libembd_bits_read_intel_window_internal(frame, frame_length, lsb_bit, low_width);
+        uint64 const high = libembd_bits_read_intel_window_internal(frame, frame_length, lsb_bit + low_width, width - low_width);
+        return low | (high << low_width);
+    }
+}
+
+LIBEMBD_LOCAL_INLINE void libembd_bits_write_motorola_internal(uint8 *frame, uint32 frame_length, uint32 msb_bit, uint32 width, uint64 value)
+{
+    uint32 const offset = msb_bit & 7u;
+    if(LIBEMBD_LIKELY(offset + width <= 64u)){
+        libembd_bits_write_motorola_window_internal(frame, frame_length, msb_bit, width, value);
+    } else {
+        uint32 const high_width = 64u - offset;
+        uint32 const low_width = width - high_width;
+        libembd_bits_write_motorola_window_internal(frame, frame_length, msb_bit, high_width, value >> low_width);
+        libembd_bits_write_motorola_window_internal(frame, frame_length, msb_bit + high_width, low_width, value);
+    }
+}
+
+LIBEMBD_LOCAL_INLINE uint64 libembd_bits_read_motorola_internal(uint8 const *frame, uint32 frame_length, uint32 msb_bit, uint32 width)
+{
+    uint32 const offset = msb_bit & 7u;
+    if(LIBEMBD_LIKELY(offset + width <= 64u)){
+        return libembd_bits_read_motorola_window_internal(frame, frame_length, msb_bit, width);
+    } else {
+        uint32 const high_width = 64u - offset;
+        uint32 const low_width = width - high_width;
+        uint64 const high = libembd_bits_read_motorola_window_internal(frame, frame_length, msb_bit, high_width);
+        uint64 const low = libembd_bits_read_motorola_window_internal(frame, frame_length, msb_bit + high_width, low_width);
+        return (high << low_width) | low;
+    }
+}
+
+// DBC Motorola start bit (MSB, sawtooth numbering) to Motorola linear bit index
+#define LIBEMBD_BITS_DBC_MOTOROLA_TO_MSB_INTERNAL(start_bit)    ((uint32)(start_bit) ^ 7u)
+
+#endif /* LIBEMBD_BITPACK_IMPL_H_ */
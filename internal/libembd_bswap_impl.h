@@ -0,0 +1,128 @@
+#ifndef LIBEMBD_BSWAP_IMPL_H_
+#define LIBEMBD_BSWAP_IMPL_H_
+
+#include <stdint.h> //uintptr_t
+#include "libembd/libembd_platform_types.h"
+#include "libembd/libembd_common.h"
+#include "libembd/libembd_util.h"
+
+#if LIBEMBD_HAS_AVX2
+    #include <immintrin.h>
+#elif LIBEMBD_HAS_SSSE3
+    #include <tmmintrin.h>
+#endif
+
+#if LIBEMBD_HAS_NEON
+    #include <arm_neon.h>
+#endif
+
+#if LIBEMBD_HAS_AVX2
+    #define LIBEMBD_BSWAP_VECTOR_SIZE_INTERNAL  32u
+#else
+    #define LIBEMBD_BSWAP_VECTOR_SIZE_INTERNAL  16u
+#endif
+
+// Shuffle masks reversing the bytes of every 16/32-bit element within a 128-bit lane
+#define LIBEMBD_BSWAP16_MASK_INTERNAL   1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14
+#define LIBEMBD_BSWAP32_MASK_INTERNAL   3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12
+
+// Vector store variants: UNALIGNED accepts any dst, ALIGNED requires dst to be at a vector boundary
+#define LIBEMBD_BSWAP_STORE256_UNALIGNED_INTERNAL(p, v)     _mm256_storeu_si256((__m256i *)(void *)(p), (v))
+#define LIBEMBD_BSWAP_STORE256_ALIGNED_INTERNAL(p, v)       _mm256_store_si256((__m256i *)(void *)(p), (v))
+#define LIBEMBD_BSWAP_STORE128_UNALIGNED_INTERNAL(p, v)     _mm_storeu_si128((__m128i *)(void *)(p), (v))
+#define LIBEMBD_BSWAP_STORE128_ALIGNED_INTERNAL(p, v)       _mm_store_si128((__m128i *)(void *)(p), (v))
+#define LIBEMBD_BSWAP_STORENEON_UNALIGNED_INTERNAL(p, v)    vst1q_u8((p), (v))
+#define LIBEMBD_BSWAP_STORENEON_ALIGNED_INTERNAL(p, v)      vst1q_u8((uint8 *)LIBEMBD_ASSUME_ALIGNED((p), 16u), (v))
+
+// Vector loops over whole 32/16-byte blocks, expanding to nothing where the instruction set is not available
+#if LIBEMBD_HAS_AVX2
+    #define LIBEMBD_BSWAP_LOOP256_INTERNAL(BITS, STORE) { \
+        __m256i const mask256 = _mm256_setr_epi8(LIBEMBD_BSWAP##BITS##_MASK_INTERNAL, LIBEMBD_BSWAP##BITS##_MASK_INTERNAL); \
+        for(; i + (256u / BITS) <= count; i += 256u / BITS){ \
+            __m256i const v = _mm256_loadu_si256((__m256i const *)(void const *)(src + i * (BITS / 8u))); \
+            LIBEMBD_BSWAP_STORE256_##STORE##_INTERNAL(dst + i * (BITS / 8u), _mm256_shuffle_epi8(v, mask256)); \
+        } \
+    }
+#else
+    #define LIBEMBD_BSWAP_LOOP256_INTERNAL(BITS, STORE)
+#endif
+
+#if LIBEMBD_HAS_AVX2 || LIBEMBD_HAS_SSSE3
+    #define LIBEMBD_BSWAP_LOOP128_INTERNAL(BITS, STORE) { \
+        __m128i const mask128 = _mm_setr_epi8(LIBEMBD_BSWAP##BITS##_MASK_INTERNAL); \
+        for(; i + (128u / BITS) <= count; i += 128u / BITS){ \
+            __m128i const v = _mm_loadu_si128((__m128i const *)(void const *)(src + i * (BITS / 8u))); \
+            LIBEMBD_BSWAP_STORE128_##STORE##_INTERNAL(dst + i * (BITS / 8u), _mm_shuffle_epi8(v, mask128)); \
+        } \
+    }
+#elif LIBEMBD_HAS_NEON
+    #define LIBEMBD_BSWAP_LOOP128_INTERNAL(BITS, STORE) { \
+        for(; i + (128u / BITS) <= count; i += 128u / BITS){ \
+            LIBEMBD_BSWAP_STORENEON_##STORE##_INTERNAL(dst + i * (BITS / 8u), vrev##BITS##q_u8(vld1q_u8(src + i * (BITS / 8u)))); \
+        } \
+    }
+#else
+    #define LIBEMBD_BSWAP_LOOP128_INTERNAL(BITS, STORE)
+#endif
+
+/**
+ * @brief Block byte swap kernels used by the bulk array marshalling apis
+ *
+ * Each kernel copies count elements from src to dst while reversing the byte order of every element. The vector loops
+ * handle whole 32/16-byte blocks and the remaining elements are handled by a scalar tail, which is also the complete
+ * implementation on targets without SIMD support. Loads are always unaligned, STORE selects the store variant.
+ */
+#define LIBEMBD_BSWAP_COPY_IMPLEMENTATION(BITS, NAME, STORE) \
+    LIBEMBD_LOCAL_INLINE void NAME(uint8 *dst, uint8 const *src, uint32 count) { \
+        uint32 i = 0u; \
+        LIBEMBD_BSWAP_LOOP256_INTERNAL(BITS, STORE) \
+        LIBEMBD_BSWAP_LOOP128_INTERNAL(BITS, STORE) \
+        for(; i < count; i++){ \
+            uint##BITS val; \
+            LIBEMBD_MEMCPY(&val, src + i * (BITS / 8u), sizeof(val)); \
+            val = (uint##BITS)LIBEMBD_BSWAP##BITS(val); \
+            LIBEMBD_MEMCPY(dst + i * (BITS / 8u), &val, sizeof(val)); \
+        } \
+    }
+
+// Neither pointer needs to be aligned
+LIBEMBD_BSWAP_COPY_IMPLEMENTATION(16, libembd_bswap16_copy_internal, UNALIGNED)
+LIBEMBD_BSWAP_COPY_IMPLEMENTATION(32, libembd_bswap32_copy_internal, UNALIGNED)
+
+// dst must be at a vector boundary
+LIBEMBD_BSWAP_COPY_IMPLEMENTATION(16, libembd_bswap16_copy_from_boundary_internal, ALIGNED)
+LIBEMBD_BSWAP_COPY_IMPLEMENTATION(32, libembd_bswap32_copy_from_boundary_internal, ALIGNED)
+
+/**
+ * @brief Block byte swap kernels for element-aligned buffers
+ *
+ * A scalar head advances dst to the next vector boundary so that every vector store is aligned. Both pointers must be
+ * naturally aligned for the element size.
+ */
+
+// Number of leading elements to swap before dst reaches a vector boundary
+LIBEMBD_LOCAL_INLINE uint32 libembd_bswap_aligned_head_internal(uint8 const *dst, uint32 element_size, uint32 count)
+{
+    uint32 const misalignment = (uint32)((uintptr_t)dst % LIBEMBD_BSWAP_VECTOR_SIZE_INTERNAL);
+    uint32 const head = (misalignment == 0u) ? 0u : (LIBEMBD_BSWAP_VECTOR_SIZE_INTERNAL - misalignment) / element_size;
+
+    return LIBEMBD_MIN(head, count);
+}
+
+LIBEMBD_LOCAL_INLINE void libembd_bswap16_copy_aligned_internal(uint8 *dst, uint8 const *src, uint32 count)
+{
+    uint32 const head = libembd_bswap_aligned_head_internal(dst, 2u, count);
+
+    libembd_bswap16_copy_internal(dst, src, head);
+    libembd_bswap16_copy_from_boundary_internal(dst + head * 2u, src + head * 2u, count - head);
+}
+
+LIBEMBD_LOCAL_INLINE void libembd_bswap32_copy_aligned_internal(uint8 *dst, uint8 const *src, uint32 count)
+{
+    uint32 const head = libembd_bswap_aligned_head_internal(dst, 4u, count);
+
+    libembd_bswap32_copy_internal(dst, src, head);
+    libembd_bswap32_copy_from_boundary_internal(dst + head * 4u, src + head * 4u, count - head);
+}
+
+#endif /* LIBEMBD_BSWAP_IMPL_H_ */
@@ -0,0 +1,216 @@
+#ifndef LIBEMBD_CHAIN_DESERIALIZER_IMPL_H_
+#define LIBEMBD_CHAIN_DESERIALIZER_IMPL_H_
+
+#include "libembd/libembd_common.h"
+#include "libembd/libembd_util.h"
+#include "libembd/libembd_marshalling.h"
+#include "libembd/libembd_chain_deserializer.h"
+
+struct LibEmbd_ChainDeserializer_t {
+    LibEmbd_Deserializer_t current; //segment being read, fields within it are read in place
+    LibEmbd_ConstBufferView_t const *next_segment; //first segment not entered yet
+    uint32 next_count;
+    uint8 const *wrap_buffer; //start of the ring buffer, entered after the last segment
+    uint32 wrap_length;
+    LibEmbd_Size_t consumed; //bytes of the segments before current
+    LibEmbd_Size_t length; //bytes of the whole chain
+    boolean overflow;
+};
+
+/*-------------------------------------------------------------Internal functions Begin---------------------------------------------------------------------------*/
+
+// Segments may be empty (and NULL), so the current deserializer is set up without the constructor's pointer check
+LIBEMBD_LOCAL_INLINE void libembd_chain_enter_internal(LibEmbd_ChainDeserializer_t *cdeser, uint8 const *data, uint32 length)
+{
+    cdeser->consumed += cdeser->current.capacity;
+    cdeser->current.buffer = data;
+    cdeser->current.capacity = length;
+    cdeser->current.position = 0u;
+}
+
+// Moves past completely read segments up to the next unread byte, if any
+LIBEMBD_LOCAL_INLINE void libembd_chain_enter_next_internal(LibEmbd_ChainDeserializer_t *cdeser)
+{
+    while((cdeser->current.position == cdeser->current.capacity) && (cdeser->consumed + cdeser->current.capacity != cdeser->length)){
+        if(cdeser->next_count > 0u){
+            libembd_chain_enter_internal(cdeser, cdeser->next_segment->data, cdeser->next_segment->length);
+            cdeser->next_segment++;
+            cdeser->next_count--;
+        } else {
+            libembd_chain_enter_internal(cdeser, cdeser->wrap_buffer, cdeser->wrap_length);
+            cdeser->wrap_length = 0u;
+        }
+    }
+}
+
+// Checks that size more bytes are left; otherwise sets the overflow flag and truncates the chain at the read position
+// so that every later read fails on the slow path, leaving the fast path free of an extra flag check
+LIBEMBD_LOCAL_INLINE boolean libembd_chain_available_internal(LibEmbd_ChainDeserializer_t *cdeser, uint32 size)
+{
+    if(LIBEMBD_UNLIKELY(cdeser->overflow || (size > cdeser->length - cdeser->consumed - cdeser->current.position))){
+        cdeser->overflow = TRUE;
+        cdeser->current.capacity = cdeser->current.position;
+        cdeser->length = cdeser->consumed + cdeser->current.position;
+        cdeser->next_count = 0u;
+        cdeser->wrap_length = 0u;
+        return FALSE;
+    }
+    return TRUE;
+}
+
+// Copies length bytes across segment boundaries (or skips them if data is NULL), availability must have been checked
+LIBEMBD_LOCAL_INLINE void libembd_chain_read_internal(LibEmbd_ChainDeserializer_t *cdeser, uint8 *data, uint32 length)
+{
+    uint32 chunk;
+
+    while(length > 0u){
+        libembd_chain_enter_next_internal(cdeser);
+        chunk = LIBEMBD_MIN(cdeser->current.capacity - cdeser->current.position, length);
+        if(data != NULL){
+            LIBEMBD_MEMCPY(data, &cdeser->current.buffer[cdeser->current.position], chunk);
+            data = &data[chunk];
+        }
+        cdeser->current.position += chunk;
+        length -= chunk;
+    }
+}
+
+/*-------------------------------------------------------------Internal Functions End-----------------------------------------------------------------------------*/
+
+LIBEMBD_HEADER_API_INLINE void libembd_make_chain_deserializer(LibEmbd_ChainDeserializer_t *cdeser, LibEmbd_ConstBufferView_t const *segments,
+                                                               uint32 segment_count)
+{
+    uint32 i;
+
+    LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(cdeser);
+    LIBEMBD_ASSUME((segments != NULL) || (segment_count == 0u));
+
+    cdeser->current.buffer = NULL;
+    cdeser->current.capacity = 0u; //empty until the first read enters a segment
+    cdeser->current.position = 0u;
+    cdeser->current.overflow = FALSE;
+    cdeser->next_segment = segments;
+    cdeser->next_count = segment_count;
+    cdeser->wrap_buffer = NULL;
+    cdeser->wrap_length = 0u;
+    cdeser->consumed = 0u;
+    cdeser->length = 0u;
+    cdeser->overflow = FALSE;
+    for(i = 0u; i < segment_count; i++){
+        cdeser->length += segments[i].length;
+    }
+}
+
+LIBEMBD_HEADER_API_INLINE void libembd_make_ring_deserializer(LibEmbd_ChainDeserializer_t *cdeser, uint8 const *ring, uint32 ring_size,
+                                                              uint32 read_index, uint32 length)
+{
+    uint32 const first = LIBEMBD_MIN(length, ring_size - read_index);
+
+    LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(cdeser);
+    LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(ring);
+    LIBEMBD_ASSUME((read_index < ring_size) && (length <= ring_size));
+
+    libembd_make_deserializer(&cdeser->current, &ring[read_index], first);
+    cdeser->next_segment = NULL;
+    cdeser->next_count = 0u;
+    cdeser->wrap_buffer = ring;
+    cdeser->wrap_length = length - first;
+    cdeser->consumed = 0u;
+    cdeser->length = length;
+    cdeser->overflow = FALSE;
+}
+
+// Fields within the current segment are read in place, fields straddling a boundary are assembled in scratch space
+#define LIBEMBD_CHAIN_GET_IMPLEMENTATION(TYPE, NAME) \
+    LIBEMBD_HEADER_API_INLINE void libembd_chain_get_##NAME(LibEmbd_ChainDeserializer_t *cdeser, TYPE *value) { \
+        LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(value); \
+        if(LIBEMBD_LIKELY(cdeser->current.capacity - cdeser->current.position >= sizeof(TYPE))) { \
+            libembd_get_##NAME##_unsafe(&cdeser->current, value); \
+        } else if(libembd_chain_available_internal(cdeser, sizeof(TYPE))) { \
+            libembd_chain_enter_next_internal(cdeser); \
+            if(cdeser->current.capacity - cdeser->current.position >= sizeof(TYPE)) { \
+                libembd_get_##NAME##_unsafe(&cdeser->current, value); \
+            } else { \
+                uint8 scratch[sizeof(TYPE)]; \
+                LibEmbd_Deserializer_t scratch_deser; \
+                libembd_chain_read_internal(cdeser, scratch, sizeof(scratch)); \
+                libembd_make_deserializer(&scratch_deser, scratch, sizeof(scratch)); \
+                libembd_get_##NAME##_unsafe(&scratch_deser, value); \
+            } \
+        } else { \
+            LIBEMBD_MEMSET(value, 0, sizeof(*value)); \
+        } \
+    }
+
+LIBEMBD_CHAIN_GET_IMPLEMENTATION(uint8, uint8)
+LIBEMBD_CHAIN_GET_IMPLEMENTATION(sint8, sint8)
+LIBEMBD_CHAIN_GET_IMPLEMENTATION(uint16, uint16_from_network)
+LIBEMBD_CHAIN_GET_IMPLEMENTATION(uint32, uint32_from_network)
+LIBEMBD_CHAIN_GET_IMPLEMENTATION(uint64, uint64_from_network)
+LIBEMBD_CHAIN_GET_IMPLEMENTATION(sint16, sint16_from_network)
+LIBEMBD_CHAIN_GET_IMPLEMENTATION(sint32, sint32_from_network)
+LIBEMBD_CHAIN_GET_IMPLEMENTATION(sint64, sint64_from_network)
+LIBEMBD_CHAIN_GET_IMPLEMENTATION(float32, float32_from_network)
+LIBEMBD_CHAIN_GET_IMPLEMENTATION(float64, float64_from_network)
+LIBEMBD_CHAIN_GET_IMPLEMENTATION(uint16, uint16_from_host)
+LIBEMBD_CHAIN_GET_IMPLEMENTATION(uint32, uint32_from_host)
+LIBEMBD_CHAIN_GET_IMPLEMENTATION(uint64, uint64_from_host)
+LIBEMBD_CHAIN_GET_IMPLEMENTATION(sint16, sint16_from_host)
+LIBEMBD_CHAIN_GET_IMPLEMENTATION(sint32, sint32_from_host)
+LIBEMBD_CHAIN_GET_IMPLEMENTATION(sint64, sint64_from_host)
+LIBEMBD_CHAIN_GET_IMPLEMENTATION(float32, float32_from_host)
+LIBEMBD_CHAIN_GET_IMPLEMENTATION(float64, float64_from_host)
+
+LIBEMBD_HEADER_API_INLINE void libembd_chain_get_buffer(LibEmbd_ChainDeserializer_t *cdeser, void *buffer, uint32 length)
+{
+    LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(cdeser);
+    LIBEMBD_ASSUME((buffer != NULL) || (length == 0u));
+
+    if(!libembd_chain_available_internal(cdeser, length)){
+        LIBEMBD_MEMSET(buffer, 0, length);
+    } else if(length > 0u){
+        libembd_chain_read_internal(cdeser, (uint8 *)buffer, length);
+    }
+}
+
+LIBEMBD_HEADER_API_INLINE LibEmbd_ConstBufferView_t libembd_chain_get_view(LibEmbd_ChainDeserializer_t *cdeser, uint16 length)
+{
+    LibEmbd_ConstBufferView_t const empty_view = { NULL, 0u };
+
+    LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(cdeser);
+
+    if(!libembd_chain_available_internal(cdeser, length)){
+        return empty_view;
+    }
+    libembd_chain_enter_next_internal(cdeser);
+    if(cdeser->current.capacity - cdeser->current.position < length){
+        return empty_view; //straddles a segment boundary
+    }
+    return libembd_get_view_unsafe(&cdeser->current, length);
+}
+
+LIBEMBD_HEADER_API_INLINE void libembd_chain_skip(LibEmbd_ChainDeserializer_t *cdeser, uint32 length)
+{
+    LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(cdeser);
+
+    if(libembd_chain_available_internal(cdeser, length)){
+        libembd_chain_read_internal(cdeser, NULL, length);
+    }
+}
+
+LIBEMBD_HEADER_API_INLINE LibEmbd_Size_t libembd_chain_deserializer_total_length(LibEmbd_ChainDeserializer_t const *cdeser)
+{
+    return cdeser->consumed + cdeser->current.position;
+}
+
+LIBEMBD_HEADER_API_INLINE LibEmbd_Size_t libembd_chain_deserializer_remaining_length(LibEmbd_ChainDeserializer_t const *cdeser)
+{
+    return cdeser->length - cdeser->consumed - cdeser->current.position;
+}
+
+LIBEMBD_HEADER_API_INLINE boolean libembd_chain_deserializer_has_overflowed(LibEmbd_ChainDeserializer_t const *cdeser)
+{
+    return cdeser->overflow;
+}
+
+#endif /* LIBEMBD_CHAIN_DESERIALIZER_IMPL_H_ */
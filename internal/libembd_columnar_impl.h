@@ -0,0 +1,310 @@
+#ifndef LIBEMBD_COLUMNAR_IMPL_H_
+#define LIBEMBD_COLUMNAR_IMPL_H_
+
+#include "libembd/libembd_common.h"
+#include "libembd/libembd_util.h"
+#include "libembd/libembd_marshalling.h"
+#include "libembd/libembd_columnar.h"
+
+LIBEMBD_STATIC_ASSERT(LIBEMBD_IS_POWER_OF_TWO(LIBEMBD_COLUMNAR_DICTIONARY_SIZE) && (LIBEMBD_COLUMNAR_DICTIONARY_SIZE <= 256u), "LIBEMBD_COLUMNAR_DICTIONARY_SIZE must be a power of two no larger than 256");
+
+#define LIBEMBD_COLUMNAR_SLOT_COUNT_INTERNAL        (2u * LIBEMBD_COLUMNAR_DICTIONARY_SIZE) //keeps the id hash table at most half full
+#define LIBEMBD_COLUMNAR_HEADER_SIZE_INTERNAL       13u //count + base + width
+#define LIBEMBD_COLUMNAR_MAX_WIRE_DICTIONARY_INTERNAL 256u //indices are single bytes
+
+struct LibEmbd_TelemetryBatch_t {
+    uint64 *timestamps;
+    uint8 *indices;
+    float32 *values;
+    uint32 capacity;
+    uint32 count;
+    uint32 dictionary_size;
+    uint32 dictionary[LIBEMBD_COLUMNAR_DICTIONARY_SIZE];
+    uint16 slots[LIBEMBD_COLUMNAR_SLOT_COUNT_INTERNAL]; //dictionary index + 1 of the id hashed to this slot, 0 if empty
+};
+
+/*-------------------------------------------------------------Internal functions Begin---------------------------------------------------------------------------*/
+
+// Narrowest offset width in bytes that holds range
+LIBEMBD_LOCAL_INLINE uint32 libembd_columnar_offset_width_internal(uint64 range)
+{
+    if(range <= 0xFFu){
+        return 1u;
+    }
+    if(range <= 0xFFFFu){
+        return 2u;
+    }
+    if(range <= 0xFFFFFFFFu){
+        return 4u;
+    }
+    return 8u;
+}
+
+// Writes the timestamp offsets from base in network byte order
+LIBEMBD_LOCAL_INLINE void libembd_columnar_write_offsets_internal(uint8 *out, uint64 const *timestamps, uint32 count, uint64 base, uint32 width)
+{
+    uint32 i;
+
+    switch(width){
+    case 1u:
+        for(i = 0u; i < count; i++){
+            out[i] = (uint8)(timestamps[i] - base);
+        }
+        break;
+    case 2u:
+        for(i = 0u; i < count; i++){
+            uint16 const offset = (uint16)LIBEMBD_HTONS((uint16)(timestamps[i] - base));
+            LIBEMBD_MEMCPY(out + i * 2u, &offset, sizeof(offset));
+        }
+        break;
+    case 4u:
+        for(i = 0u; i < count; i++){
+            uint32 const offset = (uint32)LIBEMBD_HTONL((uint32)(timestamps[i] - base));
+            LIBEMBD_MEMCPY(out + i * 4u, &offset, sizeof(offset));
+        }
+        break;
+    default:
+        for(i = 0u; i < count; i++){
+            uint64 const offset = (uint64)LIBEMBD_HTONLL(timestamps[i] - base);
+            LIBEMBD_MEMCPY(out + i * 8u, &offset, sizeof(offset));
+        }
+        break;
+    }
+}
+
+LIBEMBD_LOCAL_INLINE uint32 libembd_columnar_read32_internal(uint8 const *p)
+{
+    uint32 value;
+    LIBEMBD_MEMCPY(&value, p, sizeof(value));
+    return (uint32)LIBEMBD_NTOHL(value);
+}
+
+// Hash table slot of an id
+LIBEMBD_LOCAL_INLINE uint32 libembd_columnar_slot_internal(uint32 id)
+{
+    return ((uint32)(id * 2654435761u) >> 16u) & (LIBEMBD_COLUMNAR_SLOT_COUNT_INTERNAL - 1u);
+}
+
+/*-------------------------------------------------------------Internal Functions End-----------------------------------------------------------------------------*/
+
+LIBEMBD_HEADER_API_INLINE void libembd_make_telemetry_batch(LibEmbd_TelemetryBatch_t *batch, uint64 *timestamps, uint8 *indices, float32 *values, uint32 capacity)
+{
+    LIBEMBD_ASSUME(batch != NULL);
+    LIBEMBD_ASSUME((timestamps != NULL) && (indices != NULL) && (values != NULL));
+
+    batch->timestamps = timestamps;
+    batch->indices = indices;
+    batch->values = values;
+    batch->capacity = capacity;
+    libembd_reset_telemetry_batch(batch);
+}
+
+LIBEMBD_HEADER_API_INLINE void libembd_reset_telemetry_batch(LibEmbd_TelemetryBatch_t *batch)
+{
+    LIBEMBD_ASSUME(batch != NULL);
+
+    batch->count = 0u;
+    batch->dictionary_size = 0u;
+    LIBEMBD_MEMSET(batch->slots, 0, sizeof(batch->slots));
+}
+
+LIBEMBD_HEADER_API_INLINE LibEmbd_Std_ReturnType libembd_telemetry_batch_append(LibEmbd_TelemetryBatch_t *batch, uint64 timestamp, uint32 id, float32 value)
+{
+    uint32 slot = libembd_columnar_slot_internal(id);
+    uint32 index;
+
+    LIBEMBD_ASSUME(batch != NULL);
+
+    if(LIBEMBD_UNLIKELY(batch->count >= batch->capacity)){
+        return E_NOT_OK;
+    }
+
+    for(;;){
+        uint32 const entry = batch->slots[slot];
+        if(entry == 0u){
+            if(LIBEMBD_UNLIKELY(batch->dictionary_size >= LIBEMBD_COLUMNAR_DICTIONARY_SIZE)){
+                return E_NOT_OK;
+            }
+            index = batch->dictionary_size++;
+            batch->dictionary[index] = id;
+            batch->slots[slot] = (uint16)(index + 1u);
+            break;
+        }
+        if(batch->dictionary[entry - 1u] == id){
+            index = entry - 1u;
+            break;
+        }
+        slot = (slot + 1u) & (LIBEMBD_COLUMNAR_SLOT_COUNT_INTERNAL - 1u);
+    }
+
+    batch->timestamps[batch->count] = timestamp;
+    batch->indices[batch->count] = (uint8)index;
+    batch->values[batch->count] = value;
+    batch->count++;
+    return E_OK;
+}
+
+LIBEMBD_HEADER_API_INLINE uint32 libembd_telemetry_batch_count(LibEmbd_TelemetryBatch_t const *batch)
+{
+    LIBEMBD_ASSUME(batch != NULL);
+
+    return batch->count;
+}
+
+LIBEMBD_HEADER_API_INLINE void libembd_put_telemetry_batch_checked(LibEmbd_Serializer_t *ser, LibEmbd_TelemetryBatch_t const *batch)
+{
+    uint32 const count = batch->count;
+    uint64 base = 0u;
+    uint64 last = 0u;
+    uint32 width;
+    uint64 size;
+
+    LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(ser);
+    LIBEMBD_ASSUME(batch != NULL);
+
+    if(count != 0u){
+        uint32 i;
+
+        base = batch->timestamps[0];
+        last = base;
+        for(i = 1u; i < count; i++){
+            base = LIBEMBD_MIN(base, batch->timestamps[i]);
+            last = LIBEMBD_MAX(last, batch->timestamps[i]);
+        }
+    }
+    width = libembd_columnar_offset_width_internal(last - base);
+
+    size = LIBEMBD_COLUMNAR_HEADER_SIZE_INTERNAL + (uint64)count * width + sizeof(uint16) + (uint64)batch->dictionary_size * sizeof(uint32) + (uint64)count * (sizeof(uint8) + sizeof(float32));
+    if(LIBEMBD_UNLIKELY(ser->overflow || (size > ser->capacity - ser->position))){
+        ser->overflow = TRUE;
+        return;
+    }
+
+    libembd_put_uint32_to_network_unsafe(ser, count);
+    libembd_put_uint64_to_network_unsafe(ser, base);
+    libembd_put_uint8_unsafe(ser, (uint8)width);
+    libembd_columnar_write_offsets_internal(&ser->buffer[ser->position], batch->timestamps, count, base, width);
+    ser->position += count * width;
+
+    libembd_put_uint16_to_network_unsafe(ser, (uint16)batch->dictionary_size);
+    libembd_put_uint32_array_to_network_unsafe(ser, batch->dictionary, batch->dictionary_size);
+    LIBEMBD_MEMCPY(&ser->buffer[ser->position], batch->indices, count);
+    ser->position += count;
+    libembd_put_float32_array_to_network_unsafe(ser, batch->values, count);
+}
+
+LIBEMBD_HEADER_API_INLINE void libembd_get_telemetry_batch_checked(LibEmbd_Deserializer_t *deser, LibEmbd_TelemetryBatchView_t *view)
+{
+    uint32 position;
+    uint32 count;
+    uint64 base;
+    uint8 width;
+    uint16 dictionary_size;
+    uint64 offsets_size;
+    uint64 size;
+    uint8 const *indices;
+    uint32 max_index = 0u;
+    uint32 i;
+
+    LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(deser);
+    LIBEMBD_ASSUME(view != NULL);
+
+    position = deser->position;
+    LIBEMBD_MEMSET(view, 0, sizeof(*view)); //an empty batch with an empty dictionary
+    if(!libembd_deserializer_reserve(deser, LIBEMBD_COLUMNAR_HEADER_SIZE_INTERNAL)){
+        return;
+    }
+    libembd_read_uint32_from_network_unsafe(deser, position, &count);
+    libembd_read_uint64_from_network_unsafe(deser, position + 4u, &base);
+    width = deser->buffer[position + 12u];
+    offsets_size = (uint64)count * width;
+
+    size = LIBEMBD_COLUMNAR_HEADER_SIZE_INTERNAL + offsets_size + sizeof(uint16);
+    if(LIBEMBD_UNLIKELY(((width != 1u) && (width != 2u) && (width != 4u) && (width != 8u)) || (size > deser->capacity - position))){
+        deser->overflow = TRUE;
+        return;
+    }
+    libembd_read_uint16_from_network_unsafe(deser, position + (uint32)(size - sizeof(uint16)), &dictionary_size);
+
+    size += (uint64)dictionary_size * sizeof(uint32) + (uint64)count * (sizeof(uint8) + sizeof(float32));
+    if(LIBEMBD_UNLIKELY((dictionary_size > LIBEMBD_COLUMNAR_MAX_WIRE_DICTIONARY_INTERNAL) || (size > deser->capacity - position))){
+        deser->overflow = TRUE;
+        return;
+    }
+
+    //one pass over the indices makes every later dictionary lookup safe
+    indices = &deser->buffer[position + LIBEMBD_COLUMNAR_HEADER_SIZE_INTERNAL + (uint32)offsets_size + sizeof(uint16) + dictionary_size * sizeof(uint32)];
+    for(i = 0u; i < count; i++){
+        max_index = LIBEMBD_MAX(max_index, indices[i]);
+    }
+    if(LIBEMBD_UNLIKELY((count != 0u) && (max_index >= dictionary_size))){
+        deser->overflow = TRUE;
+        return;
+    }
+
+    view->count = count;
+    view->timestamps.base = base;
+    view->timestamps.offsets = &deser->buffer[position + LIBEMBD_COLUMNAR_HEADER_SIZE_INTERNAL];
+    view->timestamps.width = width;
+    view->ids.dictionary = view->timestamps.offsets + offsets_size + sizeof(uint16);
+    view->ids.indices = indices;
+    view->ids.size = dictionary_size;
+    view->values.data = indices + count;
+    deser->position += (uint32)size;
+}
+
+LIBEMBD_HEADER_API_INLINE uint64 libembd_timestamp_column_at(LibEmbd_TimestampColumn_t const *column, uint32 i)
+{
+    uint8 const * const p = column->offsets + (uint64)i * column->width;
+    uint64 offset;
+
+    switch(column->width){
+    case 1u:
+        offset = *p;
+        break;
+    case 2u:
+        offset = ((uint64)p[0] << 8u) | p[1];
+        break;
+    case 4u:
+        offset = libembd_columnar_read32_internal(p);
+        break;
+    default:
+        LIBEMBD_MEMCPY(&offset, p, sizeof(offset));
+        offset = (uint64)LIBEMBD_NTOHLL(offset);
+        break;
+    }
+    return column->base + offset;
+}
+
+LIBEMBD_HEADER_API_INLINE uint32 libembd_dictionary_column_at(LibEmbd_DictionaryColumn_t const *column, uint32 i)
+{
+    return libembd_columnar_read32_internal(column->dictionary + column->indices[i] * sizeof(uint32));
+}
+
+LIBEMBD_HEADER_API_INLINE boolean libembd_dictionary_column_find(LibEmbd_DictionaryColumn_t const *column, uint32 id, uint8 *index)
+{
+    uint32 i;
+    for(i = 0u; i < column->size; i++){
+        if(libembd_columnar_read32_internal(column->dictionary + i * sizeof(uint32)) == id){
+            *index = (uint8)i;
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+LIBEMBD_HEADER_API_INLINE float32 libembd_float32_column_at(LibEmbd_Float32Column_t const *column, uint32 i)
+{
+    uint32 const bits = libembd_columnar_read32_internal(column->data + (uint64)i * sizeof(float32));
+    float32 value;
+
+    LIBEMBD_MEMCPY(&value, &bits, sizeof(value));
+    return value;
+}
+
+LIBEMBD_HEADER_API_INLINE void libembd_float32_column_copy(LibEmbd_Float32Column_t const *column, uint32 first, uint32 count, float32 *values)
+{
+    LIBEMBD_NTOH32_ARRAY((uint8 *)values, column->data + (uint64)first * sizeof(float32), count);
+}
+
+#endif /* LIBEMBD_COLUMNAR_IMPL_H_ */
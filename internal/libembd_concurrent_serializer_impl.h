@@ -0,0 +1,212 @@
+#ifndef LIBEMBD_CONCURRENT_SERIALIZER_IMPL_H_
+#define LIBEMBD_CONCURRENT_SERIALIZER_IMPL_H_
+
+#include <stdint.h> //uintptr_t
+#include "libembd/libembd_common.h"
+#include "libembd/libembd_util.h"
+#include "libembd/libembd_atomic.h"
+#include "libembd/libembd_marshalling.h"
+#include "libembd/libembd_concurrent_serializer.h"
+
+#define LIBEMBD_CONCURRENT_RECORD_COMMITTED_INTERNAL    0x80000000u
+#define LIBEMBD_CONCURRENT_RECORD_PADDING_INTERNAL      0x40000000u
+#define LIBEMBD_CONCURRENT_RECORD_LENGTH_MASK_INTERNAL  0x3FFFFFFFu
+
+struct LibEmbd_ConcurrentSerializer_t {
+    uint8 *buffer;
+    uint32 capacity;
+    uint32 sealed; //batch length returned by the last seal, written by the consumer only
+    LIBEMBD_ALIGNAS(LIBEMBD_CACHE_LINE_SIZE) libembd_atomic_uint32_t reserved; //bytes handed out, exceeds capacity once full or sealed
+    LIBEMBD_ALIGNAS(LIBEMBD_CACHE_LINE_SIZE) libembd_atomic_uint32_t committed; //bytes committed or padded, at most capacity
+};
+
+/*-------------------------------------------------------------Internal functions Begin---------------------------------------------------------------------------*/
+
+LIBEMBD_LOCAL_INLINE uint32 volatile *libembd_concurrent_record_header_internal(uint8 const *buffer, uint32 position)
+{
+    return (uint32 volatile *)LIBEMBD_ASSUME_ALIGNED(&buffer[position], LIBEMBD_CONCURRENT_RECORD_ALIGNMENT);
+}
+
+// Publishes a slot header, the release fence orders every write to the slot before it
+LIBEMBD_LOCAL_INLINE void libembd_concurrent_record_publish_internal(uint8 *buffer, uint32 position, uint32 flags, uint32 length)
+{
+    libembd_atomic_thread_fence(libembd_memory_order_release);
+    *libembd_concurrent_record_header_internal(buffer, position) = LIBEMBD_HTONL(LIBEMBD_CONCURRENT_RECORD_COMMITTED_INTERNAL | flags | length);
+}
+
+// Gives up a reservation that ran past the end: the unused tail becomes one padding record
+LIBEMBD_LOCAL_INLINE void libembd_concurrent_serializer_abandon_internal(LibEmbd_ConcurrentSerializer_t *cser, uint32 start)
+{
+    if(start < cser->capacity){
+        libembd_concurrent_record_publish_internal(cser->buffer, start, LIBEMBD_CONCURRENT_RECORD_PADDING_INTERNAL,
+                                                   cser->capacity - start - LIBEMBD_CONCURRENT_RECORD_HEADER_SIZE);
+        (void)libembd_atomic_fetch_add_uint32(&cser->committed, cser->capacity - start);
+    }
+}
+
+/*-------------------------------------------------------------Internal Functions End-----------------------------------------------------------------------------*/
+
+LIBEMBD_HEADER_API_INLINE void libembd_make_concurrent_serializer(LibEmbd_ConcurrentSerializer_t *cser, uint8 *buffer, uint32 capacity)
+{
+    LIBEMBD_ASSUME(cser != NULL);
+    LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(buffer);
+    LIBEMBD_ASSUME(((uintptr_t)buffer % LIBEMBD_CONCURRENT_RECORD_ALIGNMENT) == 0u);
+    LIBEMBD_ASSUME((capacity >= LIBEMBD_CONCURRENT_RECORD_HEADER_SIZE) && (capacity <= LIBEMBD_CONCURRENT_SERIALIZER_MAX_CAPACITY));
+
+    cser->buffer = buffer;
+    cser->capacity = capacity & ~(LIBEMBD_CONCURRENT_RECORD_ALIGNMENT - 1u);
+    cser->sealed = cser->capacity;
+    libembd_reset_concurrent_serializer(cser);
+}
+
+LIBEMBD_HEADER_API_INLINE void libembd_reset_concurrent_serializer(LibEmbd_ConcurrentSerializer_t *cser)
+{
+    LIBEMBD_ASSUME(cser != NULL);
+
+    //stale payload bytes could otherwise be mistaken for headers, clear up to and including the seal padding header
+    LIBEMBD_MEMSET(cser->buffer, 0, LIBEMBD_MIN(cser->sealed + LIBEMBD_CONCURRENT_RECORD_HEADER_SIZE, cser->capacity));
+    cser->sealed = cser->capacity;
+    libembd_atomic_store_explicit_uint32(&cser->committed, 0u, libembd_memory_order_relaxed);
+    libembd_atomic_store_explicit_uint32(&cser->reserved, 0u, libembd_memory_order_relaxed);
+    libembd_atomic_thread_fence(libembd_memory_order_seq_cst);
+}
+
+LIBEMBD_HEADER_API_INLINE boolean libembd_concurrent_serializer_begin_record(LibEmbd_ConcurrentSerializer_t *cser, uint32 size, LibEmbd_Serializer_t *ser)
+{
+    uint32 slot;
+    uint32 start;
+
+    LIBEMBD_ASSUME(cser != NULL);
+    LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(ser);
+
+    //cheap check first so that a full batch does not keep pushing the shared position further past the end, and a slot
+    //that could never fit does not end the batch for everyone (the first comparison keeps the slot size from wrapping)
+    if(LIBEMBD_UNLIKELY((size > cser->capacity) || (LIBEMBD_CONCURRENT_RECORD_SIZE(size) > cser->capacity) ||
+                        (libembd_atomic_load_explicit_uint32(&cser->reserved, libembd_memory_order_relaxed) >= cser->capacity))){
+        return FALSE;
+    }
+
+    slot = LIBEMBD_CONCURRENT_RECORD_SIZE(size);
+    start = libembd_atomic_fetch_add_uint32(&cser->reserved, slot);
+    if(LIBEMBD_UNLIKELY((start >= cser->capacity) || (slot > cser->capacity - start))){
+        libembd_concurrent_serializer_abandon_internal(cser, start);
+        return FALSE;
+    }
+
+    libembd_make_serializer(ser, &cser->buffer[start + LIBEMBD_CONCURRENT_RECORD_HEADER_SIZE], size);
+    return TRUE;
+}
+
+LIBEMBD_HEADER_API_INLINE void libembd_concurrent_serializer_commit_record(LibEmbd_ConcurrentSerializer_t *cser, LibEmbd_Serializer_t const *ser)
+{
+    uint32 start;
+    uint32 slot;
+    uint32 used;
+
+    LIBEMBD_ASSUME(cser != NULL);
+    LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(ser);
+
+    start = (uint32)(ser->buffer - cser->buffer) - LIBEMBD_CONCURRENT_RECORD_HEADER_SIZE;
+    slot = LIBEMBD_CONCURRENT_RECORD_SIZE(ser->capacity);
+
+    if(LIBEMBD_UNLIKELY(ser->overflow)){
+        libembd_concurrent_record_publish_internal(cser->buffer, start, LIBEMBD_CONCURRENT_RECORD_PADDING_INTERNAL,
+                                                   slot - LIBEMBD_CONCURRENT_RECORD_HEADER_SIZE);
+    } else {
+        used = LIBEMBD_CONCURRENT_RECORD_SIZE(ser->position);
+        if(used < slot){
+            //a multiple of the alignment is left, always enough for a padding header
+            libembd_concurrent_record_publish_internal(cser->buffer, start + used, LIBEMBD_CONCURRENT_RECORD_PADDING_INTERNAL,
+                                                       slot - used - LIBEMBD_CONCURRENT_RECORD_HEADER_SIZE);
+        }
+        libembd_concurrent_record_publish_internal(cser->buffer, start, 0u, ser->position);
+    }
+    (void)libembd_atomic_fetch_add_uint32(&cser->committed, slot);
+}
+
+LIBEMBD_HEADER_API_INLINE uint32 libembd_seal_concurrent_serializer(LibEmbd_ConcurrentSerializer_t *cser)
+{
+    uint32 start;
+
+    LIBEMBD_ASSUME(cser != NULL);
+
+    //a reservation of the whole capacity can never fit, the tail it would have started at becomes padding
+    start = libembd_atomic_fetch_add_uint32(&cser->reserved, cser->capacity);
+    libembd_concurrent_serializer_abandon_internal(cser, start);
+    cser->sealed = LIBEMBD_MIN(start, cser->capacity);
+    return cser->sealed;
+}
+
+LIBEMBD_HEADER_API_INLINE boolean libembd_concurrent_serializer_is_complete(LibEmbd_ConcurrentSerializer_t const *cser)
+{
+    uint32 committed;
+    uint32 reserved;
+
+    LIBEMBD_ASSUME(cser != NULL);
+
+    //committed first: it never exceeds what was reserved, so equality with the later reserved value is conclusive
+    committed = libembd_atomic_load_explicit_uint32(&cser->committed, libembd_memory_order_relaxed);
+    libembd_atomic_thread_fence(libembd_memory_order_acquire);
+    reserved = libembd_atomic_load_explicit_uint32(&cser->reserved, libembd_memory_order_relaxed);
+    return (committed == LIBEMBD_MIN(reserved, cser->capacity)) ? TRUE : FALSE;
+}
+
+LIBEMBD_HEADER_API_INLINE boolean libembd_concurrent_serializer_get_record(LibEmbd_ConcurrentSerializer_t const *cser, uint32 *position, LibEmbd_Deserializer_t *record)
+{
+    uint32 header;
+    uint32 length;
+
+    LIBEMBD_ASSUME(cser != NULL);
+    LIBEMBD_ASSUME(position != NULL);
+    LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(record);
+
+    while(*position < cser->capacity){ //headers of slots not reserved yet read as zero
+        header = LIBEMBD_NTOHL(*libembd_concurrent_record_header_internal(cser->buffer, *position));
+        if((header & LIBEMBD_CONCURRENT_RECORD_COMMITTED_INTERNAL) == 0u){
+            return FALSE;
+        }
+        libembd_atomic_thread_fence(libembd_memory_order_acquire); //pairs with the release fence of the publisher
+
+        length = header & LIBEMBD_CONCURRENT_RECORD_LENGTH_MASK_INTERNAL;
+        if((header & LIBEMBD_CONCURRENT_RECORD_PADDING_INTERNAL) == 0u){
+            libembd_make_deserializer(record, &cser->buffer[*position + LIBEMBD_CONCURRENT_RECORD_HEADER_SIZE], length);
+            *position += LIBEMBD_CONCURRENT_RECORD_SIZE(length);
+            return TRUE;
+        }
+        *position += LIBEMBD_CONCURRENT_RECORD_SIZE(length);
+    }
+    return FALSE;
+}
+
+LIBEMBD_HEADER_API_INLINE boolean libembd_get_concurrent_record_checked(LibEmbd_Deserializer_t *deser, LibEmbd_Deserializer_t *record)
+{
+    uint32 header;
+    uint32 length;
+    uint32 padded;
+
+    LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(deser);
+    LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(record);
+
+    while(!deser->overflow && (deser->position != deser->capacity)){
+        if(!libembd_deserializer_reserve(deser, LIBEMBD_CONCURRENT_RECORD_HEADER_SIZE)){
+            return FALSE;
+        }
+        libembd_read_uint32_from_network_unsafe(deser, deser->position, &header);
+        length = header & LIBEMBD_CONCURRENT_RECORD_LENGTH_MASK_INTERNAL;
+        padded = LIBEMBD_CONCURRENT_RECORD_SIZE(length) - LIBEMBD_CONCURRENT_RECORD_HEADER_SIZE;
+        if(LIBEMBD_UNLIKELY(((header & LIBEMBD_CONCURRENT_RECORD_COMMITTED_INTERNAL) == 0u) ||
+                            (padded > deser->capacity - deser->position - LIBEMBD_CONCURRENT_RECORD_HEADER_SIZE))){
+            deser->overflow = TRUE;
+            return FALSE;
+        }
+
+        deser->position += LIBEMBD_CONCURRENT_RECORD_HEADER_SIZE + padded;
+        if((header & LIBEMBD_CONCURRENT_RECORD_PADDING_INTERNAL) == 0u){
+            libembd_make_deserializer(record, &deser->buffer[deser->position - padded], length);
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+#endif /* LIBEMBD_CONCURRENT_SERIALIZER_IMPL_H_ */
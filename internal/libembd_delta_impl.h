@@ -0,0 +1,247 @@
+#ifndef LIBEMBD_DELTA_IMPL_H_
+#define LIBEMBD_DELTA_IMPL_H_
+
+#include "libembd/libembd_common.h"
+#include "libembd/libembd_util.h"
+#include "libembd/libembd_marshalling.h"
+#include "libembd/libembd_delta.h"
+
+#if LIBEMBD_HAS_AVX2
+    #include <immintrin.h>
+#elif LIBEMBD_HAS_SSE2
+    #include <emmintrin.h>
+#endif
+
+#if LIBEMBD_HAS_NEON
+    #include <arm_neon.h>
+#endif
+
+#define LIBEMBD_DELTA_GROUP_SIZE_INTERNAL   (8u * LIBEMBD_DELTA_WORD_SIZE) //bytes covered by one bitmap byte
+
+/*-------------------------------------------------------------Internal functions Begin---------------------------------------------------------------------------*/
+
+// Returns a mask with bit i set if word i of the two blocks differs, scalar version
+LIBEMBD_LOCAL_INLINE uint32 libembd_delta_compare_words_internal(uint8 const *previous, uint8 const *current, uint32 word_count)
+{
+    uint32 mask = 0u;
+    uint32 i;
+
+    for(i = 0u; i < word_count; i++){
+        uint32 prev_word;
+        uint32 cur_word;
+        LIBEMBD_MEMCPY(&prev_word, previous + i * LIBEMBD_DELTA_WORD_SIZE, sizeof(prev_word));
+        LIBEMBD_MEMCPY(&cur_word, current + i * LIBEMBD_DELTA_WORD_SIZE, sizeof(cur_word));
+        mask |= (uint32)(prev_word != cur_word) << i;
+    }
+    return mask;
+}
+
+#if LIBEMBD_HAS_NEON && !(LIBEMBD_HAS_AVX2 || LIBEMBD_HAS_SSE2)
+// Returns a mask with bit i set if word i of the two 16-byte blocks is equal
+LIBEMBD_LOCAL_INLINE uint32 libembd_delta_equal_words_neon_internal(uint8 const *previous, uint8 const *current)
+{
+    uint32x4_t const eq = vceqq_u32(vreinterpretq_u32_u8(vld1q_u8(previous)), vreinterpretq_u32_u8(vld1q_u8(current)));
+    uint64 const lanes = vget_lane_u64(vreinterpret_u64_u16(vmovn_u32(eq)), 0); //16 bits per word
+    return (uint32)((lanes & 1u) | ((lanes >> 15u) & 2u) | ((lanes >> 30u) & 4u) | ((lanes >> 45u) & 8u));
+}
+#endif
+
+// Returns a mask with bit i set if word i of the two 32-byte groups differs
+LIBEMBD_LOCAL_INLINE uint32 libembd_delta_compare_group_internal(uint8 const *previous, uint8 const *current)
+{
+    uint32 equal;
+
+#if LIBEMBD_HAS_AVX2
+    __m256i const eq = _mm256_cmpeq_epi32(_mm256_loadu_si256((__m256i const *)previous), _mm256_loadu_si256((__m256i const *)current));
+    equal = (uint32)_mm256_movemask_ps(_mm256_castsi256_ps(eq));
+#elif LIBEMBD_HAS_SSE2
+    __m128i const eq_lo = _mm_cmpeq_epi32(_mm_loadu_si128((__m128i const *)previous), _mm_loadu_si128((__m128i const *)current));
+    __m128i const eq_hi = _mm_cmpeq_epi32(_mm_loadu_si128((__m128i const *)(previous + 16u)), _mm_loadu_si128((__m128i const *)(current + 16u)));
+    equal = (uint32)_mm_movemask_ps(_mm_castsi128_ps(eq_lo)) | ((uint32)_mm_movemask_ps(_mm_castsi128_ps(eq_hi)) << 4u);
+#elif LIBEMBD_HAS_NEON
+    equal = libembd_delta_equal_words_neon_internal(previous, current) | (libembd_delta_equal_words_neon_internal(previous + 16u, current + 16u) << 4u);
+#else
+    equal = ~libembd_delta_compare_words_internal(previous, current, 8u);
+#endif
+    return ~equal & 0xFFu;
+}
+
+// Writes the change bitmap of two frames, returns number of changed words
+LIBEMBD_LOCAL_INLINE uint32 libembd_delta_build_bitmap_internal(uint8 *bitmap, uint8 const *previous, uint8 const *current, uint32 length)
+{
+    uint32 const full_groups = length / LIBEMBD_DELTA_GROUP_SIZE_INTERNAL;
+    uint32 const tail_offset = full_groups * LIBEMBD_DELTA_GROUP_SIZE_INTERNAL;
+    uint32 changed = 0u;
+    uint32 group;
+
+    for(group = 0u; group < full_groups; group++){
+        uint32 const offset = group * LIBEMBD_DELTA_GROUP_SIZE_INTERNAL;
+        uint32 const mask = libembd_delta_compare_group_internal(previous + offset, current + offset);
+        bitmap[group] = (uint8)mask;
+        changed += LIBEMBD_POPCOUNT64(mask);
+    }
+
+    if(tail_offset < length){
+        uint32 const tail_length = length - tail_offset;
+        uint32 const full_words = tail_length / LIBEMBD_DELTA_WORD_SIZE;
+        uint32 mask = libembd_delta_compare_words_internal(previous + tail_offset, current + tail_offset, full_words);
+        uint32 const partial = tail_length % LIBEMBD_DELTA_WORD_SIZE;
+
+        if(partial != 0u){
+            uint32 const offset = tail_offset + full_words * LIBEMBD_DELTA_WORD_SIZE;
+            mask |= (uint32)(LIBEMBD_MEMCMP(previous + offset, current + offset, partial) != 0) << full_words;
+        }
+        bitmap[full_groups] = (uint8)mask;
+        changed += LIBEMBD_POPCOUNT64(mask);
+    }
+    return changed;
+}
+
+// Number of payload bytes described by a bitmap
+LIBEMBD_LOCAL_INLINE uint32 libembd_delta_payload_size_internal(uint8 const *bitmap, uint32 length)
+{
+    uint32 const word_count = LIBEMBD_DELTA_WORD_COUNT(length);
+    uint32 const bitmap_size = LIBEMBD_DELTA_BITMAP_SIZE(length);
+    uint32 const last_word = word_count - 1u;
+    uint32 changed = 0u;
+    uint32 size;
+    uint32 i;
+
+    for(i = 0u; i < bitmap_size; i++){
+        changed += LIBEMBD_POPCOUNT64(bitmap[i]);
+    }
+    size = changed * LIBEMBD_DELTA_WORD_SIZE;
+    if((word_count != 0u) && ((bitmap[last_word / 8u] & (1u << (last_word % 8u))) != 0u)){
+        size -= word_count * LIBEMBD_DELTA_WORD_SIZE - length; //last word may be partial
+    }
+    return size;
+}
+
+// TRUE if the bitmap has no bits set beyond the last word
+LIBEMBD_LOCAL_INLINE boolean libembd_delta_bitmap_is_valid_internal(uint8 const *bitmap, uint32 length)
+{
+    uint32 const word_count = LIBEMBD_DELTA_WORD_COUNT(length);
+    uint32 const used_bits = word_count % 8u;
+
+    return (used_bits == 0u) || ((bitmap[word_count / 8u] >> used_bits) == 0u);
+}
+
+// Copies the changed words of current to out, returns number of bytes written
+LIBEMBD_LOCAL_INLINE uint32 libembd_delta_write_words_internal(uint8 *out, uint8 const *bitmap, uint8 const *current, uint32 length)
+{
+    uint32 const bitmap_size = LIBEMBD_DELTA_BITMAP_SIZE(length);
+    uint32 written = 0u;
+    uint32 group;
+
+    for(group = 0u; group < bitmap_size; group++){
+        uint32 mask = bitmap[group];
+        while(mask != 0u){
+            uint32 const offset = (group * 8u + LIBEMBD_CTZ64(mask)) * LIBEMBD_DELTA_WORD_SIZE;
+            uint32 const size = LIBEMBD_MIN(LIBEMBD_DELTA_WORD_SIZE, length - offset);
+            LIBEMBD_MEMCPY(out + written, current + offset, size);
+            written += size;
+            mask &= mask - 1u;
+        }
+    }
+    return written;
+}
+
+// Patches the words marked in bitmap from in into frame, returns number of bytes consumed
+LIBEMBD_LOCAL_INLINE uint32 libembd_delta_apply_words_internal(uint8 *frame, uint8 const *bitmap, uint8 const *in, uint32 length)
+{
+    uint32 const word_count = LIBEMBD_DELTA_WORD_COUNT(length);
+    uint32 const bitmap_size = LIBEMBD_DELTA_BITMAP_SIZE(length);
+    uint32 consumed = 0u;
+    uint32 group;
+
+    for(group = 0u; group < bitmap_size; group++){
+        uint32 mask = bitmap[group];
+        if((group + 1u == bitmap_size) && ((word_count % 8u) != 0u)){
+            mask &= (1u << (word_count % 8u)) - 1u; //never write beyond the frame
+        }
+        while(mask != 0u){
+            uint32 const offset = (group * 8u + LIBEMBD_CTZ64(mask)) * LIBEMBD_DELTA_WORD_SIZE;
+            uint32 const size = LIBEMBD_MIN(LIBEMBD_DELTA_WORD_SIZE, length - offset);
+            LIBEMBD_MEMCPY(frame + offset, in + consumed, size);
+            consumed += size;
+            mask &= mask - 1u;
+        }
+    }
+    return consumed;
+}
+
+/*-------------------------------------------------------------Internal Functions End-----------------------------------------------------------------------------*/
+
+LIBEMBD_HEADER_API_INLINE uint32 libembd_put_delta_unsafe(LibEmbd_Serializer_t *ser, LibEmbd_ConstBufferView_t previous, LibEmbd_ConstBufferView_t current)
+{
+    uint32 const length = current.length;
+    uint32 const bitmap_size = LIBEMBD_DELTA_BITMAP_SIZE(length);
+    uint8 *bitmap;
+    uint32 changed;
+
+    LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(ser);
+    LIBEMBD_ASSUME(previous.length == current.length);
+    LIBEMBD_MARSHALLING_ASSERT_NO_OVERFLOW(ser, LIBEMBD_DELTA_MAX_SIZE(length));
+
+    bitmap = &ser->buffer[ser->position];
+    changed = libembd_delta_build_bitmap_internal(bitmap, previous.data, current.data, length);
+    ser->position += bitmap_size + libembd_delta_write_words_internal(bitmap + bitmap_size, bitmap, current.data, length);
+    return changed;
+}
+
+LIBEMBD_HEADER_API_INLINE uint32 libembd_put_delta_checked(LibEmbd_Serializer_t *ser, LibEmbd_ConstBufferView_t previous, LibEmbd_ConstBufferView_t current)
+{
+    uint32 const length = current.length;
+    uint32 const bitmap_size = LIBEMBD_DELTA_BITMAP_SIZE(length);
+    uint8 *bitmap;
+    uint32 changed;
+
+    LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(ser);
+    LIBEMBD_ASSUME(previous.length == current.length);
+
+    //the bitmap is built in place first, its content determines the total size
+    if(LIBEMBD_UNLIKELY(ser->overflow || (ser->capacity - ser->position < bitmap_size))){
+        ser->overflow = TRUE;
+        return 0u;
+    }
+    bitmap = &ser->buffer[ser->position];
+    changed = libembd_delta_build_bitmap_internal(bitmap, previous.data, current.data, length);
+    if(!libembd_serializer_reserve(ser, bitmap_size + libembd_delta_payload_size_internal(bitmap, length))){
+        return 0u;
+    }
+    ser->position += bitmap_size + libembd_delta_write_words_internal(bitmap + bitmap_size, bitmap, current.data, length);
+    return changed;
+}
+
+LIBEMBD_HEADER_API_INLINE void libembd_get_delta_unsafe(LibEmbd_Deserializer_t *deser, LibEmbd_MutableBufferView_t frame)
+{
+    uint32 const bitmap_size = LIBEMBD_DELTA_BITMAP_SIZE((uint32)frame.length);
+    uint8 const *bitmap;
+
+    LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(deser);
+
+    bitmap = &deser->buffer[deser->position];
+    deser->position += bitmap_size + libembd_delta_apply_words_internal(frame.data, bitmap, bitmap + bitmap_size, frame.length);
+}
+
+LIBEMBD_HEADER_API_INLINE void libembd_get_delta_checked(LibEmbd_Deserializer_t *deser, LibEmbd_MutableBufferView_t frame)
+{
+    uint32 const bitmap_size = LIBEMBD_DELTA_BITMAP_SIZE((uint32)frame.length);
+    uint8 const *bitmap;
+
+    LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(deser);
+
+    if(!libembd_deserializer_reserve(deser, bitmap_size)){
+        return;
+    }
+    bitmap = &deser->buffer[deser->position];
+    if(LIBEMBD_UNLIKELY(!libembd_delta_bitmap_is_valid_internal(bitmap, frame.length))){
+        deser->overflow = TRUE;
+        return;
+    }
+    if(libembd_deserializer_reserve(deser, bitmap_size + libembd_delta_payload_size_internal(bitmap, frame.length))){
+        libembd_get_delta_unsafe(deser, frame);
+    }
+}
+
+#endif /* LIBEMBD_DELTA_IMPL_H_ */
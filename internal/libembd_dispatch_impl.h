@@ -0,0 +1,179 @@
+#ifndef LIBEMBD_DISPATCH_IMPL_H_
+#define LIBEMBD_DISPATCH_IMPL_H_
+
+#include "libembd/libembd_common.h"
+#include "libembd/libembd_util.h"
+#include "libembd/libembd_marshalling.h"
+#include "libembd/libembd_dispatch.h"
+
+LIBEMBD_STATIC_ASSERT(LIBEMBD_IS_POWER_OF_TWO(LIBEMBD_DISPATCH_TABLE_SIZE) && (LIBEMBD_DISPATCH_TABLE_SIZE <= 0x8000u), "LIBEMBD_DISPATCH_TABLE_SIZE must be a power of two no larger than 32768");
+
+#define LIBEMBD_DISPATCH_EMPTY_KEY_INTERNAL         0x8000000000000000uLL //never produced by a lookup, lengths are below 2^32
+#define LIBEMBD_DISPATCH_EXACT_MASK_INTERNAL        0xFFFFFFFFFFFFFFFFuLL //id and length must match
+#define LIBEMBD_DISPATCH_ID_MASK_INTERNAL           0x000000000000FFFFuLL //only the id must match
+#define LIBEMBD_DISPATCH_MAX_DISPLACEMENT_INTERNAL  0x7FFFu
+#define LIBEMBD_DISPATCH_UNPLACED_INTERNAL          0x8000u //marks the bucket sizes during construction
+
+typedef struct {
+    uint64 key; //payload length << 16 | id
+    uint64 mask;
+    libembd_message_handler_t handler;
+} LibEmbd_DispatchSlot_t;
+
+struct LibEmbd_Dispatcher_t {
+    void *context;
+    uint16 displacements[LIBEMBD_DISPATCH_TABLE_SIZE]; //per bucket
+    LibEmbd_DispatchSlot_t slots[LIBEMBD_DISPATCH_TABLE_SIZE];
+};
+
+/*-------------------------------------------------------------Internal functions Begin---------------------------------------------------------------------------*/
+
+// 32-bit finalizer of MurmurHash3, every input bit affects every output bit
+LIBEMBD_LOCAL_INLINE uint32 LIBEMBD_ATTR_ALWAYS_INLINE libembd_dispatch_hash_internal(uint32 value)
+{
+    value ^= value >> 16;
+    value *= 0x85EBCA6Bu;
+    value ^= value >> 13;
+    value *= 0xC2B2AE35u;
+    value ^= value >> 16;
+    return value;
+}
+
+LIBEMBD_LOCAL_INLINE uint32 LIBEMBD_ATTR_ALWAYS_INLINE libembd_dispatch_bucket_internal(uint16 id)
+{
+    return libembd_dispatch_hash_internal(id) & (LIBEMBD_DISPATCH_TABLE_SIZE - 1u);
+}
+
+LIBEMBD_LOCAL_INLINE uint32 LIBEMBD_ATTR_ALWAYS_INLINE libembd_dispatch_slot_internal(uint16 id, uint32 displacement)
+{
+    return libembd_dispatch_hash_internal((displacement << 16) | id) & (LIBEMBD_DISPATCH_TABLE_SIZE - 1u);
+}
+
+// Clears the slots of the first count entries of bucket placed with displacement
+LIBEMBD_LOCAL_INLINE void libembd_dispatch_unplace_internal(LibEmbd_Dispatcher_t *dispatcher, LibEmbd_DispatchEntry_t const *entries,
+                                                            uint32 count, uint32 bucket, uint32 displacement)
+{
+    uint32 i;
+    for(i = 0u; i < count; i++){
+        if(libembd_dispatch_bucket_internal(entries[i].id) == bucket){
+            dispatcher->slots[libembd_dispatch_slot_internal(entries[i].id, displacement)].key = LIBEMBD_DISPATCH_EMPTY_KEY_INTERNAL;
+        }
+    }
+}
+
+// Tries to place every entry of bucket into a free slot using displacement, nothing is placed on failure
+LIBEMBD_LOCAL_INLINE boolean libembd_dispatch_place_internal(LibEmbd_Dispatcher_t *dispatcher, LibEmbd_DispatchEntry_t const *entries,
+                                                             uint32 count, uint32 bucket, uint32 displacement, boolean *duplicate)
+{
+    LibEmbd_DispatchSlot_t *slot;
+    uint32 i;
+
+    for(i = 0u; i < count; i++){
+        if(libembd_dispatch_bucket_internal(entries[i].id) != bucket){
+            continue;
+        }
+        slot = &dispatcher->slots[libembd_dispatch_slot_internal(entries[i].id, displacement)];
+        if(slot->key != LIBEMBD_DISPATCH_EMPTY_KEY_INTERNAL){
+            //equal ids share bucket and slot for every displacement
+            *duplicate = ((slot->key & LIBEMBD_DISPATCH_ID_MASK_INTERNAL) == entries[i].id) ? TRUE : FALSE;
+            libembd_dispatch_unplace_internal(dispatcher, entries, i, bucket, displacement);
+            return FALSE;
+        }
+        slot->key = ((uint64)entries[i].size << 16) | entries[i].id;
+        slot->mask = (entries[i].size == LIBEMBD_DISPATCH_ANY_SIZE) ? LIBEMBD_DISPATCH_ID_MASK_INTERNAL : LIBEMBD_DISPATCH_EXACT_MASK_INTERNAL;
+        slot->handler = entries[i].handler;
+    }
+    return TRUE;
+}
+
+/*-------------------------------------------------------------Internal Functions End-----------------------------------------------------------------------------*/
+
+LIBEMBD_HEADER_API_INLINE LibEmbd_Std_ReturnType libembd_make_dispatcher(LibEmbd_Dispatcher_t *dispatcher, LibEmbd_DispatchEntry_t const *entries,
+                                                                         uint32 count, void *context)
+{
+    boolean duplicate = FALSE;
+    uint32 largest = 0u;
+    uint32 size;
+    uint32 bucket;
+    uint32 displacement;
+    uint32 i;
+
+    LIBEMBD_ASSUME(dispatcher != NULL);
+    LIBEMBD_ASSUME((entries != NULL) || (count == 0u));
+
+    dispatcher->context = context;
+    for(i = 0u; i < LIBEMBD_DISPATCH_TABLE_SIZE; i++){
+        dispatcher->displacements[i] = 0u;
+        dispatcher->slots[i].key = LIBEMBD_DISPATCH_EMPTY_KEY_INTERNAL;
+        dispatcher->slots[i].mask = LIBEMBD_DISPATCH_EXACT_MASK_INTERNAL;
+        dispatcher->slots[i].handler = NULL;
+    }
+    if(count > LIBEMBD_DISPATCH_TABLE_SIZE){
+        return E_NOT_OK;
+    }
+
+    //bucket sizes, tagged so that they cannot be confused with displacements placed in the meantime
+    for(i = 0u; i < count; i++){
+        LIBEMBD_ASSUME(entries[i].handler != NULL);
+        bucket = libembd_dispatch_bucket_internal(entries[i].id);
+        dispatcher->displacements[bucket] = (uint16)((dispatcher->displacements[bucket] + 1u) | LIBEMBD_DISPATCH_UNPLACED_INTERNAL);
+        largest = LIBEMBD_MAX(largest, dispatcher->displacements[bucket] & ~LIBEMBD_DISPATCH_UNPLACED_INTERNAL);
+    }
+
+    //largest buckets first, while most slots are still free
+    for(size = largest; size > 0u; size--){
+        for(bucket = 0u; bucket < LIBEMBD_DISPATCH_TABLE_SIZE; bucket++){
+            if(dispatcher->displacements[bucket] != (LIBEMBD_DISPATCH_UNPLACED_INTERNAL | size)){
+                continue;
+            }
+            for(displacement = 1u; displacement <= LIBEMBD_DISPATCH_MAX_DISPLACEMENT_INTERNAL; displacement++){
+                if(libembd_dispatch_place_internal(dispatcher, entries, count, bucket, displacement, &duplicate)){
+                    break;
+                }
+                if(duplicate){
+                    return E_NOT_OK;
+                }
+            }
+            if(displacement > LIBEMBD_DISPATCH_MAX_DISPLACEMENT_INTERNAL){
+                return E_NOT_OK;
+            }
+            dispatcher->displacements[bucket] = (uint16)displacement;
+        }
+    }
+    return E_OK;
+}
+
+LIBEMBD_HEADER_API_INLINE LibEmbd_Std_ReturnType libembd_dispatch_message(LibEmbd_Dispatcher_t const *dispatcher, uint16 id, LibEmbd_Deserializer_t *payload)
+{
+    LibEmbd_DispatchSlot_t const *slot;
+    uint64 key;
+
+    LIBEMBD_ASSUME(dispatcher != NULL);
+    LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(payload);
+
+    key = ((uint64)(payload->capacity - payload->position) << 16) | id;
+    slot = &dispatcher->slots[libembd_dispatch_slot_internal(id, dispatcher->displacements[libembd_dispatch_bucket_internal(id)])];
+    if(LIBEMBD_UNLIKELY(((key ^ slot->key) & slot->mask) != 0u)){
+        return E_NOT_OK;
+    }
+    slot->handler(dispatcher->context, payload);
+    return E_OK;
+}
+
+LIBEMBD_HEADER_API_INLINE LibEmbd_Std_ReturnType libembd_dispatch_frame(LibEmbd_Dispatcher_t const *dispatcher, LibEmbd_Deserializer_t *deser)
+{
+    LibEmbd_Deserializer_t payload;
+    uint16 id;
+
+    LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(deser);
+
+    if(!libembd_deserializer_reserve(deser, sizeof(uint16))){
+        return E_NOT_OK;
+    }
+    libembd_get_uint16_from_network_unsafe(deser, &id);
+    libembd_make_deserializer(&payload, &deser->buffer[deser->position], deser->capacity - deser->position);
+    deser->position = deser->capacity;
+    return libembd_dispatch_message(dispatcher, id, &payload);
+}
+
+#endif /* LIBEMBD_DISPATCH_IMPL_H_ */
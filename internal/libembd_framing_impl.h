@@ -0,0 +1,429 @@
+#ifndef LIBEMBD_FRAMING_IMPL_H_
+#define LIBEMBD_FRAMING_IMPL_H_
+
+#include "libembd/libembd_common.h"
+#include "libembd/libembd_util.h"
+#include "libembd/libembd_framing.h"
+
+#if LIBEMBD_HAS_AVX2
+    #include <immintrin.h>
+#elif LIBEMBD_HAS_SSE2
+    #include <emmintrin.h>
+#endif
+
+#if LIBEMBD_HAS_NEON
+    #include <arm_neon.h>
+#endif
+
+#define LIBEMBD_COBS_MAX_RUN_INTERNAL   254u
+
+struct LibEmbd_FrameDecoder_t {
+    uint8 *buffer;
+    uint16 capacity;
+    uint16 length;
+    LibEmbd_Framing_Type_t type;
+    uint8 cobs_code;        //code byte of the current COBS block, 0 before the first block of a frame
+    uint8 cobs_remaining;   //data bytes left in the current COBS block
+    boolean slip_escaped;   //last SLIP byte was ESC
+    boolean discarding;     //dropping input up to the next delimiter after an error
+    boolean frame_ready;
+};
+
+/*-------------------------------------------------------------Internal functions Begin---------------------------------------------------------------------------*/
+
+/**
+ * @brief Returns the index of the first byte equal to a or b, length if there is none
+ *
+ * The vector loops compare 32/16 bytes at a time and turn the result into a bit mask (movemask on x86, narrowing shift
+ * on NEON) whose lowest set bit is the match. The scalar tail is the complete implementation on targets without SIMD.
+ */
+LIBEMBD_LOCAL_INLINE uint32 libembd_framing_find_internal(uint8 const *data, uint32 length, uint8 a, uint8 b)
+{
+    uint32 i = 0u;
+
+#if LIBEMBD_HAS_AVX2
+    {
+        __m256i const va = _mm256_set1_epi8((char)a);
+        __m256i const vb = _mm256_set1_epi8((char)b);
+        for(; i + 32u <= length; i += 32u){
+            __m256i const v = _mm256_loadu_si256((__m256i const *)(data + i));
+            uint32 const mask = (uint32)_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(v, va), _mm256_cmpeq_epi8(v, vb)));
+            if(mask != 0u){
+                return i + LIBEMBD_CTZ64(mask);
+            }
+        }
+    }
+#endif
+#if LIBEMBD_HAS_AVX2 || LIBEMBD_HAS_SSE2
+    {
+        __m128i const va = _mm_set1_epi8((char)a);
+        __m128i const vb = _mm_set1_epi8((char)b);
+        for(; i + 16u <= length; i += 16u){
+            __m128i const v = _mm_loadu_si128((__m128i const *)(data + i));
+            uint32 const mask = (uint32)_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, va), _mm_cmpeq_epi8(v, vb)));
+            if(mask != 0u){
+                return i + LIBEMBD_CTZ64(mask);
+            }
+        }
+    }
+#elif LIBEMBD_HAS_NEON
+    {
+        uint8x16_t const va = vdupq_n_u8(a);
+        uint8x16_t const vb = vdupq_n_u8(b);
+        for(; i + 16u <= length; i += 16u){
+            uint8x16_t const v = vld1q_u8(data + i);
+            uint8x16_t const eq = vorrq_u8(vceqq_u8(v, va), vceqq_u8(v, vb));
+            //4 mask bits per byte
+            uint64 const mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(eq), 4)), 0);
+            if(mask != 0u){
+                return i + (LIBEMBD_CTZ64(mask) >> 2u);
+            }
+        }
+    }
+#endif
+
+    for(; i < length; i++){
+        if((data[i] == a) || (data[i] == b)){
+            break;
+        }
+    }
+    return i;
+}
+
+// Drops the current frame, input up to the next delimiter is dropped as well unless the error was detected at one
+LIBEMBD_LOCAL_INLINE void libembd_frame_decoder_fail_internal(LibEmbd_FrameDecoder_t *dec, boolean at_delimiter)
+{
+    libembd_frame_decoder_reset(dec);
+    dec->discarding = !at_delimiter;
+}
+
+// Decodes up to one COBS block from input, returns number of bytes consumed
+LIBEMBD_LOCAL_INLINE uint32 libembd_cobs_decoder_step_internal(LibEmbd_FrameDecoder_t *dec, uint8 const *input, uint32 available, LibEmbd_FrameDecoder_Status_t *status)
+{
+    uint32 consumed;
+
+    if(dec->cobs_remaining > 0u){
+        uint32 const take = LIBEMBD_MIN((uint32)dec->cobs_remaining, available);
+        uint32 const run = libembd_framing_find_internal(input, take, 0u, 0u);
+
+        if(LIBEMBD_UNLIKELY(run > (uint32)dec->capacity - dec->length)){
+            libembd_frame_decoder_fail_internal(dec, FALSE);
+            *status = LIBEMBD_FRAME_DECODER_ERROR;
+            return 0u;
+        }
+        LIBEMBD_MEMCPY(&dec->buffer[dec->length], input, run);
+        dec->length = (uint16)(dec->length + run);
+        dec->cobs_remaining = (uint8)(dec->cobs_remaining - run);
+        consumed = run;
+
+        if(LIBEMBD_UNLIKELY(run < take)){ //delimiter inside a block: truncated frame
+            libembd_frame_decoder_fail_internal(dec, TRUE);
+            *status = LIBEMBD_FRAME_DECODER_ERROR;
+            consumed++;
+        }
+    } else {
+        uint8 const code = input[0];
+        consumed = 1u;
+
+        if(code == 0u){
+            if(dec->cobs_code != 0u){ //otherwise empty frame, skipped
+                dec->frame_ready = TRUE;
+                *status = LIBEMBD_FRAME_DECODER_FRAME_READY;
+            }
+        } else {
+            //the zero implied by the previous block is only emitted once another block follows
+            if((dec->cobs_code != 0u) && (dec->cobs_code != 0xFFu)){
+                if(LIBEMBD_UNLIKELY(dec->length == dec->capacity)){
+                    libembd_frame_decoder_fail_internal(dec, FALSE);
+                    *status = LIBEMBD_FRAME_DECODER_ERROR;
+                    return consumed;
+                }
+                dec->buffer[dec->length++] = 0u;
+            }
+            dec->cobs_code = code;
+            dec->cobs_remaining = (uint8)(code - 1u);
+        }
+    }
+    return consumed;
+}
+
+// Decodes up to the next SLIP special byte from input, returns number of bytes consumed
+LIBEMBD_LOCAL_INLINE uint32 libembd_slip_decoder_step_internal(LibEmbd_FrameDecoder_t *dec, uint8 const *input, uint32 available, LibEmbd_FrameDecoder_Status_t *status)
+{
+    uint32 run;
+    uint32 consumed;
+
+    if(dec->slip_escaped){
+        uint8 const escaped = input[0];
+        uint8 value;
+
+        dec->slip_escaped = FALSE;
+        if(escaped == LIBEMBD_SLIP_ESC_END){
+            value = LIBEMBD_SLIP_END;
+        } else if(escaped == LIBEMBD_SLIP_ESC_ESC){
+            value = LIBEMBD_SLIP_ESC;
+        } else {
+            libembd_frame_decoder_fail_internal(dec, (boolean)(escaped == LIBEMBD_SLIP_END));
+            *status = LIBEMBD_FRAME_DECODER_ERROR;
+            return 1u;
+        }
+        if(LIBEMBD_UNLIKELY(dec->length == dec->capacity)){
+            libembd_frame_decoder_fail_internal(dec, FALSE);
+            *status = LIBEMBD_FRAME_DECODER_ERROR;
+            return 1u;
+        }
+        dec->buffer[dec->length++] = value;
+        return 1u;
+    }
+
+    run = libembd_framing_find_internal(input, available, LIBEMBD_SLIP_END, LIBEMBD_SLIP_ESC);
+    if(LIBEMBD_UNLIKELY(run > (uint32)dec->capacity - dec->length)){
+        libembd_frame_decoder_fail_internal(dec, FALSE);
+        *status = LIBEMBD_FRAME_DECODER_ERROR;
+        return 0u;
+    }
+    LIBEMBD_MEMCPY(&dec->buffer[dec->length], input, run);
+    dec->length = (uint16)(dec->length + run);
+    consumed = run;
+
+    if(run < available){
+        consumed++;
+        if(input[run] == LIBEMBD_SLIP_ESC){
+            dec->slip_escaped = TRUE;
+        } else if(dec->length > 0u){ //otherwise empty frame, skipped
+            dec->frame_ready = TRUE;
+            *status = LIBEMBD_FRAME_DECODER_FRAME_READY;
+        }
+    }
+    return consumed;
+}
+
+/*-------------------------------------------------------------Internal Functions End-----------------------------------------------------------------------------*/
+
+LIBEMBD_HEADER_API_INLINE LibEmbd_Std_ReturnType libembd_cobs_encode(LibEmbd_ConstBufferView_t src, LibEmbd_MutableBufferView_t dst, uint16 *encoded_length)
+{
+    uint32 const length = src.length;
+    uint32 const capacity = dst.length;
+    uint32 in = 0u;
+    uint32 out = 0u;
+
+    *encoded_length = 0u;
+
+    for(;;){
+        uint32 const limit = LIBEMBD_MIN(length - in, LIBEMBD_COBS_MAX_RUN_INTERNAL);
+        uint32 const run = libembd_framing_find_internal(&src.data[in], limit, 0u, 0u);
+
+        if(LIBEMBD_UNLIKELY(run + 2u > capacity - out)){ //code byte + run + delimiter
+            return E_NOT_OK;
+        }
+        dst.data[out] = (uint8)(run + 1u);
+        LIBEMBD_MEMCPY(&dst.data[out + 1u], &src.data[in], run);
+        out += run + 1u;
+        in += run;
+
+        if(run < limit){
+            in++; //zero byte implied by the block code
+        } else if(in == length){
+            break;
+        } else {
+            //full block without implied zero, continue with the next one
+        }
+    }
+
+    dst.data[out++] = 0u;
+    *encoded_length = (uint16)out;
+    return E_OK;
+}
+
+LIBEMBD_HEADER_API_INLINE LibEmbd_Std_ReturnType libembd_cobs_decode(LibEmbd_ConstBufferView_t src, LibEmbd_MutableBufferView_t dst, uint16 *decoded_length)
+{
+    uint32 const capacity = dst.length;
+    uint32 length = src.length;
+    uint32 in = 0u;
+    uint32 out = 0u;
+
+    *decoded_length = 0u;
+
+    if((length > 0u) && (src.data[length - 1u] == 0u)){
+        length--;
+    }
+    if(LIBEMBD_UNLIKELY(length == 0u)){
+        return E_NOT_OK;
+    }
+
+    //out never exceeds in - 1, so in-place decoding only ever moves bytes towards the front
+    while(in < length){
+        uint32 const code = src.data[in++];
+        uint32 const run = code - 1u;
+
+        if(LIBEMBD_UNLIKELY((code == 0u) || (run > length - in) || (run > capacity - out))){
+            return E_NOT_OK;
+        }
+        if(LIBEMBD_UNLIKELY(libembd_framing_find_internal(&src.data[in], run, 0u, 0u) != run)){
+            return E_NOT_OK;
+        }
+        LIBEMBD_MEMMOVE(&dst.data[out], &src.data[in], run);
+        out += run;
+        in += run;
+
+        if((code != 0xFFu) && (in < length)){
+            if(LIBEMBD_UNLIKELY(out == capacity)){
+                return E_NOT_OK;
+            }
+            dst.data[out++] = 0u;
+        }
+    }
+
+    *decoded_length = (uint16)out;
+    return E_OK;
+}
+
+LIBEMBD_HEADER_API_INLINE LibEmbd_Std_ReturnType libembd_slip_encode(LibEmbd_ConstBufferView_t src, LibEmbd_MutableBufferView_t dst, uint16 *encoded_length)
+{
+    uint32 const length = src.length;
+    uint32 const capacity = dst.length;
+    uint32 in = 0u;
+    uint32 out = 0u;
+
+    *encoded_length = 0u;
+
+    while(in < length){
+        uint32 const run = libembd_framing_find_internal(&src.data[in], length - in, LIBEMBD_SLIP_END, LIBEMBD_SLIP_ESC);
+
+        if(LIBEMBD_UNLIKELY(run > capacity - out)){
+            return E_NOT_OK;
+        }
+        LIBEMBD_MEMCPY(&dst.data[out], &src.data[in], run);
+        out += run;
+        in += run;
+
+        if(in < length){
+            if(LIBEMBD_UNLIKELY(2u > capacity - out)){
+                return E_NOT_OK;
+            }
+            dst.data[out++] = LIBEMBD_SLIP_ESC;
+            dst.data[out++] = (src.data[in] == LIBEMBD_SLIP_END) ? LIBEMBD_SLIP_ESC_END : LIBEMBD_SLIP_ESC_ESC;
+            in++;
+        }
+    }
+
+    if(LIBEMBD_UNLIKELY(out == capacity)){
+        return E_NOT_OK;
+    }
+    dst.data[out++] = LIBEMBD_SLIP_END;
+    *encoded_length = (uint16)out;
+    return E_OK;
+}
+
+LIBEMBD_HEADER_API_INLINE LibEmbd_Std_ReturnType libembd_slip_decode(LibEmbd_ConstBufferView_t src, LibEmbd_MutableBufferView_t dst, uint16 *decoded_length)
+{
+    uint32 const capacity = dst.length;
+    uint32 length = src.length;
+    uint32 in = 0u;
+    uint32 out = 0u;
+
+    *decoded_length = 0u;
+
+    if((length > 0u) && (src.data[0] == LIBEMBD_SLIP_END)){
+        in = 1u;
+    }
+    if((length > in) && (src.data[length - 1u] == LIBEMBD_SLIP_END)){
+        length--;
+    }
+
+    //out never exceeds in, so in-place decoding only ever moves bytes towards the front
+    while(in < length){
+        uint32 const run = libembd_framing_find_internal(&src.data[in], length - in, LIBEMBD_SLIP_END, LIBEMBD_SLIP_ESC);
+
+        if(LIBEMBD_UNLIKELY(run > capacity - out)){
+            return E_NOT_OK;
+        }
+        LIBEMBD_MEMMOVE(&dst.data[out], &src.data[in], run);
+        out += run;
+        in += run;
+
+        if(in < length){
+            uint8 escaped;
+
+            if(LIBEMBD_UNLIKELY((src.data[in] == LIBEMBD_SLIP_END) || (in + 1u == length) || (out == capacity))){
+                return E_NOT_OK;
+            }
+            escaped = src.data[in + 1u];
+            if(escaped == LIBEMBD_SLIP_ESC_END){
+                dst.data[out++] = LIBEMBD_SLIP_END;
+            } else if(escaped == LIBEMBD_SLIP_ESC_ESC){
+                dst.data[out++] = LIBEMBD_SLIP_ESC;
+            } else {
+                return E_NOT_OK;
+            }
+            in += 2u;
+        }
+    }
+
+    *decoded_length = (uint16)out;
+    return E_OK;
+}
+
+LIBEMBD_HEADER_API_INLINE void libembd_make_frame_decoder(LibEmbd_FrameDecoder_t *dec, LibEmbd_Framing_Type_t type, uint8 *buffer, uint16 capacity)
+{
+    LIBEMBD_ASSUME(dec != NULL);
+    LIBEMBD_ASSUME(buffer != NULL);
+    LIBEMBD_ASSUME(type < LIBEMBD_FRAMING_LAST_DO_NOT_USE);
+
+    dec->buffer = buffer;
+    dec->capacity = capacity;
+    dec->type = type;
+    libembd_frame_decoder_reset(dec);
+}
+
+LIBEMBD_HEADER_API_INLINE void libembd_frame_decoder_reset(LibEmbd_FrameDecoder_t *dec)
+{
+    dec->length = 0u;
+    dec->cobs_code = 0u;
+    dec->cobs_remaining = 0u;
+    dec->slip_escaped = FALSE;
+    dec->discarding = FALSE;
+    dec->frame_ready = FALSE;
+}
+
+LIBEMBD_HEADER_API_INLINE LibEmbd_FrameDecoder_Status_t libembd_frame_decoder_feed(LibEmbd_FrameDecoder_t *dec, LibEmbd_ConstBufferView_t *input)
+{
+    LibEmbd_FrameDecoder_Status_t status = LIBEMBD_FRAME_DECODER_NEED_MORE;
+    uint8 const delimiter = (dec->type == LIBEMBD_FRAMING_COBS) ? 0u : LIBEMBD_SLIP_END;
+    uint8 const *data = input->data;
+    uint32 available = input->length;
+
+    if(dec->frame_ready){
+        libembd_frame_decoder_reset(dec);
+    }
+
+    while((status == LIBEMBD_FRAME_DECODER_NEED_MORE) && (available > 0u)){
+        uint32 consumed;
+
+        if(dec->discarding){
+            consumed = libembd_framing_find_internal(data, available, delimiter, delimiter);
+            if(consumed < available){
+                consumed++;
+                dec->discarding = FALSE;
+            }
+        } else if(dec->type == LIBEMBD_FRAMING_COBS){
+            consumed = libembd_cobs_decoder_step_internal(dec, data, available, &status);
+        } else {
+            consumed = libembd_slip_decoder_step_internal(dec, data, available, &status);
+        }
+        data += consumed;
+        available -= consumed;
+    }
+
+    input->data = data;
+    input->length = (uint16)available;
+    return status;
+}
+
+LIBEMBD_HEADER_API_INLINE LibEmbd_ConstBufferView_t libembd_frame_decoder_frame(LibEmbd_FrameDecoder_t const *dec)
+{
+    LibEmbd_ConstBufferView_t const view = { dec->buffer, dec->length };
+    return view;
+}
+
+#endif /* LIBEMBD_FRAMING_IMPL_H_ */
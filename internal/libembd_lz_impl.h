@@ -0,0 +1,391 @@
+#ifndef LIBEMBD_LZ_IMPL_H_
+#define LIBEMBD_LZ_IMPL_H_
+
+#include "libembd/libembd_common.h"
+#include "libembd/libembd_util.h"
+#include "libembd/libembd_marshalling.h"
+#include "libembd/libembd_lz.h"
+
+LIBEMBD_STATIC_ASSERT((LIBEMBD_LZ_HASH_LOG >= 8u) && (LIBEMBD_LZ_HASH_LOG <= 16u), "LIBEMBD_LZ_HASH_LOG must be within 8..16");
+LIBEMBD_STATIC_ASSERT((LIBEMBD_LZ_BLOCK_SIZE > 0u) && (LIBEMBD_LZ_BLOCK_SIZE <= 0xFFFFu), "LIBEMBD_LZ_BLOCK_SIZE must be within 1..65535");
+
+#define LIBEMBD_LZ_MIN_MATCH_INTERNAL       4u
+#define LIBEMBD_LZ_LAST_LITERALS_INTERNAL   5u  //a block always ends with at least 5 literals
+#define LIBEMBD_LZ_FIND_LIMIT_INTERNAL      12u //the last match starts at least 12 bytes before the end
+#define LIBEMBD_LZ_RUN_MASK_INTERNAL        15u //token nibble value signalling a length extension
+#define LIBEMBD_LZ_SKIP_SHIFT_INTERNAL      6u  //probe step grows by one every 64 misses in a row
+
+struct LibEmbd_LzWorkspace_t {
+    uint16 table[LIBEMBD_LZ_HASH_SIZE]; //last position of each hashed 4-byte sequence
+};
+
+/*-------------------------------------------------------------Internal functions Begin---------------------------------------------------------------------------*/
+
+LIBEMBD_LOCAL_INLINE uint32 libembd_lz_read32_internal(uint8 const *p)
+{
+    uint32 value;
+    LIBEMBD_MEMCPY(&value, p, sizeof(value));
+    return value;
+}
+
+// Multiplicative hash of a 4-byte sequence
+LIBEMBD_LOCAL_INLINE uint32 libembd_lz_hash_internal(uint32 sequence)
+{
+    return (uint32)(sequence * 2654435761u) >> (32u - LIBEMBD_LZ_HASH_LOG);
+}
+
+// Number of equal bytes at in + position and in + candidate, not counting beyond limit
+LIBEMBD_LOCAL_INLINE uint32 libembd_lz_match_length_internal(uint8 const *in, uint32 position, uint32 candidate, uint32 limit)
+{
+    uint32 length = 0u;
+
+    while(position + length + sizeof(uint64) <= limit){
+        uint64 a;
+        uint64 b;
+        LIBEMBD_MEMCPY(&a, in + position + length, sizeof(a));
+        LIBEMBD_MEMCPY(&b, in + candidate + length, sizeof(b));
+        if((a ^ b) != 0u){
+#if LIBEMBD_HOST_ENDIANNESS == LIBEMBD_ENDIANNESS_LITTLE_ENDIAN
+            return length + (uint32)LIBEMBD_CTZ64(a ^ b) / 8u;
+#else
+            return length + (uint32)LIBEMBD_CLZ64(a ^ b) / 8u;
+#endif
+        }
+        length += (uint32)sizeof(uint64);
+    }
+    while((position + length < limit) && (in[position + length] == in[candidate + length])){
+        length++;
+    }
+    return length;
+}
+
+// Writes the 255-run length extension of a token nibble, returns new output position
+LIBEMBD_LOCAL_INLINE uint32 libembd_lz_write_length_internal(uint8 *out, uint32 op, uint32 length)
+{
+    while(length >= 255u){
+        out[op++] = 255u;
+        length -= 255u;
+    }
+    out[op++] = (uint8)length;
+    return op;
+}
+
+// Reads a 255-run length extension and adds it to length, FALSE if the input ends inside the extension
+LIBEMBD_LOCAL_INLINE boolean libembd_lz_read_length_internal(uint8 const *in, uint32 in_length, uint32 *ip, uint32 *length)
+{
+    uint32 byte;
+
+    do {
+        if(LIBEMBD_UNLIKELY(*ip >= in_length)){
+            return FALSE;
+        }
+        byte = in[(*ip)++];
+        *length += byte;
+    } while(byte == 255u);
+    return TRUE;
+}
+
+// Appends one sequence, match_length 0 denotes the final literal-only sequence. FALSE if it does not fit
+LIBEMBD_LOCAL_INLINE boolean libembd_lz_write_sequence_internal(uint8 *out, uint32 capacity, uint32 *op, uint8 const *literals, uint32 literal_length, uint32 offset, uint32 match_length)
+{
+    uint32 const literal_extension = (literal_length >= LIBEMBD_LZ_RUN_MASK_INTERNAL) ? ((literal_length - LIBEMBD_LZ_RUN_MASK_INTERNAL) / 255u + 1u) : 0u;
+    uint32 const match_code = (match_length != 0u) ? (match_length - LIBEMBD_LZ_MIN_MATCH_INTERNAL) : 0u;
+    uint32 const match_extension = (match_code >= LIBEMBD_LZ_RUN_MASK_INTERNAL) ? ((match_code - LIBEMBD_LZ_RUN_MASK_INTERNAL) / 255u + 1u) : 0u;
+    uint32 const size = 1u + literal_extension + literal_length + ((match_length != 0u) ? (2u + match_extension) : 0u);
+    uint32 const token_position = *op;
+    uint32 position = token_position + 1u;
+    uint32 token;
+
+    if(LIBEMBD_UNLIKELY(size > capacity - *op)){
+        return FALSE;
+    }
+
+    token = LIBEMBD_MIN(literal_length, LIBEMBD_LZ_RUN_MASK_INTERNAL) << 4u;
+    if(literal_length >= LIBEMBD_LZ_RUN_MASK_INTERNAL){
+        position = libembd_lz_write_length_internal(out, position, literal_length - LIBEMBD_LZ_RUN_MASK_INTERNAL);
+    }
+    LIBEMBD_MEMCPY(out + position, literals, literal_length);
+    position += literal_length;
+
+    if(match_length != 0u){
+        out[position++] = (uint8)offset; //little endian offset, as in LZ4
+        out[position++] = (uint8)(offset >> 8u);
+        token |= LIBEMBD_MIN(match_code, LIBEMBD_LZ_RUN_MASK_INTERNAL);
+        if(match_code >= LIBEMBD_LZ_RUN_MASK_INTERNAL){
+            position = libembd_lz_write_length_internal(out, position, match_code - LIBEMBD_LZ_RUN_MASK_INTERNAL);
+        }
+    }
+    out[token_position] = (uint8)token;
+    *op = position;
+    return TRUE;
+}
+
+// Copies a match that may overlap its own output (offset < length repeats the last offset bytes)
+LIBEMBD_LOCAL_INLINE void libembd_lz_copy_match_internal(uint8 *out, uint32 op, uint32 offset, uint32 length)
+{
+    uint32 copied = 0u;
+
+    if(offset >= sizeof(uint64)){
+        //every 8-byte chunk reads bytes that have already been written
+        while(copied + sizeof(uint64) <= length){
+            LIBEMBD_MEMCPY(out + op + copied, out + op + copied - offset, sizeof(uint64));
+            copied += (uint32)sizeof(uint64);
+        }
+    }
+    while(copied < length){
+        out[op + copied] = out[op + copied - offset];
+        copied++;
+    }
+}
+
+/*-------------------------------------------------------------Internal Functions End-----------------------------------------------------------------------------*/
+
+LIBEMBD_HEADER_API_INLINE LibEmbd_Std_ReturnType libembd_lz_compress(LibEmbd_LzWorkspace_t *work, LibEmbd_ConstBufferView_t src, LibEmbd_MutableBufferView_t dst, uint16 *compressed_length)
+{
+    uint8 const * const in = src.data;
+    uint32 const length = src.length;
+    uint32 anchor = 0u;
+    uint32 op = 0u;
+
+    LIBEMBD_ASSUME(work != NULL);
+    LIBEMBD_ASSUME(compressed_length != NULL);
+
+    //positions are only inserted below the current one, so stale entries from a previous block cannot leak in
+    LIBEMBD_MEMSET(work->table, 0, sizeof(work->table));
+
+    if(length > LIBEMBD_LZ_FIND_LIMIT_INTERNAL){
+        uint32 const match_limit = length - LIBEMBD_LZ_LAST_LITERALS_INTERNAL;
+        uint32 const find_limit = length - LIBEMBD_LZ_FIND_LIMIT_INTERNAL;
+        uint32 ip = 1u;
+
+        work->table[libembd_lz_hash_internal(libembd_lz_read32_internal(in))] = 0u;
+
+        while(ip < find_limit){
+            uint32 const sequence = libembd_lz_read32_internal(in + ip);
+            uint32 const hash = libembd_lz_hash_internal(sequence);
+            uint32 candidate = work->table[hash];
+            uint32 match_length;
+
+            work->table[hash] = (uint16)ip;
+            if(libembd_lz_read32_internal(in + candidate) != sequence){
+                ip += 1u + ((ip - anchor) >> LIBEMBD_LZ_SKIP_SHIFT_INTERNAL);
+                continue;
+            }
+
+            while((ip > anchor) && (candidate > 0u) && (in[ip - 1u] == in[candidate - 1u])){
+                ip--;
+                candidate--;
+            }
+            match_length = LIBEMBD_LZ_MIN_MATCH_INTERNAL + libembd_lz_match_length_internal(in, ip + LIBEMBD_LZ_MIN_MATCH_INTERNAL, candidate + LIBEMBD_LZ_MIN_MATCH_INTERNAL, match_limit);
+            if(!libembd_lz_write_sequence_internal(dst.data, dst.length, &op, in + anchor, ip - anchor, ip - candidate, match_length)){
+                return E_NOT_OK;
+            }
+            ip += match_length;
+            anchor = ip;
+            if(ip < find_limit){
+                work->table[libembd_lz_hash_internal(libembd_lz_read32_internal(in + ip - 2u))] = (uint16)(ip - 2u);
+            }
+        }
+    }
+
+    if(!libembd_lz_write_sequence_internal(dst.data, dst.length, &op, in + anchor, length - anchor, 0u, 0u)){
+        return E_NOT_OK;
+    }
+    *compressed_length = (uint16)op;
+    return E_OK;
+}
+
+LIBEMBD_HEADER_API_INLINE LibEmbd_Std_ReturnType libembd_lz_decompress(LibEmbd_ConstBufferView_t src, LibEmbd_MutableBufferView_t dst, uint16 *decompressed_length)
+{
+    uint8 const * const in = src.data;
+    uint32 const in_length = src.length;
+    uint8 * const out = dst.data;
+    uint32 const capacity = dst.length;
+    uint32 ip = 0u;
+    uint32 op = 0u;
+
+    LIBEMBD_ASSUME(decompressed_length != NULL);
+
+    *decompressed_length = 0u;
+    if(LIBEMBD_UNLIKELY(in_length == 0u)){
+        return E_NOT_OK;
+    }
+
+    for(;;){
+        uint32 const token = in[ip++];
+        uint32 literal_length = token >> 4u;
+        uint32 match_length = token & LIBEMBD_LZ_RUN_MASK_INTERNAL;
+        uint32 offset;
+
+        if((literal_length == LIBEMBD_LZ_RUN_MASK_INTERNAL) && !libembd_lz_read_length_internal(in, in_length, &ip, &literal_length)){
+            return E_NOT_OK;
+        }
+        if(LIBEMBD_UNLIKELY((literal_length > in_length - ip) || (literal_length > capacity - op))){
+            return E_NOT_OK;
+        }
+        LIBEMBD_MEMCPY(out + op, in + ip, literal_length);
+        ip += literal_length;
+        op += literal_length;
+
+        if(ip == in_length){
+            break; //final literal-only sequence
+        }
+
+        if(LIBEMBD_UNLIKELY(in_length - ip < 2u)){
+            return E_NOT_OK;
+        }
+        offset = (uint32)in[ip] | ((uint32)in[ip + 1u] << 8u);
+        ip += 2u;
+        if(LIBEMBD_UNLIKELY((offset == 0u) || (offset > op))){
+            return E_NOT_OK;
+        }
+        if((match_length == LIBEMBD_LZ_RUN_MASK_INTERNAL) && !libembd_lz_read_length_internal(in, in_length, &ip, &match_length)){
+            return E_NOT_OK;
+        }
+        match_length += LIBEMBD_LZ_MIN_MATCH_INTERNAL;
+        if(LIBEMBD_UNLIKELY((match_length > capacity - op) || (ip == in_length))){ //a block never ends with a match
+            return E_NOT_OK;
+        }
+        libembd_lz_copy_match_internal(out, op, offset, match_length);
+        op += match_length;
+    }
+
+    *decompressed_length = (uint16)op;
+    return E_OK;
+}
+
+LIBEMBD_HEADER_API_INLINE void libembd_put_lz_block_checked(LibEmbd_Serializer_t *ser, LibEmbd_LzWorkspace_t *work, LibEmbd_ConstBufferView_t block)
+{
+    uint32 const raw_length = block.length;
+    uint16 stored_length = (uint16)raw_length;
+
+    LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(ser);
+
+    if(!libembd_serializer_reserve(ser, LIBEMBD_LZ_BLOCK_HEADER_SIZE)){
+        return;
+    }
+
+    if(raw_length != 0u){
+        //compress straight into the buffer, only output strictly smaller than the input is kept
+        uint32 const available = ser->capacity - ser->position - LIBEMBD_LZ_BLOCK_HEADER_SIZE;
+        LibEmbd_MutableBufferView_t const dst = { &ser->buffer[ser->position + LIBEMBD_LZ_BLOCK_HEADER_SIZE], (uint16)LIBEMBD_MIN(available, raw_length - 1u) };
+        uint16 compressed_length;
+
+        if(libembd_lz_compress(work, block, dst, &compressed_length) == E_OK){
+            stored_length = compressed_length;
+        }
+    }
+
+    if(stored_length == raw_length){
+        if(!libembd_serializer_reserve(ser, LIBEMBD_LZ_BLOCK_HEADER_SIZE + raw_length)){
+            return;
+        }
+        LIBEMBD_MEMCPY(&ser->buffer[ser->position + LIBEMBD_LZ_BLOCK_HEADER_SIZE], block.data, raw_length);
+    }
+
+    libembd_put_uint16_to_network_unsafe(ser, (uint16)raw_length);
+    libembd_put_uint16_to_network_unsafe(ser, stored_length);
+    ser->position += stored_length;
+}
+
+LIBEMBD_HEADER_API_INLINE void libembd_get_lz_block_checked(LibEmbd_Deserializer_t *deser, LibEmbd_MutableBufferView_t block, uint16 *length)
+{
+    uint16 raw_length;
+    uint16 stored_length;
+    LibEmbd_ConstBufferView_t stored;
+
+    LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(deser);
+
+    *length = 0u;
+    if(!libembd_deserializer_reserve(deser, LIBEMBD_LZ_BLOCK_HEADER_SIZE)){
+        return;
+    }
+    libembd_read_uint16_from_network_unsafe(deser, deser->position, &raw_length);
+    libembd_read_uint16_from_network_unsafe(deser, deser->position + 2u, &stored_length);
+    if(LIBEMBD_UNLIKELY((raw_length > block.length) || (stored_length > raw_length))){
+        deser->overflow = TRUE;
+        return;
+    }
+    if(!libembd_deserializer_reserve(deser, LIBEMBD_LZ_BLOCK_HEADER_SIZE + (uint32)stored_length)){
+        return;
+    }
+
+    stored.data = &deser->buffer[deser->position + LIBEMBD_LZ_BLOCK_HEADER_SIZE];
+    stored.length = stored_length;
+    if(stored_length == raw_length){
+        LIBEMBD_MEMCPY(block.data, stored.data, raw_length);
+    } else {
+        LibEmbd_MutableBufferView_t const dst = { block.data, raw_length };
+        uint16 decompressed_length;
+
+        if(LIBEMBD_UNLIKELY((libembd_lz_decompress(stored, dst, &decompressed_length) != E_OK) || (decompressed_length != raw_length))){
+            deser->overflow = TRUE;
+            return;
+        }
+    }
+    deser->position += LIBEMBD_LZ_BLOCK_HEADER_SIZE + (uint32)stored_length;
+    *length = raw_length;
+}
+
+LIBEMBD_HEADER_API_INLINE void libembd_put_lz_stream_checked(LibEmbd_Serializer_t *ser, LibEmbd_LzWorkspace_t *work, const void *data, uint32 length)
+{
+    uint8 const * const bytes = (uint8 const *)data;
+    uint32 const start = ser->position;
+    uint32 offset = 0u;
+
+    LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(ser);
+
+    if(!libembd_serializer_reserve(ser, sizeof(uint32))){
+        return;
+    }
+    libembd_put_uint32_to_network_unsafe(ser, length);
+
+    while((offset < length) && !ser->overflow){
+        uint32 const block_length = LIBEMBD_MIN(LIBEMBD_LZ_BLOCK_SIZE, length - offset);
+        LibEmbd_ConstBufferView_t const block = { bytes + offset, (uint16)block_length };
+
+        libembd_put_lz_block_checked(ser, work, block);
+        offset += block_length;
+    }
+    if(ser->overflow){
+        ser->position = start;
+    }
+}
+
+LIBEMBD_HEADER_API_INLINE void libembd_get_lz_stream_checked(LibEmbd_Deserializer_t *deser, void *data, uint32 capacity, uint32 *length)
+{
+    uint8 * const bytes = (uint8 *)data;
+    uint32 const start = deser->position;
+    uint32 total;
+    uint32 offset = 0u;
+
+    LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(deser);
+
+    *length = 0u;
+    if(!libembd_deserializer_reserve(deser, sizeof(uint32))){
+        return;
+    }
+    libembd_get_uint32_from_network_unsafe(deser, &total);
+    if(LIBEMBD_UNLIKELY(total > capacity)){
+        deser->overflow = TRUE;
+    }
+
+    //block sizes are taken from the wire, so the reader does not depend on the writer's LIBEMBD_LZ_BLOCK_SIZE
+    while((offset < total) && !deser->overflow){
+        LibEmbd_MutableBufferView_t const block = { bytes + offset, (uint16)LIBEMBD_MIN(total - offset, 0xFFFFu) };
+        uint16 block_length;
+
+        libembd_get_lz_block_checked(deser, block, &block_length);
+        if(LIBEMBD_UNLIKELY(block_length == 0u)){
+            deser->overflow = TRUE; //empty blocks would never make progress
+        }
+        offset += block_length;
+    }
+    if(deser->overflow){
+        deser->position = start;
+        return;
+    }
+    *length = total;
+}
+
+#endif /* LIBEMBD_LZ_IMPL_H_ */
@@ -0,0 +1,198 @@
+#ifndef LIBEMBD_MAPPED_FILE_IMPL_H_
+#define LIBEMBD_MAPPED_FILE_IMPL_H_
+
+#include "libembd/libembd_common.h"
+#include "libembd/libembd_marshalling.h"
+#include "libembd/libembd_mapped_file.h"
+
+#if defined(__linux__)
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+
+    #if !defined(O_CLOEXEC)
+        #error "libembd_mapped_file.h requires POSIX.1-2008, include it before any system header or build with -D_POSIX_C_SOURCE=200809L"
+    #endif
+#endif
+
+#if defined(__linux__)
+
+struct LibEmbd_MappedFile_t {
+    uint8 *address; //NULL for an empty file
+    uint32 length; //mapped bytes
+    int fd; //kept open for writable mappings to truncate on unmap, -1 otherwise
+};
+
+/*-------------------------------------------------------------Internal functions Begin---------------------------------------------------------------------------*/
+
+// Applies access pattern hints, failures are ignored since they never affect correctness
+LIBEMBD_LOCAL_INLINE void libembd_mapped_file_advise_internal(void *address, uint32 length, LibEmbd_MappedFile_Flags_t flags)
+{
+    if((flags & LIBEMBD_MAPPED_FILE_SEQUENTIAL) != 0u){
+        (void)posix_madvise(address, length, POSIX_MADV_SEQUENTIAL);
+    }
+    if((flags & LIBEMBD_MAPPED_FILE_WILLNEED) != 0u){
+        (void)posix_madvise(address, length, POSIX_MADV_WILLNEED);
+    }
+#if defined(MADV_HUGEPAGE)
+    if((flags & LIBEMBD_MAPPED_FILE_HUGEPAGES) != 0u){
+        (void)madvise(address, length, MADV_HUGEPAGE);
+    }
+#endif
+}
+
+// Maps length bytes of fd and applies the hints, NULL on failure
+LIBEMBD_LOCAL_INLINE uint8 *libembd_mapped_file_map_internal(int fd, uint32 length, int protection, LibEmbd_MappedFile_Flags_t flags)
+{
+    int map_flags = MAP_SHARED;
+    void *address;
+
+#if defined(MAP_POPULATE)
+    if((flags & LIBEMBD_MAPPED_FILE_POPULATE) != 0u){
+        map_flags |= MAP_POPULATE;
+    }
+#endif
+    address = mmap(NULL, length, protection, map_flags, fd, 0);
+    if(address == MAP_FAILED){
+        return NULL;
+    }
+    libembd_mapped_file_advise_internal(address, length, flags);
+    return (uint8 *)address;
+}
+
+/*-------------------------------------------------------------Internal Functions End-----------------------------------------------------------------------------*/
+
+LIBEMBD_HEADER_API_INLINE LibEmbd_Std_ReturnType libembd_map_file_for_reading(LibEmbd_MappedFile_t *file, const char *path, LibEmbd_MappedFile_Flags_t flags, LibEmbd_Deserializer_t *deser)
+{
+    static uint8 const empty_file = 0u; //deserializers require a non-NULL buffer
+    int const fd = open(path, O_RDONLY | O_CLOEXEC);
+    struct stat info;
+    LibEmbd_Std_ReturnType ret = E_NOT_OK;
+
+    LIBEMBD_ASSUME(file != NULL);
+    LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(deser);
+
+    file->address = NULL;
+    file->length = 0u;
+    file->fd = -1;
+    if(fd < 0){
+        return E_NOT_OK;
+    }
+
+    if((fstat(fd, &info) == 0) && (info.st_size >= 0) && ((uint64)info.st_size <= (uint64)UINT32_MAX)){
+        file->length = (uint32)info.st_size;
+        if(file->length == 0u){
+            ret = E_OK; //mmap() rejects empty mappings
+        } else {
+            file->address = libembd_mapped_file_map_internal(fd, file->length, PROT_READ, flags);
+            ret = (file->address != NULL) ? E_OK : E_NOT_OK;
+        }
+    }
+    (void)close(fd); //the mapping keeps its own reference to the file
+
+    if(ret == E_OK){
+        libembd_make_deserializer(deser, (file->address != NULL) ? file->address : &empty_file, file->length);
+    }
+    return ret;
+}
+
+LIBEMBD_HEADER_API_INLINE LibEmbd_Std_ReturnType libembd_map_file_for_writing(LibEmbd_MappedFile_t *file, const char *path, uint32 size, LibEmbd_MappedFile_Flags_t flags, LibEmbd_Serializer_t *ser)
+{
+    int const fd = open(path, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+
+    LIBEMBD_ASSUME(file != NULL);
+    LIBEMBD_ASSUME(size != 0u);
+    LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(ser);
+
+    file->address = NULL;
+    file->length = 0u;
+    file->fd = -1;
+    if(fd < 0){
+        return E_NOT_OK;
+    }
+
+    if(ftruncate(fd, (off_t)size) == 0){
+        file->address = libembd_mapped_file_map_internal(fd, size, PROT_READ | PROT_WRITE, flags);
+    }
+    if(file->address == NULL){
+        (void)close(fd);
+        return E_NOT_OK;
+    }
+
+    file->length = size;
+    file->fd = fd;
+    libembd_make_serializer(ser, file->address, size);
+    return E_OK;
+}
+
+LIBEMBD_HEADER_API_INLINE LibEmbd_Std_ReturnType libembd_unmap_file(LibEmbd_MappedFile_t *file, uint32 length)
+{
+    LibEmbd_Std_ReturnType ret = E_OK;
+
+    LIBEMBD_ASSUME(file != NULL);
+
+    if(file->address != NULL){
+        (void)munmap(file->address, file->length);
+    }
+    if(file->fd >= 0){
+        if(ftruncate(file->fd, (off_t)LIBEMBD_MIN(length, file->length)) != 0){
+            ret = E_NOT_OK;
+        }
+        (void)close(file->fd);
+    }
+
+    file->address = NULL;
+    file->length = 0u;
+    file->fd = -1;
+    return ret;
+}
+
+#endif /* __linux__ */
+
+LIBEMBD_HEADER_API_INLINE uint32 libembd_begin_record_checked(LibEmbd_Serializer_t *ser)
+{
+    uint32 const start = ser->position;
+
+    LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(ser);
+
+    if(libembd_serializer_reserve(ser, LIBEMBD_RECORD_HEADER_SIZE)){
+        ser->position += LIBEMBD_RECORD_HEADER_SIZE; //patched by libembd_end_record_checked()
+    }
+    return start;
+}
+
+LIBEMBD_HEADER_API_INLINE void libembd_end_record_checked(LibEmbd_Serializer_t *ser, uint32 start)
+{
+    LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(ser);
+
+    if(LIBEMBD_LIKELY(!ser->overflow)){
+        libembd_write_uint32_to_network_unsafe(ser, start, ser->position - start - LIBEMBD_RECORD_HEADER_SIZE);
+    }
+}
+
+LIBEMBD_HEADER_API_INLINE boolean libembd_get_record_checked(LibEmbd_Deserializer_t *deser, LibEmbd_Deserializer_t *record)
+{
+    uint32 length;
+
+    LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(deser);
+    LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(record);
+
+    if(deser->overflow || (deser->position == deser->capacity)){
+        return FALSE; //clean end of the record sequence
+    }
+    if(!libembd_deserializer_reserve(deser, LIBEMBD_RECORD_HEADER_SIZE)){
+        return FALSE;
+    }
+    libembd_read_uint32_from_network_unsafe(deser, deser->position, &length);
+    if(LIBEMBD_UNLIKELY(length > deser->capacity - deser->position - LIBEMBD_RECORD_HEADER_SIZE)){
+        deser->overflow = TRUE;
+        return FALSE;
+    }
+
+    libembd_make_deserializer(record, &deser->buffer[deser->position + LIBEMBD_RECORD_HEADER_SIZE], length);
+    deser->position += LIBEMBD_RECORD_HEADER_SIZE + length;
+    return TRUE;
+}
+
+#endif /* LIBEMBD_MAPPED_FILE_IMPL_H_ */
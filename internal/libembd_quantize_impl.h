@@ -0,0 +1,385 @@
+#ifndef LIBEMBD_QUANTIZE_IMPL_H_
+#define LIBEMBD_QUANTIZE_IMPL_H_
+
+#include "libembd/libembd_common.h"
+#include "libembd/libembd_util.h"
+#include "libembd/libembd_marshalling.h"
+#include "libembd/libembd_quantize.h"
+
+#if LIBEMBD_HAS_F16C
+    #include <immintrin.h>
+#endif
+
+#if LIBEMBD_HAS_NEON_FP16
+    #include <arm_neon.h>
+#endif
+
+// Network byte order differs from host byte order
+#if (LIBEMBD_HOST_ENDIANNESS == LIBEMBD_ENDIANNESS_LITTLE_ENDIAN)
+    #define LIBEMBD_QUANTIZE_NETWORK_SWAP_INTERNAL  TRUE
+#else
+    #define LIBEMBD_QUANTIZE_NETWORK_SWAP_INTERNAL  FALSE
+#endif
+
+/*-------------------------------------------------------------Internal functions Begin---------------------------------------------------------------------------*/
+
+LIBEMBD_LOCAL_INLINE uint32 libembd_float32_bits_internal(float32 value)
+{
+    uint32 bits;
+    LIBEMBD_MEMCPY(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+LIBEMBD_LOCAL_INLINE float32 libembd_float32_from_bits_internal(uint32 bits)
+{
+    float32 value;
+    LIBEMBD_MEMCPY(&value, &bits, sizeof(value));
+    return value;
+}
+
+// Rounds half away from zero and saturates to the sint16 range, NaN maps to 0
+LIBEMBD_LOCAL_INLINE sint16 libembd_saturate_to_int16_internal(float32 value)
+{
+    sint16 result;
+
+    if(value != value){
+        result = 0;
+    } else if(value >= 32767.0f){
+        result = 32767;
+    } else if(value <= -32768.0f){
+        result = -32768;
+    } else {
+        result = (sint16)(value + ((value >= 0.0f) ? 0.5f : -0.5f));
+    }
+    return result;
+}
+
+LIBEMBD_LOCAL_INLINE uint16 libembd_q15_encode_internal(float32 value)
+{
+    return (uint16)libembd_float32_to_q15(value);
+}
+
+LIBEMBD_LOCAL_INLINE float32 libembd_q15_decode_internal(uint16 raw)
+{
+    return libembd_q15_to_float32((sint16)raw);
+}
+
+LIBEMBD_LOCAL_INLINE void libembd_float16_encode_array_internal(uint8 *dst, float32 const *src, uint32 count, boolean swap)
+{
+    uint32 i = 0u;
+
+#if LIBEMBD_HAS_F16C
+    __m128i const swap_mask = _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+    for(; i + 8u <= count; i += 8u){
+        __m128i half = _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        if(swap){
+            half = _mm_shuffle_epi8(half, swap_mask);
+        }
+        _mm_storeu_si128((__m128i *)(dst + i * 2u), half);
+    }
+#elif LIBEMBD_HAS_NEON_FP16
+    for(; i + 4u <= count; i += 4u){
+        uint8x8_t half = vreinterpret_u8_f16(vcvt_f16_f32(vld1q_f32(src + i)));
+        if(swap){
+            half = vrev16_u8(half);
+        }
+        vst1_u8(dst + i * 2u, half);
+    }
+#endif
+
+    for(; i < count; i++){
+        uint16 half = libembd_float32_to_float16(src[i]);
+        if(swap){
+            half = (uint16)LIBEMBD_BSWAP16(half);
+        }
+        LIBEMBD_MEMCPY(dst + i * 2u, &half, sizeof(half));
+    }
+}
+
+LIBEMBD_LOCAL_INLINE void libembd_float16_decode_array_internal(float32 *dst, uint8 const *src, uint32 count, boolean swap)
+{
+    uint32 i = 0u;
+
+#if LIBEMBD_HAS_F16C
+    __m128i const swap_mask = _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+    for(; i + 8u <= count; i += 8u){
+        __m128i half = _mm_loadu_si128((__m128i const *)(src + i * 2u));
+        if(swap){
+            half = _mm_shuffle_epi8(half, swap_mask);
+        }
+        _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(half));
+    }
+#elif LIBEMBD_HAS_NEON_FP16
+    for(; i + 4u <= count; i += 4u){
+        uint8x8_t half = vld1_u8(src + i * 2u);
+        if(swap){
+            half = vrev16_u8(half);
+        }
+        vst1q_f32(dst + i, vcvt_f32_f16(vreinterpret_f16_u8(half)));
+    }
+#endif
+
+    for(; i < count; i++){
+        uint16 half;
+        LIBEMBD_MEMCPY(&half, src + i * 2u, sizeof(half));
+        if(swap){
+            half = (uint16)LIBEMBD_BSWAP16(half);
+        }
+        dst[i] = libembd_float16_to_float32(half);
+    }
+}
+
+// Plain loops, the conversion is a few integer operations that compilers vectorize on their own
+LIBEMBD_LOCAL_INLINE void libembd_bfloat16_encode_array_internal(uint8 *dst, float32 const *src, uint32 count, boolean swap)
+{
+    uint32 i;
+    for(i = 0u; i < count; i++){
+        uint16 bfloat = libembd_float32_to_bfloat16(src[i]);
+        if(swap){
+            bfloat = (uint16)LIBEMBD_BSWAP16(bfloat);
+        }
+        LIBEMBD_MEMCPY(dst + i * 2u, &bfloat, sizeof(bfloat));
+    }
+}
+
+LIBEMBD_LOCAL_INLINE void libembd_bfloat16_decode_array_internal(float32 *dst, uint8 const *src, uint32 count, boolean swap)
+{
+    uint32 i;
+    for(i = 0u; i < count; i++){
+        uint16 bfloat;
+        LIBEMBD_MEMCPY(&bfloat, src + i * 2u, sizeof(bfloat));
+        if(swap){
+            bfloat = (uint16)LIBEMBD_BSWAP16(bfloat);
+        }
+        dst[i] = libembd_bfloat16_to_float32(bfloat);
+    }
+}
+
+/*-------------------------------------------------------------Internal Functions End-----------------------------------------------------------------------------*/
+
+LIBEMBD_HEADER_API_INLINE uint16 libembd_float32_to_float16(float32 value)
+{
+    uint32 const bits = libembd_float32_bits_internal(value);
+    uint32 const sign = (bits >> 16u) & 0x8000u;
+    uint32 abs_bits = bits & 0x7FFFFFFFu;
+    uint32 half;
+
+    if(abs_bits >= 0x7F800000u){
+        //infinity stays infinity, NaN is quieted and keeps its upper payload bits
+        half = 0x7C00u | ((abs_bits > 0x7F800000u) ? (0x0200u | ((abs_bits >> 13u) & 0x03FFu)) : 0u);
+    } else if(abs_bits >= 0x477FF000u){
+        half = 0x7C00u; //rounds to or beyond 65520
+    } else if(abs_bits < 0x38800000u){
+        //subnormal half: adding 0.5 aligns the float32 ULP with half the subnormal half ULP, the FPU does the rounding
+        float32 const shifted = libembd_float32_from_bits_internal(abs_bits) + 0.5f;
+        half = libembd_float32_bits_internal(shifted) - 0x3F000000u;
+    } else {
+        //rebias the exponent by -112 and round to nearest even on the 13 dropped mantissa bits
+        abs_bits += 0xC8000FFFu + ((abs_bits >> 13u) & 1u);
+        half = abs_bits >> 13u;
+    }
+    return (uint16)(sign | half);
+}
+
+LIBEMBD_HEADER_API_INLINE float32 libembd_float16_to_float32(uint16 half)
+{
+    uint32 const sign = ((uint32)half & 0x8000u) << 16u;
+    uint32 const exponent = ((uint32)half >> 10u) & 0x1Fu;
+    uint32 const mantissa = (uint32)half & 0x03FFu;
+    float32 value;
+
+    if(exponent == 0x1Fu){
+        value = libembd_float32_from_bits_internal(sign | 0x7F800000u | (mantissa << 13u));
+    } else if(exponent != 0u){
+        value = libembd_float32_from_bits_internal(sign | ((exponent + 112u) << 23u) | (mantissa << 13u));
+    } else {
+        //zero or subnormal: mantissa * 2^-24
+        value = (float32)mantissa * 5.9604644775390625e-8f;
+        value = (sign != 0u) ? -value : value;
+    }
+    return value;
+}
+
+LIBEMBD_HEADER_API_INLINE uint16 libembd_float32_to_bfloat16(float32 value)
+{
+    uint32 const bits = libembd_float32_bits_internal(value);
+
+    if((bits & 0x7FFFFFFFu) > 0x7F800000u){
+        return (uint16)((bits >> 16u) | 0x0040u); //quiet NaN, rounding could turn it into infinity
+    }
+    return (uint16)((bits + 0x7FFFu + ((bits >> 16u) & 1u)) >> 16u);
+}
+
+LIBEMBD_HEADER_API_INLINE float32 libembd_bfloat16_to_float32(uint16 bfloat)
+{
+    return libembd_float32_from_bits_internal((uint32)bfloat << 16u);
+}
+
+LIBEMBD_HEADER_API_INLINE sint16 libembd_float32_to_q15(float32 value)
+{
+    return libembd_saturate_to_int16_internal(value * 32768.0f);
+}
+
+LIBEMBD_HEADER_API_INLINE float32 libembd_q15_to_float32(sint16 q15)
+{
+    return (float32)q15 * (1.0f / 32768.0f);
+}
+
+LIBEMBD_HEADER_API_INLINE sint16 libembd_float32_to_scaled_int16(float32 value, float32 scale, float32 offset)
+{
+    return libembd_saturate_to_int16_internal((value - offset) / scale);
+}
+
+LIBEMBD_HEADER_API_INLINE float32 libembd_scaled_int16_to_float32(sint16 raw, float32 scale, float32 offset)
+{
+    return (float32)raw * scale + offset;
+}
+
+#define LIBEMBD_QUANTIZE_IMPLEMENTATION(NAME, ENCODE, DECODE) \
+    LIBEMBD_HEADER_API_INLINE void libembd_put_##NAME##_to_network_unsafe(LibEmbd_Serializer_t *ser, float32 value) { \
+        libembd_put_uint16_to_network_unsafe(ser, ENCODE(value)); \
+    } \
+    LIBEMBD_HEADER_API_INLINE void libembd_put_##NAME##_to_host_unsafe(LibEmbd_Serializer_t *ser, float32 value) { \
+        libembd_put_uint16_to_host_unsafe(ser, ENCODE(value)); \
+    } \
+    LIBEMBD_HEADER_API_INLINE void libembd_put_##NAME##_to_network_checked(LibEmbd_Serializer_t *ser, float32 value) { \
+        libembd_put_uint16_to_network_checked(ser, ENCODE(value)); \
+    } \
+    LIBEMBD_HEADER_API_INLINE void libembd_put_##NAME##_to_host_checked(LibEmbd_Serializer_t *ser, float32 value) { \
+        libembd_put_uint16_to_host_checked(ser, ENCODE(value)); \
+    } \
+    LIBEMBD_HEADER_API_INLINE void libembd_get_##NAME##_from_network_unsafe(LibEmbd_Deserializer_t *deser, float32 *value) { \
+        uint16 raw; \
+        libembd_get_uint16_from_network_unsafe(deser, &raw); \
+        *value = DECODE(raw); \
+    } \
+    LIBEMBD_HEADER_API_INLINE void libembd_get_##NAME##_from_host_unsafe(LibEmbd_Deserializer_t *deser, float32 *value) { \
+        uint16 raw; \
+        libembd_get_uint16_from_host_unsafe(deser, &raw); \
+        *value = DECODE(raw); \
+    } \
+    LIBEMBD_HEADER_API_INLINE void libembd_get_##NAME##_from_network_checked(LibEmbd_Deserializer_t *deser, float32 *value) { \
+        uint16 raw; \
+        libembd_get_uint16_from_network_checked(deser, &raw); \
+        *value = DECODE(raw); /*raw is zeroed on failure, which decodes to 0.0f*/ \
+    } \
+    LIBEMBD_HEADER_API_INLINE void libembd_get_##NAME##_from_host_checked(LibEmbd_Deserializer_t *deser, float32 *value) { \
+        uint16 raw; \
+        libembd_get_uint16_from_host_checked(deser, &raw); \
+        *value = DECODE(raw); \
+    }
+
+LIBEMBD_QUANTIZE_IMPLEMENTATION(float16, libembd_float32_to_float16, libembd_float16_to_float32)
+LIBEMBD_QUANTIZE_IMPLEMENTATION(bfloat16, libembd_float32_to_bfloat16, libembd_bfloat16_to_float32)
+LIBEMBD_QUANTIZE_IMPLEMENTATION(q15, libembd_q15_encode_internal, libembd_q15_decode_internal)
+
+LIBEMBD_HEADER_API_INLINE void libembd_put_scaled_int16_to_network_unsafe(LibEmbd_Serializer_t *ser, float32 value, float32 scale, float32 offset)
+{
+    libembd_put_uint16_to_network_unsafe(ser, (uint16)libembd_float32_to_scaled_int16(value, scale, offset));
+}
+
+LIBEMBD_HEADER_API_INLINE void libembd_put_scaled_int16_to_host_unsafe(LibEmbd_Serializer_t *ser, float32 value, float32 scale, float32 offset)
+{
+    libembd_put_uint16_to_host_unsafe(ser, (uint16)libembd_float32_to_scaled_int16(value, scale, offset));
+}
+
+LIBEMBD_HEADER_API_INLINE void libembd_put_scaled_int16_to_network_checked(LibEmbd_Serializer_t *ser, float32 value, float32 scale, float32 offset)
+{
+    libembd_put_uint16_to_network_checked(ser, (uint16)libembd_float32_to_scaled_int16(value, scale, offset));
+}
+
+LIBEMBD_HEADER_API_INLINE void libembd_put_scaled_int16_to_host_checked(LibEmbd_Serializer_t *ser, float32 value, float32 scale, float32 offset)
+{
+    libembd_put_uint16_to_host_checked(ser, (uint16)libembd_float32_to_scaled_int16(value, scale, offset));
+}
+
+LIBEMBD_HEADER_API_INLINE void libembd_get_scaled_int16_from_network_unsafe(LibEmbd_Deserializer_t *deser, float32 *value, float32 scale, float32 offset)
+{
+    uint16 raw;
+    libembd_get_uint16_from_network_unsafe(deser, &raw);
+    *value = libembd_scaled_int16_to_float32((sint16)raw, scale, offset);
+}
+
+LIBEMBD_HEADER_API_INLINE void libembd_get_scaled_int16_from_host_unsafe(LibEmbd_Deserializer_t *deser, float32 *value, float32 scale, float32 offset)
+{
+    uint16 raw;
+    libembd_get_uint16_from_host_unsafe(deser, &raw);
+    *value = libembd_scaled_int16_to_float32((sint16)raw, scale, offset);
+}
+
+LIBEMBD_HEADER_API_INLINE void libembd_get_scaled_int16_from_network_checked(LibEmbd_Deserializer_t *deser, float32 *value, float32 scale, float32 offset)
+{
+    if(libembd_deserializer_reserve(deser, sizeof(uint16))){
+        libembd_get_scaled_int16_from_network_unsafe(deser, value, scale, offset);
+    } else {
+        *value = 0.0f;
+    }
+}
+
+LIBEMBD_HEADER_API_INLINE void libembd_get_scaled_int16_from_host_checked(LibEmbd_Deserializer_t *deser, float32 *value, float32 scale, float32 offset)
+{
+    if(libembd_deserializer_reserve(deser, sizeof(uint16))){
+        libembd_get_scaled_int16_from_host_unsafe(deser, value, scale, offset);
+    } else {
+        *value = 0.0f;
+    }
+}
+
+#define LIBEMBD_QUANTIZE_ARRAY_IMPLEMENTATION(NAME) \
+    LIBEMBD_HEADER_API_INLINE void libembd_put_##NAME##_array_to_network_unsafe(LibEmbd_Serializer_t *ser, float32 const *values, uint32 count) { \
+        LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(ser); \
+        LIBEMBD_MARSHALLING_ASSERT_NO_OVERFLOW(ser, count * sizeof(uint16)); \
+        libembd_##NAME##_encode_array_internal(&ser->buffer[ser->position], values, count, LIBEMBD_QUANTIZE_NETWORK_SWAP_INTERNAL); \
+        ser->position += count * sizeof(uint16); \
+    } \
+    LIBEMBD_HEADER_API_INLINE void libembd_put_##NAME##_array_to_host_unsafe(LibEmbd_Serializer_t *ser, float32 const *values, uint32 count) { \
+        LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(ser); \
+        LIBEMBD_MARSHALLING_ASSERT_NO_OVERFLOW(ser, count * sizeof(uint16)); \
+        libembd_##NAME##_encode_array_internal(&ser->buffer[ser->position], values, count, FALSE); \
+        ser->position += count * sizeof(uint16); \
+    } \
+    LIBEMBD_HEADER_API_INLINE void libembd_get_##NAME##_array_from_network_unsafe(LibEmbd_Deserializer_t *deser, float32 *values, uint32 count) { \
+        LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(deser); \
+        LIBEMBD_MARSHALLING_ASSERT_NO_OVERFLOW(deser, count * sizeof(uint16)); \
+        libembd_##NAME##_decode_array_internal(values, &deser->buffer[deser->position], count, LIBEMBD_QUANTIZE_NETWORK_SWAP_INTERNAL); \
+        deser->position += count * sizeof(uint16); \
+    } \
+    LIBEMBD_HEADER_API_INLINE void libembd_get_##NAME##_array_from_host_unsafe(LibEmbd_Deserializer_t *deser, float32 *values, uint32 count) { \
+        LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(deser); \
+        LIBEMBD_MARSHALLING_ASSERT_NO_OVERFLOW(deser, count * sizeof(uint16)); \
+        libembd_##NAME##_decode_array_internal(values, &deser->buffer[deser->position], count, FALSE); \
+        deser->position += count * sizeof(uint16); \
+    } \
+    LIBEMBD_HEADER_API_INLINE void libembd_put_##NAME##_array_to_network_checked(LibEmbd_Serializer_t *ser, float32 const *values, uint32 count) { \
+        if((count <= UINT32_MAX / sizeof(uint16)) && libembd_serializer_reserve(ser, count * sizeof(uint16))) { \
+            libembd_put_##NAME##_array_to_network_unsafe(ser, values, count); \
+        } else { \
+            ser->overflow = TRUE; \
+        } \
+    } \
+    LIBEMBD_HEADER_API_INLINE void libembd_put_##NAME##_array_to_host_checked(LibEmbd_Serializer_t *ser, float32 const *values, uint32 count) { \
+        if((count <= UINT32_MAX / sizeof(uint16)) && libembd_serializer_reserve(ser, count * sizeof(uint16))) { \
+            libembd_put_##NAME##_array_to_host_unsafe(ser, values, count); \
+        } else { \
+            ser->overflow = TRUE; \
+        } \
+    } \
+    LIBEMBD_HEADER_API_INLINE void libembd_get_##NAME##_array_from_network_checked(LibEmbd_Deserializer_t *deser, float32 *values, uint32 count) { \
+        if((count <= UINT32_MAX / sizeof(uint16)) && libembd_deserializer_reserve(deser, count * sizeof(uint16))) { \
+            libembd_get_##NAME##_array_from_network_unsafe(deser, values, count); \
+        } else { \
+            deser->overflow = TRUE; \
+        } \
+    } \
+    LIBEMBD_HEADER_API_INLINE void libembd_get_##NAME##_array_from_host_checked(LibEmbd_Deserializer_t *deser, float32 *values, uint32 count) { \
+        if((count <= UINT32_MAX / sizeof(uint16)) && libembd_deserializer_reserve(deser, count * sizeof(uint16))) { \
+            libembd_get_##NAME##_array_from_host_unsafe(deser, values, count); \
+        } else { \
+            deser->overflow = TRUE; \
+        } \
+    }
+
+LIBEMBD_QUANTIZE_ARRAY_IMPLEMENTATION(float16)
+LIBEMBD_QUANTIZE_ARRAY_IMPLEMENTATION(bfloat16)
+
+#endif /* LIBEMBD_QUANTIZE_IMPL_H_ */
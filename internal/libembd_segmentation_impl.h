@@ -0,0 +1,338 @@
+#ifndef LIBEMBD_SEGMENTATION_IMPL_H_
+#define LIBEMBD_SEGMENTATION_IMPL_H_
+
+#include "libembd/libembd_common.h"
+#include "libembd/libembd_util.h"
+#include "libembd/libembd_marshalling.h"
+#include "libembd/libembd_timer.h"
+#include "libembd/libembd_segmentation.h"
+
+LIBEMBD_STATIC_ASSERT((LIBEMBD_REASSEMBLY_MAX_SESSIONS >= 1u) && (LIBEMBD_REASSEMBLY_MAX_SESSIONS <= 128u), "LIBEMBD_REASSEMBLY_MAX_SESSIONS must be within 1..128");
+
+#define LIBEMBD_SEGMENT_PCI_SINGLE_INTERNAL         0x00u
+#define LIBEMBD_SEGMENT_PCI_FIRST_INTERNAL          0x10u
+#define LIBEMBD_SEGMENT_PCI_CONSECUTIVE_INTERNAL    0x20u
+#define LIBEMBD_SEGMENT_PCI_TYPE_MASK_INTERNAL      0xF0u
+#define LIBEMBD_SEGMENT_PCI_NIBBLE_MASK_INTERNAL    0x0Fu
+#define LIBEMBD_SEGMENT_MAX_SHORT_SINGLE_INTERNAL   7u //length in the low nibble
+#define LIBEMBD_SEGMENT_MAX_ESCAPED_SINGLE_INTERNAL 255u //length in the second byte
+#define LIBEMBD_SEGMENT_MAX_SHORT_FIRST_INTERNAL    4095u //12-bit length
+
+// Channel hash table at most half full, index size is the next power of two of twice the session count
+#define LIBEMBD_REASSEMBLY_INDEX_SIZE_INTERNAL \
+    ((LIBEMBD_REASSEMBLY_MAX_SESSIONS <= 4u)  ? 8u  : (LIBEMBD_REASSEMBLY_MAX_SESSIONS <= 8u)  ? 16u : \
+     (LIBEMBD_REASSEMBLY_MAX_SESSIONS <= 16u) ? 32u : (LIBEMBD_REASSEMBLY_MAX_SESSIONS <= 32u) ? 64u : \
+     (LIBEMBD_REASSEMBLY_MAX_SESSIONS <= 64u) ? 128u : 256u)
+
+struct LibEmbd_Segmenter_t {
+    uint8 const *data;
+    uint32 length;
+    uint32 offset; //bytes segmented so far
+    uint16 mtu;
+    uint8 sequence; //next consecutive frame sequence number
+    boolean started;
+};
+
+typedef struct {
+    uint8 *buffer; //session_capacity bytes of the storage
+    uint32 channel;
+    uint32 length; //announced by the first frame
+    uint32 received;
+    uint8 sequence; //expected consecutive frame sequence number
+    LibEmbd_Timer_t timer; //started while the session is in progress
+} LibEmbd_ReassemblySession_t;
+
+struct LibEmbd_Reassembler_t {
+    libembd_reassembly_handler_t handler;
+    void *context;
+    uint32 session_capacity;
+    libembd_timer_duration_ms timeout;
+    uint32 free_count;
+    uint8 free_sessions[LIBEMBD_REASSEMBLY_MAX_SESSIONS]; //stack of free session indices
+    uint8 index[LIBEMBD_REASSEMBLY_INDEX_SIZE_INTERNAL]; //session index + 1 of the channel hashed to this slot, 0 if empty
+    LibEmbd_ReassemblySession_t sessions[LIBEMBD_REASSEMBLY_MAX_SESSIONS];
+};
+
+/*-------------------------------------------------------------Internal functions Begin---------------------------------------------------------------------------*/
+
+// Expiry is detected from the timer state after ticking, library timer callbacks carry no context
+LIBEMBD_LOCAL_INLINE void libembd_reassembly_timeout_internal(void)
+{
+}
+
+LIBEMBD_LOCAL_INLINE uint32 LIBEMBD_ATTR_ALWAYS_INLINE libembd_reassembly_hash_internal(uint32 channel)
+{
+    return ((channel * 0x9E3779B1u) >> 24) & (LIBEMBD_REASSEMBLY_INDEX_SIZE_INTERNAL - 1u); //Fibonacci hashing, top bits
+}
+
+// Index table slot holding channel, or the empty slot it would be inserted at
+LIBEMBD_LOCAL_INLINE uint32 libembd_reassembly_find_internal(LibEmbd_Reassembler_t const *reasm, uint32 channel)
+{
+    uint32 slot = libembd_reassembly_hash_internal(channel);
+
+    while((reasm->index[slot] != 0u) && (reasm->sessions[reasm->index[slot] - 1u].channel != channel)){
+        slot = (slot + 1u) & (LIBEMBD_REASSEMBLY_INDEX_SIZE_INTERNAL - 1u);
+    }
+    return slot;
+}
+
+// Frees the session at index slot, backward shift deletion keeps every probe sequence free of holes
+LIBEMBD_LOCAL_INLINE void libembd_reassembly_release_internal(LibEmbd_Reassembler_t *reasm, uint32 slot)
+{
+    uint32 const session = reasm->index[slot] - 1u;
+    uint32 next = slot;
+    uint32 home;
+
+    libembd_stop_timer(&reasm->sessions[session].timer);
+    reasm->free_sessions[reasm->free_count++] = (uint8)session;
+    reasm->index[slot] = 0u;
+    for(;;){
+        next = (next + 1u) & (LIBEMBD_REASSEMBLY_INDEX_SIZE_INTERNAL - 1u);
+        if(reasm->index[next] == 0u){
+            return;
+        }
+        home = libembd_reassembly_hash_internal(reasm->sessions[reasm->index[next] - 1u].channel);
+        //move the entry into the hole unless its home lies cyclically within (slot, next]
+        if(((next - home) & (LIBEMBD_REASSEMBLY_INDEX_SIZE_INTERNAL - 1u)) >= ((next - slot) & (LIBEMBD_REASSEMBLY_INDEX_SIZE_INTERNAL - 1u))){
+            reasm->index[slot] = reasm->index[next];
+            reasm->index[next] = 0u;
+            slot = next;
+        }
+    }
+}
+
+// Drops the session in progress on channel, if any
+LIBEMBD_LOCAL_INLINE void libembd_reassembly_drop_internal(LibEmbd_Reassembler_t *reasm, uint32 channel)
+{
+    uint32 const slot = libembd_reassembly_find_internal(reasm, channel);
+
+    if(reasm->index[slot] != 0u){
+        libembd_reassembly_release_internal(reasm, slot);
+    }
+}
+
+// Appends a segment to the session at index slot, delivers and frees the session once complete
+LIBEMBD_LOCAL_INLINE void libembd_reassembly_append_internal(LibEmbd_Reassembler_t *reasm, uint32 slot, uint8 const *data, uint32 length)
+{
+    LibEmbd_ReassemblySession_t * const session = &reasm->sessions[reasm->index[slot] - 1u];
+    LibEmbd_Deserializer_t payload;
+    uint32 const chunk = LIBEMBD_MIN(length, session->length - session->received); //the last frame may be padded
+
+    LIBEMBD_MEMCPY(&session->buffer[session->received], data, chunk);
+    session->received += chunk;
+    if(session->received == session->length){
+        libembd_make_deserializer(&payload, session->buffer, session->length);
+        reasm->handler(reasm->context, session->channel, &payload);
+        libembd_reassembly_release_internal(reasm, libembd_reassembly_find_internal(reasm, session->channel));
+    }
+}
+
+/*-------------------------------------------------------------Internal Functions End-----------------------------------------------------------------------------*/
+
+LIBEMBD_HEADER_API_INLINE void libembd_make_segmenter(LibEmbd_Segmenter_t *seg, const void *data, uint32 length, uint16 mtu)
+{
+    LIBEMBD_ASSUME(seg != NULL);
+    LIBEMBD_ASSUME((data != NULL) || (length == 0u));
+    LIBEMBD_ASSUME(mtu >= LIBEMBD_SEGMENT_MIN_MTU);
+
+    seg->data = (uint8 const *)data;
+    seg->length = length;
+    seg->offset = 0u;
+    seg->mtu = mtu;
+    seg->sequence = 1u;
+    seg->started = FALSE;
+}
+
+LIBEMBD_HEADER_API_INLINE boolean libembd_segmenter_next(LibEmbd_Segmenter_t *seg, LibEmbd_Segment_t *segment)
+{
+    uint32 length;
+    uint32 chunk;
+
+    LIBEMBD_ASSUME(seg != NULL);
+    LIBEMBD_ASSUME(segment != NULL);
+
+    if(!seg->started){
+        seg->started = TRUE;
+        if((seg->length >= 1u) && (seg->length <= LIBEMBD_SEGMENT_MAX_SHORT_SINGLE_INTERNAL)){
+            segment->header[0] = (uint8)(LIBEMBD_SEGMENT_PCI_SINGLE_INTERNAL | seg->length);
+            segment->header_length = 1u;
+            chunk = seg->length;
+        } else if((seg->length <= LIBEMBD_SEGMENT_MAX_ESCAPED_SINGLE_INTERNAL) && (seg->length + 2u <= seg->mtu)){
+            segment->header[0] = LIBEMBD_SEGMENT_PCI_SINGLE_INTERNAL;
+            segment->header[1] = (uint8)seg->length;
+            segment->header_length = 2u;
+            chunk = seg->length;
+        } else if(seg->length <= LIBEMBD_SEGMENT_MAX_SHORT_FIRST_INTERNAL){
+            segment->header[0] = (uint8)(LIBEMBD_SEGMENT_PCI_FIRST_INTERNAL | (seg->length >> 8));
+            segment->header[1] = (uint8)seg->length;
+            segment->header_length = 2u;
+            chunk = LIBEMBD_MIN(seg->length, (uint32)seg->mtu - 2u);
+        } else {
+            segment->header[0] = LIBEMBD_SEGMENT_PCI_FIRST_INTERNAL;
+            segment->header[1] = 0u;
+            length = LIBEMBD_HTONL(seg->length);
+            LIBEMBD_MEMCPY(&segment->header[2], &length, sizeof(length));
+            segment->header_length = LIBEMBD_SEGMENT_MAX_HEADER_SIZE;
+            chunk = LIBEMBD_MIN(seg->length, (uint32)seg->mtu - LIBEMBD_SEGMENT_MAX_HEADER_SIZE);
+        }
+    } else {
+        if(seg->offset == seg->length){
+            return FALSE;
+        }
+        segment->header[0] = (uint8)(LIBEMBD_SEGMENT_PCI_CONSECUTIVE_INTERNAL | (seg->sequence & LIBEMBD_SEGMENT_PCI_NIBBLE_MASK_INTERNAL));
+        segment->header_length = 1u;
+        seg->sequence = (uint8)((seg->sequence + 1u) & LIBEMBD_SEGMENT_PCI_NIBBLE_MASK_INTERNAL);
+        chunk = LIBEMBD_MIN(seg->length - seg->offset, (uint32)seg->mtu - 1u);
+    }
+
+    segment->payload.data = &seg->data[seg->offset];
+    segment->payload.length = (uint16)chunk;
+    seg->offset += chunk;
+    return TRUE;
+}
+
+LIBEMBD_HEADER_API_INLINE void libembd_put_segment_checked(LibEmbd_Serializer_t *ser, LibEmbd_Segment_t const *segment)
+{
+    LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(ser);
+    LIBEMBD_ASSUME(segment != NULL);
+
+    if(libembd_serializer_reserve(ser, (uint32)segment->header_length + segment->payload.length)){
+        libembd_put_buffer_unsafe(ser, segment->header, segment->header_length);
+        libembd_put_buffer_unsafe(ser, segment->payload.data, segment->payload.length);
+    }
+}
+
+LIBEMBD_HEADER_API_INLINE void libembd_make_reassembler(LibEmbd_Reassembler_t *reasm, uint8 *storage, uint32 session_capacity,
+                                                        libembd_timer_duration_ms timeout, libembd_reassembly_handler_t handler, void *context)
+{
+    uint32 i;
+
+    LIBEMBD_ASSUME(reasm != NULL);
+    LIBEMBD_ASSUME(storage != NULL);
+    LIBEMBD_ASSUME(handler != NULL);
+
+    reasm->handler = handler;
+    reasm->context = context;
+    reasm->session_capacity = session_capacity;
+    reasm->timeout = timeout;
+    reasm->free_count = LIBEMBD_REASSEMBLY_MAX_SESSIONS;
+    for(i = 0u; i < LIBEMBD_REASSEMBLY_MAX_SESSIONS; i++){
+        reasm->free_sessions[i] = (uint8)(LIBEMBD_REASSEMBLY_MAX_SESSIONS - 1u - i);
+        reasm->sessions[i].buffer = &storage[i * session_capacity];
+        (void)libembd_make_timer(&reasm->sessions[i].timer, TIMER_TYPE_ONE_SHOT, libembd_reassembly_timeout_internal);
+    }
+    LIBEMBD_MEMSET(reasm->index, 0, sizeof(reasm->index));
+}
+
+LIBEMBD_HEADER_API_INLINE LibEmbd_Std_ReturnType libembd_reassembler_receive(LibEmbd_Reassembler_t *reasm, uint32 channel, LibEmbd_ConstBufferView_t frame)
+{
+    LibEmbd_ReassemblySession_t *session;
+    LibEmbd_Deserializer_t deser;
+    uint32 header_length;
+    uint32 length;
+    uint32 slot;
+    uint8 pci;
+
+    LIBEMBD_ASSUME(reasm != NULL);
+
+    if(frame.length == 0u){
+        return E_NOT_OK;
+    }
+    libembd_make_deserializer(&deser, frame.data, frame.length);
+    pci = frame.data[0];
+
+    switch(pci & LIBEMBD_SEGMENT_PCI_TYPE_MASK_INTERNAL){
+        case LIBEMBD_SEGMENT_PCI_SINGLE_INTERNAL:
+            header_length = 1u;
+            length = pci & LIBEMBD_SEGMENT_PCI_NIBBLE_MASK_INTERNAL;
+            if((length == 0u) && (frame.length >= 2u)){
+                header_length = 2u;
+                length = frame.data[1];
+            }
+            if(length > (uint32)frame.length - header_length){
+                return E_NOT_OK;
+            }
+            libembd_reassembly_drop_internal(reasm, channel);
+            libembd_make_deserializer(&deser, &frame.data[header_length], length);
+            reasm->handler(reasm->context, channel, &deser);
+            return E_OK;
+
+        case LIBEMBD_SEGMENT_PCI_FIRST_INTERNAL:
+            if(frame.length < 2u){
+                return E_NOT_OK;
+            }
+            header_length = 2u;
+            length = ((uint32)(pci & LIBEMBD_SEGMENT_PCI_NIBBLE_MASK_INTERNAL) << 8) | frame.data[1];
+            if(length == 0u){
+                if(frame.length < LIBEMBD_SEGMENT_MAX_HEADER_SIZE){
+                    return E_NOT_OK;
+                }
+                header_length = LIBEMBD_SEGMENT_MAX_HEADER_SIZE;
+                libembd_read_uint32_from_network_unsafe(&deser, 2u, &length);
+            }
+            libembd_reassembly_drop_internal(reasm, channel);
+            if((length > reasm->session_capacity) || (reasm->free_count == 0u)){
+                return E_NOT_OK;
+            }
+
+            slot = libembd_reassembly_find_internal(reasm, channel);
+            reasm->index[slot] = (uint8)(reasm->free_sessions[--reasm->free_count] + 1u);
+            session = &reasm->sessions[reasm->index[slot] - 1u];
+            session->channel = channel;
+            session->length = length;
+            session->received = 0u;
+            session->sequence = 1u;
+            (void)libembd_start_timer(&session->timer, reasm->timeout);
+            libembd_reassembly_append_internal(reasm, slot, &frame.data[header_length], frame.length - header_length);
+            return E_OK;
+
+        case LIBEMBD_SEGMENT_PCI_CONSECUTIVE_INTERNAL:
+            slot = libembd_reassembly_find_internal(reasm, channel);
+            if(reasm->index[slot] == 0u){
+                return E_NOT_OK;
+            }
+            session = &reasm->sessions[reasm->index[slot] - 1u];
+            if((pci & LIBEMBD_SEGMENT_PCI_NIBBLE_MASK_INTERNAL) != session->sequence){
+                libembd_reassembly_release_internal(reasm, slot);
+                return E_NOT_OK;
+            }
+            session->sequence = (uint8)((session->sequence + 1u) & LIBEMBD_SEGMENT_PCI_NIBBLE_MASK_INTERNAL);
+            libembd_rewind_timer(&session->timer);
+            libembd_reassembly_append_internal(reasm, slot, &frame.data[1], frame.length - 1u);
+            return E_OK;
+
+        default:
+            return E_NOT_OK;
+    }
+}
+
+LIBEMBD_HEADER_API_INLINE uint32 libembd_reassembler_tick(LibEmbd_Reassembler_t *reasm, libembd_timer_duration_ms period)
+{
+    LibEmbd_ReassemblySession_t *session;
+    uint32 dropped = 0u;
+    uint32 i;
+
+    LIBEMBD_ASSUME(reasm != NULL);
+
+    for(i = 0u; i < LIBEMBD_REASSEMBLY_MAX_SESSIONS; i++){
+        session = &reasm->sessions[i];
+        if(!libembd_timer_is_timer_started(&session->timer)){
+            continue; //free
+        }
+        libembd_timer_tick_internal(&session->timer, period);
+        if(libembd_timer_is_timer_stopped(&session->timer)){ //one-shot timer expired
+            libembd_reassembly_release_internal(reasm, libembd_reassembly_find_internal(reasm, session->channel));
+            dropped++;
+        }
+    }
+    return dropped;
+}
+
+LIBEMBD_HEADER_API_INLINE uint32 libembd_reassembler_active_sessions(LibEmbd_Reassembler_t const *reasm)
+{
+    LIBEMBD_ASSUME(reasm != NULL);
+
+    return LIBEMBD_REASSEMBLY_MAX_SESSIONS - reasm->free_count;
+}
+
+#endif /* LIBEMBD_SEGMENTATION_IMPL_H_ */
@@ -0,0 +1,186 @@
+#ifndef LIBEMBD_SG_SERIALIZER_IMPL_H_
+#define LIBEMBD_SG_SERIALIZER_IMPL_H_
+
+#include "libembd/libembd_common.h"
+#include "libembd/libembd_marshalling.h"
+#include "libembd/libembd_sg_serializer.h"
+
+#if defined(__linux__)
+    #include <errno.h>
+    #include <sys/socket.h>
+#endif
+
+struct LibEmbd_SgSerializer_t {
+    LibEmbd_Serializer_t inline_ser; //small fields are serialized here
+    uint32 chunk_start; //start of the currently open inline chunk
+    uint32 iov_count;
+    LibEmbd_Size_t total_length; //bytes described by closed iovecs
+    boolean overflow;
+    LibEmbd_IoVec_t iov[LIBEMBD_SG_MAX_IOVECS];
+};
+
+LIBEMBD_LOCAL_INLINE void libembd_sg_append_iov_internal(LibEmbd_SgSerializer_t *sg, void *base, size_t length)
+{
+    if(sg->iov_count > 0u){
+        LibEmbd_IoVec_t * const last = &sg->iov[sg->iov_count - 1u];
+        if((uint8 *)last->iov_base + last->iov_len == (uint8 *)base){
+            last->iov_len += length; //contiguous with previous chunk, merge
+            sg->total_length += (LibEmbd_Size_t)length;
+            return;
+        }
+    }
+
+    if(LIBEMBD_UNLIKELY(sg->iov_count == LIBEMBD_SG_MAX_IOVECS)){
+        sg->overflow = TRUE;
+        return;
+    }
+
+    sg->iov[sg->iov_count].iov_base = base;
+    sg->iov[sg->iov_count].iov_len = length;
+    sg->iov_count++;
+    sg->total_length += (LibEmbd_Size_t)length;
+}
+
+LIBEMBD_LOCAL_INLINE void libembd_sg_close_chunk_internal(LibEmbd_SgSerializer_t *sg)
+{
+    uint32 const chunk_end = sg->inline_ser.position;
+    if(chunk_end > sg->chunk_start){
+        libembd_sg_append_iov_internal(sg, &sg->inline_ser.buffer[sg->chunk_start], chunk_end - sg->chunk_start);
+    }
+    sg->chunk_start = chunk_end;
+}
+
+LIBEMBD_HEADER_API_INLINE void libembd_make_sg_serializer(LibEmbd_SgSerializer_t *sg, uint8 *inline_buffer, uint32 inline_capacity)
+{
+    LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(sg);
+
+    libembd_make_serializer(&sg->inline_ser, inline_buffer, inline_capacity);
+    sg->chunk_start = 0u;
+    sg->iov_count = 0u;
+    sg->total_length = 0u;
+    sg->overflow = FALSE;
+}
+
+LIBEMBD_HEADER_API_INLINE void libembd_reset_sg_serializer(LibEmbd_SgSerializer_t *sg)
+{
+    LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(sg);
+
+    libembd_reset_serializer(&sg->inline_ser);
+    sg->chunk_start = 0u;
+    sg->iov_count = 0u;
+    sg->total_length = 0u;
+    sg->overflow = FALSE;
+}
+
+LIBEMBD_HEADER_API_INLINE LibEmbd_Serializer_t * libembd_sg_serializer_inline(LibEmbd_SgSerializer_t *sg)
+{
+    return &sg->inline_ser;
+}
+
+LIBEMBD_HEADER_API_INLINE void libembd_sg_put_buffer_ref(LibEmbd_SgSerializer_t *sg, const void *buffer, uint32 buffer_length)
+{
+    if(buffer_length == 0u){
+        return;
+    }
+    libembd_sg_close_chunk_internal(sg);
+    libembd_sg_append_iov_internal(sg, (void *)(uintptr_t)buffer, buffer_length);
+}
+
+LIBEMBD_HEADER_API_INLINE void libembd_sg_put_buffer(LibEmbd_SgSerializer_t *sg, const void *buffer, uint32 buffer_length)
+{
+    if(buffer_length < LIBEMBD_SG_INLINE_COPY_THRESHOLD){
+        libembd_put_buffer_checked(&sg->inline_ser, buffer, buffer_length);
+    } else {
+        libembd_sg_put_buffer_ref(sg, buffer, buffer_length);
+    }
+}
+
+LIBEMBD_HEADER_API_INLINE LibEmbd_IoVec_t const * libembd_sg_serializer_finalize(LibEmbd_SgSerializer_t *sg, uint32 *pCount)
+{
+    libembd_sg_close_chunk_internal(sg);
+    *pCount = sg->iov_count;
+    return sg->iov;
+}
+
+LIBEMBD_HEADER_API_INLINE LibEmbd_Size_t libembd_sg_serializer_total_length(LibEmbd_SgSerializer_t const *sg)
+{
+    return sg->total_length + (sg->inline_ser.position - sg->chunk_start);
+}
+
+LIBEMBD_HEADER_API_INLINE boolean libembd_sg_serializer_has_overflowed(LibEmbd_SgSerializer_t const *sg)
+{
+    return sg->overflow || libembd_serializer_has_overflowed(&sg->inline_ser);
+}
+
+#if defined(__linux__)
+// Skip the bytes already transferred by a partial writev/sendmsg
+LIBEMBD_LOCAL_INLINE void libembd_sg_consume_internal(LibEmbd_IoVec_t **pIov, uint32 *pCount, size_t bytes)
+{
+    LibEmbd_IoVec_t *iov = *pIov;
+    uint32 count = *pCount;
+
+    while((count > 0u) && (bytes >= iov->iov_len)){
+        bytes -= iov->iov_len;
+        iov++;
+        count--;
+    }
+    if(count > 0u){
+        iov->iov_base = (uint8 *)iov->iov_base + bytes;
+        iov->iov_len -= bytes;
+    }
+
+    *pIov = iov;
+    *pCount = count;
+}
+
+LIBEMBD_HEADER_API_INLINE LibEmbd_Std_ReturnType libembd_sg_serializer_writev(LibEmbd_SgSerializer_t *sg, int fd)
+{
+    uint32 count;
+    LibEmbd_IoVec_t *iov = (LibEmbd_IoVec_t *)libembd_sg_serializer_finalize(sg, &count);
+
+    if(libembd_sg_serializer_has_overflowed(sg)){
+        return E_NOT_OK;
+    }
+
+    while(count > 0u){
+        ssize_t const written = writev(fd, iov, (int)count);
+        if(written < 0){
+            if(errno == EINTR){
+                continue;
+            }
+            return E_NOT_OK;
+        }
+        libembd_sg_consume_internal(&iov, &count, (size_t)written);
+    }
+    return E_OK;
+}
+
+LIBEMBD_HEADER_API_INLINE LibEmbd_Std_ReturnType libembd_sg_serializer_sendmsg(LibEmbd_SgSerializer_t *sg, int sockfd, int flags)
+{
+    uint32 count;
+    LibEmbd_IoVec_t *iov = (LibEmbd_IoVec_t *)libembd_sg_serializer_finalize(sg, &count);
+
+    if(libembd_sg_serializer_has_overflowed(sg)){
+        return E_NOT_OK;
+    }
+
+    while(count > 0u){
+        struct msghdr msg;
+        LIBEMBD_MEMSET(&msg, 0, sizeof(msg));
+        msg.msg_iov = iov;
+        msg.msg_iovlen = count;
+
+        ssize_t const sent = sendmsg(sockfd, &msg, flags | MSG_NOSIGNAL);
+        if(sent < 0){
+            if(errno == EINTR){
+                continue;
+            }
+            return E_NOT_OK;
+        }
+        libembd_sg_consume_internal(&iov, &count, (size_t)sent);
+    }
+    return E_OK;
+}
+#endif
+
+#endif /* LIBEMBD_SG_SERIALIZER_IMPL_H_ */
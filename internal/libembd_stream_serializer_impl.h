@@ -0,0 +1,299 @@
+#ifndef LIBEMBD_STREAM_SERIALIZER_IMPL_H_
+#define LIBEMBD_STREAM_SERIALIZER_IMPL_H_
+
+#include "libembd/libembd_common.h"
+#include "libembd/libembd_util.h"
+#include "libembd/libembd_marshalling.h"
+#include "libembd/libembd_stream_serializer.h"
+
+struct LibEmbd_StreamSerializer_t {
+    LibEmbd_Serializer_t staging; //fields are serialized here until the sink is invoked
+    libembd_stream_sink_t sink;
+    void *context;
+    LibEmbd_Size_t flushed; //bytes handed to the sink so far
+    boolean error;
+};
+
+struct LibEmbd_StreamDeserializer_t {
+    LibEmbd_Deserializer_t staging; //capacity is the fill level of storage
+    uint8 *storage;
+    uint32 storage_capacity;
+    libembd_stream_source_t source;
+    void *context;
+    LibEmbd_Size_t consumed; //bytes consumed before the current staging content
+    boolean error;
+};
+
+/*-------------------------------------------------------------Internal functions Begin---------------------------------------------------------------------------*/
+
+LIBEMBD_LOCAL_INLINE void libembd_stream_flush_internal(LibEmbd_StreamSerializer_t *sser)
+{
+    uint32 const pending = sser->staging.position;
+    if(pending > 0u){
+        if(!sser->error){
+            if(sser->sink(sser->context, sser->staging.buffer, pending) == E_OK){
+                sser->flushed += pending;
+            } else {
+                sser->error = TRUE; //output is discarded from now on
+            }
+        }
+        sser->staging.position = 0u;
+    }
+}
+
+// Copies length bytes into the staging buffer, flushing whenever it fills up
+LIBEMBD_LOCAL_INLINE void libembd_stream_write_internal(LibEmbd_StreamSerializer_t *sser, uint8 const *data, uint32 length)
+{
+    while(length > 0u){
+        uint32 const room = sser->staging.capacity - sser->staging.position;
+        uint32 chunk;
+        if(room == 0u){
+            libembd_stream_flush_internal(sser);
+            continue;
+        }
+        chunk = LIBEMBD_MIN(room, length);
+        LIBEMBD_MEMCPY(&sser->staging.buffer[sser->staging.position], data, chunk);
+        sser->staging.position += chunk;
+        data += chunk;
+        length -= chunk;
+    }
+}
+
+// Makes at least size unread bytes contiguous in the staging buffer, size must not exceed the storage capacity
+LIBEMBD_LOCAL_INLINE boolean libembd_stream_refill_internal(LibEmbd_StreamDeserializer_t *sdeser, uint32 size)
+{
+    uint32 const unread = sdeser->staging.capacity - sdeser->staging.position;
+    uint32 fill = unread;
+
+    if(sdeser->error){
+        return FALSE;
+    }
+
+    if(sdeser->staging.position > 0u){
+        LIBEMBD_MEMMOVE(sdeser->storage, &sdeser->storage[sdeser->staging.position], unread);
+        sdeser->consumed += sdeser->staging.position;
+        sdeser->staging.position = 0u;
+    }
+
+    while(fill < size){
+        uint32 const got = sdeser->source(sdeser->context, &sdeser->storage[fill], sdeser->storage_capacity - fill);
+        if(got == 0u){
+            break;
+        }
+        fill += got;
+    }
+    sdeser->staging.capacity = fill;
+    return (fill >= size);
+}
+
+// Copies up to length bytes out of the stream, returns the number of bytes copied
+LIBEMBD_LOCAL_INLINE uint32 libembd_stream_read_internal(LibEmbd_StreamDeserializer_t *sdeser, uint8 *data, uint32 length)
+{
+    uint32 copied = 0u;
+    while(copied < length){
+        uint32 const unread = sdeser->staging.capacity - sdeser->staging.position;
+        uint32 chunk;
+        if(unread == 0u){
+            if(!libembd_stream_refill_internal(sdeser, 1u)){
+                sdeser->error = TRUE;
+                break;
+            }
+            continue;
+        }
+        chunk = LIBEMBD_MIN(unread, length - copied);
+        LIBEMBD_MEMCPY(&data[copied], &sdeser->staging.buffer[sdeser->staging.position], chunk);
+        sdeser->staging.position += chunk;
+        copied += chunk;
+    }
+    return copied;
+}
+
+/*-------------------------------------------------------------Internal Functions End-----------------------------------------------------------------------------*/
+
+LIBEMBD_HEADER_API_INLINE void libembd_make_stream_serializer(LibEmbd_StreamSerializer_t *sser, uint8 *staging, uint32 capacity,
+                                                              libembd_stream_sink_t sink, void *context)
+{
+    LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(sser);
+    LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(sink);
+    LIBEMBD_ASSUME(capacity > 0u);
+
+    libembd_make_serializer(&sser->staging, staging, capacity);
+    sser->sink = sink;
+    sser->context = context;
+    sser->flushed = 0u;
+    sser->error = FALSE;
+}
+
+// Values that do not fit the remaining staging space are encoded into scratch space and split across the flush
+#define LIBEMBD_STREAM_PUT_IMPLEMENTATION(TYPE, NAME) \
+    LIBEMBD_HEADER_API_INLINE void libembd_stream_put_##NAME(LibEmbd_StreamSerializer_t *sser, TYPE value) { \
+        if(LIBEMBD_LIKELY(sser->staging.capacity - sser->staging.position >= sizeof(TYPE))) { \
+            libembd_put_##NAME##_unsafe(&sser->staging, value); \
+        } else { \
+            uint8 scratch[sizeof(TYPE)]; \
+            LibEmbd_Serializer_t scratch_ser; \
+            libembd_make_serializer(&scratch_ser, scratch, sizeof(scratch)); \
+            libembd_put_##NAME##_unsafe(&scratch_ser, value); \
+            libembd_stream_write_internal(sser, scratch, sizeof(scratch)); \
+        } \
+    }
+
+LIBEMBD_STREAM_PUT_IMPLEMENTATION(uint8, uint8)
+LIBEMBD_STREAM_PUT_IMPLEMENTATION(sint8, sint8)
+LIBEMBD_STREAM_PUT_IMPLEMENTATION(uint16, uint16_to_network)
+LIBEMBD_STREAM_PUT_IMPLEMENTATION(uint32, uint32_to_network)
+LIBEMBD_STREAM_PUT_IMPLEMENTATION(uint64, uint64_to_network)
+LIBEMBD_STREAM_PUT_IMPLEMENTATION(sint16, sint16_to_network)
+LIBEMBD_STREAM_PUT_IMPLEMENTATION(sint32, sint32_to_network)
+LIBEMBD_STREAM_PUT_IMPLEMENTATION(sint64, sint64_to_network)
+LIBEMBD_STREAM_PUT_IMPLEMENTATION(float32, float32_to_network)
+LIBEMBD_STREAM_PUT_IMPLEMENTATION(float64, float64_to_network)
+LIBEMBD_STREAM_PUT_IMPLEMENTATION(uint16, uint16_to_host)
+LIBEMBD_STREAM_PUT_IMPLEMENTATION(uint32, uint32_to_host)
+LIBEMBD_STREAM_PUT_IMPLEMENTATION(uint64, uint64_to_host)
+LIBEMBD_STREAM_PUT_IMPLEMENTATION(sint16, sint16_to_host)
+LIBEMBD_STREAM_PUT_IMPLEMENTATION(sint32, sint32_to_host)
+LIBEMBD_STREAM_PUT_IMPLEMENTATION(sint64, sint64_to_host)
+LIBEMBD_STREAM_PUT_IMPLEMENTATION(float32, float32_to_host)
+LIBEMBD_STREAM_PUT_IMPLEMENTATION(float64, float64_to_host)
+
+LIBEMBD_HEADER_API_INLINE void libembd_stream_put_buffer(LibEmbd_StreamSerializer_t *sser, const void *buffer, uint32 buffer_length)
+{
+    LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(sser);
+
+    if(buffer_length < sser->staging.capacity){
+        libembd_stream_write_internal(sser, (uint8 const *)buffer, buffer_length);
+        return;
+    }
+
+    // large payload, bypass the staging buffer
+    libembd_stream_flush_internal(sser);
+    if(!sser->error){
+        if(sser->sink(sser->context, (uint8 const *)buffer, buffer_length) == E_OK){
+            sser->flushed += buffer_length;
+        } else {
+            sser->error = TRUE;
+        }
+    }
+}
+
+LIBEMBD_HEADER_API_INLINE LibEmbd_Serializer_t * libembd_stream_serializer_reserve(LibEmbd_StreamSerializer_t *sser, uint32 size)
+{
+    if(LIBEMBD_UNLIKELY(size > sser->staging.capacity)){
+        sser->error = TRUE; //the field can never be written, the stream would silently miss it
+        return NULL;
+    }
+    if(sser->staging.capacity - sser->staging.position < size){
+        libembd_stream_flush_internal(sser);
+    }
+    return &sser->staging;
+}
+
+LIBEMBD_HEADER_API_INLINE LibEmbd_Std_ReturnType libembd_stream_serializer_flush(LibEmbd_StreamSerializer_t *sser)
+{
+    libembd_stream_flush_internal(sser);
+    return sser->error ? E_NOT_OK : E_OK;
+}
+
+LIBEMBD_HEADER_API_INLINE LibEmbd_Size_t libembd_stream_serializer_total_length(LibEmbd_StreamSerializer_t const *sser)
+{
+    return sser->flushed + sser->staging.position;
+}
+
+LIBEMBD_HEADER_API_INLINE boolean libembd_stream_serializer_has_failed(LibEmbd_StreamSerializer_t const *sser)
+{
+    return sser->error;
+}
+
+LIBEMBD_HEADER_API_INLINE void libembd_make_stream_deserializer(LibEmbd_StreamDeserializer_t *sdeser, uint8 *staging, uint32 capacity,
+                                                                libembd_stream_source_t source, void *context)
+{
+    LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(sdeser);
+    LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(source);
+    LIBEMBD_ASSUME(capacity > 0u);
+
+    libembd_make_deserializer(&sdeser->staging, staging, 0u); //empty until the first refill
+    sdeser->storage = staging;
+    sdeser->storage_capacity = capacity;
+    sdeser->source = source;
+    sdeser->context = context;
+    sdeser->consumed = 0u;
+    sdeser->error = FALSE;
+}
+
+// Values that straddle the end of the staged input are assembled in scratch space across the refill
+#define LIBEMBD_STREAM_GET_IMPLEMENTATION(TYPE, NAME) \
+    LIBEMBD_HEADER_API_INLINE void libembd_stream_get_##NAME(LibEmbd_StreamDeserializer_t *sdeser, TYPE *value) { \
+        LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(value); \
+        if(LIBEMBD_LIKELY(sdeser->staging.capacity - sdeser->staging.position >= sizeof(TYPE))) { \
+            libembd_get_##NAME##_unsafe(&sdeser->staging, value); \
+        } else { \
+            uint8 scratch[sizeof(TYPE)]; \
+            if(libembd_stream_read_internal(sdeser, scratch, sizeof(scratch)) == sizeof(scratch)) { \
+                LibEmbd_Deserializer_t scratch_deser; \
+                libembd_make_deserializer(&scratch_deser, scratch, sizeof(scratch)); \
+                libembd_get_##NAME##_unsafe(&scratch_deser, value); \
+            } else { \
+                LIBEMBD_MEMSET(value, 0, sizeof(*value)); \
+            } \
+        } \
+    }
+
+LIBEMBD_STREAM_GET_IMPLEMENTATION(uint8, uint8)
+LIBEMBD_STREAM_GET_IMPLEMENTATION(sint8, sint8)
+LIBEMBD_STREAM_GET_IMPLEMENTATION(uint16, uint16_from_network)
+LIBEMBD_STREAM_GET_IMPLEMENTATION(uint32, uint32_from_network)
+LIBEMBD_STREAM_GET_IMPLEMENTATION(uint64, uint64_from_network)
+LIBEMBD_STREAM_GET_IMPLEMENTATION(sint16, sint16_from_network)
+LIBEMBD_STREAM_GET_IMPLEMENTATION(sint32, sint32_from_network)
+LIBEMBD_STREAM_GET_IMPLEMENTATION(sint64, sint64_from_network)
+LIBEMBD_STREAM_GET_IMPLEMENTATION(float32, float32_from_network)
+LIBEMBD_STREAM_GET_IMPLEMENTATION(float64, float64_from_network)
+LIBEMBD_STREAM_GET_IMPLEMENTATION(uint16, uint16_from_host)
+LIBEMBD_STREAM_GET_IMPLEMENTATION(uint32, uint32_from_host)
+LIBEMBD_STREAM_GET_IMPLEMENTATION(uint64, uint64_from_host)
+LIBEMBD_STREAM_GET_IMPLEMENTATION(sint16, sint16_from_host)
+LIBEMBD_STREAM_GET_IMPLEMENTATION(sint32, sint32_from_host)
+LIBEMBD_STREAM_GET_IMPLEMENTATION(sint64, sint64_from_host)
+LIBEMBD_STREAM_GET_IMPLEMENTATION(float32, float32_from_host)
+LIBEMBD_STREAM_GET_IMPLEMENTATION(float64, float64_from_host)
+
+LIBEMBD_HEADER_API_INLINE uint32 libembd_stream_get_buffer(LibEmbd_StreamDeserializer_t *sdeser, void *buffer, uint32 length)
+{
+    LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(sdeser);
+    LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(buffer);
+
+    return libembd_stream_read_internal(sdeser, (uint8 *)buffer, length);
+}
+
+LIBEMBD_HEADER_API_INLINE LibEmbd_Deserializer_t * libembd_stream_deserializer_reserve(LibEmbd_StreamDeserializer_t *sdeser, uint32 size)
+{
+    if(LIBEMBD_LIKELY(sdeser->staging.capacity - sdeser->staging.position >= size)){
+        return &sdeser->staging;
+    }
+    if(LIBEMBD_UNLIKELY((size > sdeser->storage_capacity) || !libembd_stream_refill_internal(sdeser, size))){
+        sdeser->error = TRUE;
+        return NULL;
+    }
+    return &sdeser->staging;
+}
+
+LIBEMBD_HEADER_API_INLINE boolean libembd_stream_deserializer_at_end(LibEmbd_StreamDeserializer_t *sdeser)
+{
+    if(sdeser->staging.capacity != sdeser->staging.position){
+        return FALSE;
+    }
+    return !libembd_stream_refill_internal(sdeser, 1u);
+}
+
+LIBEMBD_HEADER_API_INLINE LibEmbd_Size_t libembd_stream_deserializer_total_length(LibEmbd_StreamDeserializer_t const *sdeser)
+{
+    return sdeser->consumed + sdeser->staging.position;
+}
+
+LIBEMBD_HEADER_API_INLINE boolean libembd_stream_deserializer_has_failed(LibEmbd_StreamDeserializer_t const *sdeser)
+{
+    return sdeser->error;
+}
+
+#endif /* LIBEMBD_STREAM_SERIALIZER_IMPL_H_ */
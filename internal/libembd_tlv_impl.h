@@ -0,0 +1,188 @@
+#ifndef LIBEMBD_TLV_IMPL_H_
+#define LIBEMBD_TLV_IMPL_H_
+
+#include "libembd/libembd_common.h"
+#include "libembd/libembd_util.h"
+#include "libembd/libembd_marshalling.h"
+#include "libembd/libembd_tlv.h"
+
+struct LibEmbd_TlvBuilder_t {
+    LibEmbd_Serializer_t *ser;
+    uint32 depth; //keeps counting past LIBEMBD_TLV_MAX_DEPTH so that begin/end stay balanced after an error
+    boolean error;
+    uint32 length_slot[LIBEMBD_TLV_MAX_DEPTH]; //positions of the reserved length fields of the open fields
+};
+
+LIBEMBD_STATIC_ASSERT(LIBEMBD_IS_POWER_OF_TWO(LIBEMBD_TLV_INDEX_CAPACITY), "TLV index capacity must be a power of two!");
+
+typedef struct {
+    uint16 tag;
+    uint16 length;
+    uint16 offset; //offset of the value within the message, 0 marks an empty slot
+} LibEmbd_TlvIndexEntry_t;
+
+struct LibEmbd_TlvIndex_t {
+    uint8 const *message;
+    uint32 count;
+    LibEmbd_TlvIndexEntry_t entries[LIBEMBD_TLV_INDEX_CAPACITY];
+};
+
+/*-------------------------------------------------------------Internal functions Begin---------------------------------------------------------------------------*/
+
+// Identity for tags below the capacity, so small tag spaces behave like a direct-mapped table
+LIBEMBD_LOCAL_INLINE uint32 libembd_tlv_index_slot_internal(uint16 tag)
+{
+    return ((uint32)tag ^ ((uint32)tag / LIBEMBD_TLV_INDEX_CAPACITY)) & (LIBEMBD_TLV_INDEX_CAPACITY - 1u);
+}
+
+LIBEMBD_LOCAL_INLINE uint16 libembd_tlv_load_u16_internal(uint8 const *src)
+{
+    return (uint16)(((uint16)src[0] << 8u) | src[1]);
+}
+
+/*-------------------------------------------------------------Internal Functions End-----------------------------------------------------------------------------*/
+
+LIBEMBD_HEADER_API_INLINE void libembd_make_tlv_builder(LibEmbd_TlvBuilder_t *tlv, LibEmbd_Serializer_t *ser)
+{
+    LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(tlv);
+    LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(ser);
+
+    tlv->ser = ser;
+    tlv->depth = 0u;
+    tlv->error = FALSE;
+}
+
+LIBEMBD_HEADER_API_INLINE void libembd_tlv_begin_field(LibEmbd_TlvBuilder_t *tlv, uint16 tag)
+{
+    LibEmbd_Serializer_t * const ser = tlv->ser;
+
+    if(LIBEMBD_UNLIKELY(tlv->depth >= LIBEMBD_TLV_MAX_DEPTH)){
+        tlv->error = TRUE;
+    } else if(libembd_serializer_reserve(ser, LIBEMBD_TLV_HEADER_SIZE)){
+        libembd_put_uint16_to_network_unsafe(ser, tag);
+        tlv->length_slot[tlv->depth] = ser->position;
+        ser->position += sizeof(uint16); //patched by end_field
+    }
+    tlv->depth++;
+}
+
+LIBEMBD_HEADER_API_INLINE void libembd_tlv_end_field(LibEmbd_TlvBuilder_t *tlv)
+{
+    LibEmbd_Serializer_t * const ser = tlv->ser;
+    uint32 slot;
+    uint32 length;
+
+    if(LIBEMBD_UNLIKELY(tlv->depth == 0u)){
+        tlv->error = TRUE;
+        return;
+    }
+    tlv->depth--;
+
+    if(tlv->error || ser->overflow){
+        return; //length slot is unreliable, the message is unusable anyway
+    }
+
+    slot = tlv->length_slot[tlv->depth];
+    length = ser->position - (slot + sizeof(uint16));
+    if(LIBEMBD_UNLIKELY(length > LIBEMBD_TLV_MAX_VALUE_LENGTH)){
+        tlv->error = TRUE;
+        return;
+    }
+    libembd_write_uint16_to_network_unsafe(ser, slot, (uint16)length);
+}
+
+LIBEMBD_HEADER_API_INLINE void libembd_tlv_put_field(LibEmbd_TlvBuilder_t *tlv, uint16 tag, const void *value, uint16 length)
+{
+    LibEmbd_Serializer_t * const ser = tlv->ser;
+
+    if(libembd_serializer_reserve(ser, LIBEMBD_TLV_HEADER_SIZE + (uint32)length)){
+        libembd_put_uint16_to_network_unsafe(ser, tag);
+        libembd_put_uint16_to_network_unsafe(ser, length);
+        libembd_put_buffer_unsafe(ser, value, length);
+    }
+}
+
+LIBEMBD_HEADER_API_INLINE uint32 libembd_tlv_depth(LibEmbd_TlvBuilder_t const *tlv)
+{
+    return tlv->depth;
+}
+
+LIBEMBD_HEADER_API_INLINE boolean libembd_tlv_builder_has_failed(LibEmbd_TlvBuilder_t const *tlv)
+{
+    return tlv->error || tlv->ser->overflow;
+}
+
+LIBEMBD_HEADER_API_INLINE LibEmbd_Std_ReturnType libembd_tlv_index_build(LibEmbd_TlvIndex_t *index, LibEmbd_ConstBufferView_t message)
+{
+    LibEmbd_Std_ReturnType ret = E_OK;
+    uint32 position = 0u;
+
+    LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(index);
+
+    LIBEMBD_MEMSET(index->entries, 0, sizeof(index->entries));
+    index->message = message.data;
+    index->count = 0u;
+
+    while((ret == E_OK) && (position < message.length)){
+        uint16 tag;
+        uint16 length;
+        uint32 slot;
+
+        if(LIBEMBD_UNLIKELY(message.length - position < LIBEMBD_TLV_HEADER_SIZE)){
+            ret = E_NOT_OK; //truncated header
+            continue;
+        }
+        tag = libembd_tlv_load_u16_internal(&message.data[position]);
+        length = libembd_tlv_load_u16_internal(&message.data[position + sizeof(uint16)]);
+        position += LIBEMBD_TLV_HEADER_SIZE;
+        if(LIBEMBD_UNLIKELY(length > message.length - position)){
+            ret = E_NOT_OK; //value exceeds the message
+            continue;
+        }
+
+        slot = libembd_tlv_index_slot_internal(tag);
+        while((index->entries[slot].offset != 0u) && (index->entries[slot].tag != tag)){
+            slot = (slot + 1u) & (LIBEMBD_TLV_INDEX_CAPACITY - 1u);
+        }
+        if(index->entries[slot].offset == 0u){
+            if(LIBEMBD_UNLIKELY(index->count == LIBEMBD_TLV_INDEX_CAPACITY - 1u)){
+                ret = E_NOT_OK; //one slot always stays free so that probing terminates
+                continue;
+            }
+            index->entries[slot].tag = tag;
+            index->entries[slot].length = length;
+            index->entries[slot].offset = (uint16)position;
+            index->count++;
+        }
+        position += length;
+    }
+
+    if(ret != E_OK){
+        LIBEMBD_MEMSET(index->entries, 0, sizeof(index->entries));
+        index->count = 0u;
+    }
+    return ret;
+}
+
+LIBEMBD_HEADER_API_INLINE LibEmbd_ConstBufferView_t libembd_tlv_index_find(LibEmbd_TlvIndex_t const *index, uint16 tag)
+{
+    LibEmbd_ConstBufferView_t view = { NULL, 0u };
+    uint32 slot = libembd_tlv_index_slot_internal(tag);
+
+    while(index->entries[slot].offset != 0u){
+        if(index->entries[slot].tag == tag){
+            view.data = &index->message[index->entries[slot].offset];
+            view.length = index->entries[slot].length;
+            break;
+        }
+        slot = (slot + 1u) & (LIBEMBD_TLV_INDEX_CAPACITY - 1u);
+    }
+    return view;
+}
+
+LIBEMBD_HEADER_API_INLINE uint32 libembd_tlv_index_count(LibEmbd_TlvIndex_t const *index)
+{
+    return index->count;
+}
+
+#endif /* LIBEMBD_TLV_IMPL_H_ */
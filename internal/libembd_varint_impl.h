@@ -0,0 +1,239 @@
+#ifndef LIBEMBD_VARINT_IMPL_H_
+#define LIBEMBD_VARINT_IMPL_H_
+
+#include "libembd/libembd_common.h"
+#include "libembd/libembd_util.h"
+#include "libembd/libembd_marshalling.h"
+#include "libembd/libembd_varint.h"
+
+#if defined(__BMI2__)
+    #include <immintrin.h>
+#endif
+
+#define LIBEMBD_VARINT_CONTINUATION_BITS    0x8080808080808080ull
+#define LIBEMBD_VARINT_PAYLOAD_BITS         0x7F7F7F7F7F7F7F7Full
+
+/*-------------------------------------------------------------Internal functions Begin---------------------------------------------------------------------------*/
+
+// Encodes value to dst, returns number of bytes written
+LIBEMBD_LOCAL_INLINE uint32 libembd_varint_encode_internal(uint8 *dst, uint64 value)
+{
+    uint32 n = 0u;
+    while(value >= 0x80u){
+        dst[n++] = (uint8)(value | 0x80u);
+        value >>= 7u;
+    }
+    dst[n++] = (uint8)value;
+    return n;
+}
+
+// Byte-wise decoder, returns encoded length or 0 if input is truncated or longer than max_bytes
+LIBEMBD_LOCAL_INLINE uint32 libembd_varint_decode_scalar_internal(uint8 const *src, uint32 avail, uint32 max_bytes, uint64 *pValue)
+{
+    uint32 const limit = LIBEMBD_MIN(avail, max_bytes);
+    uint64 result = 0u;
+    uint32 i;
+
+    for(i = 0u; i < limit; i++){
+        uint8 const byte = src[i];
+        result |= (uint64)(byte & 0x7Fu) << (7u * i);
+        if((byte & 0x80u) == 0u){
+            // the 10th byte of a 64-bit value may only carry the topmost bit
+            if(LIBEMBD_UNLIKELY((i == 9u) && (byte > 1u))){
+                return 0u;
+            }
+            *pValue = result;
+            return i + 1u;
+        }
+    }
+    return 0u;
+}
+
+// Word-at-a-time decoder for encodings up to 8 bytes, falls back to the byte-wise decoder otherwise
+LIBEMBD_LOCAL_INLINE uint32 libembd_varint_decode_internal(uint8 const *src, uint32 avail, uint32 max_bytes, uint64 *pValue)
+{
+    if(LIBEMBD_LIKELY(avail >= sizeof(uint64))){
+        uint64 word;
+        uint64 stop;
+
+        LIBEMBD_MEMCPY(&word, src, sizeof(word));
+#if (LIBEMBD_HOST_ENDIANNESS == LIBEMBD_ENDIANNESS_BIG_ENDIAN)
+        word = LIBEMBD_BSWAP64(word);
+#endif
+        stop = ~word & LIBEMBD_VARINT_CONTINUATION_BITS;
+        if(LIBEMBD_LIKELY(stop != 0u)){
+            uint32 const length = (LIBEMBD_CTZ64(stop) >> 3u) + 1u;
+            if(LIBEMBD_UNLIKELY(length > max_bytes)){
+                return 0u;
+            }
+            word &= (stop ^ (stop - 1u)) & LIBEMBD_VARINT_PAYLOAD_BITS; //drop bytes after the last one and the continuation bits
+#if defined(__BMI2__)
+            *pValue = _pext_u64(word, LIBEMBD_VARINT_PAYLOAD_BITS);
+#else
+            word = ((word & 0x7F007F007F007F00ull) >> 1u) | (word & 0x007F007F007F007Full);
+            word = ((word & 0x3FFF00003FFF0000ull) >> 2u) | (word & 0x00003FFF00003FFFull);
+            word = ((word & 0x0FFFFFFF00000000ull) >> 4u) | (word & 0x000000000FFFFFFFull);
+            *pValue = word;
+#endif
+            return length;
+        }
+    }
+    return libembd_varint_decode_scalar_internal(src, avail, max_bytes, pValue);
+}
+
+/*-------------------------------------------------------------Internal Functions End-----------------------------------------------------------------------------*/
+
+LIBEMBD_HEADER_API_INLINE uint16 libembd_zigzag_encode16(sint16 value)
+{
+    return (uint16)(((uint16)value << 1u) ^ (uint16)(value >> 15));
+}
+
+LIBEMBD_HEADER_API_INLINE uint32 libembd_zigzag_encode32(sint32 value)
+{
+    return ((uint32)value << 1u) ^ (uint32)(value >> 31);
+}
+
+LIBEMBD_HEADER_API_INLINE uint64 libembd_zigzag_encode64(sint64 value)
+{
+    return ((uint64)value << 1u) ^ (uint64)(value >> 63);
+}
+
+LIBEMBD_HEADER_API_INLINE sint16 libembd_zigzag_decode16(uint16 value)
+{
+    return (sint16)((uint16)(value >> 1u) ^ (uint16)(0u - (value & 1u)));
+}
+
+LIBEMBD_HEADER_API_INLINE sint32 libembd_zigzag_decode32(uint32 value)
+{
+    return (sint32)((value >> 1u) ^ (0u - (value & 1u)));
+}
+
+LIBEMBD_HEADER_API_INLINE sint64 libembd_zigzag_decode64(uint64 value)
+{
+    return (sint64)((value >> 1u) ^ (0u - (value & 1u)));
+}
+
+LIBEMBD_HEADER_API_INLINE uint32 libembd_varint_size(uint64 value)
+{
+    return (70u - LIBEMBD_CLZ64(value | 1u)) / 7u;
+}
+
+#define LIBEMBD_VARINT_IMPLEMENTATION(BITS, UTYPE, STYPE, MAX_VALUE) \
+    LIBEMBD_HEADER_API_INLINE void libembd_put_varuint##BITS##_unsafe(LibEmbd_Serializer_t *ser, UTYPE host_value) { \
+        LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(ser); \
+        LIBEMBD_MARSHALLING_ASSERT_NO_OVERFLOW(ser, libembd_varint_size(host_value)); \
+        ser->position += libembd_varint_encode_internal(&ser->buffer[ser->position], host_value); \
+    } \
+    LIBEMBD_HEADER_API_INLINE void libembd_put_varsint##BITS##_unsafe(LibEmbd_Serializer_t *ser, STYPE host_value) { \
+        libembd_put_varuint##BITS##_unsafe(ser, libembd_zigzag_encode##BITS(host_value)); \
+    } \
+    LIBEMBD_HEADER_API_INLINE void libembd_put_varuint##BITS##_checked(LibEmbd_Serializer_t *ser, UTYPE host_value) { \
+        if(libembd_serializer_reserve(ser, libembd_varint_size(host_value))) { \
+            ser->position += libembd_varint_encode_internal(&ser->buffer[ser->position], host_value); \
+        } \
+    } \
+    LIBEMBD_HEADER_API_INLINE void libembd_put_varsint##BITS##_checked(LibEmbd_Serializer_t *ser, STYPE host_value) { \
+        libembd_put_varuint##BITS##_checked(ser, libembd_zigzag_encode##BITS(host_value)); \
+    } \
+    LIBEMBD_HEADER_API_INLINE void libembd_get_varuint##BITS##_unsafe(LibEmbd_Deserializer_t *deser, UTYPE *value) { \
+        uint64 decoded = 0u; \
+        LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(deser); \
+        LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(value); \
+        uint32 const length = libembd_varint_decode_internal(&deser->buffer[deser->position], \
+            deser->capacity - deser->position, LIBEMBD_VARINT_MAX_SIZE_##BITS, &decoded); \
+        LIBEMBD_ASSUME(length != 0u); \
+        deser->position += length; \
+        *value = (UTYPE)decoded; \
+    } \
+    LIBEMBD_HEADER_API_INLINE void libembd_get_varsint##BITS##_unsafe(LibEmbd_Deserializer_t *deser, STYPE *value) { \
+        UTYPE raw; \
+        libembd_get_varuint##BITS##_unsafe(deser, &raw); \
+        *value = libembd_zigzag_decode##BITS(raw); \
+    } \
+    LIBEMBD_HEADER_API_INLINE void libembd_get_varuint##BITS##_checked(LibEmbd_Deserializer_t *deser, UTYPE *value) { \
+        uint64 decoded = 0u; \
+        uint32 length = 0u; \
+        LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(deser); \
+        LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(value); \
+        if(!deser->overflow) { \
+            length = libembd_varint_decode_internal(&deser->buffer[deser->position], \
+                deser->capacity - deser->position, LIBEMBD_VARINT_MAX_SIZE_##BITS, &decoded); \
+        } \
+        if(LIBEMBD_UNLIKELY((length == 0u) || (decoded > (MAX_VALUE)))) { \
+            deser->overflow = TRUE; \
+            *value = 0u; \
+            return; \
+        } \
+        deser->position += length; \
+        *value = (UTYPE)decoded; \
+    } \
+    LIBEMBD_HEADER_API_INLINE void libembd_get_varsint##BITS##_checked(LibEmbd_Deserializer_t *deser, STYPE *value) { \
+        UTYPE raw; \
+        libembd_get_varuint##BITS##_checked(deser, &raw); \
+        *value = libembd_zigzag_decode##BITS(raw); \
+    }
+
+LIBEMBD_VARINT_IMPLEMENTATION(16, uint16, sint16, 0xFFFFull)
+LIBEMBD_VARINT_IMPLEMENTATION(32, uint32, sint32, 0xFFFFFFFFull)
+LIBEMBD_VARINT_IMPLEMENTATION(64, uint64, sint64, 0xFFFFFFFFFFFFFFFFull)
+
+LIBEMBD_HEADER_API_INLINE void libembd_put_varuint32_array_checked(LibEmbd_Serializer_t *ser, uint32 const *values, uint32 count)
+{
+    uint32 total = 0u;
+    uint32 i;
+
+    LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(values);
+
+    if(LIBEMBD_UNLIKELY(count > UINT32_MAX / LIBEMBD_VARINT_MAX_SIZE_32)){
+        ser->overflow = TRUE;
+        return;
+    }
+
+    for(i = 0u; i < count; i++){
+        total += libembd_varint_size(values[i]);
+    }
+
+    if(libembd_serializer_reserve(ser, total)){
+        uint8 *dst = &ser->buffer[ser->position];
+        for(i = 0u; i < count; i++){
+            dst += libembd_varint_encode_internal(dst, values[i]);
+        }
+        ser->position += total;
+    }
+}
+
+LIBEMBD_HEADER_API_INLINE uint32 libembd_get_varuint32_array_checked(LibEmbd_Deserializer_t *deser, uint32 *values, uint32 count)
+{
+    uint32 i;
+
+    LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(deser);
+    LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(values);
+
+    if(LIBEMBD_UNLIKELY(deser->overflow)){
+        LIBEMBD_MEMSET(values, 0, count * sizeof(*values));
+        return 0u;
+    }
+
+    {
+        uint8 const * const base = deser->buffer;
+        uint32 position = deser->position;
+        uint32 const capacity = deser->capacity;
+
+        for(i = 0u; i < count; i++){
+            uint64 decoded = 0u;
+            uint32 const length = libembd_varint_decode_internal(&base[position], capacity - position,
+                                                                 LIBEMBD_VARINT_MAX_SIZE_32, &decoded);
+            if(LIBEMBD_UNLIKELY((length == 0u) || (decoded > 0xFFFFFFFFull))){
+                deser->overflow = TRUE;
+                LIBEMBD_MEMSET(&values[i], 0, (count - i) * sizeof(*values));
+                break;
+            }
+            values[i] = (uint32)decoded;
+            position += length;
+        }
+        deser->position = position;
+    }
+    return i;
+}
+
+#endif /* LIBEMBD_VARINT_IMPL_H_ */
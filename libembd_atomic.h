@@ -152,6 +152,12 @@ LIBEMBD_HEADER_API_INLINE boolean LIBEMBD_ATTR_ALWAYS_INLINE libembd_atomic_comp
 LIBEMBD_HEADER_API_INLINE boolean LIBEMBD_ATTR_ALWAYS_INLINE libembd_atomic_compare_exchange_weak_uint32(libembd_atomic_uint32_t * ptr, uint32* pExepcted, uint32 desired);
 LIBEMBD_HEADER_API_INLINE boolean LIBEMBD_ATTR_ALWAYS_INLINE libembd_atomic_compare_exchange_strong_uint32(libembd_atomic_uint32_t * ptr, uint32* pExepcted, uint32 desired);
 
+// Atomically adds val and returns the previous value, full barrier on both sides
+LIBEMBD_HEADER_API_INLINE uint32 LIBEMBD_ATTR_ALWAYS_INLINE libembd_atomic_fetch_add_uint32(libembd_atomic_uint32_t * ptr, uint32 const val);
+
+// Orders plain memory accesses around it (mimicking C11 atomic_thread_fence)
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_atomic_thread_fence(libembd_memory_order order);
+
 #define LIBEMBD_ATOMIC_OP_IMPLEMENTATION(type) \
     LIBEMBD_HEADER_API_INLINE type libembd_atomic_load_##type(LIBEMBD_ATOMIC_TYPE(type) const * ptr) { \
         __libembd_memory_barrier_default_internal();\
@@ -216,6 +222,23 @@ LIBEMBD_ATOMIC_OP_EXPLICIT_IMPLEMENTATION(uint8)
 LIBEMBD_ATOMIC_OP_EXPLICIT_IMPLEMENTATION(uint16)
 LIBEMBD_ATOMIC_OP_EXPLICIT_IMPLEMENTATION(uint32)
 
+LIBEMBD_HEADER_API_INLINE uint32 libembd_atomic_fetch_add_uint32(libembd_atomic_uint32_t * ptr, uint32 const val)
+{
+    uint32 old_val;
+    __libembd_memory_barrier_default_internal();
+    // exclusives even on a single core, producers on the same core may preempt each other between load and store
+    do{
+        old_val = __LDREX(&ptr->value);
+    } while(__STREX(old_val + val, &ptr->value) != 0);
+    __libembd_memory_barrier_default_internal();
+    return old_val;
+}
+
+LIBEMBD_HEADER_API_INLINE void libembd_atomic_thread_fence(libembd_memory_order order)
+{
+    __libembd_memory_barrier_internal(order);
+}
+
 // Atomic flag type
 typedef struct {
     volatile uint8 flag;
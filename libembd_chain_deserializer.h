@@ -0,0 +1,140 @@
+#ifndef LIBEMBD_CHAIN_DESERIALIZER_H_
+#define LIBEMBD_CHAIN_DESERIALIZER_H_
+
+#include "libembd/libembd_platform_types.h"
+#include "libembd/libembd_common.h"
+#include "libembd/libembd_marshalling.h"
+
+/**
+ * @file libembd_chain_deserializer.h
+ * @brief Deserializer reading across a chain of non-contiguous buffer segments without linearizing them first.
+ *
+ * Input that arrives in fragments (several packet buffers, or the two halves of a wrapped ring buffer) is read in
+ * place. A field that lies entirely within the current segment is read straight from it with the regular unsafe get
+ * APIs; only a field straddling a segment boundary is stitched together in scratch space. Empty segments are skipped.
+ *
+ * Errors are sticky as with the checked marshalling APIs: a get running past the end of the chain reads nothing, yields
+ * 0 and sets the overflow flag, after which all further gets fail as well.
+ *
+ * Example usage:
+ * @code
+ * LibEmbd_ConstBufferView_t const segments[] = { { rx_buf0, len0 }, { rx_buf1, len1 } };
+ * LibEmbd_ChainDeserializer_t cdeser;
+ * libembd_make_chain_deserializer(&cdeser, segments, 2u);
+ *
+ * libembd_chain_get_uint16_from_network(&cdeser, &msg_id);
+ * libembd_chain_get_uint32_from_network(&cdeser, &msg_length);
+ * if(libembd_chain_deserializer_has_overflowed(&cdeser)) { ... }
+ *
+ * //reading straight out of a ring buffer, the valid bytes may wrap around its end
+ * libembd_make_ring_deserializer(&cdeser, ring, sizeof(ring), ring_tail, ring_fill);
+ * libembd_chain_get_uint16_from_network(&cdeser, &msg_id);
+ * ring_tail = (ring_tail + libembd_chain_deserializer_total_length(&cdeser)) % sizeof(ring);
+ * @endcode
+ */
+
+typedef struct LibEmbd_ChainDeserializer_t LibEmbd_ChainDeserializer_t;
+
+/**
+ * @brief chain deserializer constructor
+ *
+ * @param cdeser pointer to uninitialized chain deserializer object
+ * @param segments segments in reading order, must stay valid until the chain has been read
+ * @param segment_count number of segments
+ */
+LIBEMBD_HEADER_API_INLINE void libembd_make_chain_deserializer(LibEmbd_ChainDeserializer_t *cdeser, LibEmbd_ConstBufferView_t const *segments,
+                                                               uint32 segment_count);
+
+/**
+ * @brief chain deserializer constructor reading length bytes out of a ring buffer
+ *
+ * @param cdeser pointer to uninitialized chain deserializer object
+ * @param ring ring buffer storage
+ * @param ring_size length of ring buffer storage
+ * @param read_index index of the first byte to read, less than ring_size
+ * @param length number of valid bytes from read_index on, at most ring_size, wrapping around to the start of storage
+ */
+LIBEMBD_HEADER_API_INLINE void libembd_make_ring_deserializer(LibEmbd_ChainDeserializer_t *cdeser, uint8 const *ring, uint32 ring_size,
+                                                              uint32 read_index, uint32 length);
+
+/**
+ * @brief Deserializes value in the byte order indicated by the function name and updates read position
+ *
+ * @param cdeser pointer to initialized chain deserializer object
+ * @param value pointer to variable to deserialize into
+ * @note If fewer than sizeof(*value) bytes are left, nothing is read, *value is zeroed and the sticky overflow flag is set.
+ */
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_chain_get_uint8(LibEmbd_ChainDeserializer_t *cdeser, uint8 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_chain_get_sint8(LibEmbd_ChainDeserializer_t *cdeser, sint8 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_chain_get_uint16_from_network(LibEmbd_ChainDeserializer_t *cdeser, uint16 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_chain_get_uint32_from_network(LibEmbd_ChainDeserializer_t *cdeser, uint32 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_chain_get_uint64_from_network(LibEmbd_ChainDeserializer_t *cdeser, uint64 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_chain_get_sint16_from_network(LibEmbd_ChainDeserializer_t *cdeser, sint16 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_chain_get_sint32_from_network(LibEmbd_ChainDeserializer_t *cdeser, sint32 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_chain_get_sint64_from_network(LibEmbd_ChainDeserializer_t *cdeser, sint64 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_chain_get_float32_from_network(LibEmbd_ChainDeserializer_t *cdeser, float32 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_chain_get_float64_from_network(LibEmbd_ChainDeserializer_t *cdeser, float64 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_chain_get_uint16_from_host(LibEmbd_ChainDeserializer_t *cdeser, uint16 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_chain_get_uint32_from_host(LibEmbd_ChainDeserializer_t *cdeser, uint32 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_chain_get_uint64_from_host(LibEmbd_ChainDeserializer_t *cdeser, uint64 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_chain_get_sint16_from_host(LibEmbd_ChainDeserializer_t *cdeser, sint16 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_chain_get_sint32_from_host(LibEmbd_ChainDeserializer_t *cdeser, sint32 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_chain_get_sint64_from_host(LibEmbd_ChainDeserializer_t *cdeser, sint64 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_chain_get_float32_from_host(LibEmbd_ChainDeserializer_t *cdeser, float32 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_chain_get_float64_from_host(LibEmbd_ChainDeserializer_t *cdeser, float64 *value);
+
+/**
+ * @brief Reads raw bytes and updates read position
+ *
+ * @param cdeser pointer to initialized chain deserializer object
+ * @param buffer pointer to output buffer
+ * @param length number of bytes to read
+ * @note Either all length bytes are read or the length bytes of buffer are zeroed and the sticky overflow flag is set.
+ */
+LIBEMBD_HEADER_API_INLINE void libembd_chain_get_buffer(LibEmbd_ChainDeserializer_t *cdeser, void *buffer, uint32 length);
+
+/**
+ * @brief Returns a view of the next length bytes without copying them, if they lie within a single segment
+ *
+ * @param cdeser pointer to initialized chain deserializer object
+ * @param length number of bytes to view
+ * @return view of the bytes, read position is advanced past them; an empty view (NULL data) if the bytes straddle a
+ *         segment boundary, in which case nothing is read and the overflow flag is left alone, so that the caller can fall
+ *         back to libembd_chain_get_buffer()
+ * @note Sets the sticky overflow flag and returns an empty view if fewer than length bytes are left.
+ */
+LIBEMBD_HEADER_API_INLINE LibEmbd_ConstBufferView_t libembd_chain_get_view(LibEmbd_ChainDeserializer_t *cdeser, uint16 length);
+
+/**
+ * @brief Skips bytes and updates read position
+ *
+ * @param cdeser pointer to initialized chain deserializer object
+ * @param length number of bytes to skip
+ * @note Either all length bytes are skipped or nothing is and the sticky overflow flag is set.
+ */
+LIBEMBD_HEADER_API_INLINE void libembd_chain_skip(LibEmbd_ChainDeserializer_t *cdeser, uint32 length);
+
+/**
+ * @brief Number of bytes read (or skipped) so far, across all segments
+ *
+ * @param cdeser pointer to initialized chain deserializer object
+ */
+LIBEMBD_HEADER_API_INLINE LibEmbd_Size_t LIBEMBD_ATTR_ALWAYS_INLINE libembd_chain_deserializer_total_length(LibEmbd_ChainDeserializer_t const *cdeser);
+
+/**
+ * @brief Number of bytes left to read, across all segments
+ *
+ * @param cdeser pointer to initialized chain deserializer object
+ */
+LIBEMBD_HEADER_API_INLINE LibEmbd_Size_t LIBEMBD_ATTR_ALWAYS_INLINE libembd_chain_deserializer_remaining_length(LibEmbd_ChainDeserializer_t const *cdeser);
+
+/**
+ * @brief Query the sticky overflow flag (a read ran past the end of the chain)
+ *
+ * @param cdeser pointer to initialized chain deserializer object
+ */
+LIBEMBD_HEADER_API_INLINE boolean LIBEMBD_ATTR_ALWAYS_INLINE libembd_chain_deserializer_has_overflowed(LibEmbd_ChainDeserializer_t const *cdeser);
+
+#include "libembd/internal/libembd_chain_deserializer_impl.h"
+
+#endif /* LIBEMBD_CHAIN_DESERIALIZER_H_ */
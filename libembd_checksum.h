@@ -0,0 +1,226 @@
+#ifndef LIBEMBD_CHECKSUM_H_
+#define LIBEMBD_CHECKSUM_H_
+
+#include "libembd/libembd_platform_types.h"
+#include "libembd/libembd_common.h"
+#include "libembd/libembd_marshalling.h"
+
+/**
+ * @file libembd_checksum.h
+ * @brief CRC32C, CRC16-CCITT and Fletcher-16 checksums, standalone and fused into (de)serialization.
+ *
+ * Supported checksums:
+ *  - CRC32C (Castagnoli, reflected, init/xorout 0xFFFFFFFF): uses the SSE4.2 crc32 instruction or the ARMv8 CRC32
+ *    extension when available (8 bytes per instruction), slicing-by-8 tables otherwise
+ *  - CRC16-CCITT (poly 0x1021, init 0xFFFF, not reflected, no xorout, a.k.a. CRC-16/CCITT-FALSE): table driven
+ *  - Fletcher-16 (modulo 255): modulo reduction deferred to once every few thousand bytes
+ *
+ * The update functions take and return finalized checksum values, so a checksum over several pieces is computed by
+ * chaining: crc = libembd_crc32c_update(crc, piece, length), starting from the corresponding INIT value.
+ *
+ * The checksum (de)serializers accumulate the checksum over the bytes as they are written or read instead of making a
+ * second pass over the finished frame, while the data is still hot in the cache.
+ *
+ * Example usage:
+ * @code
+ * LibEmbd_ChecksumSerializer_t cser;
+ * libembd_make_checksum_serializer(&cser, frame, sizeof(frame), LIBEMBD_CHECKSUM_CRC32C);
+ *
+ * libembd_checksum_put_uint16_to_network(&cser, MSG_ID);
+ * libembd_checksum_put_buffer(&cser, payload, payload_length);
+ * libembd_checksum_serializer_put_checksum(&cser); //appends the CRC32C in network byte order
+ *
+ * LibEmbd_ChecksumDeserializer_t cdeser;
+ * libembd_make_checksum_deserializer(&cdeser, frame, frame_length, LIBEMBD_CHECKSUM_CRC32C);
+ * libembd_checksum_get_uint16_from_network(&cdeser, &msg_id);
+ * libembd_checksum_get_buffer(&cdeser, payload, payload_length);
+ * if(!libembd_checksum_deserializer_verify(&cdeser)) { ... }
+ * @endcode
+ */
+
+typedef uint8 LibEmbd_Checksum_Type_t;
+#define LIBEMBD_CHECKSUM_CRC32C                 ((LibEmbd_Checksum_Type_t)0x00u)
+#define LIBEMBD_CHECKSUM_CRC16_CCITT            ((LibEmbd_Checksum_Type_t)0x01u)
+#define LIBEMBD_CHECKSUM_FLETCHER16             ((LibEmbd_Checksum_Type_t)0x02u)
+
+#define LIBEMBD_CHECKSUM_LAST_DO_NOT_USE        ((LibEmbd_Checksum_Type_t)0x03u)
+
+#define LIBEMBD_CRC32C_INIT                     ((uint32)0x00000000u)
+#define LIBEMBD_CRC16_CCITT_INIT                ((uint16)0xFFFFu)
+#define LIBEMBD_FLETCHER16_INIT                 ((uint16)0x0000u)
+
+/**
+ * @brief Continues a checksum over length more bytes
+ *
+ * @param checksum checksum of the preceding bytes, or the corresponding INIT value
+ * @param data pointer to input bytes
+ * @param length number of input bytes
+ * @return checksum over the preceding bytes and data
+ */
+LIBEMBD_HEADER_API_INLINE uint32 libembd_crc32c_update(uint32 checksum, uint8 const *data, uint32 length);
+LIBEMBD_HEADER_API_INLINE uint16 libembd_crc16_ccitt_update(uint16 checksum, uint8 const *data, uint32 length);
+LIBEMBD_HEADER_API_INLINE uint16 libembd_fletcher16_update(uint16 checksum, uint8 const *data, uint32 length);
+
+/**
+ * @brief Computes the checksum over a buffer view
+ *
+ * @param view input bytes
+ */
+LIBEMBD_HEADER_API_INLINE uint32 LIBEMBD_ATTR_ALWAYS_INLINE libembd_crc32c(LibEmbd_ConstBufferView_t view);
+LIBEMBD_HEADER_API_INLINE uint16 LIBEMBD_ATTR_ALWAYS_INLINE libembd_crc16_ccitt(LibEmbd_ConstBufferView_t view);
+LIBEMBD_HEADER_API_INLINE uint16 LIBEMBD_ATTR_ALWAYS_INLINE libembd_fletcher16(LibEmbd_ConstBufferView_t view);
+
+typedef struct LibEmbd_ChecksumSerializer_t LibEmbd_ChecksumSerializer_t;
+typedef struct LibEmbd_ChecksumDeserializer_t LibEmbd_ChecksumDeserializer_t;
+
+/**
+ * @brief checksum accumulating serializer constructor
+ *
+ * @param cser pointer to uninitialized checksum serializer object
+ * @param buffer pointer to output buffer
+ * @param capacity length of buffer
+ * @param type checksum to accumulate
+ */
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_make_checksum_serializer(LibEmbd_ChecksumSerializer_t *cser, uint8 *buffer, uint32 capacity,
+                                                                                           LibEmbd_Checksum_Type_t type);
+
+/**
+ * @brief Restarts the checksum at the current write position, e.g. for the next frame in the same buffer
+ *
+ * @param cser pointer to initialized checksum serializer object
+ */
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_checksum_serializer_restart(LibEmbd_ChecksumSerializer_t *cser);
+
+/**
+ * @brief Access the underlying serializer
+ *
+ * @param cser pointer to initialized checksum serializer object
+ * @return serializer usable with all regular marshalling APIs. Bytes written through it are included in the checksum
+ *         on the next checksum put or query.
+ * @note The position may be moved forwards, bytes skipped over are included in the checksum as they are. It may also be
+ *       moved backwards, e.g. to backpatch a length field; the checksum is then accumulated again from the frame start
+ *       on the next checksum put or query. Rewrite the bytes with the checksum put APIs, or query the checksum
+ *       before rewriting them through the base serializer, so that the move backwards is noticed. Moving before
+ *       the start of the frame restarts the checksum at the new position.
+ */
+LIBEMBD_HEADER_API_INLINE LibEmbd_Serializer_t * LIBEMBD_ATTR_ALWAYS_INLINE libembd_checksum_serializer_base(LibEmbd_ChecksumSerializer_t *cser);
+
+/**
+ * @brief Serializes value (checked) and accumulates the checksum over the written bytes
+ *
+ * @param cser pointer to initialized checksum serializer object
+ * @param value value to serialize
+ */
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_checksum_put_uint8(LibEmbd_ChecksumSerializer_t *cser, uint8 value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_checksum_put_sint8(LibEmbd_ChecksumSerializer_t *cser, sint8 value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_checksum_put_uint16_to_network(LibEmbd_ChecksumSerializer_t *cser, uint16 value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_checksum_put_uint32_to_network(LibEmbd_ChecksumSerializer_t *cser, uint32 value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_checksum_put_uint64_to_network(LibEmbd_ChecksumSerializer_t *cser, uint64 value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_checksum_put_sint16_to_network(LibEmbd_ChecksumSerializer_t *cser, sint16 value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_checksum_put_sint32_to_network(LibEmbd_ChecksumSerializer_t *cser, sint32 value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_checksum_put_sint64_to_network(LibEmbd_ChecksumSerializer_t *cser, sint64 value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_checksum_put_float32_to_network(LibEmbd_ChecksumSerializer_t *cser, float32 value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_checksum_put_float64_to_network(LibEmbd_ChecksumSerializer_t *cser, float64 value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_checksum_put_uint16_to_host(LibEmbd_ChecksumSerializer_t *cser, uint16 value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_checksum_put_uint32_to_host(LibEmbd_ChecksumSerializer_t *cser, uint32 value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_checksum_put_uint64_to_host(LibEmbd_ChecksumSerializer_t *cser, uint64 value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_checksum_put_sint16_to_host(LibEmbd_ChecksumSerializer_t *cser, sint16 value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_checksum_put_sint32_to_host(LibEmbd_ChecksumSerializer_t *cser, sint32 value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_checksum_put_sint64_to_host(LibEmbd_ChecksumSerializer_t *cser, sint64 value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_checksum_put_float32_to_host(LibEmbd_ChecksumSerializer_t *cser, float32 value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_checksum_put_float64_to_host(LibEmbd_ChecksumSerializer_t *cser, float64 value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_checksum_put_buffer(LibEmbd_ChecksumSerializer_t *cser, const void *buffer, uint32 buffer_length);
+
+/**
+ * @brief Returns the checksum over all bytes written since construction/restart
+ *
+ * @param cser pointer to initialized checksum serializer object
+ * @return checksum value, 16-bit checksums are zero extended
+ */
+LIBEMBD_HEADER_API_INLINE uint32 LIBEMBD_ATTR_ALWAYS_INLINE libembd_checksum_serializer_value(LibEmbd_ChecksumSerializer_t *cser);
+
+/**
+ * @brief Appends the checksum over all bytes written since construction/restart in network byte order (4 bytes for
+ *        CRC32C, 2 bytes otherwise) and restarts the checksum after it
+ *
+ * @param cser pointer to initialized checksum serializer object
+ * @note Sets the sticky overflow flag of the underlying serializer if the checksum does not fit.
+ */
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_checksum_serializer_put_checksum(LibEmbd_ChecksumSerializer_t *cser);
+
+/**
+ * @brief checksum accumulating deserializer constructor
+ *
+ * @param cdeser pointer to uninitialized checksum deserializer object
+ * @param buffer pointer to input buffer
+ * @param capacity length of buffer
+ * @param type checksum to accumulate
+ */
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_make_checksum_deserializer(LibEmbd_ChecksumDeserializer_t *cdeser, uint8 const *buffer, uint32 capacity,
+                                                                                             LibEmbd_Checksum_Type_t type);
+
+/**
+ * @brief Restarts the checksum at the current read position
+ *
+ * @param cdeser pointer to initialized checksum deserializer object
+ */
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_checksum_deserializer_restart(LibEmbd_ChecksumDeserializer_t *cdeser);
+
+/**
+ * @brief Access the underlying deserializer
+ *
+ * @param cdeser pointer to initialized checksum deserializer object
+ * @return deserializer usable with all regular marshalling APIs. Bytes read through it are included in the checksum
+ *         on the next checksum get or query.
+ * @note The position may be moved forwards, bytes skipped over are included in the checksum. Moving it backwards
+ *       accumulates the checksum again from the frame start, moving before the start of the frame restarts the checksum
+ *       at the new position.
+ */
+LIBEMBD_HEADER_API_INLINE LibEmbd_Deserializer_t * LIBEMBD_ATTR_ALWAYS_INLINE libembd_checksum_deserializer_base(LibEmbd_ChecksumDeserializer_t *cdeser);
+
+/**
+ * @brief Deserializes value (checked) and accumulates the checksum over the read bytes
+ *
+ * @param cdeser pointer to initialized checksum deserializer object
+ * @param value pointer to variable to deserialize into
+ */
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_checksum_get_uint8(LibEmbd_ChecksumDeserializer_t *cdeser, uint8 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_checksum_get_sint8(LibEmbd_ChecksumDeserializer_t *cdeser, sint8 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_checksum_get_uint16_from_network(LibEmbd_ChecksumDeserializer_t *cdeser, uint16 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_checksum_get_uint32_from_network(LibEmbd_ChecksumDeserializer_t *cdeser, uint32 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_checksum_get_uint64_from_network(LibEmbd_ChecksumDeserializer_t *cdeser, uint64 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_checksum_get_sint16_from_network(LibEmbd_ChecksumDeserializer_t *cdeser, sint16 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_checksum_get_sint32_from_network(LibEmbd_ChecksumDeserializer_t *cdeser, sint32 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_checksum_get_sint64_from_network(LibEmbd_ChecksumDeserializer_t *cdeser, sint64 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_checksum_get_float32_from_network(LibEmbd_ChecksumDeserializer_t *cdeser, float32 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_checksum_get_float64_from_network(LibEmbd_ChecksumDeserializer_t *cdeser, float64 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_checksum_get_uint16_from_host(LibEmbd_ChecksumDeserializer_t *cdeser, uint16 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_checksum_get_uint32_from_host(LibEmbd_ChecksumDeserializer_t *cdeser, uint32 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_checksum_get_uint64_from_host(LibEmbd_ChecksumDeserializer_t *cdeser, uint64 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_checksum_get_sint16_from_host(LibEmbd_ChecksumDeserializer_t *cdeser, sint16 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_checksum_get_sint32_from_host(LibEmbd_ChecksumDeserializer_t *cdeser, sint32 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_checksum_get_sint64_from_host(LibEmbd_ChecksumDeserializer_t *cdeser, sint64 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_checksum_get_float32_from_host(LibEmbd_ChecksumDeserializer_t *cdeser, float32 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_checksum_get_float64_from_host(LibEmbd_ChecksumDeserializer_t *cdeser, float64 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_checksum_get_buffer(LibEmbd_ChecksumDeserializer_t *cdeser, void *buffer, uint32 length);
+
+/**
+ * @brief Returns the checksum over all bytes read since construction/restart
+ *
+ * @param cdeser pointer to initialized checksum deserializer object
+ * @return checksum value, 16-bit checksums are zero extended
+ */
+LIBEMBD_HEADER_API_INLINE uint32 LIBEMBD_ATTR_ALWAYS_INLINE libembd_checksum_deserializer_value(LibEmbd_ChecksumDeserializer_t *cdeser);
+
+/**
+ * @brief Reads the trailing checksum in network byte order and compares it against the checksum over all bytes read
+ *        since construction/restart, then restarts the checksum after it
+ *
+ * @param cdeser pointer to initialized checksum deserializer object
+ * @return TRUE if the checksums match and no overflow occurred
+ */
+LIBEMBD_HEADER_API_INLINE boolean LIBEMBD_ATTR_ALWAYS_INLINE libembd_checksum_deserializer_verify(LibEmbd_ChecksumDeserializer_t *cdeser);
+
+#include "libembd/internal/libembd_checksum_impl.h"
+
+#endif /* LIBEMBD_CHECKSUM_H_ */
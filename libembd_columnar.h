@@ -0,0 +1,162 @@
+#ifndef LIBEMBD_COLUMNAR_H_
+#define LIBEMBD_COLUMNAR_H_
+
+#include "libembd/libembd_platform_types.h"
+#include "libembd/libembd_common.h"
+#include "libembd/libembd_marshalling.h"
+
+/**
+ * @file libembd_columnar.h
+ * @brief Columnar batches of telemetry samples (timestamp, id, value).
+ *
+ * Samples are collected into a batch and written column by column instead of row by row:
+ *  - timestamps: the smallest timestamp followed by every timestamp's offset from it, in the narrowest of 1/2/4/8 bytes
+ *    that fits the whole batch
+ *  - ids: the dictionary of distinct ids (uint32 each) followed by one uint8 dictionary index per sample
+ *  - values: a float32 array
+ * All multi-byte fields are in network byte order, the value column is byte-swapped in bulk.
+ *
+ * Wire layout: uint32 count | uint64 base | uint8 width | offsets | uint16 dictionary size | dictionary | indices | values
+ *
+ * The decoder validates the batch once and then exposes every column as a view into the buffer: any element can be read
+ * in O(1) without decoding the rest.
+ *
+ * The layout buys size and random access, not throughput: appending to the batch and writing it costs several times
+ * as much as writing plain rows, and a full scan filtering on an id is slower than the row-wise equivalent as well
+ * (see bench/bench_columnar.c).
+ *
+ * Example usage:
+ * @code
+ * static uint64 timestamps[128];
+ * static uint8 indices[128];
+ * static float32 values[128];
+ * static LibEmbd_TelemetryBatch_t batch;
+ *
+ * libembd_make_telemetry_batch(&batch, timestamps, indices, values, 128u);
+ * if(libembd_telemetry_batch_append(&batch, now, SENSOR_ID, reading) != E_OK){
+ *     libembd_put_telemetry_batch_checked(&ser, &batch); //batch or dictionary full, flush
+ *     libembd_reset_telemetry_batch(&batch);
+ *     (void)libembd_telemetry_batch_append(&batch, now, SENSOR_ID, reading);
+ * }
+ *
+ * LibEmbd_TelemetryBatchView_t view;
+ * uint8 index;
+ * libembd_get_telemetry_batch_checked(&deser, &view);
+ * if(libembd_dictionary_column_find(&view.ids, SENSOR_ID, &index)){
+ *     for(uint32 i = 0u; i < view.count; i++){
+ *         if(view.ids.indices[i] == index) { plot(libembd_timestamp_column_at(&view.timestamps, i), libembd_float32_column_at(&view.values, i)); }
+ *     }
+ * }
+ * @endcode
+ */
+
+//! please make sure the following macros are correctly configured!
+/*--------------------------------------------------- Macro Configurations--------------------------------------------------------*/
+//! maximum number of distinct ids per batch, power of two, at most 256
+#ifndef LIBEMBD_COLUMNAR_DICTIONARY_SIZE
+    #define LIBEMBD_COLUMNAR_DICTIONARY_SIZE        256u
+#endif
+/*--------------------------------------------------- Macro Configurations--------------------------------------------------------*/
+
+typedef struct LibEmbd_TelemetryBatch_t LibEmbd_TelemetryBatch_t;
+
+typedef struct {
+    uint64 base; //smallest timestamp of the batch
+    uint8 const *offsets; //count offsets from base
+    uint8 width; //bytes per offset
+} LibEmbd_TimestampColumn_t;
+
+typedef struct {
+    uint8 const *dictionary; //size uint32 ids
+    uint8 const *indices; //count dictionary indices, all validated to be below size
+    uint16 size;
+} LibEmbd_DictionaryColumn_t;
+
+typedef struct {
+    uint8 const *data; //count float32
+} LibEmbd_Float32Column_t;
+
+typedef struct {
+    uint32 count; //number of samples
+    LibEmbd_TimestampColumn_t timestamps;
+    LibEmbd_DictionaryColumn_t ids;
+    LibEmbd_Float32Column_t values;
+} LibEmbd_TelemetryBatchView_t;
+
+/**
+ * @brief telemetry batch constructor
+ *
+ * @param batch pointer to batch object
+ * @param timestamps caller-provided timestamp column, capacity elements
+ * @param indices caller-provided id index column, capacity elements
+ * @param values caller-provided value column, capacity elements
+ * @param capacity maximum number of samples per batch
+ */
+LIBEMBD_HEADER_API_INLINE void libembd_make_telemetry_batch(LibEmbd_TelemetryBatch_t *batch, uint64 *timestamps, uint8 *indices, float32 *values, uint32 capacity);
+
+/**
+ * @brief Empties the batch and its id dictionary
+ */
+LIBEMBD_HEADER_API_INLINE void libembd_reset_telemetry_batch(LibEmbd_TelemetryBatch_t *batch);
+
+/**
+ * @brief Appends a sample to the batch
+ *
+ * @return E_OK on success, E_NOT_OK if the batch is full or id would exceed LIBEMBD_COLUMNAR_DICTIONARY_SIZE distinct ids
+ */
+LIBEMBD_HEADER_API_INLINE LibEmbd_Std_ReturnType libembd_telemetry_batch_append(LibEmbd_TelemetryBatch_t *batch, uint64 timestamp, uint32 id, float32 value);
+
+/**
+ * @brief Returns the number of samples in the batch
+ */
+LIBEMBD_HEADER_API_INLINE uint32 libembd_telemetry_batch_count(LibEmbd_TelemetryBatch_t const *batch);
+
+/**
+ * @brief Writes the batch in columnar layout to underlying buffer and updates write position
+ *
+ * @param ser pointer to initialized serializer object
+ * @param batch pointer to batch, left unchanged
+ * @note If the batch does not fit, nothing is written and the sticky overflow flag is set.
+ */
+LIBEMBD_HEADER_API_INLINE void libembd_put_telemetry_batch_checked(LibEmbd_Serializer_t *ser, LibEmbd_TelemetryBatch_t const *batch);
+
+/**
+ * @brief Validates a columnar batch in underlying buffer, points view at its columns and updates read position
+ *
+ * @param deser pointer to initialized deserializer object
+ * @param view pointer to output, valid as long as the underlying buffer is
+ * @note If the batch is truncated or malformed, the view is zeroed (no samples, empty dictionary), the read position is left unchanged and the
+ *       sticky overflow flag is set.
+ */
+LIBEMBD_HEADER_API_INLINE void libembd_get_telemetry_batch_checked(LibEmbd_Deserializer_t *deser, LibEmbd_TelemetryBatchView_t *view);
+
+/**
+ * @brief Returns timestamp i of a timestamp column view
+ */
+LIBEMBD_HEADER_API_INLINE uint64 LIBEMBD_ATTR_ALWAYS_INLINE libembd_timestamp_column_at(LibEmbd_TimestampColumn_t const *column, uint32 i);
+
+/**
+ * @brief Returns id i of a dictionary column view
+ */
+LIBEMBD_HEADER_API_INLINE uint32 LIBEMBD_ATTR_ALWAYS_INLINE libembd_dictionary_column_at(LibEmbd_DictionaryColumn_t const *column, uint32 i);
+
+/**
+ * @brief Looks up the dictionary index of id, to be compared against column->indices
+ *
+ * @return TRUE if id occurs in the batch
+ */
+LIBEMBD_HEADER_API_INLINE boolean libembd_dictionary_column_find(LibEmbd_DictionaryColumn_t const *column, uint32 id, uint8 *index);
+
+/**
+ * @brief Returns value i of a float32 column view
+ */
+LIBEMBD_HEADER_API_INLINE float32 LIBEMBD_ATTR_ALWAYS_INLINE libembd_float32_column_at(LibEmbd_Float32Column_t const *column, uint32 i);
+
+/**
+ * @brief Copies count values starting at first out of a float32 column view, converting them to host byte order in bulk
+ */
+LIBEMBD_HEADER_API_INLINE void libembd_float32_column_copy(LibEmbd_Float32Column_t const *column, uint32 first, uint32 count, float32 *values);
+
+#include "libembd/internal/libembd_columnar_impl.h"
+
+#endif /* LIBEMBD_COLUMNAR_H_ */
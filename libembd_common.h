@@ -25,6 +25,56 @@
     #error Unable to detect host endianness!
 #endif
 
+// Compile-time SIMD instruction set detection
+#if defined(__AVX2__)
+    #define LIBEMBD_HAS_AVX2    1
+#else
+    #define LIBEMBD_HAS_AVX2    0
+#endif
+
+#if defined(__SSE2__)
+    #define LIBEMBD_HAS_SSE2    1
+#else
+    #define LIBEMBD_HAS_SSE2    0
+#endif
+
+#if defined(__SSSE3__)
+    #define LIBEMBD_HAS_SSSE3   1
+#else
+    #define LIBEMBD_HAS_SSSE3   0
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #define LIBEMBD_HAS_NEON    1
+#else
+    #define LIBEMBD_HAS_NEON    0
+#endif
+
+#if defined(__SSE4_2__)
+    #define LIBEMBD_HAS_SSE42   1
+#else
+    #define LIBEMBD_HAS_SSE42   0
+#endif
+
+#if defined(__F16C__)
+    #define LIBEMBD_HAS_F16C    1
+#else
+    #define LIBEMBD_HAS_F16C    0
+#endif
+
+// NEON half precision conversions (vcvt_f16_f32/vcvt_f32_f16)
+#if LIBEMBD_HAS_NEON && (defined(__aarch64__) || (defined(__ARM_FP) && (__ARM_FP & 2)))
+    #define LIBEMBD_HAS_NEON_FP16   1
+#else
+    #define LIBEMBD_HAS_NEON_FP16   0
+#endif
+
+#if defined(__ARM_FEATURE_CRC32)
+    #define LIBEMBD_HAS_ARM_CRC32   1
+#else
+    #define LIBEMBD_HAS_ARM_CRC32   0
+#endif
+
 #define LIBEMBD_API extern
 #define LIBEMBD_INTERNAL_GLOBAL extern
 #define LIBEMBD_INTERNAL_API extern
@@ -38,6 +88,13 @@
 #define LIBEMBD_ATTR_ALWAYS_INLINE  __attribute__((always_inline))
 #define LIBEMBD_ATTR_PACKED         __attribute__((packed))
 #define LIBEMBD_ALIGNAS(alignment)  __attribute__((aligned(alignment)))
+#if defined(__cplusplus)
+    #define LIBEMBD_ALIGNOF(type)   alignof(type)
+#elif (__STDC_VERSION__ >= 201112L)
+    #define LIBEMBD_ALIGNOF(type)   _Alignof(type)
+#else
+    #define LIBEMBD_ALIGNOF(type)   __alignof__(type)
+#endif
 
 #if defined(__GNUC__) || defined(__clang__)
     #define LIBEMBD_DISABLE_WARNING_PUSH _Pragma("GCC diagnostic push")
@@ -72,7 +129,9 @@
 #define LIBEMBD_MEMMOVE(dest, src, len) memmove(dest, src, len)
 #define LIBEMBD_SPRINTF sprintf
 
-#if (__STDC_VERSION__ >= 201112L)
+#if defined(__cplusplus) && (__cplusplus >= 201103L)
+    #define LIBEMBD_STATIC_ASSERT static_assert
+#elif (__STDC_VERSION__ >= 201112L)
     #include <assert.h>
     #define LIBEMBD_STATIC_ASSERT _Static_assert
 #else
@@ -87,9 +146,34 @@
 
 #define LIBEMBD_ASSERT(expr) assert(expr)
 
+/// Branch prediction hints
+#if defined(__GNUC__) || defined(__clang__)
+    #define LIBEMBD_LIKELY(expr)    __builtin_expect(!!(expr), 1)
+    #define LIBEMBD_UNLIKELY(expr)  __builtin_expect(!!(expr), 0)
+#else
+    #define LIBEMBD_LIKELY(expr)    (expr)
+    #define LIBEMBD_UNLIKELY(expr)  (expr)
+#endif
+
 /// Optimizer allowed to assume that EXPR evaluates to true
 #define LIBEMBD_ASSUME(expr) ((void)((expr) ? (void)0 : LIBEMBD_UNREACHABLE()))
 
+/// Optimizer allowed to assume that PTR is aligned to ALIGNMENT bytes, yields PTR as void pointer
+#if defined(__GNUC__) || defined(__clang__)
+    #define LIBEMBD_ASSUME_ALIGNED(ptr, alignment) __builtin_assume_aligned((ptr), (alignment))
+#else
+    #define LIBEMBD_ASSUME_ALIGNED(ptr, alignment) ((void *)(ptr))
+#endif
+
+/// 1 on targets where unaligned scalar loads/stores cost the same as aligned ones, may be predefined to override
+#ifndef LIBEMBD_FAST_UNALIGNED_ACCESS
+    #if defined(__x86_64__) || defined(__i386__) || defined(__aarch64__) || defined(__ARM_FEATURE_UNALIGNED)
+        #define LIBEMBD_FAST_UNALIGNED_ACCESS 1
+    #else
+        #define LIBEMBD_FAST_UNALIGNED_ACCESS 0
+    #endif
+#endif
+
 /// Expect asserts the condition in debug builds and assumes the condition to be
 /// true in release builds.
 #ifdef NDEBUG
@@ -105,7 +189,7 @@
 
 typedef uint8       LibEmbd_Std_ReturnType;
 #define E_OK        ((LibEmbd_Std_ReturnType)0u)
-#define E_NOT_OK    ((LibEmbd_Std_ReturnType)0u)
+#define E_NOT_OK    ((LibEmbd_Std_ReturnType)1u)
 
 typedef uint32 LibEmbd_Size_t;
 
@@ -0,0 +1,136 @@
+#ifndef LIBEMBD_CONCURRENT_SERIALIZER_H_
+#define LIBEMBD_CONCURRENT_SERIALIZER_H_
+
+#include "libembd/libembd_platform_types.h"
+#include "libembd/libembd_common.h"
+#include "libembd/libembd_marshalling.h"
+
+/**
+ * @file libembd_concurrent_serializer.h
+ * @brief Lock-free multi-producer serialization into one shared batch buffer.
+ *
+ * Every producer reserves a slot for its record with a single atomic fetch-and-add on the shared write position and
+ * then serializes into the slot with the ordinary libembd_put_* APIs, through a plain serializer over the slot. No
+ * private buffer, no copy and no lock: producers only contend on the one fetch-and-add per record.
+ *
+ * Every slot starts with a 32-bit network byte order header which doubles as the commit flag. It stays zero while the
+ * record is written and is published with release semantics on commit, so a consumer only ever sees complete records.
+ * Slots are padded to 4 bytes, space a producer reserved but did not use is covered by padding records which readers
+ * skip.
+ *
+ * Header: bit 31 committed | bit 30 padding | bits 29..0 payload length
+ *
+ * The consumer seals the batch to stop further reservations, waits for in-flight producers to commit and then sends
+ * the first libembd_seal_concurrent_serializer() bytes of the buffer.
+ *
+ * Example usage:
+ * @code
+ * static uint32 batch[1024]; //4-byte aligned
+ * static LibEmbd_ConcurrentSerializer_t cser;
+ * libembd_make_concurrent_serializer(&cser, (uint8 *)batch, sizeof(batch));
+ *
+ * //any number of producer threads
+ * LibEmbd_Serializer_t ser;
+ * if(libembd_concurrent_serializer_begin_record(&cser, 12u, &ser)){
+ *     libembd_put_uint32_to_network_checked(&ser, id);
+ *     libembd_put_float64_to_network_checked(&ser, value);
+ *     libembd_concurrent_serializer_commit_record(&cser, &ser);
+ * }
+ *
+ * //consumer thread
+ * uint32 const length = libembd_seal_concurrent_serializer(&cser);
+ * while(!libembd_concurrent_serializer_is_complete(&cser)) {}
+ * send((uint8 *)batch, length);
+ * libembd_reset_concurrent_serializer(&cser);
+ * @endcode
+ *
+ * @note Requires the atomic operations of libembd_atomic.h.
+ */
+
+#define LIBEMBD_CONCURRENT_RECORD_HEADER_SIZE       4u
+#define LIBEMBD_CONCURRENT_RECORD_ALIGNMENT         4u //buffer alignment, slots are padded to multiples of it
+#define LIBEMBD_CONCURRENT_SERIALIZER_MAX_CAPACITY  0x3FFFFFFCu
+
+/// Number of buffer bytes a record of size payload bytes occupies
+#define LIBEMBD_CONCURRENT_RECORD_SIZE(size)        (LIBEMBD_CONCURRENT_RECORD_HEADER_SIZE + (((size) + 3u) & ~3u))
+
+typedef struct LibEmbd_ConcurrentSerializer_t LibEmbd_ConcurrentSerializer_t;
+
+/**
+ * @brief concurrent serializer constructor, zeroes the buffer
+ *
+ * @param cser pointer to uninitialized concurrent serializer object
+ * @param buffer shared batch buffer, aligned to LIBEMBD_CONCURRENT_RECORD_ALIGNMENT
+ * @param capacity length of buffer, at least LIBEMBD_CONCURRENT_RECORD_HEADER_SIZE and at most
+ *                 LIBEMBD_CONCURRENT_SERIALIZER_MAX_CAPACITY. Rounded down to a multiple of the alignment.
+ */
+LIBEMBD_HEADER_API_INLINE void libembd_make_concurrent_serializer(LibEmbd_ConcurrentSerializer_t *cser, uint8 *buffer, uint32 capacity);
+
+/**
+ * @brief Empties the batch for reuse
+ *
+ * @note Must only be called once the batch is complete, i.e. while no producer holds a slot.
+ */
+LIBEMBD_HEADER_API_INLINE void libembd_reset_concurrent_serializer(LibEmbd_ConcurrentSerializer_t *cser);
+
+/**
+ * @brief Reserves a slot for a record of up to size bytes and constructs a serializer over it. Safe to call from any
+ *        number of threads concurrently.
+ *
+ * @param cser pointer to initialized concurrent serializer object
+ * @param size maximum payload length of the record
+ * @param ser pointer to serializer object to construct, pass it to libembd_concurrent_serializer_commit_record()
+ * @return TRUE if the slot was reserved, FALSE if the batch is full or sealed or the record would not even fit an empty
+ *         batch (ser is not constructed)
+ */
+LIBEMBD_HEADER_API_INLINE boolean libembd_concurrent_serializer_begin_record(LibEmbd_ConcurrentSerializer_t *cser, uint32 size, LibEmbd_Serializer_t *ser);
+
+/**
+ * @brief Publishes the record serialized into a slot, making it visible to the consumer
+ *
+ * @param cser pointer to initialized concurrent serializer object
+ * @param ser serializer constructed by libembd_concurrent_serializer_begin_record(), its write position is the record length
+ * @note A record whose serializer has overflowed is discarded, its slot is published as padding.
+ */
+LIBEMBD_HEADER_API_INLINE void libembd_concurrent_serializer_commit_record(LibEmbd_ConcurrentSerializer_t *cser, LibEmbd_Serializer_t const *ser);
+
+/**
+ * @brief Stops further reservations, to be called once per batch by the consumer
+ *
+ * @return length of the batch, records reserved before sealing lie within it
+ */
+LIBEMBD_HEADER_API_INLINE uint32 libembd_seal_concurrent_serializer(LibEmbd_ConcurrentSerializer_t *cser);
+
+/**
+ * @brief Checks whether every reserved slot has been committed
+ *
+ * @return TRUE if no producer holds a slot. Once sealed, the batch is final as soon as this returns TRUE.
+ */
+LIBEMBD_HEADER_API_INLINE boolean libembd_concurrent_serializer_is_complete(LibEmbd_ConcurrentSerializer_t const *cser);
+
+/**
+ * @brief Advances to the next committed record of the live batch and constructs a deserializer over its payload,
+ *        without copying. Padding is skipped.
+ *
+ * @param cser pointer to initialized concurrent serializer object
+ * @param position read position, 0 for the first record, advanced past every record returned
+ * @param record pointer to deserializer object to construct
+ * @return TRUE if a record was read, FALSE if the record at position is not committed yet or the batch has ended
+ * @note Records are returned in reservation order, a slow producer holds back the records reserved after it.
+ */
+LIBEMBD_HEADER_API_INLINE boolean libembd_concurrent_serializer_get_record(LibEmbd_ConcurrentSerializer_t const *cser, uint32 *position, LibEmbd_Deserializer_t *record);
+
+/**
+ * @brief Advances to the next record of a received batch and constructs a deserializer over its payload, without
+ *        copying. Padding is skipped.
+ *
+ * @param deser pointer to initialized deserializer object positioned at a record boundary
+ * @param record pointer to deserializer object to construct
+ * @return TRUE if a record was read, FALSE at the end of the buffer or on a malformed record
+ * @note A malformed record leaves the read position at it and sets the sticky overflow flag, a clean end does not.
+ */
+LIBEMBD_HEADER_API_INLINE boolean libembd_get_concurrent_record_checked(LibEmbd_Deserializer_t *deser, LibEmbd_Deserializer_t *record);
+
+#include "libembd/internal/libembd_concurrent_serializer_impl.h"
+
+#endif /* LIBEMBD_CONCURRENT_SERIALIZER_H_ */
@@ -0,0 +1,77 @@
+#ifndef LIBEMBD_DELTA_H_
+#define LIBEMBD_DELTA_H_
+
+#include "libembd/libembd_platform_types.h"
+#include "libembd/libembd_common.h"
+#include "libembd/libembd_marshalling.h"
+
+/**
+ * @file libembd_delta.h
+ * @brief Delta encoding of successive serialized frames of the same layout.
+ *
+ * The frame is split into 4-byte words (the last word may be shorter). A delta consists of
+ *  - a change bitmap of LIBEMBD_DELTA_BITMAP_SIZE(frame_length) bytes, bit (i % 8) of byte (i / 8) set if word i changed
+ *  - the changed words in ascending order, copied verbatim
+ * The frame length itself is not encoded, both sides are expected to know the layout.
+ *
+ * Words are compared 8 (AVX2), 4 (SSE2/NEON) at a time, the compare results map directly onto bitmap bits.
+ * The decoder patches the changed words into the previous frame in place.
+ *
+ * Example usage:
+ * @code
+ * //sender, previous and current hold the last and the new serialized status frame
+ * libembd_put_delta_checked(&ser, previous, current);
+ *
+ * //receiver, frame holds the last received status frame and is updated in place
+ * libembd_get_delta_checked(&deser, frame);
+ * @endcode
+ */
+
+#define LIBEMBD_DELTA_WORD_SIZE                         4u
+
+//! number of words a frame is split into
+#define LIBEMBD_DELTA_WORD_COUNT(frame_length)          (((frame_length) + LIBEMBD_DELTA_WORD_SIZE - 1u) / LIBEMBD_DELTA_WORD_SIZE)
+#define LIBEMBD_DELTA_BITMAP_SIZE(frame_length)         ((LIBEMBD_DELTA_WORD_COUNT(frame_length) + 7u) / 8u)
+//! delta size if every word changed
+#define LIBEMBD_DELTA_MAX_SIZE(frame_length)            (LIBEMBD_DELTA_BITMAP_SIZE(frame_length) + (frame_length))
+
+/**
+ * @brief Writes the delta between two frames to underlying buffer and updates write position
+ *
+ * @param ser pointer to initialized serializer object
+ * @param previous previously sent frame
+ * @param current frame to send, must have the same length as previous
+ * @return number of changed words
+ * @warning assumes the underlying buffer can hold LIBEMBD_DELTA_MAX_SIZE(current.length) bytes
+ */
+LIBEMBD_HEADER_API_INLINE uint32 libembd_put_delta_unsafe(LibEmbd_Serializer_t *ser, LibEmbd_ConstBufferView_t previous, LibEmbd_ConstBufferView_t current);
+
+/**
+ * @brief Checked counterpart of libembd_put_delta_unsafe
+ *
+ * @return number of changed words, 0 if the delta does not fit
+ * @note If the delta does not fit, the write position is left unchanged and the sticky overflow flag is set. Bytes
+ *       after the write position may have been used as scratch space for the bitmap.
+ */
+LIBEMBD_HEADER_API_INLINE uint32 libembd_put_delta_checked(LibEmbd_Serializer_t *ser, LibEmbd_ConstBufferView_t previous, LibEmbd_ConstBufferView_t current);
+
+/**
+ * @brief Reads a delta from underlying buffer, applies it to frame in place and updates read position
+ *
+ * @param deser pointer to initialized deserializer object
+ * @param frame previous frame, overwritten with the current one
+ * @warning Assumes the underlying buffer holds a complete delta for a frame of this length
+ */
+LIBEMBD_HEADER_API_INLINE void libembd_get_delta_unsafe(LibEmbd_Deserializer_t *deser, LibEmbd_MutableBufferView_t frame);
+
+/**
+ * @brief Checked counterpart of libembd_get_delta_unsafe
+ *
+ * @note If the delta is truncated (or the deserializer has already overflowed), frame is left unchanged, the read
+ *       position is left unchanged and the sticky overflow flag is set.
+ */
+LIBEMBD_HEADER_API_INLINE void libembd_get_delta_checked(LibEmbd_Deserializer_t *deser, LibEmbd_MutableBufferView_t frame);
+
+#include "libembd/internal/libembd_delta_impl.h"
+
+#endif /* LIBEMBD_DELTA_H_ */
@@ -0,0 +1,100 @@
+#ifndef LIBEMBD_DISPATCH_H_
+#define LIBEMBD_DISPATCH_H_
+
+#include "libembd/libembd_platform_types.h"
+#include "libembd/libembd_common.h"
+#include "libembd/libembd_marshalling.h"
+
+/**
+ * @file libembd_dispatch.h
+ * @brief Constant time message-ID dispatch through a perfect hash table.
+ *
+ * The dispatcher is built once from a table of (id, expected size, handler) entries. Construction searches a
+ * hash-and-displace perfect hash over the ids: every id first hashes to a bucket holding a displacement, and id plus
+ * displacement hashes to a slot no other id occupies. A lookup therefore costs two hashes, two loads and no loop, no
+ * matter how many message types are registered.
+ *
+ * Every slot stores id and expected size packed into one key, so validating the id and the payload length is a single
+ * masked compare: an unknown id and a wrong length are rejected by the same branch.
+ *
+ * Example usage:
+ * @code
+ * static void on_status(void *context, LibEmbd_Deserializer_t *payload) { ... }
+ * static void on_log(void *context, LibEmbd_Deserializer_t *payload) { ... }
+ *
+ * static LibEmbd_DispatchEntry_t const entries[] = {
+ *     { 0x0101u, 15u,                       on_status },
+ *     { 0x0230u, LIBEMBD_DISPATCH_ANY_SIZE, on_log    },
+ * };
+ * static LibEmbd_Dispatcher_t dispatcher;
+ *
+ * (void)libembd_make_dispatcher(&dispatcher, entries, sizeof(entries) / sizeof(entries[0]), &app);
+ *
+ * //frame: uint16 id in network byte order followed by the payload
+ * if(libembd_dispatch_frame(&dispatcher, &deser) != E_OK) { ... } //unknown id or unexpected length
+ * @endcode
+ */
+
+//! please make sure the following macros are correctly configured!
+/*--------------------------------------------------- Macro Configurations--------------------------------------------------------*/
+//! number of hash table slots, power of two, maximum number of entries per dispatcher
+#ifndef LIBEMBD_DISPATCH_TABLE_SIZE
+    #define LIBEMBD_DISPATCH_TABLE_SIZE             512u
+#endif
+/*--------------------------------------------------- Macro Configurations--------------------------------------------------------*/
+
+#define LIBEMBD_DISPATCH_ANY_SIZE                   0xFFFFu //entry size accepting payloads of any length
+
+/**
+ * @brief Message handler
+ *
+ * @param context user context given at construction
+ * @param payload deserializer over the payload of the message, its length has already been checked
+ */
+typedef void (*libembd_message_handler_t)(void *context, LibEmbd_Deserializer_t *payload);
+
+typedef struct {
+    uint16 id;
+    uint16 size; //expected payload length in bytes or LIBEMBD_DISPATCH_ANY_SIZE
+    libembd_message_handler_t handler;
+} LibEmbd_DispatchEntry_t;
+
+typedef struct LibEmbd_Dispatcher_t LibEmbd_Dispatcher_t;
+
+/**
+ * @brief dispatcher constructor, builds the perfect hash table
+ *
+ * @param dispatcher pointer to dispatcher object
+ * @param entries message table, not referenced after construction
+ * @param count number of entries, at most LIBEMBD_DISPATCH_TABLE_SIZE
+ * @param context user context passed to every handler
+ * @return E_OK on success, E_NOT_OK if count exceeds the table size, an id occurs twice or no perfect hash was found
+ *         (only to be expected for tables filled to the last slot, increase LIBEMBD_DISPATCH_TABLE_SIZE)
+ * @note Runs in O(count * LIBEMBD_DISPATCH_TABLE_SIZE), meant to be called once at startup.
+ */
+LIBEMBD_HEADER_API_INLINE LibEmbd_Std_ReturnType libembd_make_dispatcher(LibEmbd_Dispatcher_t *dispatcher, LibEmbd_DispatchEntry_t const *entries,
+                                                                         uint32 count, void *context);
+
+/**
+ * @brief Invokes the handler registered for id if the payload has the expected length
+ *
+ * @param dispatcher pointer to initialized dispatcher object
+ * @param id message id
+ * @param payload deserializer over the message payload, its remaining bytes are checked against the expected size
+ * @return E_OK if the handler was invoked, E_NOT_OK if id is unknown or the payload length does not match
+ */
+LIBEMBD_HEADER_API_INLINE LibEmbd_Std_ReturnType libembd_dispatch_message(LibEmbd_Dispatcher_t const *dispatcher, uint16 id, LibEmbd_Deserializer_t *payload);
+
+/**
+ * @brief Reads a network byte order uint16 message id and dispatches the rest of the buffer as its payload
+ *
+ * @param dispatcher pointer to initialized dispatcher object
+ * @param deser pointer to initialized deserializer object positioned at the start of a frame, advanced to its end
+ * @return E_OK if the handler was invoked, E_NOT_OK if the frame is too short for an id (the sticky overflow flag is
+ *         set), the id is unknown or the payload length does not match
+ */
+LIBEMBD_HEADER_API_INLINE LibEmbd_Std_ReturnType libembd_dispatch_frame(LibEmbd_Dispatcher_t const *dispatcher, LibEmbd_Deserializer_t *deser);
+
+#include "libembd/internal/libembd_dispatch_impl.h"
+
+#endif /* LIBEMBD_DISPATCH_H_ */
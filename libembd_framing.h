@@ -0,0 +1,121 @@
+#ifndef LIBEMBD_FRAMING_H_
+#define LIBEMBD_FRAMING_H_
+
+#include "libembd/libembd_platform_types.h"
+#include "libembd/libembd_common.h"
+
+/**
+ * @file libembd_framing.h
+ * @brief COBS and SLIP framing of messages carried over byte streams (UART, pipes, TCP).
+ *
+ * COBS (consistent overhead byte stuffing) removes all zero bytes from a frame at a cost of at most one byte per 254
+ * bytes, a zero byte then delimits frames. SLIP (RFC 1055) delimits frames with END (0xC0) and escapes END and ESC (0xDB)
+ * bytes inside the frame with two-byte sequences.
+ *
+ * The one-shot encoders append the delimiter to the encoded frame. The one-shot decoders accept a frame with or without
+ * its delimiter and may decode in place (dst.data == src.data). The incremental decoder accepts input in arbitrary
+ * chunks, e.g. as returned by a UART driver, and reassembles frames across chunk boundaries.
+ *
+ * Delimiter and escape bytes are located with SSE2/AVX2/NEON compares where available and the bytes in between are
+ * copied as a block, instead of a byte-at-a-time state machine.
+ *
+ * Example usage:
+ * @code
+ * LibEmbd_FrameDecoder_t dec;
+ * libembd_make_frame_decoder(&dec, LIBEMBD_FRAMING_COBS, frame_buffer, sizeof(frame_buffer));
+ *
+ * LibEmbd_ConstBufferView_t chunk = { rx_data, rx_length };
+ * while(chunk.length > 0u){
+ *     if(libembd_frame_decoder_feed(&dec, &chunk) == LIBEMBD_FRAME_DECODER_FRAME_READY){
+ *         handle_frame(libembd_frame_decoder_frame(&dec));
+ *     }
+ * }
+ * @endcode
+ */
+
+typedef uint8 LibEmbd_Framing_Type_t;
+#define LIBEMBD_FRAMING_COBS                        ((LibEmbd_Framing_Type_t)0x00u)
+#define LIBEMBD_FRAMING_SLIP                        ((LibEmbd_Framing_Type_t)0x01u)
+
+#define LIBEMBD_FRAMING_LAST_DO_NOT_USE             ((LibEmbd_Framing_Type_t)0x02u)
+
+typedef uint8 LibEmbd_FrameDecoder_Status_t;
+#define LIBEMBD_FRAME_DECODER_NEED_MORE             ((LibEmbd_FrameDecoder_Status_t)0x00u) //input consumed, frame incomplete
+#define LIBEMBD_FRAME_DECODER_FRAME_READY           ((LibEmbd_FrameDecoder_Status_t)0x01u) //a complete frame is available
+#define LIBEMBD_FRAME_DECODER_ERROR                 ((LibEmbd_FrameDecoder_Status_t)0x02u) //malformed or oversized frame dropped
+
+#define LIBEMBD_FRAME_DECODER_LAST_DO_NOT_USE       ((LibEmbd_FrameDecoder_Status_t)0x03u)
+
+#define LIBEMBD_SLIP_END                            0xC0u
+#define LIBEMBD_SLIP_ESC                            0xDBu
+#define LIBEMBD_SLIP_ESC_END                        0xDCu
+#define LIBEMBD_SLIP_ESC_ESC                        0xDDu
+
+//! worst-case encoded frame size including the delimiter
+#define LIBEMBD_COBS_MAX_ENCODED_LENGTH(length)     ((length) + ((length) / 254u) + 2u)
+#define LIBEMBD_SLIP_MAX_ENCODED_LENGTH(length)     (2u * (length) + 1u)
+
+typedef struct LibEmbd_FrameDecoder_t LibEmbd_FrameDecoder_t;
+
+/**
+ * @brief Encodes a frame and appends the delimiter
+ *
+ * @param src frame to encode
+ * @param dst output buffer, must not overlap src
+ * @param encoded_length pointer to output, number of bytes written to dst
+ * @return E_OK on success, E_NOT_OK if dst is too small (see LIBEMBD_XXX_MAX_ENCODED_LENGTH)
+ */
+LIBEMBD_HEADER_API_INLINE LibEmbd_Std_ReturnType libembd_cobs_encode(LibEmbd_ConstBufferView_t src, LibEmbd_MutableBufferView_t dst, uint16 *encoded_length);
+LIBEMBD_HEADER_API_INLINE LibEmbd_Std_ReturnType libembd_slip_encode(LibEmbd_ConstBufferView_t src, LibEmbd_MutableBufferView_t dst, uint16 *encoded_length);
+
+/**
+ * @brief Decodes a single complete frame
+ *
+ * @param src encoded frame, the trailing delimiter is optional (SLIP also accepts a leading END)
+ * @param dst output buffer, may be the same memory as src for in-place decoding
+ * @param decoded_length pointer to output, number of bytes written to dst
+ * @return E_OK on success, E_NOT_OK if the frame is malformed or dst is too small
+ */
+LIBEMBD_HEADER_API_INLINE LibEmbd_Std_ReturnType libembd_cobs_decode(LibEmbd_ConstBufferView_t src, LibEmbd_MutableBufferView_t dst, uint16 *decoded_length);
+LIBEMBD_HEADER_API_INLINE LibEmbd_Std_ReturnType libembd_slip_decode(LibEmbd_ConstBufferView_t src, LibEmbd_MutableBufferView_t dst, uint16 *decoded_length);
+
+/**
+ * @brief Incremental frame decoder constructor
+ *
+ * @param dec pointer to uninitialized frame decoder object
+ * @param type LIBEMBD_FRAMING_COBS or LIBEMBD_FRAMING_SLIP
+ * @param buffer pointer to buffer receiving the decoded frame
+ * @param capacity size of buffer, frames decoding to more bytes are dropped
+ */
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_make_frame_decoder(LibEmbd_FrameDecoder_t *dec, LibEmbd_Framing_Type_t type, uint8 *buffer, uint16 capacity);
+
+/**
+ * @brief Discards the partially decoded frame
+ *
+ * @param dec pointer to initialized frame decoder object
+ */
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_frame_decoder_reset(LibEmbd_FrameDecoder_t *dec);
+
+/**
+ * @brief Decodes input until a frame is complete, an error occurs or the input is exhausted
+ *
+ * @param dec pointer to initialized frame decoder object
+ * @param input pointer to input view, advanced past the consumed bytes
+ * @return LIBEMBD_FRAME_DECODER_FRAME_READY if a frame is available through libembd_frame_decoder_frame() until the next
+ *         call. LIBEMBD_FRAME_DECODER_ERROR if a frame was dropped, decoding resumes after the next delimiter.
+ *         LIBEMBD_FRAME_DECODER_NEED_MORE once the input is exhausted.
+ * @note Empty frames (consecutive delimiters) are skipped silently.
+ */
+LIBEMBD_HEADER_API_INLINE LibEmbd_FrameDecoder_Status_t libembd_frame_decoder_feed(LibEmbd_FrameDecoder_t *dec, LibEmbd_ConstBufferView_t *input);
+
+/**
+ * @brief View of the last completed frame
+ *
+ * @param dec pointer to initialized frame decoder object
+ * @note Only valid right after libembd_frame_decoder_feed() returned LIBEMBD_FRAME_DECODER_FRAME_READY.
+ */
+LIBEMBD_HEADER_API_INLINE LibEmbd_ConstBufferView_t LIBEMBD_ATTR_ALWAYS_INLINE libembd_frame_decoder_frame(LibEmbd_FrameDecoder_t const *dec);
+
+#include "libembd/internal/libembd_framing_impl.h"
+
+#endif /* LIBEMBD_FRAMING_H_ */
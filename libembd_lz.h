@@ -0,0 +1,123 @@
+#ifndef LIBEMBD_LZ_H_
+#define LIBEMBD_LZ_H_
+
+#include "libembd/libembd_platform_types.h"
+#include "libembd/libembd_common.h"
+#include "libembd/libembd_marshalling.h"
+
+/**
+ * @file libembd_lz.h
+ * @brief Allocation-free LZ77 block compression in the LZ4 block format.
+ *
+ * The compressor is a greedy single-probe matcher over a hash table of LIBEMBD_LZ_HASH_SIZE 16-bit positions, held in
+ * a caller-provided workspace (2KB with the default configuration). Blocks are at most 64KB, so every position and
+ * match offset fits 16 bits. The output is a standard LZ4 block and can be decoded by any LZ4 implementation.
+ *
+ * The decompressor validates every length and offset against the input and output bounds and is safe to use on
+ * untrusted input.
+ *
+ * Framing on top of the serializer:
+ *  - block: 16-bit raw length, 16-bit stored length, stored bytes (all network byte order). A block that does not
+ *    compress is stored verbatim, which is signalled by stored length == raw length.
+ *  - stream: 32-bit total length followed by blocks of up to LIBEMBD_LZ_BLOCK_SIZE raw bytes each. Blocks are
+ *    compressed independently, so data of any size is handled with the same fixed-size workspace.
+ *
+ * Example usage:
+ * @code
+ * LibEmbd_LzWorkspace_t work; //may be static, it is reinitialized on every call
+ * libembd_put_lz_stream_checked(&ser, &work, snapshot, snapshot_length);
+ *
+ * uint32 length;
+ * libembd_get_lz_stream_checked(&deser, restored, sizeof(restored), &length);
+ * @endcode
+ */
+
+//! please make sure the following macros are correctly configured!
+/*--------------------------------------------------- Macro Configurations--------------------------------------------------------*/
+//! log2 of the number of hash table entries (8..16), larger tables find more matches
+#ifndef LIBEMBD_LZ_HASH_LOG
+    #define LIBEMBD_LZ_HASH_LOG                 10u
+#endif
+
+//! raw bytes per block of a compressed stream (at most 65535)
+#ifndef LIBEMBD_LZ_BLOCK_SIZE
+    #define LIBEMBD_LZ_BLOCK_SIZE               4096u
+#endif
+/*--------------------------------------------------- Macro Configurations--------------------------------------------------------*/
+
+#define LIBEMBD_LZ_HASH_SIZE                    (1u << LIBEMBD_LZ_HASH_LOG)
+#define LIBEMBD_LZ_BLOCK_HEADER_SIZE            4u //raw length + stored length
+
+//! worst-case size of an LZ4 block holding length bytes of incompressible input
+#define LIBEMBD_LZ_MAX_COMPRESSED_SIZE(length)  ((length) + ((length) / 255u) + 16u)
+
+typedef struct LibEmbd_LzWorkspace_t LibEmbd_LzWorkspace_t;
+
+/**
+ * @brief Compresses src to an LZ4 block
+ *
+ * @param work pointer to workspace, not used concurrently by another compression
+ * @param src input bytes
+ * @param dst output buffer, must not overlap src
+ * @param compressed_length pointer to output, number of bytes written to dst
+ * @return E_OK on success, E_NOT_OK if the block does not fit into dst (see LIBEMBD_LZ_MAX_COMPRESSED_SIZE)
+ */
+LIBEMBD_HEADER_API_INLINE LibEmbd_Std_ReturnType libembd_lz_compress(LibEmbd_LzWorkspace_t *work, LibEmbd_ConstBufferView_t src, LibEmbd_MutableBufferView_t dst, uint16 *compressed_length);
+
+/**
+ * @brief Decompresses an LZ4 block
+ *
+ * @param src compressed block
+ * @param dst output buffer, must not overlap src
+ * @param decompressed_length pointer to output, number of bytes written to dst
+ * @return E_OK on success, E_NOT_OK if the block is malformed or does not fit into dst
+ */
+LIBEMBD_HEADER_API_INLINE LibEmbd_Std_ReturnType libembd_lz_decompress(LibEmbd_ConstBufferView_t src, LibEmbd_MutableBufferView_t dst, uint16 *decompressed_length);
+
+/**
+ * @brief Writes a framed compressed block to underlying buffer and updates write position
+ *
+ * @param ser pointer to initialized serializer object
+ * @param work pointer to workspace
+ * @param block raw bytes
+ * @note If the framed block does not fit, nothing is written and the sticky overflow flag is set.
+ */
+LIBEMBD_HEADER_API_INLINE void libembd_put_lz_block_checked(LibEmbd_Serializer_t *ser, LibEmbd_LzWorkspace_t *work, LibEmbd_ConstBufferView_t block);
+
+/**
+ * @brief Reads a framed compressed block from underlying buffer and updates read position
+ *
+ * @param deser pointer to initialized deserializer object
+ * @param block output buffer
+ * @param length pointer to output, number of raw bytes written to block
+ * @note If the framed block is truncated, malformed or larger than block, *length is zeroed, the read position is
+ *       left unchanged and the sticky overflow flag is set.
+ */
+LIBEMBD_HEADER_API_INLINE void libembd_get_lz_block_checked(LibEmbd_Deserializer_t *deser, LibEmbd_MutableBufferView_t block, uint16 *length);
+
+/**
+ * @brief Writes data of any length as a compressed stream to underlying buffer and updates write position
+ *
+ * @param ser pointer to initialized serializer object
+ * @param work pointer to workspace
+ * @param data pointer to raw bytes
+ * @param length number of raw bytes
+ * @note If the stream does not fit, the write position is left unchanged and the sticky overflow flag is set.
+ */
+LIBEMBD_HEADER_API_INLINE void libembd_put_lz_stream_checked(LibEmbd_Serializer_t *ser, LibEmbd_LzWorkspace_t *work, const void *data, uint32 length);
+
+/**
+ * @brief Reads a compressed stream from underlying buffer and updates read position
+ *
+ * @param deser pointer to initialized deserializer object
+ * @param data pointer to output buffer
+ * @param capacity size of output buffer
+ * @param length pointer to output, number of raw bytes written to data
+ * @note If the stream is truncated, malformed or larger than capacity, *length is zeroed, the read position is left
+ *       unchanged and the sticky overflow flag is set.
+ */
+LIBEMBD_HEADER_API_INLINE void libembd_get_lz_stream_checked(LibEmbd_Deserializer_t *deser, void *data, uint32 capacity, uint32 *length);
+
+#include "libembd/internal/libembd_lz_impl.h"
+
+#endif /* LIBEMBD_LZ_H_ */
@@ -0,0 +1,120 @@
+#ifndef LIBEMBD_MAPPED_FILE_H_
+#define LIBEMBD_MAPPED_FILE_H_
+
+// open(O_CLOEXEC), ftruncate() and madvise() are hidden by strict -std=c99/c11 builds, must precede any system header
+#if defined(__linux__) && !defined(_DEFAULT_SOURCE)
+    #define _DEFAULT_SOURCE
+#endif
+
+#include "libembd/libembd_platform_types.h"
+#include "libembd/libembd_common.h"
+#include "libembd/libembd_marshalling.h"
+
+/**
+ * @file libembd_mapped_file.h
+ * @brief File-backed (de)serializers over mmap() and a zero-copy iterator for length-prefixed record files.
+ *
+ * A file mapped for reading becomes the buffer of a deserializer, so replaying a capture neither copies the file nor
+ * commits heap memory for it: pages are faulted in from the page cache as the deserializer walks them. A file mapped for
+ * writing is created with the requested size and the serializer writes straight into the page cache.
+ *
+ * Record files are a sequence of records, each a 32-bit network byte order length followed by that many payload bytes.
+ * libembd_get_record_checked() hands out every record as a deserializer over the payload in place.
+ * The record APIs work on any buffer and are available on all platforms, the mapping APIs require Linux.
+ *
+ * Example usage:
+ * @code
+ * LibEmbd_MappedFile_t file;
+ * LibEmbd_Deserializer_t capture;
+ * LibEmbd_Deserializer_t record;
+ *
+ * if(libembd_map_file_for_reading(&file, "capture.bin", LIBEMBD_MAPPED_FILE_SEQUENTIAL, &capture) == E_OK){
+ *     while(libembd_get_record_checked(&capture, &record)){
+ *         replay(&record);
+ *     }
+ *     if(libembd_deserializer_has_overflowed(&capture)) { ... } //truncated last record
+ *     libembd_unmap_file(&file, 0u);
+ * }
+ * @endcode
+ */
+
+#define LIBEMBD_RECORD_HEADER_SIZE                  4u //32-bit length prefix
+
+typedef uint8 LibEmbd_MappedFile_Flags_t; //bitwise or of the flags below
+#define LIBEMBD_MAPPED_FILE_DEFAULT                 ((LibEmbd_MappedFile_Flags_t)0x00u)
+#define LIBEMBD_MAPPED_FILE_SEQUENTIAL              ((LibEmbd_MappedFile_Flags_t)0x01u) //aggressive read-ahead, pages dropped behind the reader
+#define LIBEMBD_MAPPED_FILE_WILLNEED                ((LibEmbd_MappedFile_Flags_t)0x02u) //start reading the whole file in the background
+#define LIBEMBD_MAPPED_FILE_POPULATE                ((LibEmbd_MappedFile_Flags_t)0x04u) //prefault all pages before returning
+#define LIBEMBD_MAPPED_FILE_HUGEPAGES               ((LibEmbd_MappedFile_Flags_t)0x08u) //transparent huge pages where the filesystem supports them
+
+#if defined(__linux__)
+
+typedef struct LibEmbd_MappedFile_t LibEmbd_MappedFile_t;
+
+/**
+ * @brief Maps a whole file read-only and constructs a deserializer over it
+ *
+ * @param file pointer to mapped file object
+ * @param path file to map
+ * @param flags access pattern hints, hints the kernel does not support are ignored
+ * @param deser pointer to deserializer object to construct
+ * @return E_OK on success, E_NOT_OK if the file cannot be opened or mapped or is larger than 4GB
+ * @note An empty file yields a deserializer with zero capacity.
+ */
+LIBEMBD_HEADER_API_INLINE LibEmbd_Std_ReturnType libembd_map_file_for_reading(LibEmbd_MappedFile_t *file, const char *path, LibEmbd_MappedFile_Flags_t flags, LibEmbd_Deserializer_t *deser);
+
+/**
+ * @brief Creates (or truncates) a file of the given size, maps it writable and constructs a serializer over it
+ *
+ * @param file pointer to mapped file object
+ * @param path file to create
+ * @param size file size and serializer capacity, must not be 0
+ * @param flags access pattern hints, hints the kernel does not support are ignored
+ * @param ser pointer to serializer object to construct
+ * @return E_OK on success, E_NOT_OK if the file cannot be created, sized or mapped
+ */
+LIBEMBD_HEADER_API_INLINE LibEmbd_Std_ReturnType libembd_map_file_for_writing(LibEmbd_MappedFile_t *file, const char *path, uint32 size, LibEmbd_MappedFile_Flags_t flags, LibEmbd_Serializer_t *ser);
+
+/**
+ * @brief Unmaps a mapped file, the (de)serializer constructed over it must not be used afterwards
+ *
+ * @param file pointer to mapped file object
+ * @param length for files mapped for writing, the file is truncated to this many bytes (typically the final write
+ *               position). Ignored for files mapped for reading.
+ * @return E_OK on success, E_NOT_OK if the file could not be truncated
+ */
+LIBEMBD_HEADER_API_INLINE LibEmbd_Std_ReturnType libembd_unmap_file(LibEmbd_MappedFile_t *file, uint32 length);
+
+#endif /* __linux__ */
+
+/**
+ * @brief Reserves a record length prefix and returns its position, pass it to libembd_end_record_checked()
+ *
+ * @param ser pointer to initialized serializer object
+ * @return position of the length prefix
+ * @note If the prefix does not fit, the sticky overflow flag is set.
+ */
+LIBEMBD_HEADER_API_INLINE uint32 libembd_begin_record_checked(LibEmbd_Serializer_t *ser);
+
+/**
+ * @brief Completes a record by patching its length prefix with the number of bytes written since it was begun
+ *
+ * @param ser pointer to initialized serializer object
+ * @param start position returned by libembd_begin_record_checked()
+ * @note Nothing is patched if the serializer has overflowed.
+ */
+LIBEMBD_HEADER_API_INLINE void libembd_end_record_checked(LibEmbd_Serializer_t *ser, uint32 start);
+
+/**
+ * @brief Advances to the next record and constructs a deserializer over its payload, without copying
+ *
+ * @param deser pointer to initialized deserializer object positioned at a record boundary
+ * @param record pointer to deserializer object to construct
+ * @return TRUE if a record was read, FALSE at the end of the buffer or on a truncated record
+ * @note A truncated record leaves the read position unchanged and sets the sticky overflow flag, a clean end does not.
+ */
+LIBEMBD_HEADER_API_INLINE boolean libembd_get_record_checked(LibEmbd_Deserializer_t *deser, LibEmbd_Deserializer_t *record);
+
+#include "libembd/internal/libembd_mapped_file_impl.h"
+
+#endif /* LIBEMBD_MAPPED_FILE_H_ */
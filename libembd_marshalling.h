@@ -2,21 +2,36 @@
 #define LIBEMBD_MARSHALLING_H_
 
 #include <stddef.h>
+#include <stdint.h> //uintptr_t
 #include "libembd/libembd_platform_types.h" //uint8 uint16 uint32 float32 typedefs
 #include "libembd/libembd_common.h" //host endianness detection etc.
 #include "libembd/libembd_util.h" //byte swap operations
+#include "libembd/internal/libembd_bswap_impl.h" //vectorized block byte swap
+#include "libembd/internal/libembd_bitpack_impl.h" //bit field kernels
 
 /**
  * @file libEmbd_marshalling.h
  * @brief Serialization/deserialization library for primitive data types with support for endian conversions.
  *
  * This library provides functions to serialize and deserialize primitive data types
- * such as `uint32` and `float32` (see typedef in Platform_Types.h) with optional endianness conversion. It supports both direct
+ * such as `uint32`, `sint64` and `float32` (see typedef in Platform_Types.h) with optional endianness conversion. It supports both direct
  * read/write operations without position adjustments and get/put operations with appropriate position adjustments. 
  * By design, all ser/des APIs provided by this library have "unsafe" included in their names. For performance and ease-of-use considerations,
- * these functions have no return value and it is the user's responsibility to ensure that no buffer overflow can occur by providing 
+ * these functions have no return value and it is the user's responsibility to ensure that no buffer overflow can occur by providing
  * a large enough buffer in initialization. It is undefined behavior if buffer overflow does occur.
  *
+ * For untrusted input, the "checked" get/put APIs are provided. Instead of invoking undefined behavior they set a sticky overflow
+ * flag in the (de)serializer on the first out-of-bounds access, after which all further checked operations become no-ops. The caller
+ * then only needs to query the flag once after the whole message has been processed. Alternatively, libembd_serializer_reserve() and
+ * libembd_deserializer_reserve() validate a fixed-size block once so that the unsafe APIs can be used inside that block.
+ *
+ * When the buffer and the message layout are known to be naturally aligned, the "aligned" put/get variants let the compiler
+ * use single word accesses instead of byte-wise copies on cores without unaligned access support
+ * (see libembd_serializer_is_aligned()).
+ *
+ * For bit-packed payloads such as CAN signals, bit-level (de)serializers transfer fields of 1 to 64 bits at arbitrary bit
+ * offsets in Intel or Motorola bit order (see libembd_make_bit_serializer()).
+ *
  * Example usage:
  * @code
  * #include <stdio.h>
@@ -57,12 +72,28 @@
     #define LIBEMBD_HTONL(x) LIBEMBD_BSWAP32(x)
     #define LIBEMBD_NTOHS(x) LIBEMBD_BSWAP16(x)
     #define LIBEMBD_NTOHL(x) LIBEMBD_BSWAP32(x)
+    #define LIBEMBD_HTONLL(x) LIBEMBD_BSWAP64(x)
+    #define LIBEMBD_NTOHLL(x) LIBEMBD_BSWAP64(x)
+    #define LIBEMBD_HTON16_ARRAY(dst, src, count) libembd_bswap16_copy_internal((dst), (src), (count))
+    #define LIBEMBD_HTON32_ARRAY(dst, src, count) libembd_bswap32_copy_internal((dst), (src), (count))
+    #define LIBEMBD_HTON16_ARRAY_ALIGNED(dst, src, count) libembd_bswap16_copy_aligned_internal((dst), (src), (count))
+    #define LIBEMBD_HTON32_ARRAY_ALIGNED(dst, src, count) libembd_bswap32_copy_aligned_internal((dst), (src), (count))
 #else
     #define LIBEMBD_HTONS(x) (x)
     #define LIBEMBD_HTONL(x) (x)
     #define LIBEMBD_NTOHS(x) (x)
     #define LIBEMBD_NTOHL(x) (x)
+    #define LIBEMBD_HTONLL(x) (x)
+    #define LIBEMBD_NTOHLL(x) (x)
+    #define LIBEMBD_HTON16_ARRAY(dst, src, count) LIBEMBD_MEMCPY((dst), (src), (count) * 2u)
+    #define LIBEMBD_HTON32_ARRAY(dst, src, count) LIBEMBD_MEMCPY((dst), (src), (count) * 4u)
+    #define LIBEMBD_HTON16_ARRAY_ALIGNED(dst, src, count) LIBEMBD_MEMCPY(LIBEMBD_ASSUME_ALIGNED((dst), 2u), LIBEMBD_ASSUME_ALIGNED((src), 2u), (count) * 2u)
+    #define LIBEMBD_HTON32_ARRAY_ALIGNED(dst, src, count) LIBEMBD_MEMCPY(LIBEMBD_ASSUME_ALIGNED((dst), 4u), LIBEMBD_ASSUME_ALIGNED((src), 4u), (count) * 4u)
 #endif
+#define LIBEMBD_NTOH16_ARRAY(dst, src, count) LIBEMBD_HTON16_ARRAY(dst, src, count)
+#define LIBEMBD_NTOH32_ARRAY(dst, src, count) LIBEMBD_HTON32_ARRAY(dst, src, count)
+#define LIBEMBD_NTOH16_ARRAY_ALIGNED(dst, src, count) LIBEMBD_HTON16_ARRAY_ALIGNED(dst, src, count)
+#define LIBEMBD_NTOH32_ARRAY_ALIGNED(dst, src, count) LIBEMBD_HTON32_ARRAY_ALIGNED(dst, src, count)
 
 #define LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(ptr) \
     LIBEMBD_ASSUME((ptr) != NULL)
@@ -73,6 +104,12 @@
 #define LIBEMBD_MARSHALLING_ASSERT_HAS_SPACE_FOR(ser, pos, size) \
     LIBEMBD_ASSUME((pos) + (size) <= (ser)->capacity)
 
+#define LIBEMBD_MARSHALLING_ASSERT_HAS_BITS_FOR(bser, bit_pos, width) \
+    LIBEMBD_ASSUME((uint64)(bit_pos) + (width) <= (uint64)(bser)->capacity * 8u)
+
+#define LIBEMBD_MARSHALLING_ASSERT_VALID_BIT_WIDTH(width) \
+    LIBEMBD_ASSUME(((width) >= 1u) && ((width) <= 64u))
+
 /**
  * @brief Read u8/u16/u32/f32 from host order byte stream at given position
  * @param deser pointer to deserializer containing the byte stream
@@ -126,6 +163,7 @@ typedef struct {
     uint8 *buffer;
     uint32 capacity;
     uint32 position; //write position
+    boolean overflow; //sticky error flag set by the checked apis
 } LibEmbd_Serializer_t;
 
 // Serializer context
@@ -133,8 +171,25 @@ typedef struct {
     uint8 const *buffer;
     uint32 capacity;
     uint32 position; //read position
+    boolean overflow; //sticky error flag set by the checked apis
 } LibEmbd_Deserializer_t;
 
+// Bit-level serializer context
+typedef struct {
+    uint8 *buffer;
+    uint32 capacity; //in bytes
+    uint32 bit_position; //stream write position in bits
+    boolean overflow; //sticky error flag set by the checked apis
+} LibEmbd_BitSerializer_t;
+
+// Bit-level deserializer context
+typedef struct {
+    uint8 const *buffer;
+    uint32 capacity; //in bytes
+    uint32 bit_position; //stream read position in bits
+    boolean overflow; //sticky error flag set by the checked apis
+} LibEmbd_BitDeserializer_t;
+
 /**
  * @brief serializer constructor
  * 
@@ -444,7 +499,7 @@ LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_buffer_unsafe(L
  * @param value pointer to uint8 variable to deserialize into
  * @warning Assumes the underlying buffer is large enough to perform the deserialization
  */
-LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_read_uint8_from_host_unsafe(LibEmbd_Deserializer_t const *deser, uint32 position, uint8 *value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_read_uint8_unsafe(LibEmbd_Deserializer_t const *deser, uint32 position, uint8 *value);
 
 /**
  * @brief Reads uint16 value in network byte order from underlying buffer without updating read position
@@ -517,18 +572,584 @@ LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_read_float32_from_h
  */
 LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_read_buffer_unsafe(LibEmbd_Deserializer_t *deser, uint32 position, void *buffer, uint32 *pLength);
 
+/**
+ * @brief Writes sint8 value to underlying buffer and updates write position
+ *
+ * @param ser pointer to initialized serializer object
+ * @param host_value sint8 value to serialize
+ * @warning assumes the underlying buffer is large enough to perform the serialization
+ */
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_sint8_unsafe(LibEmbd_Serializer_t *ser, sint8 host_value);
+
+/**
+ * @brief Writes uint64/sint16/sint32/sint64/float64 value in network byte order to underlying buffer and updates write position
+ *
+ * @param ser pointer to initialized serializer object
+ * @param host_value value to serialize
+ * @warning assumes the underlying buffer is large enough to perform the serialization
+ */
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_uint64_to_network_unsafe(LibEmbd_Serializer_t *ser, uint64 host_value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_sint16_to_network_unsafe(LibEmbd_Serializer_t *ser, sint16 host_value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_sint32_to_network_unsafe(LibEmbd_Serializer_t *ser, sint32 host_value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_sint64_to_network_unsafe(LibEmbd_Serializer_t *ser, sint64 host_value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_float64_to_network_unsafe(LibEmbd_Serializer_t *ser, float64 host_value);
+
+/**
+ * @brief Writes uint64/sint16/sint32/sint64/float64 value in host byte order to underlying buffer and updates write position
+ *
+ * @param ser pointer to initialized serializer object
+ * @param host_value value to serialize
+ * @warning assumes the underlying buffer is large enough to perform the serialization
+ */
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_uint64_to_host_unsafe(LibEmbd_Serializer_t *ser, uint64 host_value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_sint16_to_host_unsafe(LibEmbd_Serializer_t *ser, sint16 host_value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_sint32_to_host_unsafe(LibEmbd_Serializer_t *ser, sint32 host_value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_sint64_to_host_unsafe(LibEmbd_Serializer_t *ser, sint64 host_value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_float64_to_host_unsafe(LibEmbd_Serializer_t *ser, float64 host_value);
+
+/**
+ * @brief Writes sint8 value to underlying buffer without updating write position
+ *
+ * @param ser pointer to initialized serializer object
+ * @param position the position at which to perform the serialization
+ * @param host_value sint8 value to serialize
+ * @warning assumes the underlying buffer is large enough to perform the serialization
+ */
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_write_sint8_unsafe(LibEmbd_Serializer_t *ser, uint32 position, sint8 host_value);
+
+/**
+ * @brief Writes uint64/sint16/sint32/sint64/float64 value in network byte order to underlying buffer without updating write position
+ *
+ * @param ser pointer to initialized serializer object
+ * @param position the position at which to perform the serialization
+ * @param host_value value to serialize
+ * @warning assumes the underlying buffer is large enough to perform the serialization
+ */
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_write_uint64_to_network_unsafe(LibEmbd_Serializer_t *ser, uint32 position, uint64 host_value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_write_sint16_to_network_unsafe(LibEmbd_Serializer_t *ser, uint32 position, sint16 host_value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_write_sint32_to_network_unsafe(LibEmbd_Serializer_t *ser, uint32 position, sint32 host_value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_write_sint64_to_network_unsafe(LibEmbd_Serializer_t *ser, uint32 position, sint64 host_value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_write_float64_to_network_unsafe(LibEmbd_Serializer_t *ser, uint32 position, float64 host_value);
+
+/**
+ * @brief Writes uint64/sint16/sint32/sint64/float64 value in host byte order to underlying buffer without updating write position
+ *
+ * @param ser pointer to initialized serializer object
+ * @param position the position at which to perform the serialization
+ * @param host_value value to serialize
+ * @warning assumes the underlying buffer is large enough to perform the serialization
+ */
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_write_uint64_to_host_unsafe(LibEmbd_Serializer_t *ser, uint32 position, uint64 host_value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_write_sint16_to_host_unsafe(LibEmbd_Serializer_t *ser, uint32 position, sint16 host_value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_write_sint32_to_host_unsafe(LibEmbd_Serializer_t *ser, uint32 position, sint32 host_value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_write_sint64_to_host_unsafe(LibEmbd_Serializer_t *ser, uint32 position, sint64 host_value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_write_float64_to_host_unsafe(LibEmbd_Serializer_t *ser, uint32 position, float64 host_value);
+
+/**
+ * @brief Reads sint8 value from underlying buffer and updates read position
+ *
+ * @param deser pointer to initialized deserializer object
+ * @param value pointer to sint8 variable to deserialize into
+ * @warning Assumes the underlying buffer is large enough to perform the deserialization
+ */
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_sint8_unsafe(LibEmbd_Deserializer_t *deser, sint8 *value);
+
+/**
+ * @brief Reads uint64/sint16/sint32/sint64/float64 value in network byte order from underlying buffer and updates read position
+ *
+ * @param deser pointer to initialized deserializer object
+ * @param value pointer to variable to deserialize into
+ * @warning Assumes the underlying buffer is large enough to perform the deserialization
+ */
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_uint64_from_network_unsafe(LibEmbd_Deserializer_t *deser, uint64 *value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_sint16_from_network_unsafe(LibEmbd_Deserializer_t *deser, sint16 *value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_sint32_from_network_unsafe(LibEmbd_Deserializer_t *deser, sint32 *value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_sint64_from_network_unsafe(LibEmbd_Deserializer_t *deser, sint64 *value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_float64_from_network_unsafe(LibEmbd_Deserializer_t *deser, float64 *value);
+
+/**
+ * @brief Reads uint64/sint16/sint32/sint64/float64 value in host byte order from underlying buffer and updates read position
+ *
+ * @param deser pointer to initialized deserializer object
+ * @param value pointer to variable to deserialize into
+ * @warning Assumes the underlying buffer is large enough to perform the deserialization
+ */
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_uint64_from_host_unsafe(LibEmbd_Deserializer_t *deser, uint64 *value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_sint16_from_host_unsafe(LibEmbd_Deserializer_t *deser, sint16 *value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_sint32_from_host_unsafe(LibEmbd_Deserializer_t *deser, sint32 *value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_sint64_from_host_unsafe(LibEmbd_Deserializer_t *deser, sint64 *value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_float64_from_host_unsafe(LibEmbd_Deserializer_t *deser, float64 *value);
+
+/**
+ * @brief Reads sint8 value from underlying buffer without updating read position
+ *
+ * @param deser pointer to initialized deserializer object
+ * @param position the position at which to perform the deserialization
+ * @param value pointer to sint8 variable to deserialize into
+ * @warning Assumes the underlying buffer is large enough to perform the deserialization
+ */
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_read_sint8_unsafe(LibEmbd_Deserializer_t const *deser, uint32 position, sint8 *value);
+
+/**
+ * @brief Reads uint64/sint16/sint32/sint64/float64 value in network byte order from underlying buffer without updating read position
+ *
+ * @param deser pointer to initialized deserializer object
+ * @param position the position at which to perform the deserialization
+ * @param value pointer to variable to deserialize into
+ * @warning Assumes the underlying buffer is large enough to perform the deserialization
+ */
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_read_uint64_from_network_unsafe(LibEmbd_Deserializer_t const *deser, uint32 position, uint64 *value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_read_sint16_from_network_unsafe(LibEmbd_Deserializer_t const *deser, uint32 position, sint16 *value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_read_sint32_from_network_unsafe(LibEmbd_Deserializer_t const *deser, uint32 position, sint32 *value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_read_sint64_from_network_unsafe(LibEmbd_Deserializer_t const *deser, uint32 position, sint64 *value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_read_float64_from_network_unsafe(LibEmbd_Deserializer_t const *deser, uint32 position, float64 *value);
+
+/**
+ * @brief Reads uint64/sint16/sint32/sint64/float64 value in host byte order from underlying buffer without updating read position
+ *
+ * @param deser pointer to initialized deserializer object
+ * @param position the position at which to perform the deserialization
+ * @param value pointer to variable to deserialize into
+ * @warning Assumes the underlying buffer is large enough to perform the deserialization
+ */
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_read_uint64_from_host_unsafe(LibEmbd_Deserializer_t const *deser, uint32 position, uint64 *value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_read_sint16_from_host_unsafe(LibEmbd_Deserializer_t const *deser, uint32 position, sint16 *value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_read_sint32_from_host_unsafe(LibEmbd_Deserializer_t const *deser, uint32 position, sint32 *value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_read_sint64_from_host_unsafe(LibEmbd_Deserializer_t const *deser, uint32 position, sint64 *value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_read_float64_from_host_unsafe(LibEmbd_Deserializer_t const *deser, uint32 position, float64 *value);
+
+/**
+ * @brief Checks that size bytes can be written at the current write position
+ *
+ * @param ser pointer to initialized serializer object
+ * @param size number of bytes about to be written
+ * @return TRUE if the block fits and no previous overflow occurred, FALSE otherwise (the overflow flag is set)
+ * @note On TRUE, the caller may use the unsafe put APIs to fill the reserved block without further checks.
+ */
+LIBEMBD_LOCAL_INLINE boolean LIBEMBD_ATTR_ALWAYS_INLINE libembd_serializer_reserve(LibEmbd_Serializer_t *ser, uint32 size);
+
+/**
+ * @brief Checks that size bytes can be read from the current read position
+ *
+ * @param deser pointer to initialized deserializer object
+ * @param size number of bytes about to be read
+ * @return TRUE if the block is available and no previous overflow occurred, FALSE otherwise (the overflow flag is set)
+ * @note On TRUE, the caller may use the unsafe get APIs to consume the reserved block without further checks.
+ */
+LIBEMBD_LOCAL_INLINE boolean LIBEMBD_ATTR_ALWAYS_INLINE libembd_deserializer_reserve(LibEmbd_Deserializer_t *deser, uint32 size);
+
+/**
+ * @brief Query the sticky overflow flag of a serializer
+ *
+ * @param ser pointer to initialized serializer object
+ * @return TRUE if any checked operation or reservation has failed since construction/reset
+ */
+LIBEMBD_LOCAL_INLINE boolean LIBEMBD_ATTR_ALWAYS_INLINE libembd_serializer_has_overflowed(LibEmbd_Serializer_t const *ser);
+
+/**
+ * @brief Query the sticky overflow flag of a deserializer
+ *
+ * @param deser pointer to initialized deserializer object
+ * @return TRUE if any checked operation or reservation has failed since construction/reset
+ */
+LIBEMBD_LOCAL_INLINE boolean LIBEMBD_ATTR_ALWAYS_INLINE libembd_deserializer_has_overflowed(LibEmbd_Deserializer_t const *deser);
+
+/**
+ * @brief Checked counterparts of the unsafe put APIs
+ *
+ * @param ser pointer to initialized serializer object
+ * @param host_value value to serialize
+ * @note If the value does not fit (or the serializer has already overflowed), nothing is written,
+ *       the write position is left unchanged and the sticky overflow flag is set.
+ */
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_uint8_checked(LibEmbd_Serializer_t *ser, uint8 host_value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_uint16_to_network_checked(LibEmbd_Serializer_t *ser, uint16 host_value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_uint16_to_host_checked(LibEmbd_Serializer_t *ser, uint16 host_value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_uint32_to_network_checked(LibEmbd_Serializer_t *ser, uint32 host_value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_uint32_to_host_checked(LibEmbd_Serializer_t *ser, uint32 host_value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_float32_to_network_checked(LibEmbd_Serializer_t *ser, float32 host_value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_float32_to_host_checked(LibEmbd_Serializer_t *ser, float32 host_value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_sint8_checked(LibEmbd_Serializer_t *ser, sint8 host_value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_uint64_to_network_checked(LibEmbd_Serializer_t *ser, uint64 host_value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_uint64_to_host_checked(LibEmbd_Serializer_t *ser, uint64 host_value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_sint16_to_network_checked(LibEmbd_Serializer_t *ser, sint16 host_value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_sint16_to_host_checked(LibEmbd_Serializer_t *ser, sint16 host_value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_sint32_to_network_checked(LibEmbd_Serializer_t *ser, sint32 host_value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_sint32_to_host_checked(LibEmbd_Serializer_t *ser, sint32 host_value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_sint64_to_network_checked(LibEmbd_Serializer_t *ser, sint64 host_value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_sint64_to_host_checked(LibEmbd_Serializer_t *ser, sint64 host_value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_float64_to_network_checked(LibEmbd_Serializer_t *ser, float64 host_value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_float64_to_host_checked(LibEmbd_Serializer_t *ser, float64 host_value);
+
+/**
+ * @brief Writes raw bytes to underlying buffer and updates write position, checked variant
+ *
+ * @param ser pointer to initialized serializer object
+ * @param buffer pointer to input buffer
+ * @param buffer_length input buffer length
+ * @note Either the whole buffer is written or nothing is written and the sticky overflow flag is set.
+ */
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_buffer_checked(LibEmbd_Serializer_t *ser, const void* buffer, uint32 buffer_length);
+
+/**
+ * @brief Checked counterparts of the unsafe get APIs
+ *
+ * @param deser pointer to initialized deserializer object
+ * @param value pointer to variable to deserialize into
+ * @note If not enough bytes remain (or the deserializer has already overflowed), *value is zeroed,
+ *       the read position is left unchanged and the sticky overflow flag is set.
+ */
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_uint8_checked(LibEmbd_Deserializer_t *deser, uint8 *value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_uint16_from_network_checked(LibEmbd_Deserializer_t *deser, uint16 *value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_uint16_from_host_checked(LibEmbd_Deserializer_t *deser, uint16 *value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_uint32_from_network_checked(LibEmbd_Deserializer_t *deser, uint32 *value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_uint32_from_host_checked(LibEmbd_Deserializer_t *deser, uint32 *value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_float32_from_network_checked(LibEmbd_Deserializer_t *deser, float32 *value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_float32_from_host_checked(LibEmbd_Deserializer_t *deser, float32 *value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_sint8_checked(LibEmbd_Deserializer_t *deser, sint8 *value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_uint64_from_network_checked(LibEmbd_Deserializer_t *deser, uint64 *value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_uint64_from_host_checked(LibEmbd_Deserializer_t *deser, uint64 *value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_sint16_from_network_checked(LibEmbd_Deserializer_t *deser, sint16 *value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_sint16_from_host_checked(LibEmbd_Deserializer_t *deser, sint16 *value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_sint32_from_network_checked(LibEmbd_Deserializer_t *deser, sint32 *value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_sint32_from_host_checked(LibEmbd_Deserializer_t *deser, sint32 *value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_sint64_from_network_checked(LibEmbd_Deserializer_t *deser, sint64 *value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_sint64_from_host_checked(LibEmbd_Deserializer_t *deser, sint64 *value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_float64_from_network_checked(LibEmbd_Deserializer_t *deser, float64 *value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_float64_from_host_checked(LibEmbd_Deserializer_t *deser, float64 *value);
+
+/**
+ * @brief Reads exactly length raw bytes from underlying buffer and updates read position, checked variant
+ *
+ * @param deser pointer to initialized deserializer object
+ * @param buffer pointer to output buffer
+ * @param length number of bytes to read
+ * @note Either all length bytes are read or, like the other checked gets, the length bytes of buffer are zeroed,
+ *       the read position is left unchanged and the sticky overflow flag is set.
+ */
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_buffer_checked(LibEmbd_Deserializer_t *deser, void *buffer, uint32 length);
+
+/**
+ * @brief Writes an array of count values in network byte order to underlying buffer and updates write position
+ *
+ * @param ser pointer to initialized serializer object
+ * @param values pointer to the array of values to serialize
+ * @param count number of array elements (not bytes)
+ * @note Byte swapping is performed on whole blocks with SSSE3/AVX2/NEON when available
+ * @warning assumes the underlying buffer is large enough to perform the serialization
+ */
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_uint16_array_to_network_unsafe(LibEmbd_Serializer_t *ser, uint16 const *values, uint32 count);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_uint32_array_to_network_unsafe(LibEmbd_Serializer_t *ser, uint32 const *values, uint32 count);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_float32_array_to_network_unsafe(LibEmbd_Serializer_t *ser, float32 const *values, uint32 count);
+
+/**
+ * @brief Writes an array of count values in host byte order to underlying buffer and updates write position
+ *
+ * @param ser pointer to initialized serializer object
+ * @param values pointer to the array of values to serialize
+ * @param count number of array elements (not bytes)
+ * @warning assumes the underlying buffer is large enough to perform the serialization
+ */
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_uint16_array_to_host_unsafe(LibEmbd_Serializer_t *ser, uint16 const *values, uint32 count);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_uint32_array_to_host_unsafe(LibEmbd_Serializer_t *ser, uint32 const *values, uint32 count);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_float32_array_to_host_unsafe(LibEmbd_Serializer_t *ser, float32 const *values, uint32 count);
+
+/**
+ * @brief Reads an array of count values in network byte order from underlying buffer and updates read position
+ *
+ * @param deser pointer to initialized deserializer object
+ * @param values pointer to the output array
+ * @param count number of array elements (not bytes)
+ * @note Byte swapping is performed on whole blocks with SSSE3/AVX2/NEON when available
+ * @warning Assumes the underlying buffer is large enough to perform the deserialization
+ */
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_uint16_array_from_network_unsafe(LibEmbd_Deserializer_t *deser, uint16 *values, uint32 count);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_uint32_array_from_network_unsafe(LibEmbd_Deserializer_t *deser, uint32 *values, uint32 count);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_float32_array_from_network_unsafe(LibEmbd_Deserializer_t *deser, float32 *values, uint32 count);
+
+/**
+ * @brief Reads an array of count values in host byte order from underlying buffer and updates read position
+ *
+ * @param deser pointer to initialized deserializer object
+ * @param values pointer to the output array
+ * @param count number of array elements (not bytes)
+ * @warning Assumes the underlying buffer is large enough to perform the deserialization
+ */
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_uint16_array_from_host_unsafe(LibEmbd_Deserializer_t *deser, uint16 *values, uint32 count);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_uint32_array_from_host_unsafe(LibEmbd_Deserializer_t *deser, uint32 *values, uint32 count);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_float32_array_from_host_unsafe(LibEmbd_Deserializer_t *deser, float32 *values, uint32 count);
+
+/**
+ * @brief Checked counterparts of the unsafe array put/get APIs
+ *
+ * @note Either the whole array is transferred or nothing is transferred and the sticky overflow flag is set.
+ *       On failure the output array of the get variants is left untouched.
+ */
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_uint16_array_to_network_checked(LibEmbd_Serializer_t *ser, uint16 const *values, uint32 count);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_uint32_array_to_network_checked(LibEmbd_Serializer_t *ser, uint32 const *values, uint32 count);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_float32_array_to_network_checked(LibEmbd_Serializer_t *ser, float32 const *values, uint32 count);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_uint16_array_to_host_checked(LibEmbd_Serializer_t *ser, uint16 const *values, uint32 count);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_uint32_array_to_host_checked(LibEmbd_Serializer_t *ser, uint32 const *values, uint32 count);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_float32_array_to_host_checked(LibEmbd_Serializer_t *ser, float32 const *values, uint32 count);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_uint16_array_from_network_checked(LibEmbd_Deserializer_t *deser, uint16 *values, uint32 count);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_uint32_array_from_network_checked(LibEmbd_Deserializer_t *deser, uint32 *values, uint32 count);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_float32_array_from_network_checked(LibEmbd_Deserializer_t *deser, float32 *values, uint32 count);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_uint16_array_from_host_checked(LibEmbd_Deserializer_t *deser, uint16 *values, uint32 count);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_uint32_array_from_host_checked(LibEmbd_Deserializer_t *deser, uint32 *values, uint32 count);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_float32_array_from_host_checked(LibEmbd_Deserializer_t *deser, float32 *values, uint32 count);
+
+
+
+/**
+ * @brief Returns a view of the next length bytes of the underlying buffer and updates read position
+ *
+ * @param deser pointer to initialized deserializer object
+ * @param length number of bytes to view
+ * @return view pointing directly into the deserializer buffer, no data is copied
+ * @note The view is only valid as long as the buffer the deserializer was constructed with
+ * @warning Assumes the underlying buffer is large enough to perform the read
+ */
+LIBEMBD_LOCAL_INLINE LibEmbd_ConstBufferView_t LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_view_unsafe(LibEmbd_Deserializer_t *deser, uint16 length);
+
+/**
+ * @brief Returns a view of length bytes of the underlying buffer at given position without updating read position
+ *
+ * @param deser pointer to initialized deserializer object
+ * @param position the position at which the view starts
+ * @param length number of bytes to view
+ * @return view pointing directly into the deserializer buffer, no data is copied
+ * @note The view is only valid as long as the buffer the deserializer was constructed with
+ * @warning Assumes the underlying buffer is large enough to perform the read
+ */
+LIBEMBD_LOCAL_INLINE LibEmbd_ConstBufferView_t LIBEMBD_ATTR_ALWAYS_INLINE libembd_read_view_unsafe(LibEmbd_Deserializer_t const *deser, uint32 position, uint16 length);
+
+/**
+ * @brief Returns a view of the next length bytes of the underlying buffer and updates read position, checked variant
+ *
+ * @param deser pointer to initialized deserializer object
+ * @param length number of bytes to view
+ * @return view pointing directly into the deserializer buffer. If not enough bytes remain, an empty view
+ *         (data NULL, length 0) is returned, the read position is left unchanged and the sticky overflow flag is set.
+ */
+LIBEMBD_LOCAL_INLINE LibEmbd_ConstBufferView_t LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_view_checked(LibEmbd_Deserializer_t *deser, uint16 length);
+
+/**
+ * @brief Returns a pointer to count host order values stored in place in the underlying buffer and updates read position
+ *
+ * @param deser pointer to initialized deserializer object
+ * @param count number of array elements (not bytes)
+ * @return pointer into the deserializer buffer if the current read position is naturally aligned for the element type
+ *         and count elements remain, NULL otherwise (nothing is consumed, the caller should fall back to the copying get_array APIs)
+ * @note No data is copied. The returned pointer is only valid as long as the buffer the deserializer was constructed with.
+ * @note A NULL return does not set the sticky overflow flag unless the buffer is too short.
+ */
+LIBEMBD_LOCAL_INLINE uint16 const * LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_uint16_array_in_place_from_host(LibEmbd_Deserializer_t *deser, uint32 count);
+LIBEMBD_LOCAL_INLINE uint32 const * LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_uint32_array_in_place_from_host(LibEmbd_Deserializer_t *deser, uint32 count);
+LIBEMBD_LOCAL_INLINE float32 const * LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_float32_array_in_place_from_host(LibEmbd_Deserializer_t *deser, uint32 count);
+
+/**
+ * @brief Returns TRUE if the current write/read position of the underlying buffer is a multiple of alignment bytes
+ *
+ * @param alignment power of two
+ * @note Checking once per buffer is enough when the message layout keeps every field naturally aligned (e.g. a
+ *       LIBEMBD_DEFINE_MESSAGE layout ordered by decreasing field size), the aligned APIs below may then be used throughout.
+ */
+LIBEMBD_LOCAL_INLINE boolean LIBEMBD_ATTR_ALWAYS_INLINE libembd_serializer_is_aligned(LibEmbd_Serializer_t const *ser, uint32 alignment);
+LIBEMBD_LOCAL_INLINE boolean LIBEMBD_ATTR_ALWAYS_INLINE libembd_deserializer_is_aligned(LibEmbd_Deserializer_t const *deser, uint32 alignment);
+
+/**
+ * @brief Aligned counterparts of the unsafe put/get APIs
+ *
+ * Identical to the unsafe put/get APIs, except that the current position is assumed to be naturally aligned for the
+ * value type. The compiler can then emit single word loads/stores on cores without unaligned access support, where
+ * the generic APIs may be lowered to byte-wise copies. Where LIBEMBD_FAST_UNALIGNED_ACCESS is set they are the generic
+ * APIs.
+ * @warning Undefined behavior if the position is not aligned to sizeof the value type (see libembd_serializer_is_aligned())
+ */
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_uint16_to_network_aligned_unsafe(LibEmbd_Serializer_t *ser, uint16 host_value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_uint32_to_network_aligned_unsafe(LibEmbd_Serializer_t *ser, uint32 host_value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_uint64_to_network_aligned_unsafe(LibEmbd_Serializer_t *ser, uint64 host_value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_sint16_to_network_aligned_unsafe(LibEmbd_Serializer_t *ser, sint16 host_value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_sint32_to_network_aligned_unsafe(LibEmbd_Serializer_t *ser, sint32 host_value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_sint64_to_network_aligned_unsafe(LibEmbd_Serializer_t *ser, sint64 host_value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_float32_to_network_aligned_unsafe(LibEmbd_Serializer_t *ser, float32 host_value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_float64_to_network_aligned_unsafe(LibEmbd_Serializer_t *ser, float64 host_value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_uint16_to_host_aligned_unsafe(LibEmbd_Serializer_t *ser, uint16 host_value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_uint32_to_host_aligned_unsafe(LibEmbd_Serializer_t *ser, uint32 host_value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_uint64_to_host_aligned_unsafe(LibEmbd_Serializer_t *ser, uint64 host_value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_sint16_to_host_aligned_unsafe(LibEmbd_Serializer_t *ser, sint16 host_value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_sint32_to_host_aligned_unsafe(LibEmbd_Serializer_t *ser, sint32 host_value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_sint64_to_host_aligned_unsafe(LibEmbd_Serializer_t *ser, sint64 host_value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_float32_to_host_aligned_unsafe(LibEmbd_Serializer_t *ser, float32 host_value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_float64_to_host_aligned_unsafe(LibEmbd_Serializer_t *ser, float64 host_value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_uint16_from_network_aligned_unsafe(LibEmbd_Deserializer_t *deser, uint16 *value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_uint32_from_network_aligned_unsafe(LibEmbd_Deserializer_t *deser, uint32 *value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_uint64_from_network_aligned_unsafe(LibEmbd_Deserializer_t *deser, uint64 *value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_sint16_from_network_aligned_unsafe(LibEmbd_Deserializer_t *deser, sint16 *value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_sint32_from_network_aligned_unsafe(LibEmbd_Deserializer_t *deser, sint32 *value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_sint64_from_network_aligned_unsafe(LibEmbd_Deserializer_t *deser, sint64 *value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_float32_from_network_aligned_unsafe(LibEmbd_Deserializer_t *deser, float32 *value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_float64_from_network_aligned_unsafe(LibEmbd_Deserializer_t *deser, float64 *value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_uint16_from_host_aligned_unsafe(LibEmbd_Deserializer_t *deser, uint16 *value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_uint32_from_host_aligned_unsafe(LibEmbd_Deserializer_t *deser, uint32 *value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_uint64_from_host_aligned_unsafe(LibEmbd_Deserializer_t *deser, uint64 *value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_sint16_from_host_aligned_unsafe(LibEmbd_Deserializer_t *deser, sint16 *value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_sint32_from_host_aligned_unsafe(LibEmbd_Deserializer_t *deser, sint32 *value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_sint64_from_host_aligned_unsafe(LibEmbd_Deserializer_t *deser, sint64 *value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_float32_from_host_aligned_unsafe(LibEmbd_Deserializer_t *deser, float32 *value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_float64_from_host_aligned_unsafe(LibEmbd_Deserializer_t *deser, float64 *value);
+
+/**
+ * @brief Aligned counterparts of the unsafe array put/get APIs
+ *
+ * Both the current position and the values array are assumed to be naturally aligned for the element type. A short
+ * scalar head brings the buffer side to a vector boundary, after which the byte swap uses aligned vector stores.
+ * @warning Undefined behavior if either side is not aligned to sizeof the element type
+ */
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_uint16_array_to_network_aligned_unsafe(LibEmbd_Serializer_t *ser, uint16 const *values, uint32 count);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_uint32_array_to_network_aligned_unsafe(LibEmbd_Serializer_t *ser, uint32 const *values, uint32 count);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_float32_array_to_network_aligned_unsafe(LibEmbd_Serializer_t *ser, float32 const *values, uint32 count);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_uint16_array_from_network_aligned_unsafe(LibEmbd_Deserializer_t *deser, uint16 *values, uint32 count);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_uint32_array_from_network_aligned_unsafe(LibEmbd_Deserializer_t *deser, uint32 *values, uint32 count);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_float32_array_from_network_aligned_unsafe(LibEmbd_Deserializer_t *deser, float32 *values, uint32 count);
+
+/**
+ * @brief bit-level serializer constructor
+ *
+ * Bit-level (de)serializers pack and unpack fields of 1 to 64 bits at arbitrary bit offsets, as used by CAN signals.
+ * Fields are transferred with 64-bit word operations rather than bit by bit. Two bit orders are supported:
+ *  - Intel (little endian): the field LSB is addressed, higher bits continue towards the MSB of the same byte and then
+ *    into the following bytes.
+ *  - Motorola (big endian): the field MSB is addressed, lower bits continue towards the LSB of the same byte and then
+ *    into the following bytes.
+ * The positional write/read APIs take the start bit as defined by the DBC format, i.e. bit (start_bit % 8) of byte
+ * (start_bit / 8), being the LSB of an Intel signal or the MSB of a Motorola signal. The streaming put/get APIs append
+ * fields back to back at the current bit position instead; a stream should stick to one bit order between byte boundaries.
+ *
+ * @param bser pointer to uninitialized bit serializer object
+ * @param buffer pointer to output buffer
+ * @param capacity length of buffer in bytes
+ */
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_make_bit_serializer(LibEmbd_BitSerializer_t *bser, uint8 *buffer, uint32 capacity);
+
+/**
+ * @brief resets bit serializer for reuse
+ *
+ * @param bser pointer to initialized bit serializer object
+ * @note Rewinds the bit position and clears the overflow flag, the buffer content is left untouched.
+ */
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_reset_bit_serializer(LibEmbd_BitSerializer_t *bser);
+
+/**
+ * @brief bit-level deserializer constructor
+ *
+ * @param bdeser pointer to uninitialized bit deserializer object
+ * @param buffer pointer to input buffer
+ * @param capacity length of buffer in bytes
+ */
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_make_bit_deserializer(LibEmbd_BitDeserializer_t *bdeser, uint8 const *buffer, uint32 capacity);
+
+/**
+ * @brief resets bit deserializer for reuse
+ *
+ * @param bdeser pointer to initialized bit deserializer object
+ */
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_reset_bit_deserializer(LibEmbd_BitDeserializer_t *bdeser);
+
+/**
+ * @brief Query the sticky overflow flag of a bit (de)serializer
+ */
+LIBEMBD_LOCAL_INLINE boolean LIBEMBD_ATTR_ALWAYS_INLINE libembd_bit_serializer_has_overflowed(LibEmbd_BitSerializer_t const *bser);
+LIBEMBD_LOCAL_INLINE boolean LIBEMBD_ATTR_ALWAYS_INLINE libembd_bit_deserializer_has_overflowed(LibEmbd_BitDeserializer_t const *bdeser);
+
+/**
+ * @brief Number of bytes touched by the streaming put APIs so far (bit position rounded up to whole bytes)
+ *
+ * @param bser pointer to initialized bit serializer object
+ */
+LIBEMBD_LOCAL_INLINE uint32 LIBEMBD_ATTR_ALWAYS_INLINE libembd_bit_serializer_byte_length(LibEmbd_BitSerializer_t const *bser);
+
+/**
+ * @brief Writes the low width bits of value at the given DBC start bit, without updating the bit position
+ *
+ * @param bser pointer to initialized bit serializer object
+ * @param start_bit DBC start bit of the field (LSB for Intel, MSB for Motorola)
+ * @param width field width in bits, 1 to 64
+ * @param value field value, bits above width are ignored
+ * @note Bits of the buffer outside the field are preserved.
+ * @warning Assumes the field lies within the buffer
+ */
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_write_bits_intel_unsafe(LibEmbd_BitSerializer_t *bser, uint32 start_bit, uint32 width, uint64 value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_write_bits_motorola_unsafe(LibEmbd_BitSerializer_t *bser, uint32 start_bit, uint32 width, uint64 value);
+
+/**
+ * @brief Reads a width bits wide field at the given DBC start bit, without updating the bit position
+ *
+ * @param bdeser pointer to initialized bit deserializer object
+ * @param start_bit DBC start bit of the field (LSB for Intel, MSB for Motorola)
+ * @param width field width in bits, 1 to 64
+ * @param value pointer to variable receiving the zero extended field value (see libembd_sign_extend_bits)
+ * @warning Assumes the field lies within the buffer
+ */
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_read_bits_intel_unsafe(LibEmbd_BitDeserializer_t const *bdeser, uint32 start_bit, uint32 width, uint64 *value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_read_bits_motorola_unsafe(LibEmbd_BitDeserializer_t const *bdeser, uint32 start_bit, uint32 width, uint64 *value);
+
+/**
+ * @brief Appends the low width bits of value at the current bit position and advances it by width
+ *
+ * @param bser pointer to initialized bit serializer object
+ * @param width field width in bits, 1 to 64
+ * @param value field value, bits above width are ignored
+ * @warning Assumes the buffer is large enough
+ */
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_bits_intel_unsafe(LibEmbd_BitSerializer_t *bser, uint32 width, uint64 value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_bits_motorola_unsafe(LibEmbd_BitSerializer_t *bser, uint32 width, uint64 value);
+
+/**
+ * @brief Reads a width bits wide field at the current bit position and advances it by width
+ *
+ * @param bdeser pointer to initialized bit deserializer object
+ * @param width field width in bits, 1 to 64
+ * @param value pointer to variable receiving the zero extended field value
+ * @warning Assumes the buffer is large enough
+ */
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_bits_intel_unsafe(LibEmbd_BitDeserializer_t *bdeser, uint32 width, uint64 *value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_bits_motorola_unsafe(LibEmbd_BitDeserializer_t *bdeser, uint32 width, uint64 *value);
+
+/**
+ * @brief Checked counterparts of the unsafe bit-level APIs
+ *
+ * @note If the field does not lie within the buffer nothing is written (reads yield 0), the bit position is left
+ *       unchanged and the sticky overflow flag is set.
+ */
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_write_bits_intel_checked(LibEmbd_BitSerializer_t *bser, uint32 start_bit, uint32 width, uint64 value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_write_bits_motorola_checked(LibEmbd_BitSerializer_t *bser, uint32 start_bit, uint32 width, uint64 value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_read_bits_intel_checked(LibEmbd_BitDeserializer_t *bdeser, uint32 start_bit, uint32 width, uint64 *value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_read_bits_motorola_checked(LibEmbd_BitDeserializer_t *bdeser, uint32 start_bit, uint32 width, uint64 *value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_bits_intel_checked(LibEmbd_BitSerializer_t *bser, uint32 width, uint64 value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_bits_motorola_checked(LibEmbd_BitSerializer_t *bser, uint32 width, uint64 value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_bits_intel_checked(LibEmbd_BitDeserializer_t *bdeser, uint32 width, uint64 *value);
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_bits_motorola_checked(LibEmbd_BitDeserializer_t *bdeser, uint32 width, uint64 *value);
+
+/**
+ * @brief Sign extends a width bits wide two's complement field value
+ *
+ * @param value zero extended field value as returned by the bit-level read/get APIs
+ * @param width field width in bits, 1 to 64
+ */
+LIBEMBD_LOCAL_INLINE sint64 LIBEMBD_ATTR_ALWAYS_INLINE libembd_sign_extend_bits(uint64 value, uint32 width);
 
 /*-----------------------------------------------------------------Internal functions Begin----------------------------------------------------------------------------*/
 LIBEMBD_LOCAL_INLINE void libembd_write_to_network_short_internal(LibEmbd_Serializer_t* ser, uint32 const pos, uint16 const val)
 {
     uint16 const network_value = (uint16)LIBEMBD_HTONS(val);
-    LIBEMBD_MEMCPY(&ser->buffer[ser->position], &network_value, sizeof(network_value));
+    LIBEMBD_MEMCPY(&ser->buffer[pos], &network_value, sizeof(network_value));
 }
 
 LIBEMBD_LOCAL_INLINE void libembd_write_to_network_long_internal(LibEmbd_Serializer_t* ser, uint32 const pos, uint32 const val)
 {
     uint32 const network_value = (uint32)LIBEMBD_HTONL(val);
-    LIBEMBD_MEMCPY(&ser->buffer[ser->position], &network_value, sizeof(network_value));
+    LIBEMBD_MEMCPY(&ser->buffer[pos], &network_value, sizeof(network_value));
 }
 
 // Write float32 to network byte order
@@ -601,7 +1222,7 @@ LIBEMBD_LOCAL_INLINE void libembd_read_from_network_float32_internal(LibEmbd_Des
 {
     LIBEMBD_STATIC_ASSERT(sizeof(float32) == sizeof(uint32), "Unexpected type size!");
     uint32 int_value;
-    LIBEMBD_MEMCPY(&int_value, &deser->buffer[deser->position], sizeof(int_value));
+    LIBEMBD_MEMCPY(&int_value, &deser->buffer[pos], sizeof(int_value));
     int_value = (uint32)LIBEMBD_NTOHL(int_value);
     LIBEMBD_MEMCPY(p2val, &int_value, sizeof(*p2val));
    
@@ -612,6 +1233,81 @@ LIBEMBD_LOCAL_INLINE void libembd_get_from_network_float32_internal(LibEmbd_Dese
     libembd_read_from_network_float32_internal(deser, deser->position, p2val);
     deser->position += sizeof(*p2val);
 }
+LIBEMBD_LOCAL_INLINE void libembd_write_to_network_longlong_internal(LibEmbd_Serializer_t* ser, uint32 const pos, uint64 const val)
+{
+    uint64 const network_value = (uint64)LIBEMBD_HTONLL(val);
+    LIBEMBD_MEMCPY(&ser->buffer[pos], &network_value, sizeof(network_value));
+}
+
+LIBEMBD_LOCAL_INLINE void libembd_put_to_network_longlong_internal(LibEmbd_Serializer_t* ser, uint64 val)
+{
+    libembd_write_to_network_longlong_internal(ser, ser->position, val);
+    ser->position += sizeof(uint64);
+}
+
+LIBEMBD_LOCAL_INLINE void libembd_read_from_network_longlong_internal(LibEmbd_Deserializer_t const* deser, uint32 const pos, uint64* p2val)
+{
+    uint64 network_value;
+    LIBEMBD_MEMCPY(&network_value, &deser->buffer[pos], sizeof(network_value));
+    *p2val = (uint64)LIBEMBD_NTOHLL(network_value);
+}
+
+LIBEMBD_LOCAL_INLINE void libembd_get_from_network_longlong_internal(LibEmbd_Deserializer_t* deser, uint64* p2val)
+{
+    libembd_read_from_network_longlong_internal(deser, deser->position, p2val);
+    deser->position += sizeof(*p2val);
+}
+
+// Write float64 to network byte order
+LIBEMBD_LOCAL_INLINE void libembd_write_to_network_float64_internal(LibEmbd_Serializer_t *ser, uint32 const pos, float64 const host_value) {
+    LIBEMBD_STATIC_ASSERT(sizeof(float64) == sizeof(uint64), "Unexpected type size!");
+
+    uint64 int_value;
+    LIBEMBD_MEMCPY(&int_value, &host_value, sizeof(host_value));
+    libembd_write_to_network_longlong_internal(ser, pos, int_value);
+}
+
+LIBEMBD_LOCAL_INLINE void libembd_put_to_network_float64_internal(LibEmbd_Serializer_t *ser, float64 const host_value) {
+    libembd_write_to_network_float64_internal(ser, ser->position, host_value);
+    ser->position += sizeof(host_value);
+}
+
+LIBEMBD_LOCAL_INLINE void libembd_read_from_network_float64_internal(LibEmbd_Deserializer_t const* deser, uint32 const pos, float64* p2val)
+{
+    LIBEMBD_STATIC_ASSERT(sizeof(float64) == sizeof(uint64), "Unexpected type size!");
+    uint64 int_value;
+    libembd_read_from_network_longlong_internal(deser, pos, &int_value);
+    LIBEMBD_MEMCPY(p2val, &int_value, sizeof(*p2val));
+}
+
+LIBEMBD_LOCAL_INLINE void libembd_get_from_network_float64_internal(LibEmbd_Deserializer_t* deser, float64* p2val)
+{
+    libembd_read_from_network_float64_internal(deser, deser->position, p2val);
+    deser->position += sizeof(*p2val);
+}
+
+// Signed integers share the wire representation of the unsigned type of the same width (two's complement)
+#define LIBEMBD_MARSHALLING_SIGNED_NETWORK_INTERNAL_IMPLEMENTATION(STYPE, UTYPE, WIDTH) \
+    LIBEMBD_LOCAL_INLINE void libembd_write_to_network_##STYPE##_internal(LibEmbd_Serializer_t* ser, uint32 const pos, STYPE const val) { \
+        libembd_write_to_network_##WIDTH##_internal(ser, pos, (UTYPE)val); \
+    } \
+    LIBEMBD_LOCAL_INLINE void libembd_put_to_network_##STYPE##_internal(LibEmbd_Serializer_t* ser, STYPE const val) { \
+        libembd_put_to_network_##WIDTH##_internal(ser, (UTYPE)val); \
+    } \
+    LIBEMBD_LOCAL_INLINE void libembd_read_from_network_##STYPE##_internal(LibEmbd_Deserializer_t const* deser, uint32 const pos, STYPE* p2val) { \
+        UTYPE val; \
+        libembd_read_from_network_##WIDTH##_internal(deser, pos, &val); \
+        *p2val = (STYPE)val; \
+    } \
+    LIBEMBD_LOCAL_INLINE void libembd_get_from_network_##STYPE##_internal(LibEmbd_Deserializer_t* deser, STYPE* p2val) { \
+        UTYPE val; \
+        libembd_get_from_network_##WIDTH##_internal(deser, &val); \
+        *p2val = (STYPE)val; \
+    }
+
+LIBEMBD_MARSHALLING_SIGNED_NETWORK_INTERNAL_IMPLEMENTATION(sint16, uint16, short)
+LIBEMBD_MARSHALLING_SIGNED_NETWORK_INTERNAL_IMPLEMENTATION(sint32, uint32, long)
+LIBEMBD_MARSHALLING_SIGNED_NETWORK_INTERNAL_IMPLEMENTATION(sint64, uint64, longlong)
 /*-----------------------------------------------------------------Internal Functions End----------------------------------------------------------------------------*/
 
 /*-----------------------------------------------------------------API Implementaton Begin----------------------------------------------------------------------------*/
@@ -623,6 +1319,7 @@ LIBEMBD_LOCAL_INLINE void libembd_make_serializer(LibEmbd_Serializer_t* ser, uin
     ser->buffer = buffer;
     ser->capacity = capacity;
     ser->position = 0;
+    ser->overflow = FALSE;
 }
 
 LIBEMBD_LOCAL_INLINE void libembd_reset_serializer(LibEmbd_Serializer_t *ser)
@@ -630,6 +1327,7 @@ LIBEMBD_LOCAL_INLINE void libembd_reset_serializer(LibEmbd_Serializer_t *ser)
     LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(ser);
 
     ser->position = 0;
+    ser->overflow = FALSE;
 }
 
 LIBEMBD_LOCAL_INLINE void libembd_make_deserializer(LibEmbd_Deserializer_t* deser, uint8 const* buffer, uint32 const capacity)
@@ -640,6 +1338,7 @@ LIBEMBD_LOCAL_INLINE void libembd_make_deserializer(LibEmbd_Deserializer_t* dese
     deser->buffer = buffer;
     deser->capacity = capacity;
     deser->position = 0;
+    deser->overflow = FALSE;
 }
 
 LIBEMBD_LOCAL_INLINE void libembd_reset_deserializer(LibEmbd_Deserializer_t *deser)
@@ -647,6 +1346,7 @@ LIBEMBD_LOCAL_INLINE void libembd_reset_deserializer(LibEmbd_Deserializer_t *des
     LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(deser);
 
     deser->position = 0;
+    deser->overflow = FALSE;
 }
 
 LIBEMBD_LOCAL_INLINE void libembd_serializer_skip(LibEmbd_Serializer_t * ser, uint32 num_bytes)
@@ -707,7 +1407,7 @@ LIBEMBD_LOCAL_INLINE void libembd_put_uint16_to_network_unsafe(LibEmbd_Serialize
 
 LIBEMBD_LOCAL_INLINE void libembd_write_uint16_to_host_unsafe(LibEmbd_Serializer_t *ser, uint32 position, uint16 host_value) {
     LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(ser);
-    LIBEMBD_MARSHALLING_ASSERT_NO_OVERFLOW(ser, sizeof(host_value));
+    LIBEMBD_MARSHALLING_ASSERT_HAS_SPACE_FOR(ser, position, sizeof(host_value));
 
     /*-----------------------implementation-------------------------*/
     LIBEMBD_MARSHALLING_WRITE_TO_HOST_TYPE_GENERIC(ser, position, host_value);
@@ -801,12 +1501,13 @@ LIBEMBD_LOCAL_INLINE void libembd_put_buffer_unsafe(LibEmbd_Serializer_t *ser, c
 
     /*-----------------------implementation-------------------------*/
     LIBEMBD_MEMCPY(&(ser->buffer[ser->position]), buffer, buffer_length);
+    ser->position += buffer_length;
 }
 
 LIBEMBD_LOCAL_INLINE void libembd_read_uint8_unsafe(LibEmbd_Deserializer_t const *deser, uint32 position, uint8 *host_value) {
     LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(deser);
     LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(host_value);
-    LIBEMBD_MARSHALLING_ASSERT_HAS_SPACE_FOR(deser, position, sizeof(host_value));
+    LIBEMBD_MARSHALLING_ASSERT_HAS_SPACE_FOR(deser, position, sizeof(*host_value));
 
     /*-----------------------implementation-------------------------*/
     libembd_read_u8_internal(deser, position, host_value);
@@ -815,7 +1516,7 @@ LIBEMBD_LOCAL_INLINE void libembd_read_uint8_unsafe(LibEmbd_Deserializer_t const
 LIBEMBD_LOCAL_INLINE void libembd_get_uint8_unsafe(LibEmbd_Deserializer_t *deser, uint8 *host_value) {
     LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(deser);
     LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(host_value);
-    LIBEMBD_MARSHALLING_ASSERT_NO_OVERFLOW(deser, sizeof(host_value));
+    LIBEMBD_MARSHALLING_ASSERT_NO_OVERFLOW(deser, sizeof(*host_value));
 
     /*-----------------------implementation-------------------------*/
     libembd_get_u8_internal(deser, host_value);
@@ -824,7 +1525,7 @@ LIBEMBD_LOCAL_INLINE void libembd_get_uint8_unsafe(LibEmbd_Deserializer_t *deser
 LIBEMBD_LOCAL_INLINE void libembd_read_uint16_from_network_unsafe(LibEmbd_Deserializer_t const *deser, uint32 position, uint16 *host_value) {
     LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(deser);
     LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(host_value);
-    LIBEMBD_MARSHALLING_ASSERT_HAS_SPACE_FOR(deser, position, sizeof(host_value));
+    LIBEMBD_MARSHALLING_ASSERT_HAS_SPACE_FOR(deser, position, sizeof(*host_value));
 
     /*-----------------------implementation-------------------------*/
     libembd_read_from_network_short_internal(deser, position, host_value);
@@ -833,7 +1534,7 @@ LIBEMBD_LOCAL_INLINE void libembd_read_uint16_from_network_unsafe(LibEmbd_Deseri
 LIBEMBD_LOCAL_INLINE void libembd_get_uint16_from_network_unsafe(LibEmbd_Deserializer_t *deser, uint16 *host_value) {
     LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(deser);
     LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(host_value);
-    LIBEMBD_MARSHALLING_ASSERT_NO_OVERFLOW(deser, sizeof(host_value));
+    LIBEMBD_MARSHALLING_ASSERT_NO_OVERFLOW(deser, sizeof(*host_value));
 
     /*-----------------------implementation-------------------------*/
     libembd_get_from_network_short_internal(deser, host_value);
@@ -842,7 +1543,7 @@ LIBEMBD_LOCAL_INLINE void libembd_get_uint16_from_network_unsafe(LibEmbd_Deseria
 LIBEMBD_LOCAL_INLINE void libembd_read_uint16_from_host_unsafe(LibEmbd_Deserializer_t const *deser, uint32 position, uint16 *host_value) {
     LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(deser);
     LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(host_value);
-    LIBEMBD_MARSHALLING_ASSERT_HAS_SPACE_FOR(deser, position, sizeof(host_value));
+    LIBEMBD_MARSHALLING_ASSERT_HAS_SPACE_FOR(deser, position, sizeof(*host_value));
 
     /*-----------------------implementation-------------------------*/
     LIBEMBD_MARSHALLING_READ_FROM_HOST_TYPE_GENERIC(deser, position, host_value);
@@ -851,7 +1552,7 @@ LIBEMBD_LOCAL_INLINE void libembd_read_uint16_from_host_unsafe(LibEmbd_Deseriali
 LIBEMBD_LOCAL_INLINE void libembd_get_uint16_from_host_unsafe(LibEmbd_Deserializer_t *deser, uint16 *host_value) {
     LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(deser);
     LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(host_value);
-    LIBEMBD_MARSHALLING_ASSERT_NO_OVERFLOW(deser, sizeof(host_value));
+    LIBEMBD_MARSHALLING_ASSERT_NO_OVERFLOW(deser, sizeof(*host_value));
 
     /*-----------------------implementation-------------------------*/
     LIBEMBD_MARSHALLING_GET_FROM_HOST_TYPE_GENERIC(deser, host_value);
@@ -860,7 +1561,7 @@ LIBEMBD_LOCAL_INLINE void libembd_get_uint16_from_host_unsafe(LibEmbd_Deserializ
 LIBEMBD_LOCAL_INLINE void libembd_read_uint32_from_network_unsafe(LibEmbd_Deserializer_t const *deser, uint32 position, uint32 *host_value) {
     LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(deser);
     LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(host_value);
-    LIBEMBD_MARSHALLING_ASSERT_HAS_SPACE_FOR(deser, position, sizeof(host_value));
+    LIBEMBD_MARSHALLING_ASSERT_HAS_SPACE_FOR(deser, position, sizeof(*host_value));
 
     /*-----------------------implementation-------------------------*/
     libembd_read_from_network_long_internal(deser, position, host_value);
@@ -869,7 +1570,7 @@ LIBEMBD_LOCAL_INLINE void libembd_read_uint32_from_network_unsafe(LibEmbd_Deseri
 LIBEMBD_LOCAL_INLINE void libembd_get_uint32_from_network_unsafe(LibEmbd_Deserializer_t *deser, uint32 *host_value) {
     LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(deser);
     LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(host_value);
-    LIBEMBD_MARSHALLING_ASSERT_NO_OVERFLOW(deser, sizeof(host_value));
+    LIBEMBD_MARSHALLING_ASSERT_NO_OVERFLOW(deser, sizeof(*host_value));
 
     /*-----------------------implementation-------------------------*/
     libembd_get_from_network_long_internal(deser, host_value);
@@ -878,7 +1579,7 @@ LIBEMBD_LOCAL_INLINE void libembd_get_uint32_from_network_unsafe(LibEmbd_Deseria
 LIBEMBD_LOCAL_INLINE void libembd_read_uint32_from_host_unsafe(LibEmbd_Deserializer_t const *deser, uint32 position, uint32 *host_value) {
     LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(deser);
     LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(host_value);
-    LIBEMBD_MARSHALLING_ASSERT_HAS_SPACE_FOR(deser, position, sizeof(host_value));
+    LIBEMBD_MARSHALLING_ASSERT_HAS_SPACE_FOR(deser, position, sizeof(*host_value));
 
     /*-----------------------implementation-------------------------*/
     LIBEMBD_MARSHALLING_READ_FROM_HOST_TYPE_GENERIC(deser, position, host_value);
@@ -887,7 +1588,7 @@ LIBEMBD_LOCAL_INLINE void libembd_read_uint32_from_host_unsafe(LibEmbd_Deseriali
 LIBEMBD_LOCAL_INLINE void libembd_get_uint32_from_host_unsafe(LibEmbd_Deserializer_t *deser, uint32 *host_value) {
     LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(deser);
     LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(host_value);
-    LIBEMBD_MARSHALLING_ASSERT_NO_OVERFLOW(deser, sizeof(host_value));
+    LIBEMBD_MARSHALLING_ASSERT_NO_OVERFLOW(deser, sizeof(*host_value));
 
     /*-----------------------implementation-------------------------*/
     LIBEMBD_MARSHALLING_GET_FROM_HOST_TYPE_GENERIC(deser, host_value);
@@ -896,7 +1597,7 @@ LIBEMBD_LOCAL_INLINE void libembd_get_uint32_from_host_unsafe(LibEmbd_Deserializ
 LIBEMBD_LOCAL_INLINE void libembd_read_float32_from_network_unsafe(LibEmbd_Deserializer_t const *deser, uint32 position, float32 *host_value) {
     LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(deser);
     LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(host_value);
-    LIBEMBD_MARSHALLING_ASSERT_HAS_SPACE_FOR(deser, position, sizeof(host_value));
+    LIBEMBD_MARSHALLING_ASSERT_HAS_SPACE_FOR(deser, position, sizeof(*host_value));
 
     /*-----------------------implementation-------------------------*/
     libembd_read_from_network_float32_internal(deser, position, host_value);
@@ -905,7 +1606,7 @@ LIBEMBD_LOCAL_INLINE void libembd_read_float32_from_network_unsafe(LibEmbd_Deser
 LIBEMBD_LOCAL_INLINE void libembd_get_float32_from_network_unsafe(LibEmbd_Deserializer_t *deser, float32 *host_value) {
     LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(deser);
     LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(host_value);
-    LIBEMBD_MARSHALLING_ASSERT_NO_OVERFLOW(deser, sizeof(host_value));
+    LIBEMBD_MARSHALLING_ASSERT_NO_OVERFLOW(deser, sizeof(*host_value));
 
     /*-----------------------implementation-------------------------*/
     libembd_get_from_network_float32_internal(deser, host_value);
@@ -914,7 +1615,7 @@ LIBEMBD_LOCAL_INLINE void libembd_get_float32_from_network_unsafe(LibEmbd_Deseri
 LIBEMBD_LOCAL_INLINE void libembd_read_float32_from_host_unsafe(LibEmbd_Deserializer_t const *deser, uint32 position, float32 *host_value) {
     LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(deser);
     LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(host_value);
-    LIBEMBD_MARSHALLING_ASSERT_HAS_SPACE_FOR(deser, position, sizeof(host_value));
+    LIBEMBD_MARSHALLING_ASSERT_HAS_SPACE_FOR(deser, position, sizeof(*host_value));
 
     /*-----------------------implementation-------------------------*/
     LIBEMBD_MARSHALLING_READ_FROM_HOST_TYPE_GENERIC(deser, position, host_value);
@@ -923,7 +1624,7 @@ LIBEMBD_LOCAL_INLINE void libembd_read_float32_from_host_unsafe(LibEmbd_Deserial
 LIBEMBD_LOCAL_INLINE void libembd_get_float32_from_host_unsafe(LibEmbd_Deserializer_t *deser, float32 *host_value) {
     LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(deser);
     LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(host_value);
-    LIBEMBD_MARSHALLING_ASSERT_NO_OVERFLOW(deser, sizeof(host_value));
+    LIBEMBD_MARSHALLING_ASSERT_NO_OVERFLOW(deser, sizeof(*host_value));
 
     /*-----------------------implementation-------------------------*/
     LIBEMBD_MARSHALLING_GET_FROM_HOST_TYPE_GENERIC(deser, host_value);
@@ -951,8 +1652,538 @@ LIBEMBD_LOCAL_INLINE void libembd_get_buffer_unsafe(LibEmbd_Deserializer_t *dese
     uint32 const bytes_in_buffer = deser->capacity - deser->position;
     uint32 const bytes_copied = LIBEMBD_MIN(*pLength, bytes_in_buffer);
     LIBEMBD_MEMCPY(buffer, &(deser->buffer[deser->position]), bytes_copied);
+    deser->position += bytes_copied;
     *pLength = bytes_copied;
 }
+
+#define LIBEMBD_MARSHALLING_OP_IMPLEMENTATION(TYPE, NETWORK_INTERNAL) \
+    LIBEMBD_LOCAL_INLINE void libembd_write_##TYPE##_to_network_unsafe(LibEmbd_Serializer_t *ser, uint32 position, TYPE host_value) { \
+        LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(ser); \
+        LIBEMBD_MARSHALLING_ASSERT_HAS_SPACE_FOR(ser, position, sizeof(host_value)); \
+        libembd_write_to_network_##NETWORK_INTERNAL##_internal(ser, position, host_value); \
+    } \
+    LIBEMBD_LOCAL_INLINE void libembd_put_##TYPE##_to_network_unsafe(LibEmbd_Serializer_t *ser, TYPE host_value) { \
+        LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(ser); \
+        LIBEMBD_MARSHALLING_ASSERT_NO_OVERFLOW(ser, sizeof(host_value)); \
+        libembd_put_to_network_##NETWORK_INTERNAL##_internal(ser, host_value); \
+    } \
+    LIBEMBD_LOCAL_INLINE void libembd_write_##TYPE##_to_host_unsafe(LibEmbd_Serializer_t *ser, uint32 position, TYPE host_value) { \
+        LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(ser); \
+        LIBEMBD_MARSHALLING_ASSERT_HAS_SPACE_FOR(ser, position, sizeof(host_value)); \
+        LIBEMBD_MARSHALLING_WRITE_TO_HOST_TYPE_GENERIC(ser, position, host_value); \
+    } \
+    LIBEMBD_LOCAL_INLINE void libembd_put_##TYPE##_to_host_unsafe(LibEmbd_Serializer_t *ser, TYPE host_value) { \
+        LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(ser); \
+        LIBEMBD_MARSHALLING_ASSERT_NO_OVERFLOW(ser, sizeof(host_value)); \
+        LIBEMBD_MARSHALLING_PUT_TO_HOST_TYPE_GENERIC(ser, host_value); \
+    } \
+    LIBEMBD_LOCAL_INLINE void libembd_read_##TYPE##_from_network_unsafe(LibEmbd_Deserializer_t const *deser, uint32 position, TYPE *host_value) { \
+        LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(deser); \
+        LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(host_value); \
+        LIBEMBD_MARSHALLING_ASSERT_HAS_SPACE_FOR(deser, position, sizeof(*host_value)); \
+        libembd_read_from_network_##NETWORK_INTERNAL##_internal(deser, position, host_value); \
+    } \
+    LIBEMBD_LOCAL_INLINE void libembd_get_##TYPE##_from_network_unsafe(LibEmbd_Deserializer_t *deser, TYPE *host_value) { \
+        LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(deser); \
+        LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(host_value); \
+        LIBEMBD_MARSHALLING_ASSERT_NO_OVERFLOW(deser, sizeof(*host_value)); \
+        libembd_get_from_network_##NETWORK_INTERNAL##_internal(deser, host_value); \
+    } \
+    LIBEMBD_LOCAL_INLINE void libembd_read_##TYPE##_from_host_unsafe(LibEmbd_Deserializer_t const *deser, uint32 position, TYPE *host_value) { \
+        LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(deser); \
+        LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(host_value); \
+        LIBEMBD_MARSHALLING_ASSERT_HAS_SPACE_FOR(deser, position, sizeof(*host_value)); \
+        LIBEMBD_MARSHALLING_READ_FROM_HOST_TYPE_GENERIC(deser, position, host_value); \
+    } \
+    LIBEMBD_LOCAL_INLINE void libembd_get_##TYPE##_from_host_unsafe(LibEmbd_Deserializer_t *deser, TYPE *host_value) { \
+        LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(deser); \
+        LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(host_value); \
+        LIBEMBD_MARSHALLING_ASSERT_NO_OVERFLOW(deser, sizeof(*host_value)); \
+        LIBEMBD_MARSHALLING_GET_FROM_HOST_TYPE_GENERIC(deser, host_value); \
+    }
+
+LIBEMBD_MARSHALLING_OP_IMPLEMENTATION(uint64, longlong)
+LIBEMBD_MARSHALLING_OP_IMPLEMENTATION(sint16, sint16)
+LIBEMBD_MARSHALLING_OP_IMPLEMENTATION(sint32, sint32)
+LIBEMBD_MARSHALLING_OP_IMPLEMENTATION(sint64, sint64)
+LIBEMBD_MARSHALLING_OP_IMPLEMENTATION(float64, float64)
+
+LIBEMBD_LOCAL_INLINE void libembd_write_sint8_unsafe(LibEmbd_Serializer_t *ser, uint32 position, sint8 host_value) {
+    libembd_write_uint8_unsafe(ser, position, (uint8)host_value);
+}
+
+LIBEMBD_LOCAL_INLINE void libembd_put_sint8_unsafe(LibEmbd_Serializer_t *ser, sint8 host_value) {
+    libembd_put_uint8_unsafe(ser, (uint8)host_value);
+}
+
+LIBEMBD_LOCAL_INLINE void libembd_read_sint8_unsafe(LibEmbd_Deserializer_t const *deser, uint32 position, sint8 *host_value) {
+    LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(deser);
+    LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(host_value);
+    LIBEMBD_MARSHALLING_ASSERT_HAS_SPACE_FOR(deser, position, sizeof(*host_value));
+
+    /*-----------------------implementation-------------------------*/
+    LIBEMBD_MARSHALLING_READ_FROM_HOST_TYPE_GENERIC(deser, position, host_value);
+}
+
+LIBEMBD_LOCAL_INLINE void libembd_get_sint8_unsafe(LibEmbd_Deserializer_t *deser, sint8 *host_value) {
+    LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(deser);
+    LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(host_value);
+    LIBEMBD_MARSHALLING_ASSERT_NO_OVERFLOW(deser, sizeof(*host_value));
+
+    /*-----------------------implementation-------------------------*/
+    LIBEMBD_MARSHALLING_GET_FROM_HOST_TYPE_GENERIC(deser, host_value);
+}
+
+LIBEMBD_LOCAL_INLINE boolean libembd_serializer_reserve(LibEmbd_Serializer_t *ser, uint32 size)
+{
+    LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(ser);
+
+    /*-----------------------implementation-------------------------*/
+    //position never exceeds capacity, so the subtraction cannot wrap
+    if(LIBEMBD_UNLIKELY(ser->overflow || (size > ser->capacity - ser->position))){
+        ser->overflow = TRUE;
+        return FALSE;
+    }
+    return TRUE;
+}
+
+LIBEMBD_LOCAL_INLINE boolean libembd_deserializer_reserve(LibEmbd_Deserializer_t *deser, uint32 size)
+{
+    LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(deser);
+
+    /*-----------------------implementation-------------------------*/
+    if(LIBEMBD_UNLIKELY(deser->overflow || (size > deser->capacity - deser->position))){
+        deser->overflow = TRUE;
+        return FALSE;
+    }
+    return TRUE;
+}
+
+LIBEMBD_LOCAL_INLINE boolean libembd_serializer_has_overflowed(LibEmbd_Serializer_t const *ser)
+{
+    return ser->overflow;
+}
+
+LIBEMBD_LOCAL_INLINE boolean libembd_deserializer_has_overflowed(LibEmbd_Deserializer_t const *deser)
+{
+    return deser->overflow;
+}
+
+#define LIBEMBD_MARSHALLING_PUT_CHECKED_IMPLEMENTATION(TYPE, NAME) \
+    LIBEMBD_LOCAL_INLINE void libembd_put_##NAME##_checked(LibEmbd_Serializer_t *ser, TYPE host_value) { \
+        if(libembd_serializer_reserve(ser, sizeof(host_value))) { \
+            libembd_put_##NAME##_unsafe(ser, host_value); \
+        } \
+    }
+
+#define LIBEMBD_MARSHALLING_GET_CHECKED_IMPLEMENTATION(TYPE, NAME) \
+    LIBEMBD_LOCAL_INLINE void libembd_get_##NAME##_checked(LibEmbd_Deserializer_t *deser, TYPE *value) { \
+        LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(value); \
+        if(libembd_deserializer_reserve(deser, sizeof(*value))) { \
+            libembd_get_##NAME##_unsafe(deser, value); \
+        } else { \
+            LIBEMBD_MEMSET(value, 0, sizeof(*value)); \
+        } \
+    }
+
+LIBEMBD_MARSHALLING_PUT_CHECKED_IMPLEMENTATION(uint8, uint8)
+LIBEMBD_MARSHALLING_PUT_CHECKED_IMPLEMENTATION(uint16, uint16_to_network)
+LIBEMBD_MARSHALLING_PUT_CHECKED_IMPLEMENTATION(uint16, uint16_to_host)
+LIBEMBD_MARSHALLING_PUT_CHECKED_IMPLEMENTATION(uint32, uint32_to_network)
+LIBEMBD_MARSHALLING_PUT_CHECKED_IMPLEMENTATION(uint32, uint32_to_host)
+LIBEMBD_MARSHALLING_PUT_CHECKED_IMPLEMENTATION(float32, float32_to_network)
+LIBEMBD_MARSHALLING_PUT_CHECKED_IMPLEMENTATION(float32, float32_to_host)
+LIBEMBD_MARSHALLING_PUT_CHECKED_IMPLEMENTATION(sint8, sint8)
+LIBEMBD_MARSHALLING_PUT_CHECKED_IMPLEMENTATION(uint64, uint64_to_network)
+LIBEMBD_MARSHALLING_PUT_CHECKED_IMPLEMENTATION(uint64, uint64_to_host)
+LIBEMBD_MARSHALLING_PUT_CHECKED_IMPLEMENTATION(sint16, sint16_to_network)
+LIBEMBD_MARSHALLING_PUT_CHECKED_IMPLEMENTATION(sint16, sint16_to_host)
+LIBEMBD_MARSHALLING_PUT_CHECKED_IMPLEMENTATION(sint32, sint32_to_network)
+LIBEMBD_MARSHALLING_PUT_CHECKED_IMPLEMENTATION(sint32, sint32_to_host)
+LIBEMBD_MARSHALLING_PUT_CHECKED_IMPLEMENTATION(sint64, sint64_to_network)
+LIBEMBD_MARSHALLING_PUT_CHECKED_IMPLEMENTATION(sint64, sint64_to_host)
+LIBEMBD_MARSHALLING_PUT_CHECKED_IMPLEMENTATION(float64, float64_to_network)
+LIBEMBD_MARSHALLING_PUT_CHECKED_IMPLEMENTATION(float64, float64_to_host)
+
+LIBEMBD_MARSHALLING_GET_CHECKED_IMPLEMENTATION(uint8, uint8)
+LIBEMBD_MARSHALLING_GET_CHECKED_IMPLEMENTATION(uint16, uint16_from_network)
+LIBEMBD_MARSHALLING_GET_CHECKED_IMPLEMENTATION(uint16, uint16_from_host)
+LIBEMBD_MARSHALLING_GET_CHECKED_IMPLEMENTATION(uint32, uint32_from_network)
+LIBEMBD_MARSHALLING_GET_CHECKED_IMPLEMENTATION(uint32, uint32_from_host)
+LIBEMBD_MARSHALLING_GET_CHECKED_IMPLEMENTATION(float32, float32_from_network)
+LIBEMBD_MARSHALLING_GET_CHECKED_IMPLEMENTATION(float32, float32_from_host)
+LIBEMBD_MARSHALLING_GET_CHECKED_IMPLEMENTATION(sint8, sint8)
+LIBEMBD_MARSHALLING_GET_CHECKED_IMPLEMENTATION(uint64, uint64_from_network)
+LIBEMBD_MARSHALLING_GET_CHECKED_IMPLEMENTATION(uint64, uint64_from_host)
+LIBEMBD_MARSHALLING_GET_CHECKED_IMPLEMENTATION(sint16, sint16_from_network)
+LIBEMBD_MARSHALLING_GET_CHECKED_IMPLEMENTATION(sint16, sint16_from_host)
+LIBEMBD_MARSHALLING_GET_CHECKED_IMPLEMENTATION(sint32, sint32_from_network)
+LIBEMBD_MARSHALLING_GET_CHECKED_IMPLEMENTATION(sint32, sint32_from_host)
+LIBEMBD_MARSHALLING_GET_CHECKED_IMPLEMENTATION(sint64, sint64_from_network)
+LIBEMBD_MARSHALLING_GET_CHECKED_IMPLEMENTATION(sint64, sint64_from_host)
+LIBEMBD_MARSHALLING_GET_CHECKED_IMPLEMENTATION(float64, float64_from_network)
+LIBEMBD_MARSHALLING_GET_CHECKED_IMPLEMENTATION(float64, float64_from_host)
+
+LIBEMBD_LOCAL_INLINE void libembd_put_buffer_checked(LibEmbd_Serializer_t *ser, const void* buffer, uint32 buffer_length)
+{
+    if(libembd_serializer_reserve(ser, buffer_length)){
+        libembd_put_buffer_unsafe(ser, buffer, buffer_length);
+    }
+}
+
+LIBEMBD_LOCAL_INLINE void libembd_get_buffer_checked(LibEmbd_Deserializer_t *deser, void *buffer, uint32 length)
+{
+    if(libembd_deserializer_reserve(deser, length)){
+        libembd_get_buffer_unsafe(deser, buffer, &length);
+    } else {
+        LIBEMBD_MEMSET(buffer, 0, length);
+    }
+}
+#define LIBEMBD_MARSHALLING_ARRAY_IMPLEMENTATION(TYPE, BITS) \
+    LIBEMBD_LOCAL_INLINE void libembd_put_##TYPE##_array_to_network_unsafe(LibEmbd_Serializer_t *ser, TYPE const *values, uint32 count) { \
+        LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(ser); \
+        LIBEMBD_MARSHALLING_ASSERT_NO_OVERFLOW(ser, count * sizeof(TYPE)); \
+        LIBEMBD_HTON##BITS##_ARRAY(&ser->buffer[ser->position], (uint8 const *)values, count); \
+        ser->position += count * sizeof(TYPE); \
+    } \
+    LIBEMBD_LOCAL_INLINE void libembd_put_##TYPE##_array_to_host_unsafe(LibEmbd_Serializer_t *ser, TYPE const *values, uint32 count) { \
+        LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(ser); \
+        LIBEMBD_MARSHALLING_ASSERT_NO_OVERFLOW(ser, count * sizeof(TYPE)); \
+        LIBEMBD_MEMCPY(&ser->buffer[ser->position], values, count * sizeof(TYPE)); \
+        ser->position += count * sizeof(TYPE); \
+    } \
+    LIBEMBD_LOCAL_INLINE void libembd_get_##TYPE##_array_from_network_unsafe(LibEmbd_Deserializer_t *deser, TYPE *values, uint32 count) { \
+        LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(deser); \
+        LIBEMBD_MARSHALLING_ASSERT_NO_OVERFLOW(deser, count * sizeof(TYPE)); \
+        LIBEMBD_NTOH##BITS##_ARRAY((uint8 *)values, &deser->buffer[deser->position], count); \
+        deser->position += count * sizeof(TYPE); \
+    } \
+    LIBEMBD_LOCAL_INLINE void libembd_get_##TYPE##_array_from_host_unsafe(LibEmbd_Deserializer_t *deser, TYPE *values, uint32 count) { \
+        LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(deser); \
+        LIBEMBD_MARSHALLING_ASSERT_NO_OVERFLOW(deser, count * sizeof(TYPE)); \
+        LIBEMBD_MEMCPY(values, &deser->buffer[deser->position], count * sizeof(TYPE)); \
+        deser->position += count * sizeof(TYPE); \
+    } \
+    LIBEMBD_LOCAL_INLINE void libembd_put_##TYPE##_array_to_network_checked(LibEmbd_Serializer_t *ser, TYPE const *values, uint32 count) { \
+        if((count <= UINT32_MAX / sizeof(TYPE)) && libembd_serializer_reserve(ser, count * sizeof(TYPE))) { \
+            libembd_put_##TYPE##_array_to_network_unsafe(ser, values, count); \
+        } else { \
+            ser->overflow = TRUE; \
+        } \
+    } \
+    LIBEMBD_LOCAL_INLINE void libembd_put_##TYPE##_array_to_host_checked(LibEmbd_Serializer_t *ser, TYPE const *values, uint32 count) { \
+        if((count <= UINT32_MAX / sizeof(TYPE)) && libembd_serializer_reserve(ser, count * sizeof(TYPE))) { \
+            libembd_put_##TYPE##_array_to_host_unsafe(ser, values, count); \
+        } else { \
+            ser->overflow = TRUE; \
+        } \
+    } \
+    LIBEMBD_LOCAL_INLINE void libembd_get_##TYPE##_array_from_network_checked(LibEmbd_Deserializer_t *deser, TYPE *values, uint32 count) { \
+        if((count <= UINT32_MAX / sizeof(TYPE)) && libembd_deserializer_reserve(deser, count * sizeof(TYPE))) { \
+            libembd_get_##TYPE##_array_from_network_unsafe(deser, values, count); \
+        } else { \
+            deser->overflow = TRUE; \
+        } \
+    } \
+    LIBEMBD_LOCAL_INLINE void libembd_get_##TYPE##_array_from_host_checked(LibEmbd_Deserializer_t *deser, TYPE *values, uint32 count) { \
+        if((count <= UINT32_MAX / sizeof(TYPE)) && libembd_deserializer_reserve(deser, count * sizeof(TYPE))) { \
+            libembd_get_##TYPE##_array_from_host_unsafe(deser, values, count); \
+        } else { \
+            deser->overflow = TRUE; \
+        } \
+    }
+
+LIBEMBD_MARSHALLING_ARRAY_IMPLEMENTATION(uint16, 16)
+LIBEMBD_MARSHALLING_ARRAY_IMPLEMENTATION(uint32, 32)
+LIBEMBD_MARSHALLING_ARRAY_IMPLEMENTATION(float32, 32)
+LIBEMBD_LOCAL_INLINE LibEmbd_ConstBufferView_t libembd_read_view_unsafe(LibEmbd_Deserializer_t const *deser, uint32 position, uint16 length)
+{
+    LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(deser);
+    LIBEMBD_MARSHALLING_ASSERT_HAS_SPACE_FOR(deser, position, length);
+
+    /*-----------------------implementation-------------------------*/
+    LibEmbd_ConstBufferView_t const view = { &deser->buffer[position], length };
+    return view;
+}
+
+LIBEMBD_LOCAL_INLINE LibEmbd_ConstBufferView_t libembd_get_view_unsafe(LibEmbd_Deserializer_t *deser, uint16 length)
+{
+    LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(deser);
+    LIBEMBD_MARSHALLING_ASSERT_NO_OVERFLOW(deser, length);
+
+    /*-----------------------implementation-------------------------*/
+    LibEmbd_ConstBufferView_t const view = libembd_read_view_unsafe(deser, deser->position, length);
+    deser->position += length;
+    return view;
+}
+
+LIBEMBD_LOCAL_INLINE LibEmbd_ConstBufferView_t libembd_get_view_checked(LibEmbd_Deserializer_t *deser, uint16 length)
+{
+    if(!libembd_deserializer_reserve(deser, length)){
+        LibEmbd_ConstBufferView_t const empty_view = { NULL, 0u };
+        return empty_view;
+    }
+    return libembd_get_view_unsafe(deser, length);
+}
+
+#define LIBEMBD_MARSHALLING_IN_PLACE_ARRAY_IMPLEMENTATION(TYPE) \
+    LIBEMBD_LOCAL_INLINE TYPE const * libembd_get_##TYPE##_array_in_place_from_host(LibEmbd_Deserializer_t *deser, uint32 count) { \
+        LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(deser); \
+        uint8 const * const data = &deser->buffer[deser->position]; \
+        if(((uintptr_t)data % LIBEMBD_ALIGNOF(TYPE)) != 0u) { \
+            return NULL; \
+        } \
+        if((count > UINT32_MAX / sizeof(TYPE)) || !libembd_deserializer_reserve(deser, count * sizeof(TYPE))) { \
+            deser->overflow = TRUE; \
+            return NULL; \
+        } \
+        deser->position += count * sizeof(TYPE); \
+        return (TYPE const *)(void const *)data; \
+    }
+
+LIBEMBD_MARSHALLING_IN_PLACE_ARRAY_IMPLEMENTATION(uint16)
+LIBEMBD_MARSHALLING_IN_PLACE_ARRAY_IMPLEMENTATION(uint32)
+LIBEMBD_MARSHALLING_IN_PLACE_ARRAY_IMPLEMENTATION(float32)
+
+LIBEMBD_LOCAL_INLINE boolean libembd_serializer_is_aligned(LibEmbd_Serializer_t const *ser, uint32 alignment)
+{
+    LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(ser);
+    LIBEMBD_ASSUME(LIBEMBD_IS_POWER_OF_TWO(alignment));
+
+    /*-----------------------implementation-------------------------*/
+    return (((uintptr_t)&ser->buffer[ser->position]) & (alignment - 1u)) == 0u;
+}
+
+LIBEMBD_LOCAL_INLINE boolean libembd_deserializer_is_aligned(LibEmbd_Deserializer_t const *deser, uint32 alignment)
+{
+    LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(deser);
+    LIBEMBD_ASSUME(LIBEMBD_IS_POWER_OF_TWO(alignment));
+
+    /*-----------------------implementation-------------------------*/
+    return (((uintptr_t)&deser->buffer[deser->position]) & (alignment - 1u)) == 0u;
+}
+
+#if LIBEMBD_FAST_UNALIGNED_ACCESS
+// Nothing to gain, forward to the generic APIs: loops over them vectorize, while the bit pattern copies below kept
+// per-element loops scalar
+#define LIBEMBD_MARSHALLING_ALIGNED_OP_IMPLEMENTATION(TYPE, BITS_TYPE, HTON) \
+    LIBEMBD_LOCAL_INLINE void libembd_put_##TYPE##_to_network_aligned_unsafe(LibEmbd_Serializer_t *ser, TYPE host_value) { \
+        libembd_put_##TYPE##_to_network_unsafe(ser, host_value); \
+    } \
+    LIBEMBD_LOCAL_INLINE void libembd_put_##TYPE##_to_host_aligned_unsafe(LibEmbd_Serializer_t *ser, TYPE host_value) { \
+        libembd_put_##TYPE##_to_host_unsafe(ser, host_value); \
+    } \
+    LIBEMBD_LOCAL_INLINE void libembd_get_##TYPE##_from_network_aligned_unsafe(LibEmbd_Deserializer_t *deser, TYPE *host_value) { \
+        libembd_get_##TYPE##_from_network_unsafe(deser, host_value); \
+    } \
+    LIBEMBD_LOCAL_INLINE void libembd_get_##TYPE##_from_host_aligned_unsafe(LibEmbd_Deserializer_t *deser, TYPE *host_value) { \
+        libembd_get_##TYPE##_from_host_unsafe(deser, host_value); \
+    }
+#else
+// The byte swap works on the bit pattern, memcpy through an alignment-annotated pointer compiles to a single access
+#define LIBEMBD_MARSHALLING_ALIGNED_OP_IMPLEMENTATION(TYPE, BITS_TYPE, HTON) \
+    LIBEMBD_LOCAL_INLINE void libembd_put_##TYPE##_to_network_aligned_unsafe(LibEmbd_Serializer_t *ser, TYPE host_value) { \
+        BITS_TYPE bits; \
+        LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(ser); \
+        LIBEMBD_MARSHALLING_ASSERT_NO_OVERFLOW(ser, sizeof(host_value)); \
+        LIBEMBD_MEMCPY(&bits, &host_value, sizeof(bits)); \
+        bits = (BITS_TYPE)HTON(bits); \
+        LIBEMBD_MEMCPY(LIBEMBD_ASSUME_ALIGNED(&ser->buffer[ser->position], sizeof(TYPE)), &bits, sizeof(bits)); \
+        ser->position += sizeof(TYPE); \
+    } \
+    LIBEMBD_LOCAL_INLINE void libembd_put_##TYPE##_to_host_aligned_unsafe(LibEmbd_Serializer_t *ser, TYPE host_value) { \
+        LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(ser); \
+        LIBEMBD_MARSHALLING_ASSERT_NO_OVERFLOW(ser, sizeof(host_value)); \
+        LIBEMBD_MEMCPY(LIBEMBD_ASSUME_ALIGNED(&ser->buffer[ser->position], sizeof(TYPE)), &host_value, sizeof(host_value)); \
+        ser->position += sizeof(TYPE); \
+    } \
+    LIBEMBD_LOCAL_INLINE void libembd_get_##TYPE##_from_network_aligned_unsafe(LibEmbd_Deserializer_t *deser, TYPE *host_value) { \
+        BITS_TYPE bits; \
+        LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(deser); \
+        LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(host_value); \
+        LIBEMBD_MARSHALLING_ASSERT_NO_OVERFLOW(deser, sizeof(*host_value)); \
+        LIBEMBD_MEMCPY(&bits, LIBEMBD_ASSUME_ALIGNED(&deser->buffer[deser->position], sizeof(TYPE)), sizeof(bits)); \
+        bits = (BITS_TYPE)HTON(bits); \
+        LIBEMBD_MEMCPY(host_value, &bits, sizeof(bits)); \
+        deser->position += sizeof(TYPE); \
+    } \
+    LIBEMBD_LOCAL_INLINE void libembd_get_##TYPE##_from_host_aligned_unsafe(LibEmbd_Deserializer_t *deser, TYPE *host_value) { \
+        LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(deser); \
+        LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(host_value); \
+        LIBEMBD_MARSHALLING_ASSERT_NO_OVERFLOW(deser, sizeof(*host_value)); \
+        LIBEMBD_MEMCPY(host_value, LIBEMBD_ASSUME_ALIGNED(&deser->buffer[deser->position], sizeof(TYPE)), sizeof(*host_value)); \
+        deser->position += sizeof(TYPE); \
+    }
+#endif
+
+LIBEMBD_MARSHALLING_ALIGNED_OP_IMPLEMENTATION(uint16, uint16, LIBEMBD_HTONS)
+LIBEMBD_MARSHALLING_ALIGNED_OP_IMPLEMENTATION(uint32, uint32, LIBEMBD_HTONL)
+LIBEMBD_MARSHALLING_ALIGNED_OP_IMPLEMENTATION(uint64, uint64, LIBEMBD_HTONLL)
+LIBEMBD_MARSHALLING_ALIGNED_OP_IMPLEMENTATION(sint16, uint16, LIBEMBD_HTONS)
+LIBEMBD_MARSHALLING_ALIGNED_OP_IMPLEMENTATION(sint32, uint32, LIBEMBD_HTONL)
+LIBEMBD_MARSHALLING_ALIGNED_OP_IMPLEMENTATION(sint64, uint64, LIBEMBD_HTONLL)
+LIBEMBD_MARSHALLING_ALIGNED_OP_IMPLEMENTATION(float32, uint32, LIBEMBD_HTONL)
+LIBEMBD_MARSHALLING_ALIGNED_OP_IMPLEMENTATION(float64, uint64, LIBEMBD_HTONLL)
+
+#define LIBEMBD_MARSHALLING_ALIGNED_ARRAY_IMPLEMENTATION(TYPE, BITS) \
+    LIBEMBD_LOCAL_INLINE void libembd_put_##TYPE##_array_to_network_aligned_unsafe(LibEmbd_Serializer_t *ser, TYPE const *values, uint32 count) { \
+        LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(ser); \
+        LIBEMBD_MARSHALLING_ASSERT_NO_OVERFLOW(ser, count * sizeof(TYPE)); \
+        LIBEMBD_HTON##BITS##_ARRAY_ALIGNED(&ser->buffer[ser->position], (uint8 const *)values, count); \
+        ser->position += count * sizeof(TYPE); \
+    } \
+    LIBEMBD_LOCAL_INLINE void libembd_get_##TYPE##_array_from_network_aligned_unsafe(LibEmbd_Deserializer_t *deser, TYPE *values, uint32 count) { \
+        LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(deser); \
+        LIBEMBD_MARSHALLING_ASSERT_NO_OVERFLOW(deser, count * sizeof(TYPE)); \
+        LIBEMBD_NTOH##BITS##_ARRAY_ALIGNED((uint8 *)values, &deser->buffer[deser->position], count); \
+        deser->position += count * sizeof(TYPE); \
+    }
+
+LIBEMBD_MARSHALLING_ALIGNED_ARRAY_IMPLEMENTATION(uint16, 16)
+LIBEMBD_MARSHALLING_ALIGNED_ARRAY_IMPLEMENTATION(uint32, 32)
+LIBEMBD_MARSHALLING_ALIGNED_ARRAY_IMPLEMENTATION(float32, 32)
+
+LIBEMBD_LOCAL_INLINE void libembd_make_bit_serializer(LibEmbd_BitSerializer_t *bser, uint8 *buffer, uint32 capacity)
+{
+    LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(bser);
+    LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(buffer);
+
+    bser->buffer = buffer;
+    bser->capacity = capacity;
+    bser->bit_position = 0;
+    bser->overflow = FALSE;
+}
+
+LIBEMBD_LOCAL_INLINE void libembd_reset_bit_serializer(LibEmbd_BitSerializer_t *bser)
+{
+    LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(bser);
+
+    bser->bit_position = 0;
+    bser->overflow = FALSE;
+}
+
+LIBEMBD_LOCAL_INLINE void libembd_make_bit_deserializer(LibEmbd_BitDeserializer_t *bdeser, uint8 const *buffer, uint32 capacity)
+{
+    LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(bdeser);
+    LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(buffer);
+
+    bdeser->buffer = buffer;
+    bdeser->capacity = capacity;
+    bdeser->bit_position = 0;
+    bdeser->overflow = FALSE;
+}
+
+LIBEMBD_LOCAL_INLINE void libembd_reset_bit_deserializer(LibEmbd_BitDeserializer_t *bdeser)
+{
+    LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(bdeser);
+
+    bdeser->bit_position = 0;
+    bdeser->overflow = FALSE;
+}
+
+LIBEMBD_LOCAL_INLINE boolean libembd_bit_serializer_has_overflowed(LibEmbd_BitSerializer_t const *bser)
+{
+    return bser->overflow;
+}
+
+LIBEMBD_LOCAL_INLINE boolean libembd_bit_deserializer_has_overflowed(LibEmbd_BitDeserializer_t const *bdeser)
+{
+    return bdeser->overflow;
+}
+
+LIBEMBD_LOCAL_INLINE uint32 libembd_bit_serializer_byte_length(LibEmbd_BitSerializer_t const *bser)
+{
+    return (bser->bit_position + 7u) >> 3u;
+}
+
+LIBEMBD_LOCAL_INLINE sint64 libembd_sign_extend_bits(uint64 value, uint32 width)
+{
+    uint32 const shift = 64u - width;
+    LIBEMBD_MARSHALLING_ASSERT_VALID_BIT_WIDTH(width);
+    return (sint64)(value << shift) >> shift;
+}
+
+// ORDER is intel or motorola, TO_LINEAR maps a DBC start bit to the bit index used by the kernels of that order
+#define LIBEMBD_MARSHALLING_BITS_IMPLEMENTATION(ORDER, TO_LINEAR) \
+    LIBEMBD_LOCAL_INLINE void libembd_write_bits_##ORDER##_unsafe(LibEmbd_BitSerializer_t *bser, uint32 start_bit, uint32 width, uint64 value) { \
+        uint32 const linear = TO_LINEAR(start_bit); \
+        LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(bser); \
+        LIBEMBD_MARSHALLING_ASSERT_VALID_BIT_WIDTH(width); \
+        LIBEMBD_MARSHALLING_ASSERT_HAS_BITS_FOR(bser, linear, width); \
+        libembd_bits_write_##ORDER##_internal(bser->buffer, bser->capacity, linear, width, value); \
+    } \
+    LIBEMBD_LOCAL_INLINE void libembd_read_bits_##ORDER##_unsafe(LibEmbd_BitDeserializer_t const *bdeser, uint32 start_bit, uint32 width, uint64 *value) { \
+        uint32 const linear = TO_LINEAR(start_bit); \
+        LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(bdeser); \
+        LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(value); \
+        LIBEMBD_MARSHALLING_ASSERT_VALID_BIT_WIDTH(width); \
+        LIBEMBD_MARSHALLING_ASSERT_HAS_BITS_FOR(bdeser, linear, width); \
+        *value = libembd_bits_read_##ORDER##_internal(bdeser->buffer, bdeser->capacity, linear, width); \
+    } \
+    LIBEMBD_LOCAL_INLINE void libembd_put_bits_##ORDER##_unsafe(LibEmbd_BitSerializer_t *bser, uint32 width, uint64 value) { \
+        LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(bser); \
+        LIBEMBD_MARSHALLING_ASSERT_VALID_BIT_WIDTH(width); \
+        LIBEMBD_MARSHALLING_ASSERT_HAS_BITS_FOR(bser, bser->bit_position, width); \
+        libembd_bits_write_##ORDER##_internal(bser->buffer, bser->capacity, bser->bit_position, width, value); \
+        bser->bit_position += width; \
+    } \
+    LIBEMBD_LOCAL_INLINE void libembd_get_bits_##ORDER##_unsafe(LibEmbd_BitDeserializer_t *bdeser, uint32 width, uint64 *value) { \
+        LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(bdeser); \
+        LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(value); \
+        LIBEMBD_MARSHALLING_ASSERT_VALID_BIT_WIDTH(width); \
+        LIBEMBD_MARSHALLING_ASSERT_HAS_BITS_FOR(bdeser, bdeser->bit_position, width); \
+        *value = libembd_bits_read_##ORDER##_internal(bdeser->buffer, bdeser->capacity, bdeser->bit_position, width); \
+        bdeser->bit_position += width; \
+    } \
+    LIBEMBD_LOCAL_INLINE void libembd_write_bits_##ORDER##_checked(LibEmbd_BitSerializer_t *bser, uint32 start_bit, uint32 width, uint64 value) { \
+        uint32 const linear = TO_LINEAR(start_bit); \
+        LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(bser); \
+        LIBEMBD_MARSHALLING_ASSERT_VALID_BIT_WIDTH(width); \
+        if(LIBEMBD_UNLIKELY(bser->overflow || ((uint64)linear + width > (uint64)bser->capacity * 8u))) { \
+            bser->overflow = TRUE; \
+            return; \
+        } \
+        libembd_bits_write_##ORDER##_internal(bser->buffer, bser->capacity, linear, width, value); \
+    } \
+    LIBEMBD_LOCAL_INLINE void libembd_read_bits_##ORDER##_checked(LibEmbd_BitDeserializer_t *bdeser, uint32 start_bit, uint32 width, uint64 *value) { \
+        uint32 const linear = TO_LINEAR(start_bit); \
+        LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(bdeser); \
+        LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(value); \
+        LIBEMBD_MARSHALLING_ASSERT_VALID_BIT_WIDTH(width); \
+        if(LIBEMBD_UNLIKELY(bdeser->overflow || ((uint64)linear + width > (uint64)bdeser->capacity * 8u))) { \
+            bdeser->overflow = TRUE; \
+            *value = 0u; \
+            return; \
+        } \
+        *value = libembd_bits_read_##ORDER##_internal(bdeser->buffer, bdeser->capacity, linear, width); \
+    } \
+    LIBEMBD_LOCAL_INLINE void libembd_put_bits_##ORDER##_checked(LibEmbd_BitSerializer_t *bser, uint32 width, uint64 value) { \
+        LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(bser); \
+        LIBEMBD_MARSHALLING_ASSERT_VALID_BIT_WIDTH(width); \
+        if(LIBEMBD_UNLIKELY(bser->overflow || ((uint64)bser->bit_position + width > (uint64)bser->capacity * 8u))) { \
+            bser->overflow = TRUE; \
+            return; \
+        } \
+        libembd_bits_write_##ORDER##_internal(bser->buffer, bser->capacity, bser->bit_position, width, value); \
+        bser->bit_position += width; \
+    } \
+    LIBEMBD_LOCAL_INLINE void libembd_get_bits_##ORDER##_checked(LibEmbd_BitDeserializer_t *bdeser, uint32 width, uint64 *value) { \
+        LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(bdeser); \
+        LIBEMBD_MARSHALLING_ASSERT_POINTER_NOT_NULL(value); \
+        LIBEMBD_MARSHALLING_ASSERT_VALID_BIT_WIDTH(width); \
+        if(LIBEMBD_UNLIKELY(bdeser->overflow || ((uint64)bdeser->bit_position + width > (uint64)bdeser->capacity * 8u))) { \
+            bdeser->overflow = TRUE; \
+            *value = 0u; \
+            return; \
+        } \
+        *value = libembd_bits_read_##ORDER##_internal(bdeser->buffer, bdeser->capacity, bdeser->bit_position, width); \
+        bdeser->bit_position += width; \
+    }
+
+#define LIBEMBD_MARSHALLING_BITS_INTEL_LINEAR_INTERNAL(start_bit)   ((uint32)(start_bit))
+
+LIBEMBD_MARSHALLING_BITS_IMPLEMENTATION(intel, LIBEMBD_MARSHALLING_BITS_INTEL_LINEAR_INTERNAL)
+LIBEMBD_MARSHALLING_BITS_IMPLEMENTATION(motorola, LIBEMBD_BITS_DBC_MOTOROLA_TO_MSB_INTERNAL)
 /*-----------------------------------------------------------------API Implementaton End----------------------------------------------------------------------------*/
 
 #endif /* LIBEMBD_MARSHALLING_H_ */
@@ -0,0 +1,366 @@
+#ifndef LIBEMBD_MARSHALLING_CPP_H_
+#define LIBEMBD_MARSHALLING_CPP_H_
+
+#ifndef __cplusplus
+    #error libembd_marshalling_cpp.h requires a C++17 compiler!
+#endif
+
+#include <array>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "libembd/libembd_platform_types.h"
+#include "libembd/libembd_common.h"
+#include "libembd/libembd_marshalling.h"
+#include "libembd/libembd_message_schema.h"
+
+/**
+ * @file libembd_marshalling_cpp.h
+ * @brief Type-driven C++17 front end for LibEmbd_Serializer_t/LibEmbd_Deserializer_t.
+ *
+ * libembd::Serializer and libembd::Deserializer wrap an existing C (de)serializer, so both APIs can be mixed on the
+ * same buffer. The byte order is a template parameter (libembd::ByteOrder, shared with libembd::MessageLayout) and the
+ * element type is deduced, which replaces the type-suffixed C functions.
+ *
+ * Supported wire types:
+ *  - all arithmetic types of size 1, 2, 4 or 8 bytes (bool is encoded as one byte 0/1) and enums (as underlying type)
+ *  - std::array and built-in arrays, std::pair and std::tuple of supported types
+ *  - structs that list their members with LIBEMBD_WIRE_FIELDS
+ *
+ * The wire size of every supported type is a compile-time constant (libembd::wire_size_v). put()/get() of any number of
+ * values therefore performs a single bounds check, after which every field is stored at a constant offset from the
+ * same base pointer, which lets the compiler merge the individual stores.
+ *
+ * Example usage:
+ * @code
+ * struct Reading {
+ *     uint16 sensor_id;
+ *     uint64 timestamp;
+ *     std::array<float32, 3> xyz;
+ *     LIBEMBD_WIRE_FIELDS(sensor_id, timestamp, xyz)
+ * };
+ * static_assert(libembd::wire_size_v<Reading> == 22u, "");
+ *
+ * libembd::Serializer<libembd::ByteOrder::network> out(ser);
+ * if(!out.put(MSG_ID_READING, reading)) { ... } //not enough space, nothing written
+ *
+ * libembd::Deserializer<libembd::ByteOrder::network> in(deser);
+ * uint8 msg_id;
+ * if(!in.get(msg_id, reading)) { ... }
+ * @endcode
+ */
+
+/**
+ * @brief Declares the wire layout of a struct as the given members in the given order, to be placed inside the struct
+ */
+#define LIBEMBD_WIRE_FIELDS(...) \
+    auto libembd_wire_fields() { return std::tie(__VA_ARGS__); } \
+    auto libembd_wire_fields() const { return std::tie(__VA_ARGS__); }
+
+namespace libembd {
+
+namespace detail {
+
+template <typename T>
+using RemoveCvRef = std::remove_cv_t<std::remove_reference_t<T>>;
+
+template <std::size_t Size> struct WireUint;
+template <> struct WireUint<1u> { using type = uint8; };
+template <> struct WireUint<2u> { using type = uint16; };
+template <> struct WireUint<4u> { using type = uint32; };
+template <> struct WireUint<8u> { using type = uint64; };
+
+template <ByteOrder Order> struct WireSwap {
+    static uint8 apply(uint8 val) { return val; }
+    static uint16 apply(uint16 val) { return val; }
+    static uint32 apply(uint32 val) { return val; }
+    static uint64 apply(uint64 val) { return val; }
+};
+
+template <> struct WireSwap<ByteOrder::network> {
+    static uint8 apply(uint8 val) { return val; }
+    static uint16 apply(uint16 val) { return (uint16)LIBEMBD_HTONS(val); }
+    static uint32 apply(uint32 val) { return (uint32)LIBEMBD_HTONL(val); }
+    static uint64 apply(uint64 val) { return (uint64)LIBEMBD_HTONLL(val); }
+};
+
+template <typename T, typename Enable = void> struct Codec; //unsupported wire type
+
+template <typename T> struct HasWireFields {
+    template <typename U> static auto test(int) -> decltype(std::declval<U const &>().libembd_wire_fields(), std::true_type{});
+    template <typename U> static std::false_type test(...);
+    static constexpr bool value = decltype(test<T>(0))::value;
+};
+
+/**
+ * @brief Consecutive fields of types Ts, stored from/loaded into tuples of values or references
+ */
+template <typename... Ts> struct FieldList {
+    static constexpr uint32 size = (0u + ... + Codec<Ts>::size);
+
+    template <std::size_t Index>
+    static constexpr uint32 offset() {
+        constexpr uint32 sizes[] = { Codec<Ts>::size..., 0u };
+        uint32 result = 0u;
+        for(std::size_t i = 0; i < Index; i++){
+            result += sizes[i];
+        }
+        return result;
+    }
+
+    template <ByteOrder Order, typename Tuple>
+    static void store(uint8 *dst, Tuple const &values) {
+        store_internal<Order>(dst, values, std::index_sequence_for<Ts...>{});
+    }
+
+    template <ByteOrder Order, typename Tuple>
+    static void load(uint8 const *src, Tuple &&values) {
+        load_internal<Order>(src, values, std::index_sequence_for<Ts...>{});
+    }
+
+private:
+    template <ByteOrder Order, typename Tuple, std::size_t... Is>
+    static void store_internal(uint8 *dst, Tuple const &values, std::index_sequence<Is...>) {
+        (Codec<Ts>::template store<Order>(dst + offset<Is>(), std::get<Is>(values)), ...);
+    }
+
+    template <ByteOrder Order, typename Tuple, std::size_t... Is>
+    static void load_internal(uint8 const *src, Tuple &values, std::index_sequence<Is...>) {
+        (Codec<Ts>::template load<Order>(src + offset<Is>(), std::get<Is>(values)), ...);
+    }
+};
+
+template <typename T>
+struct Codec<T, std::enable_if_t<std::is_arithmetic_v<T>>> {
+    static_assert((sizeof(T) == 1u) || (sizeof(T) == 2u) || (sizeof(T) == 4u) || (sizeof(T) == 8u), "Unsupported arithmetic type size!");
+    using Uint = typename WireUint<sizeof(T)>::type;
+    static constexpr uint32 size = sizeof(T);
+
+    template <ByteOrder Order>
+    static void store(uint8 *dst, T const &val) {
+        Uint bits;
+        if constexpr (std::is_same_v<T, bool>) {
+            bits = val ? 1u : 0u;
+        } else {
+            LIBEMBD_MEMCPY(&bits, &val, sizeof(bits));
+        }
+        bits = WireSwap<Order>::apply(bits);
+        LIBEMBD_MEMCPY(dst, &bits, sizeof(bits));
+    }
+
+    template <ByteOrder Order>
+    static void load(uint8 const *src, T &val) {
+        Uint bits;
+        LIBEMBD_MEMCPY(&bits, src, sizeof(bits));
+        bits = WireSwap<Order>::apply(bits);
+        if constexpr (std::is_same_v<T, bool>) {
+            val = (bits != 0u);
+        } else {
+            LIBEMBD_MEMCPY(&val, &bits, sizeof(bits));
+        }
+    }
+};
+
+template <typename T>
+struct Codec<T, std::enable_if_t<std::is_enum_v<T>>> {
+    using Underlying = std::underlying_type_t<T>;
+    static constexpr uint32 size = Codec<Underlying>::size;
+
+    template <ByteOrder Order>
+    static void store(uint8 *dst, T const &val) { Codec<Underlying>::template store<Order>(dst, static_cast<Underlying>(val)); }
+
+    template <ByteOrder Order>
+    static void load(uint8 const *src, T &val) {
+        Underlying raw;
+        Codec<Underlying>::template load<Order>(src, raw);
+        val = static_cast<T>(raw);
+    }
+};
+
+template <typename E, std::size_t N>
+struct Codec<E[N], void> {
+    static constexpr uint32 size = (uint32)N * Codec<E>::size;
+
+    template <ByteOrder Order>
+    static void store(uint8 *dst, E const (&vals)[N]) {
+        for(std::size_t i = 0; i < N; i++){
+            Codec<E>::template store<Order>(dst + i * Codec<E>::size, vals[i]);
+        }
+    }
+
+    template <ByteOrder Order>
+    static void load(uint8 const *src, E (&vals)[N]) {
+        for(std::size_t i = 0; i < N; i++){
+            Codec<E>::template load<Order>(src + i * Codec<E>::size, vals[i]);
+        }
+    }
+};
+
+template <typename E, std::size_t N>
+struct Codec<std::array<E, N>, void> {
+    static constexpr uint32 size = (uint32)N * Codec<E>::size;
+
+    template <ByteOrder Order>
+    static void store(uint8 *dst, std::array<E, N> const &vals) {
+        for(std::size_t i = 0; i < N; i++){
+            Codec<E>::template store<Order>(dst + i * Codec<E>::size, vals[i]);
+        }
+    }
+
+    template <ByteOrder Order>
+    static void load(uint8 const *src, std::array<E, N> &vals) {
+        for(std::size_t i = 0; i < N; i++){
+            Codec<E>::template load<Order>(src + i * Codec<E>::size, vals[i]);
+        }
+    }
+};
+
+template <typename... Ts>
+struct Codec<std::tuple<Ts...>, void> {
+    using Fields = FieldList<Ts...>;
+    static constexpr uint32 size = Fields::size;
+
+    template <ByteOrder Order>
+    static void store(uint8 *dst, std::tuple<Ts...> const &vals) { Fields::template store<Order>(dst, vals); }
+
+    template <ByteOrder Order>
+    static void load(uint8 const *src, std::tuple<Ts...> &vals) { Fields::template load<Order>(src, vals); }
+};
+
+template <typename T1, typename T2>
+struct Codec<std::pair<T1, T2>, void> {
+    using Fields = FieldList<T1, T2>;
+    static constexpr uint32 size = Fields::size;
+
+    template <ByteOrder Order>
+    static void store(uint8 *dst, std::pair<T1, T2> const &vals) { Fields::template store<Order>(dst, std::tie(vals.first, vals.second)); }
+
+    template <ByteOrder Order>
+    static void load(uint8 const *src, std::pair<T1, T2> &vals) { Fields::template load<Order>(src, std::tie(vals.first, vals.second)); }
+};
+
+template <typename Tuple> struct FieldListOf;
+template <typename... Ts> struct FieldListOf<std::tuple<Ts...>> { using type = FieldList<RemoveCvRef<Ts>...>; };
+
+template <typename T>
+struct Codec<T, std::enable_if_t<HasWireFields<T>::value>> {
+    using Fields = typename FieldListOf<decltype(std::declval<T const &>().libembd_wire_fields())>::type;
+    static constexpr uint32 size = Fields::size;
+
+    template <ByteOrder Order>
+    static void store(uint8 *dst, T const &val) { Fields::template store<Order>(dst, val.libembd_wire_fields()); }
+
+    template <ByteOrder Order>
+    static void load(uint8 const *src, T &val) { Fields::template load<Order>(src, val.libembd_wire_fields()); }
+};
+
+} // namespace detail
+
+/**
+ * @brief Total wire size of the given types (compile-time constant)
+ */
+template <typename... Ts>
+inline constexpr uint32 wire_size_v = detail::FieldList<detail::RemoveCvRef<Ts>...>::size;
+
+/**
+ * @brief Typed serializer over an existing LibEmbd_Serializer_t
+ *
+ * @tparam Order wire byte order of all values
+ */
+template <ByteOrder Order = ByteOrder::network>
+class Serializer {
+public:
+    explicit Serializer(LibEmbd_Serializer_t &ser) : ser_(&ser) {}
+
+    /**
+     * @brief Serialize values at the current position with a single bounds check
+     * @return TRUE on success, FALSE if the values do not fit (nothing is written and the sticky overflow flag is set)
+     */
+    template <typename... Ts>
+    boolean put(Ts const &... values) {
+        if(!libembd_serializer_reserve(ser_, wire_size_v<Ts...>)){
+            return FALSE;
+        }
+        put_unsafe(values...);
+        return TRUE;
+    }
+
+    /**
+     * @brief Serialize values at the current position without bounds check
+     */
+    template <typename... Ts>
+    void put_unsafe(Ts const &... values) {
+        write_unsafe(ser_->position, values...);
+        ser_->position += wire_size_v<Ts...>;
+    }
+
+    /**
+     * @brief Serialize values at the given position without bounds check, the current position is left unchanged
+     */
+    template <typename... Ts>
+    void write_unsafe(uint32 position, Ts const &... values) {
+        LIBEMBD_MARSHALLING_ASSERT_HAS_SPACE_FOR(ser_, position, wire_size_v<Ts...>);
+        detail::FieldList<Ts...>::template store<Order>(&ser_->buffer[position], std::tie(values...));
+    }
+
+    boolean has_overflowed() const { return libembd_serializer_has_overflowed(ser_); }
+    uint32 position() const { return ser_->position; }
+    LibEmbd_Serializer_t &raw() const { return *ser_; }
+
+private:
+    LibEmbd_Serializer_t *ser_;
+};
+
+/**
+ * @brief Typed deserializer over an existing LibEmbd_Deserializer_t
+ *
+ * @tparam Order wire byte order of all values
+ */
+template <ByteOrder Order = ByteOrder::network>
+class Deserializer {
+public:
+    explicit Deserializer(LibEmbd_Deserializer_t &deser) : deser_(&deser) {}
+
+    /**
+     * @brief Deserialize values from the current position with a single bounds check
+     * @return TRUE on success, FALSE if not enough bytes remain (values are unchanged and the sticky overflow flag is set)
+     */
+    template <typename... Ts>
+    boolean get(Ts &... values) {
+        if(!libembd_deserializer_reserve(deser_, wire_size_v<Ts...>)){
+            return FALSE;
+        }
+        get_unsafe(values...);
+        return TRUE;
+    }
+
+    /**
+     * @brief Deserialize values from the current position without bounds check
+     */
+    template <typename... Ts>
+    void get_unsafe(Ts &... values) {
+        read_unsafe(deser_->position, values...);
+        deser_->position += wire_size_v<Ts...>;
+    }
+
+    /**
+     * @brief Deserialize values from the given position without bounds check, the current position is left unchanged
+     */
+    template <typename... Ts>
+    void read_unsafe(uint32 position, Ts &... values) const {
+        LIBEMBD_MARSHALLING_ASSERT_HAS_SPACE_FOR(deser_, position, wire_size_v<Ts...>);
+        detail::FieldList<Ts...>::template load<Order>(&deser_->buffer[position], std::tie(values...));
+    }
+
+    boolean has_overflowed() const { return libembd_deserializer_has_overflowed(deser_); }
+    uint32 position() const { return deser_->position; }
+    LibEmbd_Deserializer_t &raw() const { return *deser_; }
+
+private:
+    LibEmbd_Deserializer_t *deser_;
+};
+
+} // namespace libembd
+
+#endif /* LIBEMBD_MARSHALLING_CPP_H_ */
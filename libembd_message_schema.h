@@ -0,0 +1,471 @@
+#ifndef LIBEMBD_MESSAGE_SCHEMA_H_
+#define LIBEMBD_MESSAGE_SCHEMA_H_
+
+#include <stddef.h> //offsetof
+#include "libembd/libembd_platform_types.h"
+#include "libembd/libembd_common.h"
+#include "libembd/libembd_marshalling.h"
+
+/**
+ * @file libembd_message_schema.h
+ * @brief Schema-driven fixed-layout messages with generated pack/unpack functions.
+ *
+ * A message is described exactly once as an X-macro list of (type, name, byte order) entries, where byte order is
+ * either `network` or `host`. From that list LIBEMBD_DEFINE_MESSAGE generates:
+ *  - `NAME_t`: the host side struct holding the decoded fields
+ *  - `NAME_Wire_t`: a padding-free byte image of the wire layout used to derive compile-time field offsets
+ *  - `NAME_pack()`/`NAME_unpack()`: (de)serialize the whole message at the current position with a single bounds check
+ *
+ * Since every field is accessed at a compile-time constant offset from the same base, the compiler is free to
+ * merge adjacent stores/loads instead of updating the position after every field.
+ *
+ * Example usage:
+ * @code
+ * #define STATUS_MSG_FIELDS(FIELD) \
+ *     FIELD(uint16,  msg_id,    network) \
+ *     FIELD(uint64,  timestamp, network) \
+ *     FIELD(float32, value,     network) \
+ *     FIELD(uint8,   flags,     host)
+ *
+ * LIBEMBD_DEFINE_MESSAGE(StatusMsg, STATUS_MSG_FIELDS)
+ *
+ * LIBEMBD_STATIC_ASSERT(LIBEMBD_MESSAGE_SIZE(StatusMsg) == 15u, "");
+ * LIBEMBD_STATIC_ASSERT(LIBEMBD_MESSAGE_OFFSET(StatusMsg, value) == 10u, "");
+ *
+ * StatusMsg_t msg = { 0x42u, 123456789u, 3.14f, 0x01u };
+ * if(!StatusMsg_pack(&ser, &msg)) {
+ *     // not enough space, serializer overflow flag is set
+ * }
+ * @endcode
+ *
+ * Handlers that only need a few fields of a large message can skip the full unpack: NAME_view() merely checks that the
+ * whole message is present and constructs a deserializer over it, LIBEMBD_MESSAGE_VIEW_GET() then loads a single field
+ * on demand with one (byte-swapped) load at its compile-time offset. No other field is ever touched.
+ * @code
+ * LibEmbd_Deserializer_t view;
+ * uint64 timestamp;
+ * if(StatusMsg_view(&deser, &view)) {
+ *     LIBEMBD_MESSAGE_VIEW_GET(StatusMsg, &view, timestamp, &timestamp);
+ * }
+ * @endcode
+ *
+ * For C++ users an equivalent constexpr facility (libembd::MessageLayout) is provided that works on existing structs.
+ *
+ * Bit-level frames (e.g. CAN/CAN-FD) are described the same way with LIBEMBD_DEFINE_SIGNAL_FRAME, where every entry gives
+ * the DBC start bit, the width in bits and the bit order (`intel` or `motorola`) of an integer signal:
+ * @code
+ * #define ENGINE_FRAME_SIGNALS(SIGNAL) \
+ *     SIGNAL(uint16,  rpm,         0, 14, intel) \
+ *     SIGNAL(sint8,   coolant,    14,  8, intel) \
+ *     SIGNAL(uint32,  odometer,   39, 24, motorola)
+ *
+ * LIBEMBD_DEFINE_SIGNAL_FRAME(EngineFrame, 8u, ENGINE_FRAME_SIGNALS)
+ *
+ * EngineFrame_t frame = { 3000u, -12, 123456u };
+ * (void)EngineFrame_pack(&ser, &frame);
+ * @endcode
+ */
+
+/**
+ * @brief Total wire size of a message defined with LIBEMBD_DEFINE_MESSAGE (compile-time constant)
+ */
+#define LIBEMBD_MESSAGE_SIZE(NAME)              ((uint32)sizeof(NAME##_Wire_t))
+
+/**
+ * @brief Wire offset of a field of a message defined with LIBEMBD_DEFINE_MESSAGE (compile-time constant)
+ */
+#define LIBEMBD_MESSAGE_OFFSET(NAME, FIELD)     ((uint32)offsetof(NAME##_Wire_t, FIELD))
+
+/**
+ * @brief Reads a single field out of a view constructed by NAME_view(), without decoding any other field
+ *
+ * @param NAME message name
+ * @param VIEW pointer to the view deserializer
+ * @param FIELD field name
+ * @param P2VAL pointer to output, its type must have the size of the field (checked at compile time)
+ */
+#define LIBEMBD_MESSAGE_VIEW_GET(NAME, VIEW, FIELD, P2VAL) \
+    libembd_schema_view_read_internal((VIEW), LIBEMBD_MESSAGE_OFFSET(NAME, FIELD), \
+        LIBEMBD_SCHEMA_CHECKED_FIELD_SIZE_INTERNAL(NAME, FIELD, P2VAL), \
+        (sizeof(((NAME##_Order_t *)0)->FIELD) == LIBEMBD_SCHEMA_ORDER_network_INTERNAL) ? TRUE : FALSE, (P2VAL))
+
+/*-----------------------------------------------------------------Internal functions Begin----------------------------------------------------------------------------*/
+// Uniform (type, byte order) accessors so that the generated code can paste the type and byte order tokens
+#define LIBEMBD_SCHEMA_ACCESSOR_INTERNAL_IMPLEMENTATION(TYPE) \
+    LIBEMBD_LOCAL_INLINE void libembd_schema_write_##TYPE##_network_internal(LibEmbd_Serializer_t *ser, uint32 pos, TYPE val) { \
+        libembd_write_##TYPE##_to_network_unsafe(ser, pos, val); \
+    } \
+    LIBEMBD_LOCAL_INLINE void libembd_schema_write_##TYPE##_host_internal(LibEmbd_Serializer_t *ser, uint32 pos, TYPE val) { \
+        libembd_write_##TYPE##_to_host_unsafe(ser, pos, val); \
+    } \
+    LIBEMBD_LOCAL_INLINE void libembd_schema_read_##TYPE##_network_internal(LibEmbd_Deserializer_t const *deser, uint32 pos, TYPE *p2val) { \
+        libembd_read_##TYPE##_from_network_unsafe(deser, pos, p2val); \
+    } \
+    LIBEMBD_LOCAL_INLINE void libembd_schema_read_##TYPE##_host_internal(LibEmbd_Deserializer_t const *deser, uint32 pos, TYPE *p2val) { \
+        libembd_read_##TYPE##_from_host_unsafe(deser, pos, p2val); \
+    }
+
+// Single byte types have no byte order
+#define LIBEMBD_SCHEMA_BYTE_ACCESSOR_INTERNAL_IMPLEMENTATION(TYPE) \
+    LIBEMBD_LOCAL_INLINE void libembd_schema_write_##TYPE##_network_internal(LibEmbd_Serializer_t *ser, uint32 pos, TYPE val) { \
+        libembd_write_##TYPE##_unsafe(ser, pos, val); \
+    } \
+    LIBEMBD_LOCAL_INLINE void libembd_schema_write_##TYPE##_host_internal(LibEmbd_Serializer_t *ser, uint32 pos, TYPE val) { \
+        libembd_write_##TYPE##_unsafe(ser, pos, val); \
+    } \
+    LIBEMBD_LOCAL_INLINE void libembd_schema_read_##TYPE##_network_internal(LibEmbd_Deserializer_t const *deser, uint32 pos, TYPE *p2val) { \
+        libembd_read_##TYPE##_unsafe(deser, pos, p2val); \
+    } \
+    LIBEMBD_LOCAL_INLINE void libembd_schema_read_##TYPE##_host_internal(LibEmbd_Deserializer_t const *deser, uint32 pos, TYPE *p2val) { \
+        libembd_read_##TYPE##_unsafe(deser, pos, p2val); \
+    }
+
+LIBEMBD_SCHEMA_BYTE_ACCESSOR_INTERNAL_IMPLEMENTATION(uint8)
+LIBEMBD_SCHEMA_BYTE_ACCESSOR_INTERNAL_IMPLEMENTATION(sint8)
+LIBEMBD_SCHEMA_ACCESSOR_INTERNAL_IMPLEMENTATION(uint16)
+LIBEMBD_SCHEMA_ACCESSOR_INTERNAL_IMPLEMENTATION(uint32)
+LIBEMBD_SCHEMA_ACCESSOR_INTERNAL_IMPLEMENTATION(uint64)
+LIBEMBD_SCHEMA_ACCESSOR_INTERNAL_IMPLEMENTATION(sint16)
+LIBEMBD_SCHEMA_ACCESSOR_INTERNAL_IMPLEMENTATION(sint32)
+LIBEMBD_SCHEMA_ACCESSOR_INTERNAL_IMPLEMENTATION(sint64)
+LIBEMBD_SCHEMA_ACCESSOR_INTERNAL_IMPLEMENTATION(float32)
+LIBEMBD_SCHEMA_ACCESSOR_INTERNAL_IMPLEMENTATION(float64)
+
+// Reads size bytes at offset, byte-swapped if network. With size and network being compile-time constants at every call
+// site this folds to a single load
+LIBEMBD_LOCAL_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_schema_view_read_internal(LibEmbd_Deserializer_t const *view, uint32 offset, uint32 size, boolean network, void *p2val)
+{
+    switch(size){
+        case sizeof(uint16): {
+            uint16 val;
+            if(network){
+                libembd_read_uint16_from_network_unsafe(view, offset, &val);
+            } else {
+                libembd_read_uint16_from_host_unsafe(view, offset, &val);
+            }
+            LIBEMBD_MEMCPY(p2val, &val, sizeof(val));
+            break;
+        }
+        case sizeof(uint32): {
+            uint32 val;
+            if(network){
+                libembd_read_uint32_from_network_unsafe(view, offset, &val);
+            } else {
+                libembd_read_uint32_from_host_unsafe(view, offset, &val);
+            }
+            LIBEMBD_MEMCPY(p2val, &val, sizeof(val));
+            break;
+        }
+        case sizeof(uint64): {
+            uint64 val;
+            if(network){
+                libembd_read_uint64_from_network_unsafe(view, offset, &val);
+            } else {
+                libembd_read_uint64_from_host_unsafe(view, offset, &val);
+            }
+            LIBEMBD_MEMCPY(p2val, &val, sizeof(val));
+            break;
+        }
+        default:
+            LIBEMBD_MEMCPY(p2val, &view->buffer[offset], sizeof(uint8));
+            break;
+    }
+}
+
+// Byte order of a field encoded as the size of a dummy member so that it can be queried by field name
+#define LIBEMBD_SCHEMA_ORDER_network_INTERNAL   1u
+#define LIBEMBD_SCHEMA_ORDER_host_INTERNAL      2u
+
+// Field size, fails to compile (negative array size) if the output type does not match it
+#define LIBEMBD_SCHEMA_CHECKED_FIELD_SIZE_INTERNAL(NAME, FIELD, P2VAL) \
+    ((uint32)(sizeof(((NAME##_Wire_t *)0)->FIELD) * \
+              sizeof(char[(sizeof(*(P2VAL)) == sizeof(((NAME##_Wire_t *)0)->FIELD)) ? 1 : -1])))
+
+#define LIBEMBD_SCHEMA_STRUCT_MEMBER_INTERNAL(TYPE, NAME, ORDER)   TYPE NAME;
+#define LIBEMBD_SCHEMA_WIRE_MEMBER_INTERNAL(TYPE, NAME, ORDER)     uint8 NAME[sizeof(TYPE)];
+#define LIBEMBD_SCHEMA_WIRE_SIZE_INTERNAL(TYPE, NAME, ORDER)       + sizeof(TYPE)
+#define LIBEMBD_SCHEMA_ORDER_MEMBER_INTERNAL(TYPE, NAME, ORDER)    uint8 NAME[LIBEMBD_SCHEMA_ORDER_##ORDER##_INTERNAL];
+
+// Expanded inside the generated functions, which provide the libembd_schema_wire_t typedef, base, ser/deser and msg
+#define LIBEMBD_SCHEMA_PACK_FIELD_INTERNAL(TYPE, NAME, ORDER) \
+    libembd_schema_write_##TYPE##_##ORDER##_internal(ser, base + (uint32)offsetof(libembd_schema_wire_t, NAME), msg->NAME);
+#define LIBEMBD_SCHEMA_UNPACK_FIELD_INTERNAL(TYPE, NAME, ORDER) \
+    libembd_schema_read_##TYPE##_##ORDER##_internal(deser, base + (uint32)offsetof(libembd_schema_wire_t, NAME), &msg->NAME);
+
+// Signal frame helpers, ORDER is intel or motorola
+#define LIBEMBD_SCHEMA_SIGNAL_LINEAR_intel_INTERNAL(start_bit)      ((uint32)(start_bit))
+#define LIBEMBD_SCHEMA_SIGNAL_LINEAR_motorola_INTERNAL(start_bit)   LIBEMBD_BITS_DBC_MOTOROLA_TO_MSB_INTERNAL(start_bit)
+
+#define LIBEMBD_SCHEMA_SIGNAL_MEMBER_INTERNAL(TYPE, NAME, START_BIT, WIDTH, ORDER)  TYPE NAME;
+#define LIBEMBD_SCHEMA_SIGNAL_CHECK_INTERNAL(TYPE, NAME, START_BIT, WIDTH, ORDER) \
+    && ((WIDTH) >= 1u) && ((WIDTH) <= 8u * sizeof(TYPE)) \
+    && ((LIBEMBD_SCHEMA_SIGNAL_LINEAR_##ORDER##_INTERNAL(START_BIT) + (WIDTH)) <= 8u * sizeof(libembd_schema_frame_t))
+
+// Expanded inside the generated functions, which provide frame and sig. ((TYPE)-1 < 1) only holds for signed types
+#define LIBEMBD_SCHEMA_PACK_SIGNAL_INTERNAL(TYPE, NAME, START_BIT, WIDTH, ORDER) \
+    libembd_bits_write_##ORDER##_internal(frame, (uint32)sizeof(libembd_schema_frame_t), \
+        LIBEMBD_SCHEMA_SIGNAL_LINEAR_##ORDER##_INTERNAL(START_BIT), (WIDTH), (uint64)sig->NAME);
+#define LIBEMBD_SCHEMA_UNPACK_SIGNAL_INTERNAL(TYPE, NAME, START_BIT, WIDTH, ORDER) \
+    { \
+        uint64 const raw = libembd_bits_read_##ORDER##_internal(frame, (uint32)sizeof(libembd_schema_frame_t), \
+            LIBEMBD_SCHEMA_SIGNAL_LINEAR_##ORDER##_INTERNAL(START_BIT), (WIDTH)); \
+        sig->NAME = (((TYPE)-1) < (TYPE)1) ? (TYPE)libembd_sign_extend_bits(raw, (WIDTH)) : (TYPE)raw; \
+    }
+/*-----------------------------------------------------------------Internal Functions End----------------------------------------------------------------------------*/
+
+/**
+ * @brief Define a fixed-layout message from an X-macro field list
+ *
+ * @param NAME message name, used as prefix for the generated types and functions
+ * @param FIELDS X-macro taking a single macro argument FIELD, invoked as FIELD(type, name, network|host) for every field
+ *
+ * Generated functions:
+ *  - boolean NAME_pack(LibEmbd_Serializer_t *ser, NAME_t const *msg)
+ *  - boolean NAME_unpack(LibEmbd_Deserializer_t *deser, NAME_t *msg)
+ *  - boolean NAME_view(LibEmbd_Deserializer_t *deser, LibEmbd_Deserializer_t *view)
+ * All return FALSE (and set the sticky overflow flag) without touching the buffer/message if the whole message does not fit,
+ * otherwise the position is advanced by LIBEMBD_MESSAGE_SIZE(NAME). Pack/unpack transfer all fields, view constructs a
+ * deserializer over the message bytes in place for LIBEMBD_MESSAGE_VIEW_GET().
+ */
+#define LIBEMBD_DEFINE_MESSAGE(NAME, FIELDS) \
+    typedef struct { FIELDS(LIBEMBD_SCHEMA_STRUCT_MEMBER_INTERNAL) } NAME##_t; \
+    typedef struct { FIELDS(LIBEMBD_SCHEMA_WIRE_MEMBER_INTERNAL) } NAME##_Wire_t; \
+    typedef struct { FIELDS(LIBEMBD_SCHEMA_ORDER_MEMBER_INTERNAL) } NAME##_Order_t; \
+    LIBEMBD_STATIC_ASSERT(sizeof(NAME##_Wire_t) == (0u FIELDS(LIBEMBD_SCHEMA_WIRE_SIZE_INTERNAL)), "Unexpected padding in wire layout!"); \
+    LIBEMBD_LOCAL_INLINE boolean NAME##_pack(LibEmbd_Serializer_t *ser, NAME##_t const *msg) { \
+        typedef NAME##_Wire_t libembd_schema_wire_t; \
+        if(!libembd_serializer_reserve(ser, LIBEMBD_MESSAGE_SIZE(NAME))) { \
+            return FALSE; \
+        } \
+        uint32 const base = ser->position; \
+        FIELDS(LIBEMBD_SCHEMA_PACK_FIELD_INTERNAL) \
+        ser->position = base + LIBEMBD_MESSAGE_SIZE(NAME); \
+        return TRUE; \
+    } \
+    LIBEMBD_LOCAL_INLINE boolean NAME##_unpack(LibEmbd_Deserializer_t *deser, NAME##_t *msg) { \
+        typedef NAME##_Wire_t libembd_schema_wire_t; \
+        if(!libembd_deserializer_reserve(deser, LIBEMBD_MESSAGE_SIZE(NAME))) { \
+            return FALSE; \
+        } \
+        uint32 const base = deser->position; \
+        FIELDS(LIBEMBD_SCHEMA_UNPACK_FIELD_INTERNAL) \
+        deser->position = base + LIBEMBD_MESSAGE_SIZE(NAME); \
+        return TRUE; \
+    } \
+    LIBEMBD_LOCAL_INLINE boolean NAME##_view(LibEmbd_Deserializer_t *deser, LibEmbd_Deserializer_t *view) { \
+        if(!libembd_deserializer_reserve(deser, LIBEMBD_MESSAGE_SIZE(NAME))) { \
+            return FALSE; \
+        } \
+        libembd_make_deserializer(view, &deser->buffer[deser->position], LIBEMBD_MESSAGE_SIZE(NAME)); \
+        deser->position += LIBEMBD_MESSAGE_SIZE(NAME); \
+        return TRUE; \
+    }
+
+/**
+ * @brief Total size in bytes of a frame defined with LIBEMBD_DEFINE_SIGNAL_FRAME (compile-time constant)
+ */
+#define LIBEMBD_SIGNAL_FRAME_SIZE(NAME)         ((uint32)sizeof(NAME##_Frame_t))
+
+/**
+ * @brief Define a bit-level signal frame from an X-macro signal list
+ *
+ * @param NAME frame name, used as prefix for the generated types and functions
+ * @param FRAME_LENGTH frame size in bytes
+ * @param SIGNALS X-macro taking a single macro argument SIGNAL, invoked as SIGNAL(type, name, start_bit, width, intel|motorola)
+ *        for every signal. type must be an integer type of at least width bits, start_bit follows the DBC convention
+ *        (LSB for intel, MSB for motorola). Signal placement is validated at compile time.
+ *
+ * Generated functions:
+ *  - boolean NAME_pack(LibEmbd_Serializer_t *ser, NAME_t const *sig)
+ *  - boolean NAME_unpack(LibEmbd_Deserializer_t *deser, NAME_t *sig)
+ * Both return FALSE (and set the sticky overflow flag) if the whole frame does not fit, otherwise all signals are
+ * transferred and the position is advanced by LIBEMBD_SIGNAL_FRAME_SIZE(NAME). Pack clears the frame first, so bits not
+ * covered by any signal are zero. Signals of signed type are sign extended on unpack.
+ *
+ * Since start bits and widths are compile-time constants, every signal compiles down to one or two 64-bit
+ * load/mask/shift/store sequences on the frame.
+ */
+#define LIBEMBD_DEFINE_SIGNAL_FRAME(NAME, FRAME_LENGTH, SIGNALS) \
+    typedef struct { SIGNALS(LIBEMBD_SCHEMA_SIGNAL_MEMBER_INTERNAL) } NAME##_t; \
+    typedef uint8 NAME##_Frame_t[FRAME_LENGTH]; \
+    LIBEMBD_LOCAL_INLINE boolean NAME##_pack(LibEmbd_Serializer_t *ser, NAME##_t const *sig) { \
+        typedef NAME##_Frame_t libembd_schema_frame_t; \
+        LIBEMBD_STATIC_ASSERT(1 SIGNALS(LIBEMBD_SCHEMA_SIGNAL_CHECK_INTERNAL), "Signal does not fit its type or the frame!"); \
+        if(!libembd_serializer_reserve(ser, LIBEMBD_SIGNAL_FRAME_SIZE(NAME))) { \
+            return FALSE; \
+        } \
+        uint8 * const frame = &ser->buffer[ser->position]; \
+        LIBEMBD_MEMSET(frame, 0, LIBEMBD_SIGNAL_FRAME_SIZE(NAME)); \
+        SIGNALS(LIBEMBD_SCHEMA_PACK_SIGNAL_INTERNAL) \
+        ser->position += LIBEMBD_SIGNAL_FRAME_SIZE(NAME); \
+        return TRUE; \
+    } \
+    LIBEMBD_LOCAL_INLINE boolean NAME##_unpack(LibEmbd_Deserializer_t *deser, NAME##_t *sig) { \
+        typedef NAME##_Frame_t libembd_schema_frame_t; \
+        if(!libembd_deserializer_reserve(deser, LIBEMBD_SIGNAL_FRAME_SIZE(NAME))) { \
+            return FALSE; \
+        } \
+        uint8 const * const frame = &deser->buffer[deser->position]; \
+        SIGNALS(LIBEMBD_SCHEMA_UNPACK_SIGNAL_INTERNAL) \
+        deser->position += LIBEMBD_SIGNAL_FRAME_SIZE(NAME); \
+        return TRUE; \
+    }
+
+#ifdef __cplusplus
+
+#include <cstddef>
+#include <tuple>
+#include <utility>
+
+namespace libembd {
+
+enum class ByteOrder : uint8 { network, host };
+
+namespace detail {
+
+template <ByteOrder Order> struct SchemaAccess;
+
+#define LIBEMBD_SCHEMA_CPP_OVERLOAD_INTERNAL(TYPE, ORDER) \
+    static void write(LibEmbd_Serializer_t *ser, uint32 pos, TYPE val) { libembd_schema_write_##TYPE##_##ORDER##_internal(ser, pos, val); } \
+    static void read(LibEmbd_Deserializer_t const *deser, uint32 pos, TYPE *p2val) { libembd_schema_read_##TYPE##_##ORDER##_internal(deser, pos, p2val); }
+
+#define LIBEMBD_SCHEMA_CPP_ACCESS_INTERNAL(ORDER) \
+    template <> struct SchemaAccess<ByteOrder::ORDER> { \
+        LIBEMBD_SCHEMA_CPP_OVERLOAD_INTERNAL(uint8, ORDER) \
+        LIBEMBD_SCHEMA_CPP_OVERLOAD_INTERNAL(sint8, ORDER) \
+        LIBEMBD_SCHEMA_CPP_OVERLOAD_INTERNAL(uint16, ORDER) \
+        LIBEMBD_SCHEMA_CPP_OVERLOAD_INTERNAL(uint32, ORDER) \
+        LIBEMBD_SCHEMA_CPP_OVERLOAD_INTERNAL(uint64, ORDER) \
+        LIBEMBD_SCHEMA_CPP_OVERLOAD_INTERNAL(sint16, ORDER) \
+        LIBEMBD_SCHEMA_CPP_OVERLOAD_INTERNAL(sint32, ORDER) \
+        LIBEMBD_SCHEMA_CPP_OVERLOAD_INTERNAL(sint64, ORDER) \
+        LIBEMBD_SCHEMA_CPP_OVERLOAD_INTERNAL(float32, ORDER) \
+        LIBEMBD_SCHEMA_CPP_OVERLOAD_INTERNAL(float64, ORDER) \
+    };
+
+LIBEMBD_SCHEMA_CPP_ACCESS_INTERNAL(network)
+LIBEMBD_SCHEMA_CPP_ACCESS_INTERNAL(host)
+
+template <typename MemberPtr> struct MemberPointerTraits;
+template <typename Class, typename T> struct MemberPointerTraits<T Class::*> {
+    using class_type = Class;
+    using value_type = T;
+};
+
+} // namespace detail
+
+/**
+ * @brief Describes one wire field bound to a struct member
+ *
+ * @tparam Member pointer to the struct member holding the field value
+ * @tparam Order wire byte order of the field
+ */
+template <auto Member, ByteOrder Order = ByteOrder::network>
+struct Field {
+    using value_type = typename detail::MemberPointerTraits<decltype(Member)>::value_type;
+    static constexpr uint32 size = sizeof(value_type);
+
+    template <typename Msg>
+    static void write(LibEmbd_Serializer_t *ser, uint32 pos, Msg const &msg) {
+        detail::SchemaAccess<Order>::write(ser, pos, msg.*Member);
+    }
+
+    template <typename Msg>
+    static void read(LibEmbd_Deserializer_t const *deser, uint32 pos, Msg &msg) {
+        detail::SchemaAccess<Order>::read(deser, pos, &(msg.*Member));
+    }
+};
+
+/**
+ * @brief Compile-time message layout made of consecutive Fields, the C++ equivalent of LIBEMBD_DEFINE_MESSAGE
+ *
+ * @code
+ * struct StatusMsg { uint16 msg_id; uint64 timestamp; float32 value; };
+ * using StatusLayout = libembd::MessageLayout<libembd::Field<&StatusMsg::msg_id>,
+ *                                             libembd::Field<&StatusMsg::timestamp>,
+ *                                             libembd::Field<&StatusMsg::value, libembd::ByteOrder::host>>;
+ * static_assert(StatusLayout::size == 14u, "");
+ * static_assert(StatusLayout::offset<2>() == 10u, "");
+ * @endcode
+ */
+template <typename... Fields>
+struct MessageLayout {
+    static constexpr uint32 size = (0u + ... + Fields::size);
+
+    template <std::size_t Index>
+    static constexpr uint32 offset() {
+        static_assert(Index < sizeof...(Fields), "Field index out of range!");
+        constexpr uint32 sizes[] = { Fields::size..., 0u };
+        uint32 result = 0u;
+        for(std::size_t i = 0; i < Index; i++){
+            result += sizes[i];
+        }
+        return result;
+    }
+
+    /**
+     * @brief Serialize msg at the current position with a single bounds check
+     * @return TRUE on success, FALSE if the message does not fit (the sticky overflow flag is set)
+     */
+    template <typename Msg>
+    static boolean pack(LibEmbd_Serializer_t *ser, Msg const &msg) {
+        if(!libembd_serializer_reserve(ser, size)){
+            return FALSE;
+        }
+        pack_internal(ser, ser->position, msg, std::index_sequence_for<Fields...>{});
+        ser->position += size;
+        return TRUE;
+    }
+
+    /**
+     * @brief Deserialize msg from the current position with a single bounds check
+     * @return TRUE on success, FALSE if not enough bytes remain (the sticky overflow flag is set)
+     */
+    template <typename Msg>
+    static boolean unpack(LibEmbd_Deserializer_t *deser, Msg &msg) {
+        if(!libembd_deserializer_reserve(deser, size)){
+            return FALSE;
+        }
+        unpack_internal(deser, deser->position, msg, std::index_sequence_for<Fields...>{});
+        deser->position += size;
+        return TRUE;
+    }
+
+    /**
+     * @brief Checks that the whole message is present and constructs a deserializer over it without decoding any field
+     * @return TRUE on success, FALSE if not enough bytes remain (the sticky overflow flag is set)
+     */
+    static boolean view(LibEmbd_Deserializer_t *deser, LibEmbd_Deserializer_t *view) {
+        if(!libembd_deserializer_reserve(deser, size)){
+            return FALSE;
+        }
+        libembd_make_deserializer(view, &deser->buffer[deser->position], size);
+        deser->position += size;
+        return TRUE;
+    }
+
+    /**
+     * @brief Decodes only field Index of a view constructed by view() into msg
+     */
+    template <std::size_t Index, typename Msg>
+    static void get(LibEmbd_Deserializer_t const *view, Msg &msg) {
+        std::tuple_element_t<Index, std::tuple<Fields...>>::read(view, offset<Index>(), msg);
+    }
+
+private:
+    template <typename Msg, std::size_t... Is>
+    static void pack_internal(LibEmbd_Serializer_t *ser, uint32 base, Msg const &msg, std::index_sequence<Is...>) {
+        (Fields::write(ser, base + offset<Is>(), msg), ...);
+    }
+
+    template <typename Msg, std::size_t... Is>
+    static void unpack_internal(LibEmbd_Deserializer_t const *deser, uint32 base, Msg &msg, std::index_sequence<Is...>) {
+        (Fields::read(deser, base + offset<Is>(), msg), ...);
+    }
+};
+
+} // namespace libembd
+
+#endif /* __cplusplus */
+
+#endif /* LIBEMBD_MESSAGE_SCHEMA_H_ */
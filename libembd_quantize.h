@@ -0,0 +1,147 @@
+#ifndef LIBEMBD_QUANTIZE_H_
+#define LIBEMBD_QUANTIZE_H_
+
+#include "libembd/libembd_platform_types.h"
+#include "libembd/libembd_common.h"
+#include "libembd/libembd_marshalling.h"
+
+/**
+ * @file libembd_quantize.h
+ * @brief 16-bit wire encodings of float32 values: half precision, bfloat16, Q15 and scaled fixed-point.
+ *
+ * Supported encodings (all occupying 2 bytes on the wire):
+ *  - float16: IEEE 754 binary16, 11 significant bits, range +-65504. Values are rounded to nearest even, values beyond
+ *    the range become infinity, NaNs stay NaNs.
+ *  - bfloat16: upper half of a float32, 8 significant bits, full float32 range. Rounded to nearest even.
+ *  - Q15: signed fixed-point in [-1, 1) with a resolution of 2^-15. Out of range values saturate, NaN becomes 0.
+ *  - scaled int16: raw = round((value - offset) / scale), value = raw * scale + offset, the convention used by DBC
+ *    signal definitions. Out of range values saturate, NaN becomes offset.
+ *
+ * The bulk float16 array APIs use the F16C (x86) or NEON FP16 (ARM) conversion instructions when available, 8 resp. 4
+ * values at a time, fused with the byte swap for network byte order.
+ *
+ * Example usage:
+ * @code
+ * libembd_put_float16_to_network_checked(&ser, temperature);              //2 instead of 4 bytes
+ * libembd_put_scaled_int16_to_network_checked(&ser, voltage, 0.001f, 0.0f); //mV resolution, +-32.767V
+ * libembd_put_float16_array_to_network_checked(&ser, samples, sample_count);
+ * @endcode
+ */
+
+/**
+ * @brief Convert between float32 and the 16-bit encodings
+ */
+LIBEMBD_HEADER_API_INLINE uint16 LIBEMBD_ATTR_ALWAYS_INLINE libembd_float32_to_float16(float32 value);
+LIBEMBD_HEADER_API_INLINE float32 LIBEMBD_ATTR_ALWAYS_INLINE libembd_float16_to_float32(uint16 half);
+LIBEMBD_HEADER_API_INLINE uint16 LIBEMBD_ATTR_ALWAYS_INLINE libembd_float32_to_bfloat16(float32 value);
+LIBEMBD_HEADER_API_INLINE float32 LIBEMBD_ATTR_ALWAYS_INLINE libembd_bfloat16_to_float32(uint16 bfloat);
+LIBEMBD_HEADER_API_INLINE sint16 LIBEMBD_ATTR_ALWAYS_INLINE libembd_float32_to_q15(float32 value);
+LIBEMBD_HEADER_API_INLINE float32 LIBEMBD_ATTR_ALWAYS_INLINE libembd_q15_to_float32(sint16 q15);
+LIBEMBD_HEADER_API_INLINE sint16 LIBEMBD_ATTR_ALWAYS_INLINE libembd_float32_to_scaled_int16(float32 value, float32 scale, float32 offset);
+LIBEMBD_HEADER_API_INLINE float32 LIBEMBD_ATTR_ALWAYS_INLINE libembd_scaled_int16_to_float32(sint16 raw, float32 scale, float32 offset);
+
+/**
+ * @brief Encodes value to 16 bits and writes it to underlying buffer in network/host byte order, updates write position
+ *
+ * @param ser pointer to initialized serializer object
+ * @param value value to serialize
+ * @warning assumes the underlying buffer is large enough to perform the serialization
+ */
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_float16_to_network_unsafe(LibEmbd_Serializer_t *ser, float32 value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_float16_to_host_unsafe(LibEmbd_Serializer_t *ser, float32 value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_bfloat16_to_network_unsafe(LibEmbd_Serializer_t *ser, float32 value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_bfloat16_to_host_unsafe(LibEmbd_Serializer_t *ser, float32 value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_q15_to_network_unsafe(LibEmbd_Serializer_t *ser, float32 value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_q15_to_host_unsafe(LibEmbd_Serializer_t *ser, float32 value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_scaled_int16_to_network_unsafe(LibEmbd_Serializer_t *ser, float32 value, float32 scale, float32 offset);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_scaled_int16_to_host_unsafe(LibEmbd_Serializer_t *ser, float32 value, float32 scale, float32 offset);
+
+/**
+ * @brief Checked counterparts of the unsafe put APIs
+ *
+ * @note If the value does not fit (or the serializer has already overflowed), nothing is written,
+ *       the write position is left unchanged and the sticky overflow flag is set.
+ */
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_float16_to_network_checked(LibEmbd_Serializer_t *ser, float32 value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_float16_to_host_checked(LibEmbd_Serializer_t *ser, float32 value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_bfloat16_to_network_checked(LibEmbd_Serializer_t *ser, float32 value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_bfloat16_to_host_checked(LibEmbd_Serializer_t *ser, float32 value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_q15_to_network_checked(LibEmbd_Serializer_t *ser, float32 value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_q15_to_host_checked(LibEmbd_Serializer_t *ser, float32 value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_scaled_int16_to_network_checked(LibEmbd_Serializer_t *ser, float32 value, float32 scale, float32 offset);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_scaled_int16_to_host_checked(LibEmbd_Serializer_t *ser, float32 value, float32 scale, float32 offset);
+
+/**
+ * @brief Reads a 16-bit encoded value in network/host byte order from underlying buffer, updates read position
+ *
+ * @param deser pointer to initialized deserializer object
+ * @param value pointer to variable to deserialize into
+ * @warning Assumes the underlying buffer holds enough bytes to perform the deserialization
+ */
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_float16_from_network_unsafe(LibEmbd_Deserializer_t *deser, float32 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_float16_from_host_unsafe(LibEmbd_Deserializer_t *deser, float32 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_bfloat16_from_network_unsafe(LibEmbd_Deserializer_t *deser, float32 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_bfloat16_from_host_unsafe(LibEmbd_Deserializer_t *deser, float32 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_q15_from_network_unsafe(LibEmbd_Deserializer_t *deser, float32 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_q15_from_host_unsafe(LibEmbd_Deserializer_t *deser, float32 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_scaled_int16_from_network_unsafe(LibEmbd_Deserializer_t *deser, float32 *value, float32 scale, float32 offset);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_scaled_int16_from_host_unsafe(LibEmbd_Deserializer_t *deser, float32 *value, float32 scale, float32 offset);
+
+/**
+ * @brief Checked counterparts of the unsafe get APIs
+ *
+ * @note If not enough bytes remain (or the deserializer has already overflowed), *value is zeroed,
+ *       the read position is left unchanged and the sticky overflow flag is set.
+ */
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_float16_from_network_checked(LibEmbd_Deserializer_t *deser, float32 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_float16_from_host_checked(LibEmbd_Deserializer_t *deser, float32 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_bfloat16_from_network_checked(LibEmbd_Deserializer_t *deser, float32 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_bfloat16_from_host_checked(LibEmbd_Deserializer_t *deser, float32 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_q15_from_network_checked(LibEmbd_Deserializer_t *deser, float32 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_q15_from_host_checked(LibEmbd_Deserializer_t *deser, float32 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_scaled_int16_from_network_checked(LibEmbd_Deserializer_t *deser, float32 *value, float32 scale, float32 offset);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_scaled_int16_from_host_checked(LibEmbd_Deserializer_t *deser, float32 *value, float32 scale, float32 offset);
+
+/**
+ * @brief Encodes count float32 values to float16/bfloat16 and writes them to underlying buffer, updates write position
+ *
+ * @param ser pointer to initialized serializer object
+ * @param values pointer to the array of values to serialize
+ * @param count number of array elements
+ * @warning assumes the underlying buffer is large enough to hold count * 2 bytes
+ */
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_float16_array_to_network_unsafe(LibEmbd_Serializer_t *ser, float32 const *values, uint32 count);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_float16_array_to_host_unsafe(LibEmbd_Serializer_t *ser, float32 const *values, uint32 count);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_bfloat16_array_to_network_unsafe(LibEmbd_Serializer_t *ser, float32 const *values, uint32 count);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_bfloat16_array_to_host_unsafe(LibEmbd_Serializer_t *ser, float32 const *values, uint32 count);
+
+/**
+ * @brief Reads count float16/bfloat16 values from underlying buffer as float32, updates read position
+ *
+ * @param deser pointer to initialized deserializer object
+ * @param values pointer to the output array
+ * @param count number of array elements
+ * @warning Assumes the underlying buffer holds count * 2 bytes
+ */
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_float16_array_from_network_unsafe(LibEmbd_Deserializer_t *deser, float32 *values, uint32 count);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_float16_array_from_host_unsafe(LibEmbd_Deserializer_t *deser, float32 *values, uint32 count);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_bfloat16_array_from_network_unsafe(LibEmbd_Deserializer_t *deser, float32 *values, uint32 count);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_bfloat16_array_from_host_unsafe(LibEmbd_Deserializer_t *deser, float32 *values, uint32 count);
+
+/**
+ * @brief Checked counterparts of the unsafe array APIs
+ *
+ * @note Either all elements are processed or nothing is and the sticky overflow flag is set.
+ */
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_float16_array_to_network_checked(LibEmbd_Serializer_t *ser, float32 const *values, uint32 count);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_float16_array_to_host_checked(LibEmbd_Serializer_t *ser, float32 const *values, uint32 count);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_bfloat16_array_to_network_checked(LibEmbd_Serializer_t *ser, float32 const *values, uint32 count);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_bfloat16_array_to_host_checked(LibEmbd_Serializer_t *ser, float32 const *values, uint32 count);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_float16_array_from_network_checked(LibEmbd_Deserializer_t *deser, float32 *values, uint32 count);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_float16_array_from_host_checked(LibEmbd_Deserializer_t *deser, float32 *values, uint32 count);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_bfloat16_array_from_network_checked(LibEmbd_Deserializer_t *deser, float32 *values, uint32 count);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_bfloat16_array_from_host_checked(LibEmbd_Deserializer_t *deser, float32 *values, uint32 count);
+
+#include "libembd/internal/libembd_quantize_impl.h"
+
+#endif /* LIBEMBD_QUANTIZE_H_ */
@@ -0,0 +1,146 @@
+#ifndef LIBEMBD_SEGMENTATION_H_
+#define LIBEMBD_SEGMENTATION_H_
+
+#include "libembd/libembd_platform_types.h"
+#include "libembd/libembd_common.h"
+#include "libembd/libembd_marshalling.h"
+#include "libembd/libembd_timer.h"
+
+/**
+ * @file libembd_segmentation.h
+ * @brief ISO-TP (ISO 15765-2) style segmentation and reassembly of payloads larger than the transport MTU.
+ *
+ * Frames start with an ISO-TP protocol control information header:
+ *  - single frame: 0x0L (L = length 1..7) or 0x00 LL (length up to 255, CAN FD style escape)
+ *  - first frame: 0x1H LL (12-bit total length) or 0x10 0x00 + 32-bit total length for payloads above 4095 bytes
+ *  - consecutive frame: 0x2N (N = 4-bit sequence number, starting at 1 and wrapping to 0)
+ * Flow control frames are not used: the sender paces consecutive frames itself.
+ *
+ * The segmenter never copies: every frame is handed out as its (at most 6 byte) header plus a view into the source
+ * buffer, ready for a gather write or for libembd_put_segment_checked() straight into the transmit buffer.
+ *
+ * The reassembler copies each segment exactly once, straight into the destination slot of its session. Sessions are
+ * keyed by a caller-defined channel (e.g. CAN identifier or source address), looked up through a hash table in O(1),
+ * and bounded by LIBEMBD_REASSEMBLY_MAX_SESSIONS. Every session owns a one-shot library timer, started by the first
+ * frame and rewound by every consecutive frame: a session that stalls for longer than the timeout is dropped.
+ *
+ * Example usage:
+ * @code
+ * LibEmbd_Segmenter_t seg;
+ * LibEmbd_Segment_t segment;
+ * libembd_make_segmenter(&seg, payload, payload_length, 8u);
+ * while(libembd_segmenter_next(&seg, &segment)) {
+ *     libembd_make_serializer(&ser, can_frame, 8u);
+ *     libembd_put_segment_checked(&ser, &segment);
+ *     can_send(TX_ID, can_frame, ser.position);
+ * }
+ *
+ * static uint8 storage[LIBEMBD_REASSEMBLY_MAX_SESSIONS * 4096u];
+ * static LibEmbd_Reassembler_t reasm;
+ * libembd_make_reassembler(&reasm, storage, 4096u, 1000u, on_message, &app);
+ *
+ * //on every received frame
+ * (void)libembd_reassembler_receive(&reasm, rx_id, frame);
+ * //every 10ms
+ * (void)libembd_reassembler_tick(&reasm, 10u);
+ * @endcode
+ */
+
+//! please make sure the following macros are correctly configured!
+/*--------------------------------------------------- Macro Configurations--------------------------------------------------------*/
+//! maximum number of concurrent reassembly sessions, at most 128
+#ifndef LIBEMBD_REASSEMBLY_MAX_SESSIONS
+    #define LIBEMBD_REASSEMBLY_MAX_SESSIONS         8u
+#endif
+/*--------------------------------------------------- Macro Configurations--------------------------------------------------------*/
+
+#define LIBEMBD_SEGMENT_MAX_HEADER_SIZE             6u //escaped first frame
+#define LIBEMBD_SEGMENT_MIN_MTU                     8u
+
+typedef struct {
+    uint8 header[LIBEMBD_SEGMENT_MAX_HEADER_SIZE];
+    uint8 header_length;
+    LibEmbd_ConstBufferView_t payload; //points into the source buffer
+} LibEmbd_Segment_t;
+
+/**
+ * @brief Invoked for every completely reassembled payload
+ *
+ * @param context user context given at construction
+ * @param channel channel the payload was received on
+ * @param payload deserializer over the payload, only valid until the handler returns
+ */
+typedef void (*libembd_reassembly_handler_t)(void *context, uint32 channel, LibEmbd_Deserializer_t *payload);
+
+typedef struct LibEmbd_Segmenter_t LibEmbd_Segmenter_t;
+typedef struct LibEmbd_Reassembler_t LibEmbd_Reassembler_t;
+
+/**
+ * @brief segmenter constructor
+ *
+ * @param seg pointer to segmenter object
+ * @param data source buffer, must stay valid and unmodified until the last segment has been sent
+ * @param length number of bytes to segment
+ * @param mtu maximum frame length of the transport, at least LIBEMBD_SEGMENT_MIN_MTU
+ */
+LIBEMBD_HEADER_API_INLINE void libembd_make_segmenter(LibEmbd_Segmenter_t *seg, const void *data, uint32 length, uint16 mtu);
+
+/**
+ * @brief Produces the next frame of the payload, without copying
+ *
+ * @param seg pointer to initialized segmenter object
+ * @param segment pointer to output, header plus a view of the payload bytes carried by the frame
+ * @return TRUE if a segment was produced, FALSE once all of the payload has been segmented
+ */
+LIBEMBD_HEADER_API_INLINE boolean libembd_segmenter_next(LibEmbd_Segmenter_t *seg, LibEmbd_Segment_t *segment);
+
+/**
+ * @brief Writes a segment (header and payload) to underlying buffer and updates write position
+ *
+ * @note If the segment does not fit, nothing is written and the sticky overflow flag is set.
+ */
+LIBEMBD_HEADER_API_INLINE void libembd_put_segment_checked(LibEmbd_Serializer_t *ser, LibEmbd_Segment_t const *segment);
+
+/**
+ * @brief reassembler constructor
+ *
+ * @param reasm pointer to reassembler object
+ * @param storage LIBEMBD_REASSEMBLY_MAX_SESSIONS * session_capacity bytes, every session reassembles into its own slot
+ * @param session_capacity maximum payload length per session, longer payloads are rejected
+ * @param timeout maximum time between consecutive frames of a session
+ * @param handler invoked for every reassembled payload
+ * @param context user context passed to handler
+ */
+LIBEMBD_HEADER_API_INLINE void libembd_make_reassembler(LibEmbd_Reassembler_t *reasm, uint8 *storage, uint32 session_capacity,
+                                                        libembd_timer_duration_ms timeout, libembd_reassembly_handler_t handler, void *context);
+
+/**
+ * @brief Processes a received frame
+ *
+ * @param reasm pointer to initialized reassembler object
+ * @param channel channel the frame was received on
+ * @param frame received frame
+ * @return E_OK if the frame was accepted, E_NOT_OK if it was malformed, unexpected (consecutive frame without session or
+ *         out of sequence, which also drops the session), too long for a session or no session was free
+ * @note Single frames and completed payloads are passed to the handler from within this call. A single or first frame
+ *       on a channel with a session in progress drops the session, as in ISO-TP.
+ */
+LIBEMBD_HEADER_API_INLINE LibEmbd_Std_ReturnType libembd_reassembler_receive(LibEmbd_Reassembler_t *reasm, uint32 channel, LibEmbd_ConstBufferView_t frame);
+
+/**
+ * @brief Advances the session timers and drops timed out sessions
+ *
+ * @param reasm pointer to initialized reassembler object
+ * @param period time since the last call in ms, the period this function is called at
+ * @return number of sessions dropped
+ */
+LIBEMBD_HEADER_API_INLINE uint32 libembd_reassembler_tick(LibEmbd_Reassembler_t *reasm, libembd_timer_duration_ms period);
+
+/**
+ * @brief Returns the number of sessions in progress
+ */
+LIBEMBD_HEADER_API_INLINE uint32 libembd_reassembler_active_sessions(LibEmbd_Reassembler_t const *reasm);
+
+#include "libembd/internal/libembd_segmentation_impl.h"
+
+#endif /* LIBEMBD_SEGMENTATION_H_ */
@@ -0,0 +1,155 @@
+#ifndef LIBEMBD_SG_SERIALIZER_H_
+#define LIBEMBD_SG_SERIALIZER_H_
+
+#include <stddef.h>
+#include "libembd/libembd_platform_types.h"
+#include "libembd/libembd_common.h"
+#include "libembd/libembd_marshalling.h"
+
+/**
+ * @file libembd_sg_serializer.h
+ * @brief Scatter-gather serializer producing an iovec chain instead of one contiguous buffer.
+ *
+ * Small fields are serialized with the regular put APIs into an inline chunk buffer owned by the caller, while large
+ * payloads are referenced by pointer instead of being copied. The resulting iovec list can be handed to writev()/sendmsg()
+ * directly on Linux.
+ *
+ * Example usage:
+ * @code
+ * uint8 header[64];
+ * LibEmbd_SgSerializer_t sg;
+ * libembd_make_sg_serializer(&sg, header, sizeof(header));
+ *
+ * LibEmbd_Serializer_t * const ser = libembd_sg_serializer_inline(&sg);
+ * libembd_put_uint16_to_network_checked(ser, MSG_ID);
+ * libembd_put_uint32_to_network_checked(ser, payload_length);
+ * libembd_sg_put_buffer(&sg, payload, payload_length); //referenced, not copied
+ * libembd_put_uint32_to_network_checked(ser, trailer);
+ *
+ * if(libembd_sg_serializer_writev(&sg, fd) != E_OK) { ... }
+ * @endcode
+ */
+
+//! please make sure the following macros are correctly configured!
+/*--------------------------------------------------- Macro Configurations--------------------------------------------------------*/
+//! maximum number of iovecs a single scatter-gather serializer can hold
+#ifndef LIBEMBD_SG_MAX_IOVECS
+    #define LIBEMBD_SG_MAX_IOVECS               16u
+#endif
+
+//! buffers shorter than this are copied into the inline chunk instead of being referenced
+#ifndef LIBEMBD_SG_INLINE_COPY_THRESHOLD
+    #define LIBEMBD_SG_INLINE_COPY_THRESHOLD    128u
+#endif
+/*--------------------------------------------------- Macro Configurations--------------------------------------------------------*/
+
+#if defined(__linux__)
+    #include <sys/uio.h>
+    typedef struct iovec LibEmbd_IoVec_t;
+#else
+    typedef struct {
+        void *iov_base;
+        size_t iov_len;
+    } LibEmbd_IoVec_t;
+#endif
+
+typedef struct LibEmbd_SgSerializer_t LibEmbd_SgSerializer_t;
+
+/**
+ * @brief scatter-gather serializer constructor
+ *
+ * @param sg pointer to uninitialized scatter-gather serializer object
+ * @param inline_buffer buffer holding the inline (copied) chunks
+ * @param inline_capacity length of inline buffer
+ */
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_make_sg_serializer(LibEmbd_SgSerializer_t *sg, uint8 *inline_buffer, uint32 inline_capacity);
+
+/**
+ * @brief resets scatter-gather serializer for reuse
+ *
+ * @param sg pointer to initialized scatter-gather serializer object
+ * @note Drops all chunks and references, clears the overflow flag and rewinds the inline buffer.
+ */
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_reset_sg_serializer(LibEmbd_SgSerializer_t *sg);
+
+/**
+ * @brief Access the inline chunk serializer
+ *
+ * @param sg pointer to initialized scatter-gather serializer object
+ * @return serializer to be used with the regular put APIs for small fields
+ * @note Positional writes (write APIs) must not target bytes of an already closed chunk once the iovecs have been sent.
+ */
+LIBEMBD_HEADER_API_INLINE LibEmbd_Serializer_t * LIBEMBD_ATTR_ALWAYS_INLINE libembd_sg_serializer_inline(LibEmbd_SgSerializer_t *sg);
+
+/**
+ * @brief Appends raw bytes to the output
+ *
+ * @param sg pointer to initialized scatter-gather serializer object
+ * @param buffer pointer to input buffer
+ * @param buffer_length input buffer length
+ * @note Buffers shorter than LIBEMBD_SG_INLINE_COPY_THRESHOLD are copied into the inline chunk, longer ones are referenced
+ *       and must stay valid and unmodified until the output has been consumed.
+ * @note Sets the sticky overflow flag if the iovec list or the inline buffer is exhausted.
+ */
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_sg_put_buffer(LibEmbd_SgSerializer_t *sg, const void *buffer, uint32 buffer_length);
+
+/**
+ * @brief Appends a reference to raw bytes to the output, regardless of their size
+ *
+ * @param sg pointer to initialized scatter-gather serializer object
+ * @param buffer pointer to input buffer, must stay valid and unmodified until the output has been consumed
+ * @param buffer_length input buffer length
+ * @note Sets the sticky overflow flag if the iovec list is exhausted.
+ */
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_sg_put_buffer_ref(LibEmbd_SgSerializer_t *sg, const void *buffer, uint32 buffer_length);
+
+/**
+ * @brief Closes the pending inline chunk and returns the iovec list
+ *
+ * @param sg pointer to initialized scatter-gather serializer object
+ * @param pCount pointer to variable receiving the number of iovecs
+ * @return pointer to the iovec list owned by sg
+ * @note Can be called repeatedly; more data may be appended afterwards.
+ */
+LIBEMBD_HEADER_API_INLINE LibEmbd_IoVec_t const * LIBEMBD_ATTR_ALWAYS_INLINE libembd_sg_serializer_finalize(LibEmbd_SgSerializer_t *sg, uint32 *pCount);
+
+/**
+ * @brief Total number of bytes described by the serializer (inline and referenced)
+ *
+ * @param sg pointer to initialized scatter-gather serializer object
+ */
+LIBEMBD_HEADER_API_INLINE LibEmbd_Size_t LIBEMBD_ATTR_ALWAYS_INLINE libembd_sg_serializer_total_length(LibEmbd_SgSerializer_t const *sg);
+
+/**
+ * @brief Query the sticky overflow flag (iovec list or inline buffer exhausted)
+ *
+ * @param sg pointer to initialized scatter-gather serializer object
+ */
+LIBEMBD_HEADER_API_INLINE boolean LIBEMBD_ATTR_ALWAYS_INLINE libembd_sg_serializer_has_overflowed(LibEmbd_SgSerializer_t const *sg);
+
+#if defined(__linux__)
+/**
+ * @brief Writes the whole output to fd with writev(), retrying on partial writes and EINTR
+ *
+ * @param sg pointer to initialized scatter-gather serializer object
+ * @param fd file descriptor to write to
+ * @return E_OK if all bytes were written, E_NOT_OK on overflow or write error (errno is preserved)
+ * @note The iovec list is consumed by this call, reset the serializer before reuse.
+ */
+LIBEMBD_HEADER_API_INLINE LibEmbd_Std_ReturnType libembd_sg_serializer_writev(LibEmbd_SgSerializer_t *sg, int fd);
+
+/**
+ * @brief Sends the whole output on sockfd with sendmsg(), retrying on partial sends and EINTR
+ *
+ * @param sg pointer to initialized scatter-gather serializer object
+ * @param sockfd connected socket
+ * @param flags sendmsg flags (MSG_NOSIGNAL is always added)
+ * @return E_OK if all bytes were sent, E_NOT_OK on overflow or send error (errno is preserved)
+ * @note The iovec list is consumed by this call, reset the serializer before reuse.
+ */
+LIBEMBD_HEADER_API_INLINE LibEmbd_Std_ReturnType libembd_sg_serializer_sendmsg(LibEmbd_SgSerializer_t *sg, int sockfd, int flags);
+#endif
+
+#include "libembd/internal/libembd_sg_serializer_impl.h"
+
+#endif /* LIBEMBD_SG_SERIALIZER_H_ */
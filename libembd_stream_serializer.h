@@ -0,0 +1,226 @@
+#ifndef LIBEMBD_STREAM_SERIALIZER_H_
+#define LIBEMBD_STREAM_SERIALIZER_H_
+
+#include "libembd/libembd_platform_types.h"
+#include "libembd/libembd_common.h"
+#include "libembd/libembd_marshalling.h"
+
+/**
+ * @file libembd_stream_serializer.h
+ * @brief Streaming serializer/deserializer working through a small staging buffer.
+ *
+ * The streaming serializer collects output in a caller provided staging buffer and hands it to a user sink whenever the
+ * buffer fills up (and on explicit flush). The streaming deserializer pulls input from a user source whenever the staging
+ * buffer runs dry. Fields may span a refill/flush boundary, so memory use stays constant for arbitrarily large streams.
+ *
+ * Instead of the undefined behavior of the unsafe marshalling APIs, errors are sticky: once the sink reports an error
+ * all further output is discarded, and once the source runs dry in the middle of a field all further gets yield 0. A
+ * reservation larger than the staging buffer is an error as well.
+ * Query the error state once at the end via libembd_stream_serializer_flush()/libembd_stream_deserializer_has_failed().
+ *
+ * Example usage:
+ * @code
+ * static LibEmbd_Std_ReturnType fd_sink(void *context, uint8 const *data, uint32 length) {
+ *     return (write(*(int *)context, data, length) == (ssize_t)length) ? E_OK : E_NOT_OK;
+ * }
+ *
+ * uint8 staging[256];
+ * LibEmbd_StreamSerializer_t sser;
+ * libembd_make_stream_serializer(&sser, staging, sizeof(staging), fd_sink, &fd);
+ *
+ * for(uint32 i = 0u; i < record_count; i++) {
+ *     libembd_stream_put_uint32_to_network(&sser, records[i].id);
+ *     libembd_stream_put_float64_to_network(&sser, records[i].value);
+ * }
+ * if(libembd_stream_serializer_flush(&sser) != E_OK) { ... }
+ * @endcode
+ */
+
+/**
+ * @brief The user sink receiving staged output
+ *
+ * @param context user context given at construction
+ * @param data pointer to the bytes to consume
+ * @param length number of bytes to consume
+ * @return E_OK if all length bytes were consumed, E_NOT_OK otherwise
+ */
+typedef LibEmbd_Std_ReturnType (*libembd_stream_sink_t)(void *context, uint8 const *data, uint32 length);
+
+/**
+ * @brief The user source providing input
+ *
+ * @param context user context given at construction
+ * @param buffer pointer to the buffer to fill
+ * @param capacity maximum number of bytes to provide
+ * @return number of bytes provided, 0 at end of stream or on error
+ */
+typedef uint32 (*libembd_stream_source_t)(void *context, uint8 *buffer, uint32 capacity);
+
+typedef struct LibEmbd_StreamSerializer_t LibEmbd_StreamSerializer_t;
+typedef struct LibEmbd_StreamDeserializer_t LibEmbd_StreamDeserializer_t;
+
+/**
+ * @brief streaming serializer constructor
+ *
+ * @param sser pointer to uninitialized streaming serializer object
+ * @param staging staging buffer, at least 1 byte
+ * @param capacity length of staging buffer
+ * @param sink user sink invoked whenever the staging buffer is full or flushed
+ * @param context user context passed to sink
+ */
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_make_stream_serializer(LibEmbd_StreamSerializer_t *sser, uint8 *staging, uint32 capacity,
+                                                                                         libembd_stream_sink_t sink, void *context);
+
+/**
+ * @brief Serializes value to the stream in the byte order indicated by the function name
+ *
+ * @param sser pointer to initialized streaming serializer object
+ * @param value value to serialize
+ * @note The sink is invoked whenever the staging buffer fills up, possibly in the middle of the value.
+ */
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_stream_put_uint8(LibEmbd_StreamSerializer_t *sser, uint8 value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_stream_put_sint8(LibEmbd_StreamSerializer_t *sser, sint8 value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_stream_put_uint16_to_network(LibEmbd_StreamSerializer_t *sser, uint16 value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_stream_put_uint32_to_network(LibEmbd_StreamSerializer_t *sser, uint32 value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_stream_put_uint64_to_network(LibEmbd_StreamSerializer_t *sser, uint64 value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_stream_put_sint16_to_network(LibEmbd_StreamSerializer_t *sser, sint16 value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_stream_put_sint32_to_network(LibEmbd_StreamSerializer_t *sser, sint32 value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_stream_put_sint64_to_network(LibEmbd_StreamSerializer_t *sser, sint64 value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_stream_put_float32_to_network(LibEmbd_StreamSerializer_t *sser, float32 value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_stream_put_float64_to_network(LibEmbd_StreamSerializer_t *sser, float64 value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_stream_put_uint16_to_host(LibEmbd_StreamSerializer_t *sser, uint16 value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_stream_put_uint32_to_host(LibEmbd_StreamSerializer_t *sser, uint32 value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_stream_put_uint64_to_host(LibEmbd_StreamSerializer_t *sser, uint64 value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_stream_put_sint16_to_host(LibEmbd_StreamSerializer_t *sser, sint16 value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_stream_put_sint32_to_host(LibEmbd_StreamSerializer_t *sser, sint32 value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_stream_put_sint64_to_host(LibEmbd_StreamSerializer_t *sser, sint64 value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_stream_put_float32_to_host(LibEmbd_StreamSerializer_t *sser, float32 value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_stream_put_float64_to_host(LibEmbd_StreamSerializer_t *sser, float64 value);
+
+/**
+ * @brief Writes raw bytes to the stream
+ *
+ * @param sser pointer to initialized streaming serializer object
+ * @param buffer pointer to input buffer
+ * @param buffer_length input buffer length
+ * @note Buffers at least as large as the staging buffer are handed to the sink directly without being copied.
+ */
+LIBEMBD_HEADER_API_INLINE void libembd_stream_put_buffer(LibEmbd_StreamSerializer_t *sser, const void *buffer, uint32 buffer_length);
+
+/**
+ * @brief Makes room for size contiguous bytes in the staging buffer, flushing it if required
+ *
+ * @param sser pointer to initialized streaming serializer object
+ * @param size number of contiguous bytes needed
+ * @return the staging serializer to be used with the regular (unsafe) put APIs or the schema pack functions for up to
+ *         size bytes, NULL if size exceeds the staging capacity (the sticky error flag is then set)
+ */
+LIBEMBD_HEADER_API_INLINE LibEmbd_Serializer_t * libembd_stream_serializer_reserve(LibEmbd_StreamSerializer_t *sser, uint32 size);
+
+/**
+ * @brief Hands all staged bytes to the sink
+ *
+ * @param sser pointer to initialized streaming serializer object
+ * @return E_OK if the sink consumed all output produced so far, E_NOT_OK if the sticky error flag is set
+ */
+LIBEMBD_HEADER_API_INLINE LibEmbd_Std_ReturnType libembd_stream_serializer_flush(LibEmbd_StreamSerializer_t *sser);
+
+/**
+ * @brief Total number of bytes written to the stream so far, flushed or staged
+ *
+ * @param sser pointer to initialized streaming serializer object
+ */
+LIBEMBD_HEADER_API_INLINE LibEmbd_Size_t LIBEMBD_ATTR_ALWAYS_INLINE libembd_stream_serializer_total_length(LibEmbd_StreamSerializer_t const *sser);
+
+/**
+ * @brief Query the sticky error flag (sink reported an error or a reservation exceeded the staging capacity)
+ *
+ * @param sser pointer to initialized streaming serializer object
+ */
+LIBEMBD_HEADER_API_INLINE boolean LIBEMBD_ATTR_ALWAYS_INLINE libembd_stream_serializer_has_failed(LibEmbd_StreamSerializer_t const *sser);
+
+/**
+ * @brief streaming deserializer constructor
+ *
+ * @param sdeser pointer to uninitialized streaming deserializer object
+ * @param staging staging buffer, at least 1 byte
+ * @param capacity length of staging buffer
+ * @param source user source invoked whenever the staging buffer runs dry
+ * @param context user context passed to source
+ */
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_make_stream_deserializer(LibEmbd_StreamDeserializer_t *sdeser, uint8 *staging, uint32 capacity,
+                                                                                           libembd_stream_source_t source, void *context);
+
+/**
+ * @brief Deserializes value from the stream in the byte order indicated by the function name
+ *
+ * @param sdeser pointer to initialized streaming deserializer object
+ * @param value pointer to variable to deserialize into
+ * @note The source is invoked whenever the staging buffer runs dry, possibly in the middle of the value.
+ *       If the source runs dry before the value is complete, *value is zeroed and the sticky error flag is set.
+ */
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_stream_get_uint8(LibEmbd_StreamDeserializer_t *sdeser, uint8 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_stream_get_sint8(LibEmbd_StreamDeserializer_t *sdeser, sint8 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_stream_get_uint16_from_network(LibEmbd_StreamDeserializer_t *sdeser, uint16 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_stream_get_uint32_from_network(LibEmbd_StreamDeserializer_t *sdeser, uint32 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_stream_get_uint64_from_network(LibEmbd_StreamDeserializer_t *sdeser, uint64 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_stream_get_sint16_from_network(LibEmbd_StreamDeserializer_t *sdeser, sint16 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_stream_get_sint32_from_network(LibEmbd_StreamDeserializer_t *sdeser, sint32 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_stream_get_sint64_from_network(LibEmbd_StreamDeserializer_t *sdeser, sint64 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_stream_get_float32_from_network(LibEmbd_StreamDeserializer_t *sdeser, float32 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_stream_get_float64_from_network(LibEmbd_StreamDeserializer_t *sdeser, float64 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_stream_get_uint16_from_host(LibEmbd_StreamDeserializer_t *sdeser, uint16 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_stream_get_uint32_from_host(LibEmbd_StreamDeserializer_t *sdeser, uint32 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_stream_get_uint64_from_host(LibEmbd_StreamDeserializer_t *sdeser, uint64 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_stream_get_sint16_from_host(LibEmbd_StreamDeserializer_t *sdeser, sint16 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_stream_get_sint32_from_host(LibEmbd_StreamDeserializer_t *sdeser, sint32 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_stream_get_sint64_from_host(LibEmbd_StreamDeserializer_t *sdeser, sint64 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_stream_get_float32_from_host(LibEmbd_StreamDeserializer_t *sdeser, float32 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_stream_get_float64_from_host(LibEmbd_StreamDeserializer_t *sdeser, float64 *value);
+
+/**
+ * @brief Reads raw bytes from the stream
+ *
+ * @param sdeser pointer to initialized streaming deserializer object
+ * @param buffer pointer to output buffer
+ * @param length number of bytes to read
+ * @return number of bytes actually read, less than length if the source ran dry (the sticky error flag is then set)
+ */
+LIBEMBD_HEADER_API_INLINE uint32 libembd_stream_get_buffer(LibEmbd_StreamDeserializer_t *sdeser, void *buffer, uint32 length);
+
+/**
+ * @brief Makes size contiguous bytes available in the staging buffer, refilling it from the source if required
+ *
+ * @param sdeser pointer to initialized streaming deserializer object
+ * @param size number of contiguous bytes needed
+ * @return the staging deserializer to be used with the regular (unsafe) get APIs or the schema unpack functions for up to
+ *         size bytes, NULL if size exceeds the staging capacity or the source ran dry (the sticky error flag is then set)
+ */
+LIBEMBD_HEADER_API_INLINE LibEmbd_Deserializer_t * libembd_stream_deserializer_reserve(LibEmbd_StreamDeserializer_t *sdeser, uint32 size);
+
+/**
+ * @brief Checks for the end of the stream, refilling the staging buffer if it is empty
+ *
+ * @param sdeser pointer to initialized streaming deserializer object
+ * @return TRUE if no more input is available
+ * @note Reaching the end of the stream at a field boundary is not an error.
+ */
+LIBEMBD_HEADER_API_INLINE boolean libembd_stream_deserializer_at_end(LibEmbd_StreamDeserializer_t *sdeser);
+
+/**
+ * @brief Total number of bytes consumed from the stream so far
+ *
+ * @param sdeser pointer to initialized streaming deserializer object
+ */
+LIBEMBD_HEADER_API_INLINE LibEmbd_Size_t LIBEMBD_ATTR_ALWAYS_INLINE libembd_stream_deserializer_total_length(LibEmbd_StreamDeserializer_t const *sdeser);
+
+/**
+ * @brief Query the sticky error flag (source ran dry in the middle of a field or a reservation exceeded the staging capacity)
+ *
+ * @param sdeser pointer to initialized streaming deserializer object
+ */
+LIBEMBD_HEADER_API_INLINE boolean LIBEMBD_ATTR_ALWAYS_INLINE libembd_stream_deserializer_has_failed(LibEmbd_StreamDeserializer_t const *sdeser);
+
+#include "libembd/internal/libembd_stream_serializer_impl.h"
+
+#endif /* LIBEMBD_STREAM_SERIALIZER_H_ */
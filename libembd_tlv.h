@@ -0,0 +1,146 @@
+#ifndef LIBEMBD_TLV_H_
+#define LIBEMBD_TLV_H_
+
+#include "libembd/libembd_platform_types.h"
+#include "libembd/libembd_common.h"
+#include "libembd/libembd_marshalling.h"
+
+/**
+ * @file libembd_tlv.h
+ * @brief Single-pass builder and indexed parser for nested tag-length-value encoded messages.
+ *
+ * Wire format of a field: 16-bit tag, 16-bit length, followed by length bytes of value, all in network byte order.
+ * The value of a field may itself consist of fields (nesting).
+ *
+ * libembd_tlv_begin_field() writes the tag and reserves the length slot, libembd_tlv_end_field() patches the slot with
+ * the number of bytes written in between. Nested messages are therefore encoded in a single pass without computing
+ * their sizes up front. The value bytes are written with the regular marshalling APIs on the underlying serializer.
+ *
+ * Example usage:
+ * @code
+ * LibEmbd_TlvBuilder_t tlv;
+ * libembd_make_tlv_builder(&tlv, &ser);
+ *
+ * libembd_tlv_begin_field(&tlv, TAG_DEVICE);
+ *     libembd_tlv_put_field(&tlv, TAG_NAME, name, name_length);
+ *     libembd_tlv_begin_field(&tlv, TAG_READING);
+ *         libembd_put_uint32_to_network_checked(&ser, timestamp);
+ *         libembd_put_float32_to_network_checked(&ser, value);
+ *     libembd_tlv_end_field(&tlv);
+ * libembd_tlv_end_field(&tlv);
+ *
+ * if(libembd_tlv_builder_has_failed(&tlv)) { ... }
+ * @endcode
+ *
+ * On the receiving side, libembd_tlv_index_build() walks a message once and records every top-level field in a small
+ * hash table, so that each subsequent lookup is an O(1) zero-copy view instead of a linear walk from the start:
+ * @code
+ * LibEmbd_TlvIndex_t index;
+ * if(libembd_tlv_index_build(&index, message) != E_OK) { ... } //malformed
+ *
+ * LibEmbd_ConstBufferView_t const device = libembd_tlv_index_find(&index, TAG_DEVICE);
+ * LibEmbd_TlvIndex_t device_index; //nested fields are indexed separately
+ * (void)libembd_tlv_index_build(&device_index, device);
+ * @endcode
+ */
+
+//! please make sure the following macros are correctly configured!
+/*--------------------------------------------------- Macro Configurations--------------------------------------------------------*/
+//! maximum number of simultaneously open fields
+#ifndef LIBEMBD_TLV_MAX_DEPTH
+    #define LIBEMBD_TLV_MAX_DEPTH               8u
+#endif
+
+//! hash table size of the TLV index (holds up to this value - 1 distinct tags), must be a power of two. Tags below this value never collide.
+#ifndef LIBEMBD_TLV_INDEX_CAPACITY
+    #define LIBEMBD_TLV_INDEX_CAPACITY          16u
+#endif
+/*--------------------------------------------------- Macro Configurations--------------------------------------------------------*/
+
+#define LIBEMBD_TLV_HEADER_SIZE                 4u //tag + length
+#define LIBEMBD_TLV_MAX_VALUE_LENGTH            0xFFFFu
+
+typedef struct LibEmbd_TlvBuilder_t LibEmbd_TlvBuilder_t;
+typedef struct LibEmbd_TlvIndex_t LibEmbd_TlvIndex_t;
+
+/**
+ * @brief TLV builder constructor
+ *
+ * @param tlv pointer to uninitialized TLV builder object
+ * @param ser pointer to initialized serializer the fields are written to, must outlive the builder
+ */
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_make_tlv_builder(LibEmbd_TlvBuilder_t *tlv, LibEmbd_Serializer_t *ser);
+
+/**
+ * @brief Opens a field: writes its tag and reserves its length slot at the current write position
+ *
+ * @param tlv pointer to initialized TLV builder object
+ * @param tag field tag
+ * @note Opening more than LIBEMBD_TLV_MAX_DEPTH fields at once sets the sticky error flag.
+ */
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_tlv_begin_field(LibEmbd_TlvBuilder_t *tlv, uint16 tag);
+
+/**
+ * @brief Closes the innermost open field and patches its length slot
+ *
+ * @param tlv pointer to initialized TLV builder object
+ * @note Closing without an open field or a value longer than LIBEMBD_TLV_MAX_VALUE_LENGTH sets the sticky error flag.
+ */
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_tlv_end_field(LibEmbd_TlvBuilder_t *tlv);
+
+/**
+ * @brief Writes a complete leaf field
+ *
+ * @param tlv pointer to initialized TLV builder object
+ * @param tag field tag
+ * @param value pointer to the value bytes
+ * @param length number of value bytes
+ */
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_tlv_put_field(LibEmbd_TlvBuilder_t *tlv, uint16 tag, const void *value, uint16 length);
+
+/**
+ * @brief Number of currently open fields
+ *
+ * @param tlv pointer to initialized TLV builder object
+ */
+LIBEMBD_HEADER_API_INLINE uint32 LIBEMBD_ATTR_ALWAYS_INLINE libembd_tlv_depth(LibEmbd_TlvBuilder_t const *tlv);
+
+/**
+ * @brief Query the sticky error flag (nesting error, oversized field or serializer overflow)
+ *
+ * @param tlv pointer to initialized TLV builder object
+ * @return TRUE if the encoded message must not be used
+ * @note Fields still open are not considered an error, check libembd_tlv_depth() for that.
+ */
+LIBEMBD_HEADER_API_INLINE boolean LIBEMBD_ATTR_ALWAYS_INLINE libembd_tlv_builder_has_failed(LibEmbd_TlvBuilder_t const *tlv);
+
+/**
+ * @brief Indexes all top-level fields of a message in a single pass
+ *
+ * @param index pointer to TLV index object, previous content is discarded
+ * @param message the encoded message, must stay valid as long as views returned by the index are used
+ * @return E_OK on success. E_NOT_OK if a field header is truncated, a field length exceeds the message or the message
+ *         holds more than LIBEMBD_TLV_INDEX_CAPACITY - 1 distinct tags; the index is then empty.
+ * @note If a tag occurs more than once, the first occurrence is indexed.
+ */
+LIBEMBD_HEADER_API_INLINE LibEmbd_Std_ReturnType libembd_tlv_index_build(LibEmbd_TlvIndex_t *index, LibEmbd_ConstBufferView_t message);
+
+/**
+ * @brief Looks up the value of a field
+ *
+ * @param index pointer to built TLV index object
+ * @param tag field tag
+ * @return view of the field value pointing into the message, an empty view (data NULL, length 0) if the tag is absent
+ */
+LIBEMBD_HEADER_API_INLINE LibEmbd_ConstBufferView_t LIBEMBD_ATTR_ALWAYS_INLINE libembd_tlv_index_find(LibEmbd_TlvIndex_t const *index, uint16 tag);
+
+/**
+ * @brief Number of distinct tags in the index
+ *
+ * @param index pointer to built TLV index object
+ */
+LIBEMBD_HEADER_API_INLINE uint32 LIBEMBD_ATTR_ALWAYS_INLINE libembd_tlv_index_count(LibEmbd_TlvIndex_t const *index);
+
+#include "libembd/internal/libembd_tlv_impl.h"
+
+#endif /* LIBEMBD_TLV_H_ */
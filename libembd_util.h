@@ -43,12 +43,14 @@
     #include <arm_ghs.h>
     #define LIBEMBD_BSWAP16(u16) __REV16(u16)
     #define LIBEMBD_BSWAP32(u32) __REV(u32)
+    #define LIBEMBD_BSWAP64(u64) \
+        ((((uint64)__REV((uint32)(u64))) << 32u) | (uint64)__REV((uint32)((u64) >> 32u)))
 #else 
     #ifdef __GNUC__ // gnuc
         # if __GNUC_PREREQ (4, 3)
             #define LIBEMBD_BSWAP16(u16) __builtin_bswap16(u16)
             #define LIBEMBD_BSWAP32(u32) __builtin_bswap32(u32)
-            #define LIBEMBD_BSWAP64(u32) __builtin_bswap64(u32)
+            #define LIBEMBD_BSWAP64(u64) __builtin_bswap64(u64)
         # elif __GNUC__ >= 2
             #define LIBEMBD_BSWAP16(u16) \
                 ((u16 & 0xFF00u) >>  8u) | \
@@ -58,6 +60,9 @@
                 ((u32 & 0x00FF0000u) >>  8u) | \
                 ((u32 & 0x0000FF00u) <<  8u) | \
                 ((u32 & 0x000000FFu) << 24u) 
+            #define LIBEMBD_BSWAP64(u64) \
+                ((((uint64)(LIBEMBD_BSWAP32((uint32)(u64)))) << 32u) | \
+                 ((uint64)(LIBEMBD_BSWAP32((uint32)((u64) >> 32u)))))
         # endif  // gcc version
     #else
         #error Unsupported compiler!
@@ -70,7 +75,43 @@
 
 #define LIBEMBD_IS_EVEN(uint) (!((uint) & 1))
 
-#define LIBEMBD_IS_POWER_OF_TWO(uint) (!((uint) & ((uint) - 1))) 
+#define LIBEMBD_IS_POWER_OF_TWO(uint) (!((uint) & ((uint) - 1)))
+
+/**
+ * @brief Count leading/trailing zero bits of a non-zero 64-bit value
+ * @note Undefined for zero input, same as the underlying compiler builtins
+ */
+#if defined(__GNUC__) || defined(__clang__)
+    #define LIBEMBD_CLZ64(u64) ((uint32)__builtin_clzll((unsigned long long)(u64)))
+    #define LIBEMBD_CTZ64(u64) ((uint32)__builtin_ctzll((unsigned long long)(u64)))
+#else
+    LIBEMBD_HEADER_API_INLINE uint32 libembd_clz64_internal(uint64 val) {
+        uint32 n = 0;
+        while((val & (1ull << 63u)) == 0u){ val <<= 1u; n++; }
+        return n;
+    }
+    LIBEMBD_HEADER_API_INLINE uint32 libembd_ctz64_internal(uint64 val) {
+        uint32 n = 0;
+        while((val & 1u) == 0u){ val >>= 1u; n++; }
+        return n;
+    }
+    #define LIBEMBD_CLZ64(u64) libembd_clz64_internal((uint64)(u64))
+    #define LIBEMBD_CTZ64(u64) libembd_ctz64_internal((uint64)(u64))
+#endif
+
+/**
+ * @brief Count set bits of a 64-bit value
+ */
+#if defined(__GNUC__) || defined(__clang__)
+    #define LIBEMBD_POPCOUNT64(u64) ((uint32)__builtin_popcountll((unsigned long long)(u64)))
+#else
+    LIBEMBD_HEADER_API_INLINE uint32 libembd_popcount64_internal(uint64 val) {
+        uint32 n = 0;
+        while(val != 0u){ val &= val - 1u; n++; }
+        return n;
+    }
+    #define LIBEMBD_POPCOUNT64(u64) libembd_popcount64_internal((uint64)(u64))
+#endif
 
 #define LIBEMBD_FIND_INTERNAL(arr, len, val) \
   do { \
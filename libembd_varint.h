@@ -0,0 +1,138 @@
+#ifndef LIBEMBD_VARINT_H_
+#define LIBEMBD_VARINT_H_
+
+#include "libembd/libembd_platform_types.h"
+#include "libembd/libembd_common.h"
+#include "libembd/libembd_marshalling.h"
+
+/**
+ * @file libembd_varint.h
+ * @brief LEB128 variable length integer encoding with zigzag mapping for signed values.
+ *
+ * Unsigned values are encoded 7 bits per byte, least significant group first, with the MSB of each byte set if more
+ * bytes follow (unsigned LEB128, as used by protobuf). Signed values are first zigzag mapped (0, -1, 1, -2, ... -> 0, 1, 2, 3, ...)
+ * so that small magnitudes of either sign stay short.
+ *
+ * Encoded sizes: 16-bit values take at most 3 bytes, 32-bit values at most 5 bytes, 64-bit values at most 10 bytes.
+ *
+ * Decoding uses a branchless word-at-a-time path whenever at least 8 bytes remain in the buffer, and a byte-wise
+ * path otherwise. The checked decoders reject truncated, over-long and out-of-range encodings by setting the sticky
+ * overflow flag of the deserializer.
+ */
+
+#define LIBEMBD_VARINT_MAX_SIZE_16      3u
+#define LIBEMBD_VARINT_MAX_SIZE_32      5u
+#define LIBEMBD_VARINT_MAX_SIZE_64      10u
+
+/**
+ * @brief Zigzag map signed values to unsigned values
+ */
+LIBEMBD_HEADER_API_INLINE uint16 LIBEMBD_ATTR_ALWAYS_INLINE libembd_zigzag_encode16(sint16 value);
+LIBEMBD_HEADER_API_INLINE uint32 LIBEMBD_ATTR_ALWAYS_INLINE libembd_zigzag_encode32(sint32 value);
+LIBEMBD_HEADER_API_INLINE uint64 LIBEMBD_ATTR_ALWAYS_INLINE libembd_zigzag_encode64(sint64 value);
+
+/**
+ * @brief Inverse of the zigzag mapping
+ */
+LIBEMBD_HEADER_API_INLINE sint16 LIBEMBD_ATTR_ALWAYS_INLINE libembd_zigzag_decode16(uint16 value);
+LIBEMBD_HEADER_API_INLINE sint32 LIBEMBD_ATTR_ALWAYS_INLINE libembd_zigzag_decode32(uint32 value);
+LIBEMBD_HEADER_API_INLINE sint64 LIBEMBD_ATTR_ALWAYS_INLINE libembd_zigzag_decode64(uint64 value);
+
+/**
+ * @brief Number of bytes needed to LEB128 encode value
+ */
+LIBEMBD_HEADER_API_INLINE uint32 LIBEMBD_ATTR_ALWAYS_INLINE libembd_varint_size(uint64 value);
+
+/**
+ * @brief Writes value as unsigned LEB128 to underlying buffer and updates write position
+ *
+ * @param ser pointer to initialized serializer object
+ * @param host_value value to serialize
+ * @warning assumes the underlying buffer is large enough to perform the serialization (see libembd_varint_size)
+ */
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_varuint16_unsafe(LibEmbd_Serializer_t *ser, uint16 host_value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_varuint32_unsafe(LibEmbd_Serializer_t *ser, uint32 host_value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_varuint64_unsafe(LibEmbd_Serializer_t *ser, uint64 host_value);
+
+/**
+ * @brief Writes value as zigzag mapped LEB128 to underlying buffer and updates write position
+ *
+ * @param ser pointer to initialized serializer object
+ * @param host_value value to serialize
+ * @warning assumes the underlying buffer is large enough to perform the serialization (see libembd_varint_size)
+ */
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_varsint16_unsafe(LibEmbd_Serializer_t *ser, sint16 host_value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_varsint32_unsafe(LibEmbd_Serializer_t *ser, sint32 host_value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_varsint64_unsafe(LibEmbd_Serializer_t *ser, sint64 host_value);
+
+/**
+ * @brief Checked counterparts of the unsafe varint put APIs
+ *
+ * @note If the encoding does not fit, nothing is written and the sticky overflow flag is set.
+ */
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_varuint16_checked(LibEmbd_Serializer_t *ser, uint16 host_value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_varuint32_checked(LibEmbd_Serializer_t *ser, uint32 host_value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_varuint64_checked(LibEmbd_Serializer_t *ser, uint64 host_value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_varsint16_checked(LibEmbd_Serializer_t *ser, sint16 host_value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_varsint32_checked(LibEmbd_Serializer_t *ser, sint32 host_value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_put_varsint64_checked(LibEmbd_Serializer_t *ser, sint64 host_value);
+
+/**
+ * @brief Reads an unsigned LEB128 value from underlying buffer and updates read position
+ *
+ * @param deser pointer to initialized deserializer object
+ * @param value pointer to variable to deserialize into
+ * @warning Assumes the underlying buffer holds a well-formed encoding of a value in range of the target type
+ */
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_varuint16_unsafe(LibEmbd_Deserializer_t *deser, uint16 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_varuint32_unsafe(LibEmbd_Deserializer_t *deser, uint32 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_varuint64_unsafe(LibEmbd_Deserializer_t *deser, uint64 *value);
+
+/**
+ * @brief Reads a zigzag mapped LEB128 value from underlying buffer and updates read position
+ *
+ * @param deser pointer to initialized deserializer object
+ * @param value pointer to variable to deserialize into
+ * @warning Assumes the underlying buffer holds a well-formed encoding of a value in range of the target type
+ */
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_varsint16_unsafe(LibEmbd_Deserializer_t *deser, sint16 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_varsint32_unsafe(LibEmbd_Deserializer_t *deser, sint32 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_varsint64_unsafe(LibEmbd_Deserializer_t *deser, sint64 *value);
+
+/**
+ * @brief Checked counterparts of the unsafe varint get APIs
+ *
+ * @note On truncated, over-long or out-of-range input *value is zeroed, the read position is left unchanged
+ *       and the sticky overflow flag is set.
+ */
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_varuint16_checked(LibEmbd_Deserializer_t *deser, uint16 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_varuint32_checked(LibEmbd_Deserializer_t *deser, uint32 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_varuint64_checked(LibEmbd_Deserializer_t *deser, uint64 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_varsint16_checked(LibEmbd_Deserializer_t *deser, sint16 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_varsint32_checked(LibEmbd_Deserializer_t *deser, sint32 *value);
+LIBEMBD_HEADER_API_INLINE void LIBEMBD_ATTR_ALWAYS_INLINE libembd_get_varsint64_checked(LibEmbd_Deserializer_t *deser, sint64 *value);
+
+/**
+ * @brief Writes count values as consecutive unsigned LEB128 encodings, checked
+ *
+ * @param ser pointer to initialized serializer object
+ * @param values pointer to the array of values to serialize
+ * @param count number of array elements
+ * @note Either all values are written or nothing is written and the sticky overflow flag is set.
+ */
+LIBEMBD_HEADER_API_INLINE void libembd_put_varuint32_array_checked(LibEmbd_Serializer_t *ser, uint32 const *values, uint32 count);
+
+/**
+ * @brief Reads count consecutive unsigned LEB128 encodings, checked
+ *
+ * @param deser pointer to initialized deserializer object
+ * @param values pointer to the output array
+ * @param count number of array elements
+ * @return number of values successfully decoded. If less than count, the sticky overflow flag is set, the remaining
+ *         output elements are zeroed and the read position is left after the last successfully decoded value.
+ */
+LIBEMBD_HEADER_API_INLINE uint32 libembd_get_varuint32_array_checked(LibEmbd_Deserializer_t *deser, uint32 *values, uint32 count);
+
+#include "libembd/internal/libembd_varint_impl.h"
+
+#endif /* LIBEMBD_VARINT_H_ */
@@ -0,0 +1,51 @@
+#ifndef LIBEMBD_TEST_ATOMIC_HOST_H_
+#define LIBEMBD_TEST_ATOMIC_HOST_H_
+
+/**
+ * @file atomic_host.h
+ * @brief Host stand-in for libembd_atomic.h, which only supports GHS on ARM.
+ *
+ * Include it before any libembd header: it takes the include guard of libembd_atomic.h and provides the subset of its
+ * API the tested modules use, on top of the GCC/Clang __atomic builtins.
+ */
+
+#ifdef LIBEMBD_ATOMIC_H_
+    #error atomic_host.h must be included before libembd_atomic.h!
+#endif
+#define LIBEMBD_ATOMIC_H_
+
+#include "libembd/libembd_platform_types.h"
+#include "libembd/libembd_common.h"
+
+typedef enum {
+    libembd_memory_order_relaxed = __ATOMIC_RELAXED,
+    libembd_memory_order_consume = __ATOMIC_CONSUME,
+    libembd_memory_order_acquire = __ATOMIC_ACQUIRE,
+    libembd_memory_order_release = __ATOMIC_RELEASE,
+    libembd_memory_order_acq_rel = __ATOMIC_ACQ_REL,
+    libembd_memory_order_seq_cst = __ATOMIC_SEQ_CST
+} libembd_memory_order;
+
+typedef struct { volatile uint32 value; } libembd_atomic_uint32_t;
+
+LIBEMBD_HEADER_API_INLINE uint32 libembd_atomic_load_explicit_uint32(libembd_atomic_uint32_t const *ptr, libembd_memory_order order)
+{
+    return __atomic_load_n(&ptr->value, (int)order);
+}
+
+LIBEMBD_HEADER_API_INLINE void libembd_atomic_store_explicit_uint32(libembd_atomic_uint32_t *ptr, uint32 const val, libembd_memory_order order)
+{
+    __atomic_store_n(&ptr->value, val, (int)order);
+}
+
+LIBEMBD_HEADER_API_INLINE uint32 libembd_atomic_fetch_add_uint32(libembd_atomic_uint32_t *ptr, uint32 const val)
+{
+    return __atomic_fetch_add(&ptr->value, val, __ATOMIC_SEQ_CST);
+}
+
+LIBEMBD_HEADER_API_INLINE void libembd_atomic_thread_fence(libembd_memory_order order)
+{
+    __atomic_thread_fence((int)order);
+}
+
+#endif /* LIBEMBD_TEST_ATOMIC_HOST_H_ */
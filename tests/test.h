@@ -0,0 +1,57 @@
+#ifndef LIBEMBD_TEST_H_
+#define LIBEMBD_TEST_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "libembd/libembd_platform_types.h"
+
+/**
+ * @file test.h
+ * @brief Minimal check macros shared by the unit test programs.
+ *
+ * A failed check prints its location and expression and exits, so that the first failure is the one reported.
+ */
+
+#define TEST_CHECK(expr) \
+    do { \
+        if(!(expr)) { \
+            (void)fflush(stdout); \
+            (void)fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #expr); \
+            exit(EXIT_FAILURE); \
+        } \
+    } while(0)
+
+#define TEST_CHECK_EQUAL(expected, actual) \
+    do { \
+        unsigned long long const test_expected_ = (unsigned long long)(expected); \
+        unsigned long long const test_actual_ = (unsigned long long)(actual); \
+        if(test_expected_ != test_actual_) { \
+            (void)fflush(stdout); \
+            (void)fprintf(stderr, "%s:%d: check failed: %s == %s (0x%llX != 0x%llX)\n", __FILE__, __LINE__, \
+                          #expected, #actual, test_expected_, test_actual_); \
+            exit(EXIT_FAILURE); \
+        } \
+    } while(0)
+
+#define TEST_CHECK_BYTES(expected, actual, length) TEST_CHECK(memcmp((expected), (actual), (length)) == 0)
+
+static uint32 g_test_random = 0x9E3779B9u;
+
+//! xorshift32 pseudo random numbers, the same sequence on every run
+static inline uint32 test_random(void)
+{
+    g_test_random ^= g_test_random << 13u;
+    g_test_random ^= g_test_random >> 17u;
+    g_test_random ^= g_test_random << 5u;
+    return g_test_random;
+}
+
+//! runs a test function and reports it
+#define TEST_RUN(test) \
+    do { \
+        test(); \
+        (void)printf("  %-56s ok\n", #test); \
+    } while(0)
+
+#endif /* LIBEMBD_TEST_H_ */
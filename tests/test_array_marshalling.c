@@ -0,0 +1,169 @@
+#include "test.h"
+#include "libembd/libembd_marshalling.h"
+
+// Counts up to MAX_COUNT cover the 16/8/4 element wide vector loops and every tail length, buffer offsets up to
+// MAX_OFFSET put the frame at every position relative to a 32-byte vector boundary.
+#define MAX_COUNT   80u
+#define MAX_OFFSET  32u
+#define GUARD       0xA5u
+
+static _Alignas(32) uint8 g_frame[MAX_OFFSET + MAX_COUNT * sizeof(uint32) + 8u];
+static uint8 g_expected[MAX_COUNT * sizeof(uint32)];
+
+// Every byte of the frame outside [offset, offset + length) still holds the guard pattern
+static void check_guard(uint32 offset, uint32 length)
+{
+    uint32 i;
+    for(i = 0u; i < sizeof(g_frame); i++){
+        if((i < offset) || (i >= offset + length)){
+            TEST_CHECK_EQUAL(GUARD, g_frame[i]);
+        }
+    }
+}
+
+static void test_uint16_arrays(void)
+{
+    _Alignas(32) uint16 values[MAX_COUNT + 16u];
+    _Alignas(32) uint16 restored[MAX_COUNT + 16u];
+    LibEmbd_Serializer_t ser;
+    LibEmbd_Deserializer_t deser;
+
+    for(uint32 count = 0u; count <= MAX_COUNT; count++){
+        for(uint32 offset = 0u; offset < MAX_OFFSET; offset++){
+            uint32 const length = count * (uint32)sizeof(uint16);
+            boolean const aligned = (offset % sizeof(uint16)) == 0u;
+            uint16 *const source = &values[offset % 16u]; //vary the host array alignment as well
+            uint32 i;
+
+            libembd_make_serializer(&ser, g_expected, sizeof(g_expected));
+            for(i = 0u; i < count; i++){
+                source[i] = (uint16)test_random();
+                libembd_put_uint16_to_network_unsafe(&ser, source[i]);
+            }
+
+            memset(g_frame, GUARD, sizeof(g_frame));
+            libembd_make_serializer(&ser, &g_frame[offset], length);
+            libembd_put_uint16_array_to_network_unsafe(&ser, source, count);
+            TEST_CHECK_EQUAL(length, ser.position);
+            TEST_CHECK_BYTES(g_expected, &g_frame[offset], length);
+            check_guard(offset, length);
+
+            memset(restored, 0, sizeof(restored));
+            libembd_make_deserializer(&deser, &g_frame[offset], length);
+            libembd_get_uint16_array_from_network_unsafe(&deser, &restored[offset % 16u], count);
+            TEST_CHECK_EQUAL(length, deser.position);
+            TEST_CHECK_BYTES(source, &restored[offset % 16u], length);
+
+            if(aligned){
+                memset(g_frame, GUARD, sizeof(g_frame));
+                libembd_make_serializer(&ser, &g_frame[offset], length);
+                libembd_put_uint16_array_to_network_aligned_unsafe(&ser, source, count);
+                TEST_CHECK_EQUAL(length, ser.position);
+                TEST_CHECK_BYTES(g_expected, &g_frame[offset], length);
+                check_guard(offset, length);
+
+                memset(restored, 0, sizeof(restored));
+                libembd_make_deserializer(&deser, &g_frame[offset], length);
+                libembd_get_uint16_array_from_network_aligned_unsafe(&deser, &restored[offset % 16u], count);
+                TEST_CHECK_EQUAL(length, deser.position);
+                TEST_CHECK_BYTES(source, &restored[offset % 16u], length);
+            }
+        }
+    }
+}
+
+static void test_uint32_arrays(void)
+{
+    _Alignas(32) uint32 values[MAX_COUNT + 8u];
+    _Alignas(32) uint32 restored[MAX_COUNT + 8u];
+    LibEmbd_Serializer_t ser;
+    LibEmbd_Deserializer_t deser;
+
+    for(uint32 count = 0u; count <= MAX_COUNT; count++){
+        for(uint32 offset = 0u; offset < MAX_OFFSET; offset++){
+            uint32 const length = count * (uint32)sizeof(uint32);
+            boolean const aligned = (offset % sizeof(uint32)) == 0u;
+            uint32 *const source = &values[offset % 8u];
+            uint32 i;
+
+            libembd_make_serializer(&ser, g_expected, sizeof(g_expected));
+            for(i = 0u; i < count; i++){
+                source[i] = test_random();
+                libembd_put_uint32_to_network_unsafe(&ser, source[i]);
+            }
+
+            memset(g_frame, GUARD, sizeof(g_frame));
+            libembd_make_serializer(&ser, &g_frame[offset], length);
+            libembd_put_uint32_array_to_network_unsafe(&ser, source, count);
+            TEST_CHECK_EQUAL(length, ser.position);
+            TEST_CHECK_BYTES(g_expected, &g_frame[offset], length);
+            check_guard(offset, length);
+
+            memset(restored, 0, sizeof(restored));
+            libembd_make_deserializer(&deser, &g_frame[offset], length);
+            libembd_get_uint32_array_from_network_unsafe(&deser, &restored[offset % 8u], count);
+            TEST_CHECK_EQUAL(length, deser.position);
+            TEST_CHECK_BYTES(source, &restored[offset % 8u], length);
+
+            if(aligned){
+                memset(g_frame, GUARD, sizeof(g_frame));
+                libembd_make_serializer(&ser, &g_frame[offset], length);
+                libembd_put_uint32_array_to_network_aligned_unsafe(&ser, source, count);
+                TEST_CHECK_EQUAL(length, ser.position);
+                TEST_CHECK_BYTES(g_expected, &g_frame[offset], length);
+                check_guard(offset, length);
+
+                memset(restored, 0, sizeof(restored));
+                libembd_make_deserializer(&deser, &g_frame[offset], length);
+                libembd_get_uint32_array_from_network_aligned_unsafe(&deser, &restored[offset % 8u], count);
+                TEST_CHECK_EQUAL(length, deser.position);
+                TEST_CHECK_BYTES(source, &restored[offset % 8u], length);
+            }
+        }
+    }
+}
+
+static void test_float32_arrays(void)
+{
+    _Alignas(32) float32 values[MAX_COUNT];
+    _Alignas(32) float32 restored[MAX_COUNT];
+    LibEmbd_Serializer_t ser;
+    LibEmbd_Deserializer_t deser;
+    uint32 i;
+
+    libembd_make_serializer(&ser, g_expected, sizeof(g_expected));
+    for(i = 0u; i < MAX_COUNT; i++){
+        values[i] = (float32)(sint32)test_random() * 1e-3f;
+        libembd_put_float32_to_network_unsafe(&ser, values[i]);
+    }
+
+    memset(g_frame, GUARD, sizeof(g_frame));
+    libembd_make_serializer(&ser, &g_frame[4], sizeof(g_expected));
+    libembd_put_float32_array_to_network_aligned_unsafe(&ser, values, MAX_COUNT);
+    TEST_CHECK_BYTES(g_expected, &g_frame[4], sizeof(g_expected));
+    check_guard(4u, sizeof(g_expected));
+
+    libembd_make_deserializer(&deser, &g_frame[4], sizeof(g_expected));
+    libembd_get_float32_array_from_network_aligned_unsafe(&deser, restored, MAX_COUNT);
+    TEST_CHECK_BYTES(values, restored, sizeof(values));
+
+    memset(g_frame, GUARD, sizeof(g_frame));
+    libembd_make_serializer(&ser, &g_frame[3], sizeof(g_expected));
+    libembd_put_float32_array_to_network_unsafe(&ser, values, MAX_COUNT);
+    TEST_CHECK_BYTES(g_expected, &g_frame[3], sizeof(g_expected));
+    check_guard(3u, sizeof(g_expected));
+
+    memset(restored, 0, sizeof(restored));
+    libembd_make_deserializer(&deser, &g_frame[3], sizeof(g_expected));
+    libembd_get_float32_array_from_network_unsafe(&deser, restored, MAX_COUNT);
+    TEST_CHECK_BYTES(values, restored, sizeof(values));
+}
+
+int main(void)
+{
+    (void)printf("%s\n", __FILE__);
+    TEST_RUN(test_uint16_arrays);
+    TEST_RUN(test_uint32_arrays);
+    TEST_RUN(test_float32_arrays);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,364 @@
+#include "test.h"
+#include "libembd/libembd_marshalling.h"
+#include "libembd/libembd_message_schema.h"
+
+// Frames are allocated with their exact length so that the sanitizer build catches any access beyond frame_length made
+// by the byte-wise tail. g_frame_lengths mixes short frames, where every field runs into the tail, with a CAN-FD frame.
+static uint32 const g_frame_lengths[] = { 1u, 3u, 8u, 9u, 13u, 64u };
+
+static uint64 random64(void)
+{
+    return ((uint64)test_random() << 32u) | test_random();
+}
+
+static uint64 mask_of(uint32 width)
+{
+    return (width == 64u) ? ~0ull : ((1ull << width) - 1u);
+}
+
+// Bit by bit references, DBC numbering: bit (start_bit % 8) of byte (start_bit / 8). Intel fields run from the LSB
+// upwards, Motorola fields from the MSB downwards through each byte and then on to bit 7 of the next byte.
+
+static boolean reference_fits(uint32 frame_length, uint32 start_bit, uint32 width, boolean motorola)
+{
+    if(motorola){
+        uint32 const msb = start_bit ^ 7u; //sawtooth to linear numbering, see the Motorola kernel
+        return (uint64)msb + width <= (uint64)frame_length * 8u;
+    }
+    return (uint64)start_bit + width <= (uint64)frame_length * 8u;
+}
+
+static uint32 reference_next_bit(uint32 bit, boolean motorola)
+{
+    if(!motorola){
+        return bit + 1u;
+    }
+    return ((bit % 8u) == 0u) ? bit + 15u : bit - 1u;
+}
+
+static void reference_write(uint8 *frame, uint32 start_bit, uint32 width, uint64 value, boolean motorola)
+{
+    uint32 bit = start_bit;
+    uint32 k;
+    for(k = 0u; k < width; k++){
+        uint32 const value_bit = motorola ? (width - 1u - k) : k;
+        uint8 const mask = (uint8)(1u << (bit % 8u));
+        if(((value >> value_bit) & 1u) != 0u){
+            frame[bit / 8u] |= mask;
+        } else {
+            frame[bit / 8u] &= (uint8)~mask;
+        }
+        bit = reference_next_bit(bit, motorola);
+    }
+}
+
+static uint64 reference_read(uint8 const *frame, uint32 start_bit, uint32 width, boolean motorola)
+{
+    uint64 value = 0u;
+    uint32 bit = start_bit;
+    uint32 k;
+    for(k = 0u; k < width; k++){
+        uint32 const value_bit = motorola ? (width - 1u - k) : k;
+        value |= (uint64)((frame[bit / 8u] >> (bit % 8u)) & 1u) << value_bit;
+        bit = reference_next_bit(bit, motorola);
+    }
+    return value;
+}
+
+static void write_checked(LibEmbd_BitSerializer_t *bser, uint32 start_bit, uint32 width, uint64 value, boolean motorola)
+{
+    if(motorola){
+        libembd_write_bits_motorola_checked(bser, start_bit, width, value);
+    } else {
+        libembd_write_bits_intel_checked(bser, start_bit, width, value);
+    }
+}
+
+static uint64 read_checked(LibEmbd_BitDeserializer_t *bdeser, uint32 start_bit, uint32 width, boolean motorola)
+{
+    uint64 value = 1u;
+    if(motorola){
+        libembd_read_bits_motorola_checked(bdeser, start_bit, width, &value);
+    } else {
+        libembd_read_bits_intel_checked(bdeser, start_bit, width, &value);
+    }
+    return value;
+}
+
+// Every width at every start bit of every frame length, on a random background: covers single window fields,
+// fields wider than 57 bits split at the window boundary and windows assembled byte by byte near the end of the frame
+static void test_positional_against_reference(void)
+{
+    uint32 f;
+    for(f = 0u; f < sizeof(g_frame_lengths) / sizeof(g_frame_lengths[0]); f++){
+        uint32 const frame_length = g_frame_lengths[f];
+        uint8 * const frame = malloc(frame_length);
+        uint8 * const expected = malloc(frame_length);
+        uint32 order;
+        TEST_CHECK((frame != NULL) && (expected != NULL));
+
+        for(order = 0u; order < 2u; order++){
+            boolean const motorola = (order == 1u);
+            uint32 start_bit;
+            for(start_bit = 0u; start_bit < frame_length * 8u; start_bit++){
+                uint32 width;
+                for(width = 1u; width <= 64u; width++){
+                    uint64 const value = random64();
+                    LibEmbd_BitSerializer_t bser;
+                    LibEmbd_BitDeserializer_t bdeser;
+                    uint32 i;
+
+                    if(!reference_fits(frame_length, start_bit, width, motorola)){
+                        continue;
+                    }
+                    for(i = 0u; i < frame_length; i++){
+                        frame[i] = (uint8)test_random();
+                    }
+                    memcpy(expected, frame, frame_length);
+                    reference_write(expected, start_bit, width, value, motorola);
+
+                    libembd_make_bit_serializer(&bser, frame, frame_length);
+                    write_checked(&bser, start_bit, width, value, motorola);
+                    TEST_CHECK(!libembd_bit_serializer_has_overflowed(&bser));
+                    TEST_CHECK_BYTES(expected, frame, frame_length);
+
+                    libembd_make_bit_deserializer(&bdeser, frame, frame_length);
+                    TEST_CHECK_EQUAL(value & mask_of(width), read_checked(&bdeser, start_bit, width, motorola));
+                    TEST_CHECK(!libembd_bit_deserializer_has_overflowed(&bdeser));
+                    TEST_CHECK_EQUAL(reference_read(frame, start_bit, width, motorola),
+                                     read_checked(&bdeser, start_bit, width, motorola));
+                }
+            }
+        }
+        free(expected);
+        free(frame);
+    }
+}
+
+// Streaming fields back to back: Intel fields continue at the next linear bit, Motorola fields at the next bit in
+// MSB-first order, i.e. the DBC start bit of the following field is next ^ 7
+static void test_streaming_against_reference(void)
+{
+    uint8 frame[64];
+    uint8 expected[64];
+    uint32 round;
+
+    for(round = 0u; round < 2000u; round++){
+        boolean const motorola = (round & 1u) != 0u;
+        uint32 widths[40];
+        uint64 values[40];
+        LibEmbd_BitSerializer_t bser;
+        LibEmbd_BitDeserializer_t bdeser;
+        uint32 count = 0u;
+        uint32 bits = 0u;
+        uint32 i;
+
+        memset(frame, 0, sizeof(frame));
+        memset(expected, 0, sizeof(expected));
+        libembd_make_bit_serializer(&bser, frame, sizeof(frame));
+        while(count < 40u){
+            uint32 const width = 1u + (test_random() % 64u);
+            if(bits + width > sizeof(frame) * 8u){
+                break;
+            }
+            widths[count] = width;
+            values[count] = random64();
+            reference_write(expected, motorola ? (bits ^ 7u) : bits, width, values[count], motorola);
+            if(motorola){
+                libembd_put_bits_motorola_checked(&bser, width, values[count]);
+            } else {
+                libembd_put_bits_intel_checked(&bser, width, values[count]);
+            }
+            bits += width;
+            count++;
+        }
+        TEST_CHECK(!libembd_bit_serializer_has_overflowed(&bser));
+        TEST_CHECK_EQUAL((bits + 7u) / 8u, libembd_bit_serializer_byte_length(&bser));
+        TEST_CHECK_BYTES(expected, frame, sizeof(frame));
+
+        libembd_make_bit_deserializer(&bdeser, frame, (bits + 7u) / 8u);
+        for(i = 0u; i < count; i++){
+            uint64 value;
+            if(motorola){
+                libembd_get_bits_motorola_unsafe(&bdeser, widths[i], &value);
+            } else {
+                libembd_get_bits_intel_unsafe(&bdeser, widths[i], &value);
+            }
+            TEST_CHECK_EQUAL(values[i] & mask_of(widths[i]), value);
+        }
+    }
+}
+
+// Layouts worked out by hand from the DBC definition
+static void test_known_dbc_layouts(void)
+{
+    uint8 frame[8];
+    LibEmbd_BitSerializer_t bser;
+    LibEmbd_BitDeserializer_t bdeser;
+    uint64 value;
+
+    // 24|16@1+ : bytes 3 and 4, little endian
+    memset(frame, 0, sizeof(frame));
+    libembd_make_bit_serializer(&bser, frame, sizeof(frame));
+    libembd_write_bits_intel_unsafe(&bser, 24u, 16u, 0x1234u);
+    TEST_CHECK_BYTES("\x00\x00\x00\x34\x12\x00\x00\x00", frame, 8u);
+
+    // 7|16@0+ : bytes 0 and 1, big endian
+    memset(frame, 0, sizeof(frame));
+    libembd_write_bits_motorola_unsafe(&bser, 7u, 16u, 0x1234u);
+    TEST_CHECK_BYTES("\x12\x34\x00\x00\x00\x00\x00\x00", frame, 8u);
+
+    // 7|12@0+ : all of byte 0, then the high nibble of byte 1
+    memset(frame, 0, sizeof(frame));
+    libembd_write_bits_motorola_unsafe(&bser, 7u, 12u, 0xABCu);
+    TEST_CHECK_BYTES("\xAB\xC0\x00\x00\x00\x00\x00\x00", frame, 8u);
+
+    // 12|12@0+ : bits 4..0 of byte 1, then bits 7..1 of byte 2
+    memset(frame, 0, sizeof(frame));
+    libembd_write_bits_motorola_unsafe(&bser, 12u, 12u, 0xABCu);
+    TEST_CHECK_BYTES("\x00\x15\x78\x00\x00\x00\x00\x00", frame, 8u);
+
+    // 4|12@1+ : high nibble of byte 0, then all of byte 1
+    memset(frame, 0, sizeof(frame));
+    libembd_write_bits_intel_unsafe(&bser, 4u, 12u, 0xABCu);
+    TEST_CHECK_BYTES("\xC0\xAB\x00\x00\x00\x00\x00\x00", frame, 8u);
+
+    // 56|1@0+ : the LSB of the last byte, the last bit a Motorola signal can start at
+    memset(frame, 0, sizeof(frame));
+    libembd_write_bits_motorola_checked(&bser, 56u, 1u, 1u);
+    TEST_CHECK(!libembd_bit_serializer_has_overflowed(&bser));
+    TEST_CHECK_BYTES("\x00\x00\x00\x00\x00\x00\x00\x01", frame, 8u);
+
+    // 7|64@0+ and 0|64@1+ : the whole frame
+    libembd_write_bits_motorola_unsafe(&bser, 7u, 64u, 0x0102030405060708ull);
+    TEST_CHECK_BYTES("\x01\x02\x03\x04\x05\x06\x07\x08", frame, 8u);
+    libembd_make_bit_deserializer(&bdeser, frame, sizeof(frame));
+    libembd_read_bits_intel_unsafe(&bdeser, 0u, 64u, &value);
+    TEST_CHECK_EQUAL(0x0807060504030201ull, value);
+    libembd_read_bits_motorola_unsafe(&bdeser, 7u, 64u, &value);
+    TEST_CHECK_EQUAL(0x0102030405060708ull, value);
+
+    TEST_CHECK_EQUAL(-1, libembd_sign_extend_bits(0x3FFFu, 14u));
+    TEST_CHECK_EQUAL(-8192, libembd_sign_extend_bits(0x2000u, 14u));
+    TEST_CHECK_EQUAL(8191, libembd_sign_extend_bits(0x1FFFu, 14u));
+    TEST_CHECK_EQUAL(INT64_MIN, libembd_sign_extend_bits(0x8000000000000000ull, 64u));
+    TEST_CHECK_EQUAL(-1, libembd_sign_extend_bits(1u, 1u));
+}
+
+// The example frame of libembd_message_schema.h
+#define ENGINE_FRAME_SIGNALS(SIGNAL) \
+    SIGNAL(uint16,  rpm,         0, 14, intel) \
+    SIGNAL(sint8,   coolant,    14,  8, intel) \
+    SIGNAL(uint32,  odometer,   39, 24, motorola)
+
+LIBEMBD_DEFINE_SIGNAL_FRAME(EngineFrame, 8u, ENGINE_FRAME_SIGNALS)
+
+static void test_signal_frame(void)
+{
+    EngineFrame_t const sent = { 3000u, -12, 123456u };
+    EngineFrame_t received;
+    uint8 buffer[LIBEMBD_SIGNAL_FRAME_SIZE(EngineFrame) + 1u];
+    uint8 expected[LIBEMBD_SIGNAL_FRAME_SIZE(EngineFrame)];
+    LibEmbd_Serializer_t ser;
+    LibEmbd_Deserializer_t deser;
+
+    TEST_CHECK_EQUAL(8u, LIBEMBD_SIGNAL_FRAME_SIZE(EngineFrame));
+    memset(expected, 0, sizeof(expected));
+    reference_write(expected, 0u, 14u, sent.rpm, FALSE);
+    reference_write(expected, 14u, 8u, (uint8)sent.coolant, FALSE);
+    reference_write(expected, 39u, 24u, sent.odometer, TRUE);
+    TEST_CHECK_BYTES("\xB8\x0B\x3D\x00\x01\xE2\x40\x00", expected, 8u); //3000 = 0xBB8, -12 = 0xF4, 123456 = 0x01E240
+
+    memset(buffer, 0xFF, sizeof(buffer)); //pack clears the bits no signal covers
+    libembd_make_serializer(&ser, buffer, sizeof(buffer));
+    TEST_CHECK(EngineFrame_pack(&ser, &sent));
+    TEST_CHECK_EQUAL(8u, ser.position);
+    TEST_CHECK_BYTES(expected, buffer, sizeof(expected));
+    TEST_CHECK_EQUAL(0xFFu, buffer[8]);
+
+    libembd_make_deserializer(&deser, buffer, 8u);
+    TEST_CHECK(EngineFrame_unpack(&deser, &received));
+    TEST_CHECK_EQUAL(8u, deser.position);
+    TEST_CHECK_EQUAL(sent.rpm, received.rpm);
+    TEST_CHECK_EQUAL(sent.coolant, received.coolant); //sign extended
+    TEST_CHECK_EQUAL(sent.odometer, received.odometer);
+
+    // a frame that does not fit is neither packed nor unpacked
+    libembd_make_serializer(&ser, buffer, 7u);
+    TEST_CHECK(!EngineFrame_pack(&ser, &sent));
+    TEST_CHECK(libembd_serializer_has_overflowed(&ser));
+    TEST_CHECK_EQUAL(0u, ser.position);
+    libembd_make_deserializer(&deser, buffer, 7u);
+    TEST_CHECK(!EngineFrame_unpack(&deser, &received));
+    TEST_CHECK(libembd_deserializer_has_overflowed(&deser));
+}
+
+static void test_checked_overflow(void)
+{
+    uint8 frame[8];
+    uint8 before[8];
+    LibEmbd_BitSerializer_t bser;
+    LibEmbd_BitDeserializer_t bdeser;
+    uint64 value;
+
+    memset(frame, 0x5A, sizeof(frame));
+    memcpy(before, frame, sizeof(frame));
+
+    // one bit past the end, for either order; nothing is written
+    libembd_make_bit_serializer(&bser, frame, sizeof(frame));
+    libembd_write_bits_intel_checked(&bser, 63u, 2u, 3u);
+    TEST_CHECK(libembd_bit_serializer_has_overflowed(&bser));
+    TEST_CHECK_BYTES(before, frame, sizeof(frame));
+    libembd_make_bit_serializer(&bser, frame, sizeof(frame));
+    libembd_write_bits_motorola_checked(&bser, 56u, 2u, 3u);
+    TEST_CHECK(libembd_bit_serializer_has_overflowed(&bser));
+    TEST_CHECK_BYTES(before, frame, sizeof(frame));
+    libembd_make_bit_serializer(&bser, frame, sizeof(frame));
+    libembd_write_bits_motorola_checked(&bser, 0u, 58u, 3u); //linear bit 7, one bit more than fits
+    TEST_CHECK(libembd_bit_serializer_has_overflowed(&bser));
+
+    // start bits close to the top of the range must not wrap around
+    libembd_make_bit_serializer(&bser, frame, sizeof(frame));
+    libembd_write_bits_intel_checked(&bser, 0xFFFFFFF8u, 64u, 3u);
+    TEST_CHECK(libembd_bit_serializer_has_overflowed(&bser));
+    libembd_make_bit_deserializer(&bdeser, frame, sizeof(frame));
+    libembd_read_bits_motorola_checked(&bdeser, 0xFFFFFFFFu, 16u, &value);
+    TEST_CHECK(libembd_bit_deserializer_has_overflowed(&bdeser));
+    TEST_CHECK_BYTES(before, frame, sizeof(frame));
+
+    // sticky: a valid access after the failure does nothing, reads yield 0
+    libembd_make_bit_serializer(&bser, frame, sizeof(frame));
+    libembd_put_bits_intel_checked(&bser, 60u, 1u);
+    TEST_CHECK_EQUAL(0x01u, frame[0]);
+    libembd_put_bits_intel_checked(&bser, 5u, 1u);
+    TEST_CHECK(libembd_bit_serializer_has_overflowed(&bser));
+    TEST_CHECK_EQUAL(60u, bser.bit_position);
+    libembd_write_bits_intel_checked(&bser, 0u, 8u, 0xFFu);
+    TEST_CHECK_EQUAL(0x01u, frame[0]);
+    libembd_reset_bit_serializer(&bser);
+    TEST_CHECK(!libembd_bit_serializer_has_overflowed(&bser));
+    TEST_CHECK_EQUAL(0u, bser.bit_position);
+
+    libembd_make_bit_deserializer(&bdeser, frame, sizeof(frame));
+    libembd_get_bits_motorola_checked(&bdeser, 60u, &value);
+    TEST_CHECK(!libembd_bit_deserializer_has_overflowed(&bdeser));
+    value = 1u;
+    libembd_get_bits_motorola_checked(&bdeser, 5u, &value);
+    TEST_CHECK(libembd_bit_deserializer_has_overflowed(&bdeser));
+    TEST_CHECK_EQUAL(0u, value);
+    TEST_CHECK_EQUAL(60u, bdeser.bit_position);
+    value = 1u;
+    libembd_read_bits_intel_checked(&bdeser, 0u, 8u, &value);
+    TEST_CHECK_EQUAL(0u, value);
+}
+
+int main(void)
+{
+    (void)printf("%s\n", __FILE__);
+    TEST_RUN(test_positional_against_reference);
+    TEST_RUN(test_streaming_against_reference);
+    TEST_RUN(test_known_dbc_layouts);
+    TEST_RUN(test_signal_frame);
+    TEST_RUN(test_checked_overflow);
+    return EXIT_SUCCESS;
+}
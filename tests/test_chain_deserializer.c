@@ -0,0 +1,261 @@
+#include "test.h"
+#include "libembd/libembd_chain_deserializer.h"
+
+#define MAX_SEGMENTS    64u
+#define RING_SIZE       1000u
+
+static uint8 g_data[4096];
+static uint8 g_ring[RING_SIZE];
+
+static LibEmbd_ConstBufferView_t const_view(uint8 const *data, uint32 length)
+{
+    LibEmbd_ConstBufferView_t view;
+    view.data = data;
+    view.length = (uint16)length;
+    return view;
+}
+
+static void test_fields_straddling_segments(void)
+{
+    uint8 const bytes[] = { 0x01u, 0x02u, 0x03u, 0x04u, 0x05u, 0x06u, 0x07u, 0x08u, 0x09u, 0x0Au, 0x0Bu, 0x0Cu, 0x0Du, 0x0Eu };
+    LibEmbd_ConstBufferView_t const segments[] = {
+        const_view(&bytes[0], 3u), const_view(NULL, 0u), const_view(&bytes[3], 1u), const_view(&bytes[4], 4u),
+        const_view(&bytes[8], 0u), const_view(&bytes[8], 6u)
+    };
+    LibEmbd_ChainDeserializer_t cdeser;
+    uint64 u64;
+    uint16 u16;
+    uint32 u32;
+
+    libembd_make_chain_deserializer(&cdeser, segments, sizeof(segments) / sizeof(segments[0]));
+    TEST_CHECK_EQUAL(sizeof(bytes), libembd_chain_deserializer_remaining_length(&cdeser));
+    libembd_chain_get_uint64_from_network(&cdeser, &u64); //spans four segments, two of them empty
+    TEST_CHECK_EQUAL(0x0102030405060708ull, u64);
+    libembd_chain_get_uint16_from_network(&cdeser, &u16); //within the last segment, read in place
+    TEST_CHECK_EQUAL(0x090Au, u16);
+    libembd_chain_get_uint32_from_host(&cdeser, &u32);
+    TEST_CHECK_EQUAL(0x0E0D0C0Bu, u32);
+    TEST_CHECK_EQUAL(sizeof(bytes), libembd_chain_deserializer_total_length(&cdeser));
+    TEST_CHECK_EQUAL(0u, libembd_chain_deserializer_remaining_length(&cdeser));
+    TEST_CHECK(!libembd_chain_deserializer_has_overflowed(&cdeser));
+}
+
+static void test_ring_wrap(void)
+{
+    uint8 ring[8] = { 0x05u, 0x06u, 0x07u, 0x08u, 0xEEu, 0x01u, 0x02u, 0x03u };
+    LibEmbd_ChainDeserializer_t cdeser;
+    LibEmbd_ConstBufferView_t view;
+    uint32 u32;
+    uint8 u8;
+
+    //valid bytes 01 02 03 | 05 06 07 08 wrap around the end of storage
+    libembd_make_ring_deserializer(&cdeser, ring, sizeof(ring), 5u, 7u);
+    libembd_chain_get_uint8(&cdeser, &u8);
+    TEST_CHECK_EQUAL(0x01u, u8);
+    libembd_chain_get_uint32_from_network(&cdeser, &u32);
+    TEST_CHECK_EQUAL(0x02030506u, u32);
+    view = libembd_chain_get_view(&cdeser, 2u);
+    TEST_CHECK(view.data == &ring[2]);
+    TEST_CHECK_EQUAL(2u, view.length);
+    TEST_CHECK_EQUAL(7u, libembd_chain_deserializer_total_length(&cdeser));
+    libembd_chain_get_uint8(&cdeser, &u8); //0xEE is not part of the valid bytes
+    TEST_CHECK_EQUAL(0u, u8);
+    TEST_CHECK(libembd_chain_deserializer_has_overflowed(&cdeser));
+
+    //the whole ring, starting at 0, does not wrap
+    libembd_make_ring_deserializer(&cdeser, ring, sizeof(ring), 0u, sizeof(ring));
+    libembd_chain_skip(&cdeser, sizeof(ring));
+    TEST_CHECK_EQUAL(0u, libembd_chain_deserializer_remaining_length(&cdeser));
+    TEST_CHECK(!libembd_chain_deserializer_has_overflowed(&cdeser));
+}
+
+static void test_view_and_overflow(void)
+{
+    uint8 const bytes[] = { 1u, 2u, 3u, 4u, 5u, 6u };
+    LibEmbd_ConstBufferView_t const segments[] = { const_view(&bytes[0], 3u), const_view(&bytes[3], 3u) };
+    LibEmbd_ChainDeserializer_t cdeser;
+    LibEmbd_ConstBufferView_t view;
+    uint8 buffer[6] = { 0u };
+    uint32 u32 = 0xFFFFFFFFu;
+
+    libembd_make_chain_deserializer(&cdeser, segments, 2u);
+    view = libembd_chain_get_view(&cdeser, 2u);
+    TEST_CHECK(view.data == &bytes[0]);
+    //straddles the boundary: empty view, nothing read and no overflow, so the caller can copy instead
+    view = libembd_chain_get_view(&cdeser, 2u);
+    TEST_CHECK(view.data == NULL);
+    TEST_CHECK_EQUAL(0u, view.length);
+    TEST_CHECK_EQUAL(2u, libembd_chain_deserializer_total_length(&cdeser));
+    TEST_CHECK(!libembd_chain_deserializer_has_overflowed(&cdeser));
+    libembd_chain_get_buffer(&cdeser, buffer, 2u);
+    TEST_CHECK_BYTES(&bytes[2], buffer, 2u);
+
+    //overflow: nothing is read, the value is zeroed and every later read fails as well
+    libembd_chain_get_uint32_from_network(&cdeser, &u32);
+    TEST_CHECK_EQUAL(0u, u32);
+    TEST_CHECK(libembd_chain_deserializer_has_overflowed(&cdeser));
+    TEST_CHECK_EQUAL(4u, libembd_chain_deserializer_total_length(&cdeser));
+    TEST_CHECK_EQUAL(0u, libembd_chain_deserializer_remaining_length(&cdeser));
+    memset(buffer, 0xAA, sizeof(buffer));
+    libembd_chain_get_buffer(&cdeser, buffer, 1u);
+    TEST_CHECK_EQUAL(0u, buffer[0]);
+    view = libembd_chain_get_view(&cdeser, 1u);
+    TEST_CHECK(view.data == NULL);
+    libembd_chain_skip(&cdeser, 0u);
+    TEST_CHECK(libembd_chain_deserializer_has_overflowed(&cdeser));
+    TEST_CHECK_EQUAL(4u, libembd_chain_deserializer_total_length(&cdeser));
+
+    //no segments at all
+    u32 = 1u;
+    libembd_make_chain_deserializer(&cdeser, NULL, 0u);
+    libembd_chain_get_uint32_from_network(&cdeser, &u32);
+    TEST_CHECK_EQUAL(0u, u32);
+    TEST_CHECK(libembd_chain_deserializer_has_overflowed(&cdeser));
+}
+
+// Replays the same random read sequence on a contiguous checked deserializer over the same bytes and compares
+static void compare_with_contiguous(LibEmbd_ChainDeserializer_t *cdeser, uint32 length)
+{
+    LibEmbd_Deserializer_t deser;
+    uint32 i;
+
+    libembd_make_deserializer(&deser, g_data, length);
+    for(i = 0u; i < 400u; i++){
+        switch(test_random() % 8u){
+            case 0u: {
+                uint8 expected, actual;
+                libembd_get_uint8_checked(&deser, &expected);
+                libembd_chain_get_uint8(cdeser, &actual);
+                TEST_CHECK_EQUAL(expected, actual);
+                break;
+            }
+            case 1u: {
+                uint16 expected, actual;
+                libembd_get_uint16_from_network_checked(&deser, &expected);
+                libembd_chain_get_uint16_from_network(cdeser, &actual);
+                TEST_CHECK_EQUAL(expected, actual);
+                break;
+            }
+            case 2u: {
+                sint32 expected, actual;
+                libembd_get_sint32_from_network_checked(&deser, &expected);
+                libembd_chain_get_sint32_from_network(cdeser, &actual);
+                TEST_CHECK_EQUAL(expected, actual);
+                break;
+            }
+            case 3u: {
+                uint64 expected, actual;
+                libembd_get_uint64_from_host_checked(&deser, &expected);
+                libembd_chain_get_uint64_from_host(cdeser, &actual);
+                TEST_CHECK_EQUAL(expected, actual);
+                break;
+            }
+            case 4u: {
+                uint8 expected[40];
+                uint8 actual[40];
+                uint32 const count = test_random() % sizeof(expected);
+                memset(expected, 0x11, sizeof(expected));
+                memset(actual, 0x22, sizeof(actual)); //both zeroed on failure
+                libembd_get_buffer_checked(&deser, expected, count);
+                libembd_chain_get_buffer(cdeser, actual, count);
+                TEST_CHECK_BYTES(expected, actual, count);
+                break;
+            }
+            case 5u: {
+                uint32 const count = test_random() % 30u;
+                if(libembd_deserializer_reserve(&deser, count)){
+                    deser.position += count;
+                }
+                libembd_chain_skip(cdeser, count);
+                break;
+            }
+            case 6u: {
+                uint16 const count = (uint16)(test_random() % 20u);
+                boolean const overflowed = libembd_chain_deserializer_has_overflowed(cdeser);
+                LibEmbd_Size_t const before = libembd_chain_deserializer_total_length(cdeser);
+                LibEmbd_ConstBufferView_t const view = libembd_chain_get_view(cdeser, count);
+                if(view.data != NULL){
+                    TEST_CHECK(libembd_deserializer_reserve(&deser, count));
+                    TEST_CHECK_EQUAL(count, view.length);
+                    TEST_CHECK_BYTES(&g_data[deser.position], view.data, count);
+                    deser.position += count;
+                } else if(overflowed || libembd_chain_deserializer_has_overflowed(cdeser)){
+                    (void)libembd_deserializer_reserve(&deser, count); //fails on both
+                } else {
+                    TEST_CHECK_EQUAL(before, libembd_chain_deserializer_total_length(cdeser)); //straddling, nothing read
+                }
+                break;
+            }
+            default: {
+                float64 expected, actual;
+                libembd_get_float64_from_network_checked(&deser, &expected);
+                libembd_chain_get_float64_from_network(cdeser, &actual);
+                TEST_CHECK_BYTES(&expected, &actual, sizeof(expected));
+                break;
+            }
+        }
+        TEST_CHECK_EQUAL(libembd_deserializer_has_overflowed(&deser), libembd_chain_deserializer_has_overflowed(cdeser));
+        if(!libembd_deserializer_has_overflowed(&deser)){
+            TEST_CHECK_EQUAL(deser.position, libembd_chain_deserializer_total_length(cdeser));
+            TEST_CHECK_EQUAL(length - deser.position, libembd_chain_deserializer_remaining_length(cdeser));
+        }
+    }
+}
+
+static void test_random_segments(void)
+{
+    LibEmbd_ConstBufferView_t segments[MAX_SEGMENTS];
+    LibEmbd_ChainDeserializer_t cdeser;
+    uint32 i;
+
+    for(i = 0u; i < 20000u; i++){
+        uint32 const length = test_random() % 600u;
+        uint32 count = 0u;
+        uint32 position = 0u;
+
+        //mostly short segments, some long and some empty (with and without a data pointer)
+        while((position < length) && (count < MAX_SEGMENTS - 1u)){
+            uint32 size = ((test_random() % 4u) == 0u) ? 0u : (test_random() % 20u);
+            if((test_random() % 10u) == 0u){
+                size = test_random() % 200u;
+            }
+            size = LIBEMBD_MIN(size, length - position);
+            segments[count++] = const_view(((size == 0u) && ((test_random() & 1u) != 0u)) ? NULL : &g_data[position], size);
+            position += size;
+        }
+        libembd_make_chain_deserializer(&cdeser, segments, count);
+        compare_with_contiguous(&cdeser, position);
+    }
+}
+
+static void test_random_ring(void)
+{
+    LibEmbd_ChainDeserializer_t cdeser;
+    uint32 i;
+
+    for(i = 0u; i < 20000u; i++){
+        uint32 const length = test_random() % (RING_SIZE + 1u);
+        uint32 const read_index = test_random() % RING_SIZE;
+        for(uint32 j = 0u; j < length; j++){
+            g_ring[(read_index + j) % RING_SIZE] = g_data[j];
+        }
+        libembd_make_ring_deserializer(&cdeser, g_ring, RING_SIZE, read_index, length);
+        compare_with_contiguous(&cdeser, length);
+    }
+}
+
+int main(void)
+{
+    uint32 i;
+
+    (void)printf("%s\n", __FILE__);
+    for(i = 0u; i < sizeof(g_data); i++){
+        g_data[i] = (uint8)test_random();
+    }
+    TEST_RUN(test_fields_straddling_segments);
+    TEST_RUN(test_ring_wrap);
+    TEST_RUN(test_view_and_overflow);
+    TEST_RUN(test_random_segments);
+    TEST_RUN(test_random_ring);
+    return EXIT_SUCCESS;
+}
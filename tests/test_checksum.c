@@ -0,0 +1,190 @@
+#include "test.h"
+#include "libembd/libembd_checksum.h"
+
+static uint8 const check_input[] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+
+static LibEmbd_ConstBufferView_t make_view(uint8 const *data, uint32 length)
+{
+    LibEmbd_ConstBufferView_t view;
+    view.data = data;
+    view.length = length;
+    return view;
+}
+
+static void test_check_values(void)
+{
+    uint8 const fletcher_input[] = { 'a', 'b', 'c', 'd', 'e' };
+
+    TEST_CHECK_EQUAL(0xE3069283u, libembd_crc32c(make_view(check_input, sizeof(check_input))));
+    TEST_CHECK_EQUAL(0x29B1u, libembd_crc16_ccitt(make_view(check_input, sizeof(check_input))));
+    TEST_CHECK_EQUAL(0xC8F0u, libembd_fletcher16(make_view(fletcher_input, sizeof(fletcher_input))));
+    TEST_CHECK_EQUAL(0x0000u, libembd_crc32c(make_view(check_input, 0u)));
+}
+
+static void test_chained_update(void)
+{
+    static uint8 data[20000];
+    uint32 i;
+    uint32 split;
+
+    for(i = 0u; i < sizeof(data); i++){
+        data[i] = (uint8)((i * 7u) ^ (i >> 5u));
+    }
+    for(split = 0u; split < sizeof(data); split += 997u){
+        uint32 const crc32c = libembd_crc32c_update(libembd_crc32c_update(LIBEMBD_CRC32C_INIT, data, split), &data[split], sizeof(data) - split);
+        uint16 const crc16 = libembd_crc16_ccitt_update(libembd_crc16_ccitt_update(LIBEMBD_CRC16_CCITT_INIT, data, split), &data[split], sizeof(data) - split);
+        uint16 const fletcher16 = libembd_fletcher16_update(libembd_fletcher16_update(LIBEMBD_FLETCHER16_INIT, data, split), &data[split], sizeof(data) - split);
+
+        TEST_CHECK_EQUAL(libembd_crc32c(make_view(data, sizeof(data))), crc32c);
+        TEST_CHECK_EQUAL(libembd_crc16_ccitt(make_view(data, sizeof(data))), crc16);
+        TEST_CHECK_EQUAL(libembd_fletcher16(make_view(data, sizeof(data))), fletcher16);
+    }
+}
+
+static uint32 checksum_of(LibEmbd_Checksum_Type_t type, uint8 const *data, uint32 length)
+{
+    LibEmbd_ConstBufferView_t const view = make_view(data, length);
+    return (type == LIBEMBD_CHECKSUM_CRC32C) ? libembd_crc32c(view) :
+           (type == LIBEMBD_CHECKSUM_CRC16_CCITT) ? (uint32)libembd_crc16_ccitt(view) : (uint32)libembd_fletcher16(view);
+}
+
+static void test_round_trip(void)
+{
+    LibEmbd_Checksum_Type_t type;
+
+    for(type = 0u; type < LIBEMBD_CHECKSUM_LAST_DO_NOT_USE; type++){
+        uint8 frame[64];
+        uint8 const payload[5] = { 1u, 2u, 3u, 4u, 5u };
+        uint8 payload_out[5];
+        uint16 id;
+        uint32 counter;
+        uint8 flags;
+        uint32 const trailer = (type == LIBEMBD_CHECKSUM_CRC32C) ? 4u : 2u;
+        LibEmbd_ChecksumSerializer_t cser;
+        LibEmbd_ChecksumDeserializer_t cdeser;
+
+        libembd_make_checksum_serializer(&cser, frame, sizeof(frame), type);
+        libembd_checksum_put_uint16_to_network(&cser, 0x1234u);
+        libembd_checksum_put_uint32_to_network(&cser, 0xDEADBEEFu);
+        libembd_put_uint8_checked(libembd_checksum_serializer_base(&cser), 0xA5u);
+        libembd_checksum_put_buffer(&cser, payload, sizeof(payload));
+        TEST_CHECK_EQUAL(checksum_of(type, frame, 12u), libembd_checksum_serializer_value(&cser));
+        libembd_checksum_serializer_put_checksum(&cser);
+        TEST_CHECK(!libembd_serializer_has_overflowed(libembd_checksum_serializer_base(&cser)));
+        TEST_CHECK_EQUAL(12u + trailer, libembd_checksum_serializer_base(&cser)->position);
+
+        libembd_make_checksum_deserializer(&cdeser, frame, 12u + trailer, type);
+        libembd_checksum_get_uint16_from_network(&cdeser, &id);
+        libembd_checksum_get_uint32_from_network(&cdeser, &counter);
+        libembd_get_uint8_checked(libembd_checksum_deserializer_base(&cdeser), &flags);
+        libembd_checksum_get_buffer(&cdeser, payload_out, sizeof(payload_out));
+        TEST_CHECK(libembd_checksum_deserializer_verify(&cdeser));
+        TEST_CHECK_EQUAL(0x1234u, id);
+        TEST_CHECK_EQUAL(0xDEADBEEFu, counter);
+        TEST_CHECK_EQUAL(0xA5u, flags);
+        TEST_CHECK_BYTES(payload, payload_out, sizeof(payload));
+
+        //a flipped bit is detected
+        frame[7] ^= 0x10u;
+        libembd_make_checksum_deserializer(&cdeser, frame, 12u + trailer, type);
+        libembd_checksum_get_buffer(&cdeser, payload_out, 5u);
+        libembd_checksum_get_buffer(&cdeser, payload_out, 5u);
+        libembd_checksum_get_uint16_from_network(&cdeser, &id);
+        TEST_CHECK(!libembd_checksum_deserializer_verify(&cdeser));
+
+        //a truncated frame fails verification
+        libembd_make_checksum_deserializer(&cdeser, frame, 12u + trailer - 1u, type);
+        libembd_checksum_get_buffer(&cdeser, payload_out, 5u);
+        libembd_checksum_get_buffer(&cdeser, payload_out, 5u);
+        libembd_checksum_get_uint16_from_network(&cdeser, &id);
+        TEST_CHECK(!libembd_checksum_deserializer_verify(&cdeser));
+    }
+}
+
+// Moving the position back must not accumulate a wrapped around length
+static void test_serializer_seek_back(void)
+{
+    uint8 frame[16];
+    LibEmbd_ChecksumSerializer_t cser;
+
+    libembd_make_checksum_serializer(&cser, frame, sizeof(frame), LIBEMBD_CHECKSUM_CRC32C);
+    libembd_checksum_put_uint32_to_network(&cser, 0x01020304u);
+    libembd_serializer_seek(libembd_checksum_serializer_base(&cser), 0u);
+    libembd_checksum_put_uint8(&cser, 0xFFu);
+    TEST_CHECK_EQUAL(checksum_of(LIBEMBD_CHECKSUM_CRC32C, frame, 1u), libembd_checksum_serializer_value(&cser));
+
+    libembd_serializer_seek(libembd_checksum_serializer_base(&cser), 4u);
+    TEST_CHECK_EQUAL(checksum_of(LIBEMBD_CHECKSUM_CRC32C, frame, 4u), libembd_checksum_serializer_value(&cser));
+    TEST_CHECK_EQUAL(0xFFu, frame[0]);
+}
+
+// A write straddling the accumulated position after moving back must not leave stale bytes in the checksum
+static void test_serializer_backpatch(void)
+{
+    LibEmbd_Checksum_Type_t type;
+
+    for(type = 0u; type < LIBEMBD_CHECKSUM_LAST_DO_NOT_USE; type++){
+        uint8 frame[32];
+        uint8 const payload[7] = { 9u, 8u, 7u, 6u, 5u, 4u, 3u };
+        LibEmbd_ChecksumSerializer_t cser;
+        LibEmbd_Serializer_t *ser;
+        uint32 end;
+        uint16 length;
+        LibEmbd_ChecksumDeserializer_t cdeser;
+
+        libembd_make_checksum_serializer(&cser, frame, sizeof(frame), type);
+        ser = libembd_checksum_serializer_base(&cser);
+        libembd_checksum_put_uint8(&cser, 0x42u);
+        libembd_checksum_put_uint16_to_network(&cser, 0u); //length placeholder
+        libembd_checksum_put_buffer(&cser, payload, sizeof(payload));
+        end = ser->position;
+        libembd_serializer_seek(ser, 1u);
+        libembd_checksum_put_uint16_to_network(&cser, (uint16)sizeof(payload));
+        libembd_serializer_seek(ser, end);
+        libembd_checksum_serializer_put_checksum(&cser);
+        TEST_CHECK(!libembd_serializer_has_overflowed(ser));
+
+        libembd_make_checksum_deserializer(&cdeser, frame, ser->position, type);
+        libembd_checksum_get_uint8(&cdeser, &frame[31]);
+        libembd_checksum_get_uint16_from_network(&cdeser, &length);
+        TEST_CHECK_EQUAL(sizeof(payload), length);
+        libembd_deserializer_skip(libembd_checksum_deserializer_base(&cdeser), length);
+        TEST_CHECK(libembd_checksum_deserializer_verify(&cdeser));
+    }
+}
+
+static void test_seek_before_frame_start(void)
+{
+    uint8 frame[16] = { 0u };
+    LibEmbd_ChecksumSerializer_t cser;
+    LibEmbd_ChecksumDeserializer_t cdeser;
+    uint8 value;
+
+    libembd_make_checksum_serializer(&cser, frame, sizeof(frame), LIBEMBD_CHECKSUM_CRC16_CCITT);
+    libembd_checksum_put_uint32_to_network(&cser, 0x11223344u);
+    libembd_checksum_serializer_put_checksum(&cser); //restarts at 6
+    libembd_checksum_put_uint16_to_network(&cser, 0x5566u);
+    libembd_serializer_seek(libembd_checksum_serializer_base(&cser), 2u);
+    libembd_checksum_put_uint8(&cser, 0x77u);
+    TEST_CHECK_EQUAL(checksum_of(LIBEMBD_CHECKSUM_CRC16_CCITT, &frame[2], 1u), libembd_checksum_serializer_value(&cser));
+
+    libembd_make_checksum_deserializer(&cdeser, frame, sizeof(frame), LIBEMBD_CHECKSUM_FLETCHER16);
+    libembd_checksum_get_buffer(&cdeser, &frame[12], 4u);
+    libembd_deserializer_seek(libembd_checksum_deserializer_base(&cdeser), 0u);
+    libembd_checksum_get_uint8(&cdeser, &value);
+    TEST_CHECK_EQUAL(checksum_of(LIBEMBD_CHECKSUM_FLETCHER16, frame, 1u), libembd_checksum_deserializer_value(&cdeser));
+    libembd_deserializer_seek(libembd_checksum_deserializer_base(&cdeser), 3u);
+    TEST_CHECK_EQUAL(checksum_of(LIBEMBD_CHECKSUM_FLETCHER16, frame, 3u), libembd_checksum_deserializer_value(&cdeser));
+}
+
+int main(void)
+{
+    (void)printf("%s\n", __FILE__);
+    TEST_RUN(test_check_values);
+    TEST_RUN(test_chained_update);
+    TEST_RUN(test_round_trip);
+    TEST_RUN(test_serializer_seek_back);
+    TEST_RUN(test_serializer_backpatch);
+    TEST_RUN(test_seek_before_frame_start);
+    return EXIT_SUCCESS;
+}
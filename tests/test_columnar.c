@@ -0,0 +1,260 @@
+#include "test.h"
+#include "libembd/libembd_columnar.h"
+
+#define MAX_SAMPLES     200u
+#define MAX_BATCH_SIZE  (13u + MAX_SAMPLES * 8u + 2u + LIBEMBD_COLUMNAR_DICTIONARY_SIZE * 4u + MAX_SAMPLES * 5u)
+
+static uint64 g_timestamps[MAX_SAMPLES];
+static uint8 g_indices[MAX_SAMPLES];
+static float32 g_values[MAX_SAMPLES];
+static LibEmbd_TelemetryBatch_t g_batch;
+
+typedef struct {
+    uint64 timestamp;
+    uint32 id;
+    float32 value;
+} Sample_t;
+
+// Samples in random order from base on, spanning at most range, drawn from id_count distinct ids
+static void make_samples(Sample_t *samples, uint32 count, uint64 base, uint64 range, uint32 id_count)
+{
+    uint32 i;
+    for(i = 0u; i < count; i++){
+        uint64 const offset = (((uint64)test_random() << 32u) | test_random()) % (range + 1u);
+        samples[i].timestamp = base + offset;
+        samples[i].id = 0xC0DE0000u + (test_random() % id_count) * 7919u;
+        samples[i].value = (float32)(sint32)test_random() / 1024.0f;
+    }
+    if(count > 1u){
+        uint32 const first = test_random() % count;
+        samples[first].timestamp = base; //span exactly range
+        samples[(first + 1u + test_random() % (count - 1u)) % count].timestamp = base + range;
+    }
+}
+
+static uint32 encode(uint8 *buffer, uint32 capacity, Sample_t const *samples, uint32 count)
+{
+    LibEmbd_Serializer_t ser;
+    uint32 i;
+
+    libembd_make_telemetry_batch(&g_batch, g_timestamps, g_indices, g_values, MAX_SAMPLES);
+    for(i = 0u; i < count; i++){
+        TEST_CHECK_EQUAL(E_OK, libembd_telemetry_batch_append(&g_batch, samples[i].timestamp, samples[i].id, samples[i].value));
+    }
+    TEST_CHECK_EQUAL(count, libembd_telemetry_batch_count(&g_batch));
+    libembd_make_serializer(&ser, buffer, capacity);
+    libembd_put_telemetry_batch_checked(&ser, &g_batch);
+    TEST_CHECK(!libembd_serializer_has_overflowed(&ser));
+    return ser.position;
+}
+
+static void check_view(LibEmbd_TelemetryBatchView_t const *view, Sample_t const *samples, uint32 count)
+{
+    float32 copied[MAX_SAMPLES];
+    uint32 i;
+
+    TEST_CHECK_EQUAL(count, view->count);
+    libembd_float32_column_copy(&view->values, 0u, count, copied);
+    for(i = 0u; i < count; i++){
+        uint8 index = 0xFFu;
+        TEST_CHECK_EQUAL(samples[i].timestamp, libembd_timestamp_column_at(&view->timestamps, i));
+        TEST_CHECK_EQUAL(samples[i].id, libembd_dictionary_column_at(&view->ids, i));
+        TEST_CHECK(libembd_dictionary_column_find(&view->ids, samples[i].id, &index));
+        TEST_CHECK_EQUAL(index, view->ids.indices[i]);
+        TEST_CHECK(libembd_float32_column_at(&view->values, i) == samples[i].value);
+        TEST_CHECK(copied[i] == samples[i].value);
+    }
+}
+
+// Every offset width, on both sides of each width boundary
+static void test_round_trip(void)
+{
+    static uint64 const ranges[] = { 0u, 0xFFu, 0x100u, 0xFFFFu, 0x10000u, 0xFFFFFFFFu, 0x100000000ull, 0xFFFFFFFFFFFFull };
+    static uint8 const widths[] = { 1u, 1u, 2u, 2u, 4u, 4u, 8u, 8u };
+    uint8 buffer[MAX_BATCH_SIZE + 3u];
+    Sample_t samples[MAX_SAMPLES];
+    uint32 r;
+
+    for(r = 0u; r < sizeof(ranges) / sizeof(ranges[0]); r++){
+        uint32 const count = 2u + (test_random() % (MAX_SAMPLES - 1u));
+        uint32 const id_count = 1u + (test_random() % 60u);
+        LibEmbd_Deserializer_t deser;
+        LibEmbd_TelemetryBatchView_t view;
+        uint32 length;
+        uint8 index;
+
+        make_samples(samples, count, 1700000000000ull, ranges[r], id_count);
+        length = encode(buffer, sizeof(buffer), samples, count);
+        TEST_CHECK_EQUAL(widths[r], buffer[12]);
+        TEST_CHECK(length <= 13u + count * widths[r] + 2u + id_count * 4u + count * 5u);
+
+        buffer[length] = 0x5Au; //whatever follows the batch stays unread
+        libembd_make_deserializer(&deser, buffer, length + 1u);
+        libembd_get_telemetry_batch_checked(&deser, &view);
+        TEST_CHECK(!libembd_deserializer_has_overflowed(&deser));
+        TEST_CHECK_EQUAL(length, deser.position);
+        TEST_CHECK_EQUAL(widths[r], view.timestamps.width);
+        check_view(&view, samples, count);
+        TEST_CHECK(!libembd_dictionary_column_find(&view.ids, 0x12345678u, &index));
+    }
+}
+
+static void test_empty_batch(void)
+{
+    uint8 buffer[32];
+    LibEmbd_Deserializer_t deser;
+    LibEmbd_TelemetryBatchView_t view;
+    uint32 length;
+    uint8 index;
+
+    length = encode(buffer, sizeof(buffer), NULL, 0u);
+    TEST_CHECK_EQUAL(13u + 2u, length);
+    libembd_make_deserializer(&deser, buffer, length);
+    libembd_get_telemetry_batch_checked(&deser, &view);
+    TEST_CHECK(!libembd_deserializer_has_overflowed(&deser));
+    TEST_CHECK_EQUAL(0u, view.count);
+    TEST_CHECK_EQUAL(0u, view.ids.size);
+    TEST_CHECK(!libembd_dictionary_column_find(&view.ids, 0xC0DE0000u, &index));
+}
+
+static void test_append_limits(void)
+{
+    static uint64 timestamps[LIBEMBD_COLUMNAR_DICTIONARY_SIZE + 1u];
+    static uint8 indices[LIBEMBD_COLUMNAR_DICTIONARY_SIZE + 1u];
+    static float32 values[LIBEMBD_COLUMNAR_DICTIONARY_SIZE + 1u];
+    uint32 i;
+
+    libembd_make_telemetry_batch(&g_batch, timestamps, indices, values, 3u);
+    for(i = 0u; i < 3u; i++){
+        TEST_CHECK_EQUAL(E_OK, libembd_telemetry_batch_append(&g_batch, i, 7u, 1.0f));
+    }
+    TEST_CHECK_EQUAL(E_NOT_OK, libembd_telemetry_batch_append(&g_batch, 3u, 7u, 1.0f));
+    TEST_CHECK_EQUAL(3u, libembd_telemetry_batch_count(&g_batch));
+    libembd_reset_telemetry_batch(&g_batch);
+    TEST_CHECK_EQUAL(0u, libembd_telemetry_batch_count(&g_batch));
+
+    // one distinct id too many, known ids are still accepted afterwards
+    libembd_make_telemetry_batch(&g_batch, timestamps, indices, values, LIBEMBD_COLUMNAR_DICTIONARY_SIZE + 1u);
+    for(i = 0u; i < LIBEMBD_COLUMNAR_DICTIONARY_SIZE; i++){
+        TEST_CHECK_EQUAL(E_OK, libembd_telemetry_batch_append(&g_batch, i, i * 0x10000u, 1.0f)); //ids colliding in the hash
+        TEST_CHECK_EQUAL(i, indices[i]);
+    }
+    TEST_CHECK_EQUAL(E_NOT_OK, libembd_telemetry_batch_append(&g_batch, 0u, 0xFFFFFFFFu, 1.0f));
+    TEST_CHECK_EQUAL(E_OK, libembd_telemetry_batch_append(&g_batch, 0u, 0x30000u, 1.0f));
+    TEST_CHECK_EQUAL(3u, indices[LIBEMBD_COLUMNAR_DICTIONARY_SIZE]);
+}
+
+// Every proper prefix of a batch is rejected without consuming anything, the same for a serializer that is too small
+static void test_truncation(void)
+{
+    uint8 buffer[MAX_BATCH_SIZE];
+    uint8 small[MAX_BATCH_SIZE];
+    Sample_t samples[20];
+    uint32 length;
+    uint32 prefix;
+
+    make_samples(samples, 20u, 1000u, 0x1234u, 5u);
+    length = encode(buffer, sizeof(buffer), samples, 20u);
+    for(prefix = 0u; prefix < length; prefix++){
+        LibEmbd_Deserializer_t deser;
+        LibEmbd_Serializer_t ser;
+        LibEmbd_TelemetryBatchView_t view;
+
+        memset(&view, 0xA5, sizeof(view));
+        libembd_make_deserializer(&deser, buffer, prefix);
+        libembd_get_telemetry_batch_checked(&deser, &view);
+        TEST_CHECK(libembd_deserializer_has_overflowed(&deser));
+        TEST_CHECK_EQUAL(0u, deser.position);
+        TEST_CHECK_EQUAL(0u, view.count);
+        TEST_CHECK_EQUAL(0u, view.ids.size);
+
+        memset(small, 0xEE, sizeof(small));
+        libembd_make_serializer(&ser, small, prefix);
+        libembd_put_telemetry_batch_checked(&ser, &g_batch);
+        TEST_CHECK(libembd_serializer_has_overflowed(&ser));
+        TEST_CHECK_EQUAL(0u, ser.position);
+        TEST_CHECK_EQUAL(0xEEu, small[0]);
+    }
+}
+
+static void check_rejected(uint8 const *buffer, uint32 length)
+{
+    LibEmbd_Deserializer_t deser;
+    LibEmbd_TelemetryBatchView_t view;
+
+    libembd_make_deserializer(&deser, buffer, length);
+    libembd_get_telemetry_batch_checked(&deser, &view);
+    TEST_CHECK(libembd_deserializer_has_overflowed(&deser));
+    TEST_CHECK_EQUAL(0u, deser.position);
+    TEST_CHECK_EQUAL(0u, view.count);
+}
+
+static void test_malformed(void)
+{
+    uint8 buffer[MAX_BATCH_SIZE];
+    Sample_t samples[20];
+    uint32 length;
+    uint32 indices;
+    uint32 i;
+
+    // 4 distinct ids at 1 byte offsets: the indices start behind the header, offsets, dictionary size and dictionary
+    make_samples(samples, 20u, 1000u, 0x80u, 4u);
+    for(i = 0u; i < 4u; i++){
+        samples[i].id = 0xC0DE0000u + i * 7919u;
+    }
+    length = encode(buffer, sizeof(buffer), samples, 20u);
+    TEST_CHECK_EQUAL(4u, buffer[13u + 20u + 1u]);
+    indices = 13u + 20u + 2u + 4u * 4u;
+
+    // any index at or beyond the dictionary size
+    for(i = 0u; i < 20u; i++){
+        uint8 const saved = buffer[indices + i];
+        LibEmbd_Deserializer_t deser;
+        LibEmbd_TelemetryBatchView_t view;
+
+        buffer[indices + i] = 4u;
+        check_rejected(buffer, length);
+        buffer[indices + i] = 0xFFu;
+        check_rejected(buffer, length);
+        buffer[indices + i] = 3u; //the last valid one
+        libembd_make_deserializer(&deser, buffer, length);
+        libembd_get_telemetry_batch_checked(&deser, &view);
+        TEST_CHECK(!libembd_deserializer_has_overflowed(&deser));
+        TEST_CHECK_EQUAL(samples[3].id, libembd_dictionary_column_at(&view.ids, i));
+        buffer[indices + i] = saved;
+    }
+
+    // an offset width other than 1, 2, 4 or 8
+    for(i = 0u; i < 10u; i++){
+        if((i != 1u) && (i != 2u) && (i != 4u) && (i != 8u)){
+            buffer[12] = (uint8)i;
+            check_rejected(buffer, sizeof(buffer));
+        }
+    }
+    buffer[12] = 1u;
+
+    // a dictionary larger than single byte indices can address
+    buffer[13u + 20u] = 0x01u;
+    buffer[13u + 20u + 1u] = 0x01u;
+    check_rejected(buffer, sizeof(buffer));
+    buffer[13u + 20u] = 0u;
+    buffer[13u + 20u + 1u] = 4u;
+
+    // a count whose columns would wrap a 32 bit size computation
+    buffer[0] = 0xFFu;
+    buffer[1] = 0xFFu;
+    buffer[2] = 0xFFu;
+    buffer[3] = 0xFFu;
+    check_rejected(buffer, sizeof(buffer));
+}
+
+int main(void)
+{
+    (void)printf("%s\n", __FILE__);
+    TEST_RUN(test_round_trip);
+    TEST_RUN(test_empty_batch);
+    TEST_RUN(test_append_limits);
+    TEST_RUN(test_truncation);
+    TEST_RUN(test_malformed);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,298 @@
+#include "atomic_host.h" //first, stands in for libembd_atomic.h
+#include <threads.h>
+#include "test.h"
+#include "libembd/libembd_concurrent_serializer.h"
+
+#define PRODUCERS           4u
+#define RECORDS_PER_PRODUCER 2000u
+
+static uint32 g_batch[4096]; //4-byte aligned
+static LibEmbd_ConcurrentSerializer_t g_cser;
+
+static uint8 *batch_bytes(void)
+{
+    return (uint8 *)g_batch;
+}
+
+static void begin_and_commit(uint32 size, uint32 used, uint8 fill)
+{
+    LibEmbd_Serializer_t ser;
+    uint32 i;
+
+    TEST_CHECK(libembd_concurrent_serializer_begin_record(&g_cser, size, &ser));
+    TEST_CHECK_EQUAL(size, ser.capacity);
+    for(i = 0u; i < used; i++){
+        libembd_put_uint8_checked(&ser, (uint8)(fill + i));
+    }
+    libembd_concurrent_serializer_commit_record(&g_cser, &ser);
+}
+
+static void check_record(LibEmbd_Deserializer_t *record, uint32 used, uint8 fill)
+{
+    uint32 i;
+
+    TEST_CHECK_EQUAL(used, record->capacity);
+    for(i = 0u; i < used; i++){
+        TEST_CHECK_EQUAL((uint8)(fill + i), record->buffer[i]);
+    }
+}
+
+// Reserved sizes that are and are not multiples of the alignment, records using all, part or none of their slot
+static void test_round_trip(void)
+{
+    static uint32 const sizes[] = { 0u, 1u, 4u, 5u, 12u, 12u, 7u, 30u };
+    static uint32 const used[] = { 0u, 1u, 4u, 2u, 12u, 0u, 7u, 17u };
+    LibEmbd_Deserializer_t deser;
+    LibEmbd_Deserializer_t record;
+    uint32 position = 0u;
+    uint32 expected_length = 0u;
+    uint32 length;
+    uint32 i;
+
+    libembd_make_concurrent_serializer(&g_cser, batch_bytes(), 256u);
+    for(i = 0u; i < sizeof(sizes) / sizeof(sizes[0]); i++){
+        begin_and_commit(sizes[i], used[i], (uint8)(i * 16u));
+        expected_length += LIBEMBD_CONCURRENT_RECORD_SIZE(sizes[i]);
+    }
+    TEST_CHECK(libembd_concurrent_serializer_is_complete(&g_cser));
+
+    // the live batch, before sealing
+    for(i = 0u; i < sizeof(sizes) / sizeof(sizes[0]); i++){
+        TEST_CHECK(libembd_concurrent_serializer_get_record(&g_cser, &position, &record));
+        check_record(&record, used[i], (uint8)(i * 16u));
+    }
+    TEST_CHECK(!libembd_concurrent_serializer_get_record(&g_cser, &position, &record));
+
+    length = libembd_seal_concurrent_serializer(&g_cser);
+    TEST_CHECK_EQUAL(expected_length, length);
+    TEST_CHECK(libembd_concurrent_serializer_is_complete(&g_cser));
+
+    // the received batch
+    libembd_make_deserializer(&deser, batch_bytes(), length);
+    for(i = 0u; i < sizeof(sizes) / sizeof(sizes[0]); i++){
+        TEST_CHECK(libembd_get_concurrent_record_checked(&deser, &record));
+        check_record(&record, used[i], (uint8)(i * 16u));
+    }
+    TEST_CHECK(!libembd_get_concurrent_record_checked(&deser, &record));
+    TEST_CHECK(!libembd_deserializer_has_overflowed(&deser)); //a clean end
+    TEST_CHECK_EQUAL(length, deser.position);
+}
+
+static void test_overflowed_record_is_discarded(void)
+{
+    LibEmbd_Serializer_t ser;
+    LibEmbd_Deserializer_t deser;
+    LibEmbd_Deserializer_t record;
+    uint32 length;
+
+    libembd_make_concurrent_serializer(&g_cser, batch_bytes(), 128u);
+    begin_and_commit(4u, 4u, 0x10u);
+    TEST_CHECK(libembd_concurrent_serializer_begin_record(&g_cser, 6u, &ser));
+    libembd_put_uint64_to_network_checked(&ser, 1u); //does not fit the 6 reserved bytes
+    TEST_CHECK(libembd_serializer_has_overflowed(&ser));
+    libembd_concurrent_serializer_commit_record(&g_cser, &ser);
+    begin_and_commit(3u, 3u, 0x20u);
+
+    length = libembd_seal_concurrent_serializer(&g_cser);
+    libembd_make_deserializer(&deser, batch_bytes(), length);
+    TEST_CHECK(libembd_get_concurrent_record_checked(&deser, &record));
+    check_record(&record, 4u, 0x10u);
+    TEST_CHECK(libembd_get_concurrent_record_checked(&deser, &record));
+    check_record(&record, 3u, 0x20u);
+    TEST_CHECK(!libembd_get_concurrent_record_checked(&deser, &record));
+    TEST_CHECK(!libembd_deserializer_has_overflowed(&deser));
+}
+
+// A record whose slot is larger than the whole batch is refused without touching the shared position
+static void test_record_larger_than_batch(void)
+{
+    LibEmbd_Serializer_t ser;
+    uint32 size;
+
+    for(size = 61u; size <= 64u; size++){
+        libembd_make_concurrent_serializer(&g_cser, batch_bytes(), 64u);
+        TEST_CHECK(!libembd_concurrent_serializer_begin_record(&g_cser, size, &ser));
+        TEST_CHECK(!libembd_concurrent_serializer_begin_record(&g_cser, 0xFFFFFFFFu, &ser));
+        TEST_CHECK(libembd_concurrent_serializer_is_complete(&g_cser));
+        begin_and_commit(60u, 60u, 0u); //the batch is still empty: the largest record that fits goes in
+        TEST_CHECK_EQUAL(64u, libembd_seal_concurrent_serializer(&g_cser));
+    }
+}
+
+// Reservations past the end are refused, the tail of the batch becomes padding
+static void test_full_batch(void)
+{
+    LibEmbd_Serializer_t ser;
+    LibEmbd_Deserializer_t deser;
+    LibEmbd_Deserializer_t record;
+    uint32 records = 0u;
+    uint32 length;
+
+    libembd_make_concurrent_serializer(&g_cser, batch_bytes(), 64u + 3u); //rounded down to 64
+    begin_and_commit(20u, 20u, 0u); //24 bytes
+    begin_and_commit(20u, 20u, 0u); //48 bytes
+    TEST_CHECK(!libembd_concurrent_serializer_begin_record(&g_cser, 20u, &ser)); //would end at 72
+    TEST_CHECK(libembd_concurrent_serializer_is_complete(&g_cser));
+    TEST_CHECK(!libembd_concurrent_serializer_begin_record(&g_cser, 0u, &ser)); //the batch stays full
+    length = libembd_seal_concurrent_serializer(&g_cser);
+    TEST_CHECK_EQUAL(64u, length);
+
+    libembd_make_deserializer(&deser, batch_bytes(), length);
+    while(libembd_get_concurrent_record_checked(&deser, &record)){
+        check_record(&record, 20u, 0u);
+        records++;
+    }
+    TEST_CHECK_EQUAL(2u, records);
+    TEST_CHECK(!libembd_deserializer_has_overflowed(&deser));
+}
+
+static void test_seal_and_reset(void)
+{
+    LibEmbd_Serializer_t held;
+    LibEmbd_Serializer_t ser;
+    LibEmbd_Deserializer_t record;
+    uint32 position = 0u;
+    uint32 length;
+
+    libembd_make_concurrent_serializer(&g_cser, batch_bytes(), 256u);
+    begin_and_commit(8u, 8u, 0x30u);
+    TEST_CHECK(libembd_concurrent_serializer_begin_record(&g_cser, 8u, &held));
+    TEST_CHECK(!libembd_concurrent_serializer_is_complete(&g_cser));
+
+    // sealing stops new reservations, the one in flight still completes the batch
+    length = libembd_seal_concurrent_serializer(&g_cser);
+    TEST_CHECK_EQUAL(24u, length);
+    TEST_CHECK(!libembd_concurrent_serializer_begin_record(&g_cser, 1u, &ser));
+    TEST_CHECK(!libembd_concurrent_serializer_is_complete(&g_cser));
+    TEST_CHECK(libembd_concurrent_serializer_get_record(&g_cser, &position, &record));
+    TEST_CHECK(!libembd_concurrent_serializer_get_record(&g_cser, &position, &record)); //held back by the open slot
+    libembd_put_uint64_to_network_checked(&held, 0x0102030405060708ull);
+    libembd_concurrent_serializer_commit_record(&g_cser, &held);
+    TEST_CHECK(libembd_concurrent_serializer_is_complete(&g_cser));
+    TEST_CHECK(libembd_concurrent_serializer_get_record(&g_cser, &position, &record));
+    TEST_CHECK_BYTES("\x01\x02\x03\x04\x05\x06\x07\x08", record.buffer, 8u);
+    TEST_CHECK(!libembd_concurrent_serializer_get_record(&g_cser, &position, &record));
+
+    // a reset batch starts over, stale payload is never mistaken for a header
+    memset(batch_bytes() + 24u, 0xFF, 32u);
+    libembd_reset_concurrent_serializer(&g_cser);
+    position = 0u;
+    TEST_CHECK(!libembd_concurrent_serializer_get_record(&g_cser, &position, &record));
+    begin_and_commit(2u, 2u, 0x40u);
+    TEST_CHECK(libembd_concurrent_serializer_get_record(&g_cser, &position, &record));
+    check_record(&record, 2u, 0x40u);
+    TEST_CHECK_EQUAL(8u, libembd_seal_concurrent_serializer(&g_cser));
+}
+
+static void test_malformed_batch(void)
+{
+    uint8 buffer[16] = { 0x80u, 0x00u, 0x00u, 0x02u, 0xAAu, 0xBBu, 0x00u, 0x00u,
+                         0x80u, 0x00u, 0x00u, 0x04u, 0x01u, 0x02u, 0x03u, 0x04u };
+    LibEmbd_Deserializer_t deser;
+    LibEmbd_Deserializer_t record;
+
+    // a record running past the end
+    libembd_make_deserializer(&deser, buffer, 15u);
+    TEST_CHECK(libembd_get_concurrent_record_checked(&deser, &record));
+    TEST_CHECK_BYTES("\xAA\xBB", record.buffer, 2u);
+    TEST_CHECK(!libembd_get_concurrent_record_checked(&deser, &record));
+    TEST_CHECK(libembd_deserializer_has_overflowed(&deser));
+    TEST_CHECK_EQUAL(8u, deser.position);
+
+    // a header cut short
+    libembd_make_deserializer(&deser, buffer, 10u);
+    TEST_CHECK(libembd_get_concurrent_record_checked(&deser, &record));
+    TEST_CHECK(!libembd_get_concurrent_record_checked(&deser, &record));
+    TEST_CHECK(libembd_deserializer_has_overflowed(&deser));
+
+    // an uncommitted slot
+    buffer[8] = 0x00u;
+    libembd_make_deserializer(&deser, buffer, sizeof(buffer));
+    TEST_CHECK(libembd_get_concurrent_record_checked(&deser, &record));
+    TEST_CHECK(!libembd_get_concurrent_record_checked(&deser, &record));
+    TEST_CHECK(libembd_deserializer_has_overflowed(&deser));
+    TEST_CHECK_EQUAL(8u, deser.position);
+}
+
+static int producer(void *argument)
+{
+    uint32 const id = (uint32)(uintptr_t)argument;
+    uint32 i;
+
+    for(i = 0u; i < RECORDS_PER_PRODUCER; i++){
+        LibEmbd_Serializer_t ser;
+        while(!libembd_concurrent_serializer_begin_record(&g_cser, 12u, &ser)){
+            thrd_yield(); //the consumer drains the batch
+        }
+        libembd_put_uint32_to_network_checked(&ser, id);
+        libembd_put_uint32_to_network_checked(&ser, i);
+        if((i % 3u) != 0u){
+            libembd_put_uint32_to_network_checked(&ser, id ^ i);
+        }
+        libembd_concurrent_serializer_commit_record(&g_cser, &ser);
+    }
+    return 0;
+}
+
+// Producers race for a batch much smaller than their output, the consumer drains it batch by batch
+static void test_concurrent_producers(void)
+{
+    thrd_t threads[PRODUCERS];
+    uint32 next[PRODUCERS] = { 0u };
+    uint32 total = 0u;
+    uint32 i;
+
+    libembd_make_concurrent_serializer(&g_cser, batch_bytes(), 1024u);
+    for(i = 0u; i < PRODUCERS; i++){
+        TEST_CHECK_EQUAL(thrd_success, thrd_create(&threads[i], producer, (void *)(uintptr_t)i));
+    }
+
+    while(total < PRODUCERS * RECORDS_PER_PRODUCER){
+        LibEmbd_Deserializer_t deser;
+        LibEmbd_Deserializer_t record;
+        uint32 const length = libembd_seal_concurrent_serializer(&g_cser);
+
+        while(!libembd_concurrent_serializer_is_complete(&g_cser)){
+            thrd_yield();
+        }
+        libembd_make_deserializer(&deser, batch_bytes(), length);
+        while(libembd_get_concurrent_record_checked(&deser, &record)){
+            uint32 id;
+            uint32 sequence;
+            uint32 check;
+
+            libembd_get_uint32_from_network_checked(&record, &id);
+            libembd_get_uint32_from_network_checked(&record, &sequence);
+            TEST_CHECK(id < PRODUCERS);
+            TEST_CHECK_EQUAL(next[id], sequence); //each producer's records arrive once and in order
+            if((sequence % 3u) != 0u){
+                libembd_get_uint32_from_network_checked(&record, &check);
+                TEST_CHECK_EQUAL(id ^ sequence, check);
+            }
+            TEST_CHECK(!libembd_deserializer_has_overflowed(&record));
+            TEST_CHECK_EQUAL(record.capacity, record.position);
+            next[id]++;
+            total++;
+        }
+        TEST_CHECK(!libembd_deserializer_has_overflowed(&deser));
+        libembd_reset_concurrent_serializer(&g_cser);
+    }
+
+    for(i = 0u; i < PRODUCERS; i++){
+        TEST_CHECK_EQUAL(thrd_success, thrd_join(threads[i], NULL));
+        TEST_CHECK_EQUAL(RECORDS_PER_PRODUCER, next[i]);
+    }
+}
+
+int main(void)
+{
+    (void)printf("%s\n", __FILE__);
+    TEST_RUN(test_round_trip);
+    TEST_RUN(test_overflowed_record_is_discarded);
+    TEST_RUN(test_record_larger_than_batch);
+    TEST_RUN(test_full_batch);
+    TEST_RUN(test_seal_and_reset);
+    TEST_RUN(test_malformed_batch);
+    TEST_RUN(test_concurrent_producers);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,176 @@
+#include "test.h"
+#include "libembd/libembd_delta.h"
+
+#define MAX_FRAME_LENGTH    72u
+
+static LibEmbd_ConstBufferView_t const_view(uint8 const *data, uint32 length)
+{
+    LibEmbd_ConstBufferView_t view;
+    view.data = data;
+    view.length = (uint16)length;
+    return view;
+}
+
+static LibEmbd_MutableBufferView_t mutable_view(uint8 *data, uint32 length)
+{
+    LibEmbd_MutableBufferView_t view;
+    view.data = data;
+    view.length = (uint16)length;
+    return view;
+}
+
+// Changes a random subset of bytes, from none to all of them
+static void mutate(uint8 *frame, uint32 length)
+{
+    uint32 const changes = test_random() % (length + 1u);
+    uint32 i;
+    for(i = 0u; i < changes; i++){
+        frame[test_random() % length] ^= (uint8)(1u + (test_random() % 255u));
+    }
+}
+
+static uint32 expected_delta_size(uint8 const *previous, uint8 const *current, uint32 length, uint32 *changed_words)
+{
+    uint32 size = LIBEMBD_DELTA_BITMAP_SIZE(length);
+    uint32 offset;
+
+    *changed_words = 0u;
+    for(offset = 0u; offset < length; offset += LIBEMBD_DELTA_WORD_SIZE){
+        uint32 const word_size = LIBEMBD_MIN(LIBEMBD_DELTA_WORD_SIZE, length - offset);
+        if(memcmp(&previous[offset], &current[offset], word_size) != 0){
+            size += word_size;
+            (*changed_words)++;
+        }
+    }
+    return size;
+}
+
+// Frame lengths with every partial last word and bitmap sizes across the 8 resp. 4 word vector width
+static void test_round_trip(void)
+{
+    uint32 length;
+
+    for(length = 1u; length <= MAX_FRAME_LENGTH; length++){
+        uint32 round;
+        for(round = 0u; round < 50u; round++){
+            uint8 previous[MAX_FRAME_LENGTH];
+            uint8 current[MAX_FRAME_LENGTH];
+            uint8 receiver[MAX_FRAME_LENGTH];
+            uint8 delta[LIBEMBD_DELTA_MAX_SIZE(MAX_FRAME_LENGTH) + 1u];
+            uint32 changed_words;
+            uint32 i;
+            LibEmbd_Serializer_t ser;
+            LibEmbd_Deserializer_t deser;
+            uint32 delta_size;
+
+            for(i = 0u; i < length; i++){
+                previous[i] = (uint8)test_random();
+            }
+            memcpy(current, previous, length);
+            mutate(current, length);
+            memcpy(receiver, previous, length);
+            delta_size = expected_delta_size(previous, current, length, &changed_words);
+
+            //exact capacity
+            libembd_make_serializer(&ser, delta, delta_size);
+            TEST_CHECK_EQUAL(changed_words, libembd_put_delta_checked(&ser, const_view(previous, length), const_view(current, length)));
+            TEST_CHECK(!libembd_serializer_has_overflowed(&ser));
+            TEST_CHECK_EQUAL(delta_size, ser.position);
+
+            libembd_make_deserializer(&deser, delta, delta_size);
+            libembd_get_delta_checked(&deser, mutable_view(receiver, length));
+            TEST_CHECK(!libembd_deserializer_has_overflowed(&deser));
+            TEST_CHECK_EQUAL(delta_size, deser.position);
+            TEST_CHECK_BYTES(current, receiver, length);
+
+            //one byte short: nothing is written or applied
+            memcpy(receiver, previous, length);
+            libembd_make_deserializer(&deser, delta, delta_size - 1u);
+            libembd_get_delta_checked(&deser, mutable_view(receiver, length));
+            TEST_CHECK(libembd_deserializer_has_overflowed(&deser));
+            TEST_CHECK_EQUAL(0u, deser.position);
+            TEST_CHECK_BYTES(previous, receiver, length);
+
+            libembd_make_serializer(&ser, delta, delta_size - 1u);
+            TEST_CHECK_EQUAL(0u, libembd_put_delta_checked(&ser, const_view(previous, length), const_view(current, length)));
+            TEST_CHECK(libembd_serializer_has_overflowed(&ser));
+            TEST_CHECK_EQUAL(0u, ser.position);
+
+            //unsafe variants with worst case capacity
+            libembd_make_serializer(&ser, delta, LIBEMBD_DELTA_MAX_SIZE(length));
+            TEST_CHECK_EQUAL(changed_words, libembd_put_delta_unsafe(&ser, const_view(previous, length), const_view(current, length)));
+            TEST_CHECK_EQUAL(delta_size, ser.position);
+            libembd_make_deserializer(&deser, delta, ser.position);
+            libembd_get_delta_unsafe(&deser, mutable_view(receiver, length));
+            TEST_CHECK_EQUAL(delta_size, deser.position);
+            TEST_CHECK_BYTES(current, receiver, length);
+        }
+    }
+}
+
+static void test_unchanged_and_all_changed(void)
+{
+    uint8 previous[33];
+    uint8 current[33];
+    uint8 delta[LIBEMBD_DELTA_MAX_SIZE(33u)];
+    LibEmbd_Serializer_t ser;
+
+    memset(previous, 0x55, sizeof(previous));
+    memcpy(current, previous, sizeof(current));
+    libembd_make_serializer(&ser, delta, sizeof(delta));
+    TEST_CHECK_EQUAL(0u, libembd_put_delta_checked(&ser, const_view(previous, sizeof(previous)), const_view(current, sizeof(current))));
+    TEST_CHECK_EQUAL(LIBEMBD_DELTA_BITMAP_SIZE(33u), ser.position);
+    TEST_CHECK_EQUAL(0u, delta[0]);
+    TEST_CHECK_EQUAL(0u, delta[1]);
+
+    memset(current, 0xAA, sizeof(current));
+    libembd_make_serializer(&ser, delta, sizeof(delta));
+    TEST_CHECK_EQUAL(9u, libembd_put_delta_checked(&ser, const_view(previous, sizeof(previous)), const_view(current, sizeof(current))));
+    TEST_CHECK_EQUAL(LIBEMBD_DELTA_MAX_SIZE(33u), ser.position);
+    TEST_CHECK_EQUAL(0xFFu, delta[0]);
+    TEST_CHECK_EQUAL(0x01u, delta[1]);
+}
+
+// Bits for words beyond the frame are malformed, they must not make the decoder write past the frame
+static void test_malformed_bitmap(void)
+{
+    uint8 frame[12] = { 0u };
+    uint8 const delta[] = { 0x08u, 1u, 2u, 3u, 4u, 5u, 6u, 7u, 8u }; //word 3 of a 3 word frame
+    LibEmbd_Deserializer_t deser;
+    uint32 i;
+
+    libembd_make_deserializer(&deser, delta, sizeof(delta));
+    libembd_get_delta_checked(&deser, mutable_view(frame, 10u));
+    TEST_CHECK(libembd_deserializer_has_overflowed(&deser));
+    TEST_CHECK_EQUAL(0u, deser.position);
+    for(i = 0u; i < sizeof(frame); i++){
+        TEST_CHECK_EQUAL(0u, frame[i]);
+    }
+
+    //random garbage is either rejected or applied within the frame
+    for(i = 0u; i < 5000u; i++){
+        uint8 garbage[16];
+        uint8 guarded[MAX_FRAME_LENGTH + 4u];
+        uint32 const length = 1u + (test_random() % MAX_FRAME_LENGTH);
+        uint32 j;
+
+        for(j = 0u; j < sizeof(garbage); j++){
+            garbage[j] = (uint8)test_random();
+        }
+        memset(guarded, 0xEE, sizeof(guarded));
+        libembd_make_deserializer(&deser, garbage, test_random() % (sizeof(garbage) + 1u));
+        libembd_get_delta_checked(&deser, mutable_view(guarded, length));
+        for(j = length; j < sizeof(guarded); j++){
+            TEST_CHECK_EQUAL(0xEEu, guarded[j]);
+        }
+    }
+}
+
+int main(void)
+{
+    (void)printf("%s\n", __FILE__);
+    TEST_RUN(test_round_trip);
+    TEST_RUN(test_unchanged_and_all_changed);
+    TEST_RUN(test_malformed_bitmap);
+    return EXIT_SUCCESS;
+}
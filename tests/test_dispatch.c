@@ -0,0 +1,310 @@
+#include "test.h"
+#include "libembd/libembd_dispatch.h"
+
+#define ID_COUNT        0x10000u
+#define MAX_PAYLOAD     0x20000u //longer than any uint16 size, to reach lengths of 2^16 and beyond
+
+static LibEmbd_Dispatcher_t g_dispatcher;
+static LibEmbd_DispatchEntry_t g_entries[LIBEMBD_DISPATCH_TABLE_SIZE + 1u];
+static uint8 g_used[ID_COUNT];
+static uint8 g_payload[MAX_PAYLOAD];
+static int g_context;
+
+typedef struct {
+    uint32 calls;
+    uint32 handler; //1 or 2, which handler ran last
+    void *context;
+    LibEmbd_Deserializer_t const *payload;
+    uint32 length;
+} Calls_t;
+
+static Calls_t g_calls;
+
+static void record(uint32 handler, void *context, LibEmbd_Deserializer_t *payload)
+{
+    g_calls.calls++;
+    g_calls.handler = handler;
+    g_calls.context = context;
+    g_calls.payload = payload;
+    g_calls.length = payload->capacity - payload->position;
+}
+
+static void handler_one(void *context, LibEmbd_Deserializer_t *payload)
+{
+    record(1u, context, payload);
+}
+
+static void handler_two(void *context, LibEmbd_Deserializer_t *payload)
+{
+    record(2u, context, payload);
+}
+
+static LibEmbd_Std_ReturnType dispatch(uint16 id, uint32 length)
+{
+    LibEmbd_Deserializer_t payload;
+    libembd_make_deserializer(&payload, g_payload, length);
+    return libembd_dispatch_message(&g_dispatcher, id, &payload);
+}
+
+static void set_entry(uint32 index, uint16 id)
+{
+    uint32 const kind = test_random() % 5u;
+    g_entries[index].id = id;
+    g_entries[index].size = (kind == 0u) ? LIBEMBD_DISPATCH_ANY_SIZE : (uint16)(test_random() % 64u);
+    g_entries[index].handler = ((kind & 1u) != 0u) ? handler_one : handler_two;
+    g_used[id] = 1u;
+}
+
+static uint16 unused_id(void)
+{
+    uint16 id;
+    do {
+        id = (uint16)test_random();
+    } while(g_used[id] != 0u);
+    return id;
+}
+
+// count entries with distinct random ids, random sizes and every fifth entry accepting any size
+static void make_entries(uint32 count)
+{
+    uint32 i;
+    (void)memset(g_used, 0, sizeof(g_used));
+    for(i = 0u; i < count; i++){
+        set_entry(i, unused_id());
+    }
+}
+
+static uint32 occupied_slots(void)
+{
+    uint32 occupied = 0u;
+    uint32 i;
+    for(i = 0u; i < LIBEMBD_DISPATCH_TABLE_SIZE; i++){
+        if(g_dispatcher.slots[i].key != LIBEMBD_DISPATCH_EMPTY_KEY_INTERNAL){
+            occupied++;
+        }
+    }
+    return occupied;
+}
+
+static void check_accepted(LibEmbd_DispatchEntry_t const *entry, uint32 length)
+{
+    uint32 const calls = g_calls.calls;
+    TEST_CHECK_EQUAL(E_OK, dispatch(entry->id, length));
+    TEST_CHECK_EQUAL(calls + 1u, g_calls.calls);
+    TEST_CHECK_EQUAL((entry->handler == handler_one) ? 1u : 2u, g_calls.handler);
+    TEST_CHECK(g_calls.context == &g_context);
+    TEST_CHECK_EQUAL(length, g_calls.length);
+}
+
+static void check_rejected(uint16 id, uint32 length)
+{
+    uint32 const calls = g_calls.calls;
+    TEST_CHECK_EQUAL(E_NOT_OK, dispatch(id, length));
+    TEST_CHECK_EQUAL(calls, g_calls.calls);
+}
+
+// Every entry reaches its handler with its size and only with it, every other id is rejected
+static void check_table(uint32 count)
+{
+    uint32 id;
+    uint32 i;
+
+    TEST_CHECK_EQUAL(count, occupied_slots()); //failed placement attempts left nothing behind
+    for(i = 0u; i < count; i++){
+        LibEmbd_DispatchEntry_t const *entry = &g_entries[i];
+        if(entry->size == LIBEMBD_DISPATCH_ANY_SIZE){
+            check_accepted(entry, 0u);
+            check_accepted(entry, test_random() % MAX_PAYLOAD);
+        } else {
+            check_accepted(entry, entry->size);
+            check_rejected(entry->id, entry->size + 1u);
+            check_rejected(entry->id, entry->size + 0x10000u); //length bits above the uint16 size
+            if(entry->size > 0u){
+                check_rejected(entry->id, entry->size - 1u);
+            }
+        }
+    }
+    for(id = 0u; id < ID_COUNT; id++){
+        if(g_used[id] == 0u){
+            check_rejected((uint16)id, 0u);
+            check_rejected((uint16)id, test_random() % 64u);
+        }
+    }
+}
+
+static void test_empty_table(void)
+{
+    make_entries(0u);
+    TEST_CHECK_EQUAL(E_OK, libembd_make_dispatcher(&g_dispatcher, NULL, 0u, &g_context));
+    check_table(0u);
+}
+
+static void test_random_tables(void)
+{
+    static uint32 const counts[] = { 1u, 2u, 3u, 17u, 100u, 256u, 400u, 511u };
+    uint32 i;
+
+    for(i = 0u; i < sizeof(counts) / sizeof(counts[0]); i++){
+        make_entries(counts[i]);
+        TEST_CHECK_EQUAL(E_OK, libembd_make_dispatcher(&g_dispatcher, g_entries, counts[i], &g_context));
+        check_table(counts[i]);
+    }
+}
+
+static void test_full_table(void)
+{
+    uint32 i;
+
+    make_entries(LIBEMBD_DISPATCH_TABLE_SIZE);
+    TEST_CHECK_EQUAL(E_OK, libembd_make_dispatcher(&g_dispatcher, g_entries, LIBEMBD_DISPATCH_TABLE_SIZE, &g_context));
+    check_table(LIBEMBD_DISPATCH_TABLE_SIZE);
+
+    //consecutive ids, the usual layout of a message catalogue
+    (void)memset(g_used, 0, sizeof(g_used));
+    for(i = 0u; i < LIBEMBD_DISPATCH_TABLE_SIZE; i++){
+        set_entry(i, (uint16)(0x0100u + i));
+    }
+    TEST_CHECK_EQUAL(E_OK, libembd_make_dispatcher(&g_dispatcher, g_entries, LIBEMBD_DISPATCH_TABLE_SIZE, &g_context));
+    check_table(LIBEMBD_DISPATCH_TABLE_SIZE);
+
+    //one entry too many, nothing is dispatched afterwards
+    set_entry(LIBEMBD_DISPATCH_TABLE_SIZE, unused_id());
+    TEST_CHECK_EQUAL(E_NOT_OK, libembd_make_dispatcher(&g_dispatcher, g_entries, LIBEMBD_DISPATCH_TABLE_SIZE + 1u, &g_context));
+    TEST_CHECK_EQUAL(0u, occupied_slots());
+    for(i = 0u; i <= LIBEMBD_DISPATCH_TABLE_SIZE; i++){
+        check_rejected(g_entries[i].id, g_entries[i].size);
+    }
+}
+
+// Buckets of 12, 8 and 5 ids in a full table: the large buckets only fit while most slots are free, and every failed
+// attempt to place them has to be undone or the table runs out of slots.
+static void test_crowded_buckets(void)
+{
+    static uint32 const bucket_sizes[] = { 12u, 8u, 5u, 5u, 3u };
+    uint32 count = 0u;
+    uint32 found;
+    uint32 id;
+    uint32 i;
+
+    (void)memset(g_used, 0, sizeof(g_used));
+    for(i = 0u; i < sizeof(bucket_sizes) / sizeof(bucket_sizes[0]); i++){
+        found = 0u;
+        for(id = 0u; (id < ID_COUNT) && (found < bucket_sizes[i]); id++){
+            if(libembd_dispatch_bucket_internal((uint16)id) == 7u * i){
+                set_entry(count++, (uint16)id);
+                found++;
+            }
+        }
+        TEST_CHECK_EQUAL(bucket_sizes[i], found);
+    }
+    //the crowded buckets last in the table, so that table order and placement order differ
+    for(i = 0u; i < count; i++){
+        g_entries[LIBEMBD_DISPATCH_TABLE_SIZE - count + i] = g_entries[i];
+    }
+    for(i = 0u; i < LIBEMBD_DISPATCH_TABLE_SIZE - count; i++){
+        set_entry(i, unused_id());
+    }
+    TEST_CHECK_EQUAL(E_OK, libembd_make_dispatcher(&g_dispatcher, g_entries, LIBEMBD_DISPATCH_TABLE_SIZE, &g_context));
+    check_table(LIBEMBD_DISPATCH_TABLE_SIZE);
+}
+
+static void test_duplicate_ids(void)
+{
+    //same id twice, with equal and with different sizes
+    make_entries(2u);
+    g_entries[1] = g_entries[0];
+    TEST_CHECK_EQUAL(E_NOT_OK, libembd_make_dispatcher(&g_dispatcher, g_entries, 2u, &g_context));
+    g_entries[1].size = (uint16)(g_entries[0].size + 1u);
+    TEST_CHECK_EQUAL(E_NOT_OK, libembd_make_dispatcher(&g_dispatcher, g_entries, 2u, &g_context));
+
+    //a duplicate far apart in a large table, at the front and at the back
+    make_entries(300u);
+    g_entries[299].id = g_entries[0].id;
+    TEST_CHECK_EQUAL(E_NOT_OK, libembd_make_dispatcher(&g_dispatcher, g_entries, 300u, &g_context));
+    make_entries(LIBEMBD_DISPATCH_TABLE_SIZE);
+    g_entries[0].id = g_entries[LIBEMBD_DISPATCH_TABLE_SIZE - 1u].id;
+    TEST_CHECK_EQUAL(E_NOT_OK, libembd_make_dispatcher(&g_dispatcher, g_entries, LIBEMBD_DISPATCH_TABLE_SIZE, &g_context));
+}
+
+static void test_any_size(void)
+{
+    static uint32 const lengths[] = { 0u, 1u, 2u, 0xFFFEu, 0xFFFFu, 0x10000u, MAX_PAYLOAD };
+    LibEmbd_DispatchEntry_t entries[3];
+    uint32 i;
+
+    entries[0].id = 0x0001u;
+    entries[0].size = LIBEMBD_DISPATCH_ANY_SIZE;
+    entries[0].handler = handler_one;
+    entries[1].id = 0x0002u;
+    entries[1].size = 0u;
+    entries[1].handler = handler_two;
+    entries[2].id = 0xFFFFu;
+    entries[2].size = 0xFFFEu; //the largest exact size
+    entries[2].handler = handler_one;
+    TEST_CHECK_EQUAL(E_OK, libembd_make_dispatcher(&g_dispatcher, entries, 3u, &g_context));
+
+    for(i = 0u; i < sizeof(lengths) / sizeof(lengths[0]); i++){
+        check_accepted(&entries[0], lengths[i]);
+        if(lengths[i] != 0u){
+            check_rejected(entries[1].id, lengths[i]);
+        }
+        if(lengths[i] != 0xFFFEu){
+            check_rejected(entries[2].id, lengths[i]);
+        }
+    }
+    check_accepted(&entries[1], 0u);
+    check_accepted(&entries[2], 0xFFFEu);
+    check_rejected(0x0003u, 0u); //the masked compare only relaxes the length, not the id
+    check_rejected(0x0101u, 0u);
+}
+
+static void test_dispatch_frame(void)
+{
+    static uint8 const frame[] = { 0x12u, 0x34u, 0xAAu, 0xBBu, 0xCCu };
+    static uint8 const unknown[] = { 0x12u, 0x35u, 0xAAu, 0xBBu, 0xCCu };
+    LibEmbd_DispatchEntry_t entry;
+    LibEmbd_Deserializer_t deser;
+    uint32 const calls = g_calls.calls;
+
+    entry.id = 0x1234u;
+    entry.size = 3u;
+    entry.handler = handler_two;
+    TEST_CHECK_EQUAL(E_OK, libembd_make_dispatcher(&g_dispatcher, &entry, 1u, &g_context));
+
+    libembd_make_deserializer(&deser, frame, sizeof(frame));
+    TEST_CHECK_EQUAL(E_OK, libembd_dispatch_frame(&g_dispatcher, &deser));
+    TEST_CHECK_EQUAL(calls + 1u, g_calls.calls);
+    TEST_CHECK_EQUAL(2u, g_calls.handler);
+    TEST_CHECK(g_calls.context == &g_context);
+    TEST_CHECK_EQUAL(3u, g_calls.length);
+    TEST_CHECK(g_calls.payload->buffer == &frame[2]);
+    TEST_CHECK_EQUAL(sizeof(frame), deser.position);
+    TEST_CHECK(!libembd_deserializer_has_overflowed(&deser));
+
+    //wrong payload length and unknown id, the frame is consumed all the same
+    libembd_make_deserializer(&deser, frame, sizeof(frame) - 1u);
+    TEST_CHECK_EQUAL(E_NOT_OK, libembd_dispatch_frame(&g_dispatcher, &deser));
+    TEST_CHECK_EQUAL(sizeof(frame) - 1u, deser.position);
+    libembd_make_deserializer(&deser, unknown, sizeof(unknown));
+    TEST_CHECK_EQUAL(E_NOT_OK, libembd_dispatch_frame(&g_dispatcher, &deser));
+    TEST_CHECK(!libembd_deserializer_has_overflowed(&deser));
+
+    //too short for an id
+    libembd_make_deserializer(&deser, frame, 1u);
+    TEST_CHECK_EQUAL(E_NOT_OK, libembd_dispatch_frame(&g_dispatcher, &deser));
+    TEST_CHECK(libembd_deserializer_has_overflowed(&deser));
+    TEST_CHECK_EQUAL(calls + 1u, g_calls.calls);
+}
+
+int main(void)
+{
+    (void)printf("%s\n", __FILE__);
+    TEST_RUN(test_empty_table);
+    TEST_RUN(test_random_tables);
+    TEST_RUN(test_full_table);
+    TEST_RUN(test_crowded_buckets);
+    TEST_RUN(test_duplicate_ids);
+    TEST_RUN(test_any_size);
+    TEST_RUN(test_dispatch_frame);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,298 @@
+#include "test.h"
+#include "libembd/libembd_framing.h"
+
+#define MAX_FRAME_LENGTH    600u
+
+typedef LibEmbd_Std_ReturnType (*encode_function)(LibEmbd_ConstBufferView_t, LibEmbd_MutableBufferView_t, uint16 *);
+typedef LibEmbd_Std_ReturnType (*decode_function)(LibEmbd_ConstBufferView_t, LibEmbd_MutableBufferView_t, uint16 *);
+
+static encode_function const encoders[LIBEMBD_FRAMING_LAST_DO_NOT_USE] = { libembd_cobs_encode, libembd_slip_encode };
+static decode_function const decoders[LIBEMBD_FRAMING_LAST_DO_NOT_USE] = { libembd_cobs_decode, libembd_slip_decode };
+
+// Payload rich in the bytes the encoders have to deal with
+static void fill_payload(uint8 *data, uint32 length)
+{
+    static uint8 const special[] = { 0x00u, LIBEMBD_SLIP_END, LIBEMBD_SLIP_ESC, LIBEMBD_SLIP_ESC_END, LIBEMBD_SLIP_ESC_ESC };
+    uint32 i;
+    for(i = 0u; i < length; i++){
+        uint8 const r = (uint8)test_random();
+        data[i] = (r < 64u) ? special[r % sizeof(special)] : (uint8)test_random();
+    }
+}
+
+static LibEmbd_ConstBufferView_t const_view(uint8 const *data, uint32 length)
+{
+    LibEmbd_ConstBufferView_t view;
+    view.data = data;
+    view.length = (uint16)length;
+    return view;
+}
+
+static LibEmbd_MutableBufferView_t mutable_view(uint8 *data, uint32 length)
+{
+    LibEmbd_MutableBufferView_t view;
+    view.data = data;
+    view.length = (uint16)length;
+    return view;
+}
+
+static void check_encoding(LibEmbd_Framing_Type_t type, uint8 const *data, uint32 length, uint8 const *expected, uint32 expected_length)
+{
+    uint8 encoded[16];
+    uint8 decoded[16];
+    uint16 encoded_length;
+    uint16 decoded_length;
+
+    TEST_CHECK_EQUAL(E_OK, encoders[type](const_view(data, length), mutable_view(encoded, sizeof(encoded)), &encoded_length));
+    TEST_CHECK_EQUAL(expected_length, encoded_length);
+    TEST_CHECK_BYTES(expected, encoded, expected_length);
+    TEST_CHECK_EQUAL(E_OK, decoders[type](const_view(encoded, encoded_length), mutable_view(decoded, sizeof(decoded)), &decoded_length));
+    TEST_CHECK_EQUAL(length, decoded_length);
+    TEST_CHECK_BYTES(data, decoded, length);
+}
+
+static void test_known_encodings(void)
+{
+    static uint8 const zero[] = { 0x00u };
+    static uint8 const zero_cobs[] = { 0x01u, 0x01u, 0x00u };
+    static uint8 const zeros[] = { 0x00u, 0x00u };
+    static uint8 const zeros_cobs[] = { 0x01u, 0x01u, 0x01u, 0x00u };
+    static uint8 const mixed[] = { 0x11u, 0x22u, 0x00u, 0x33u };
+    static uint8 const mixed_cobs[] = { 0x03u, 0x11u, 0x22u, 0x02u, 0x33u, 0x00u };
+    static uint8 const trailing[] = { 0x11u, 0x00u, 0x00u, 0x00u };
+    static uint8 const trailing_cobs[] = { 0x02u, 0x11u, 0x01u, 0x01u, 0x01u, 0x00u };
+    static uint8 const empty_cobs[] = { 0x01u, 0x00u };
+    static uint8 const special[] = { LIBEMBD_SLIP_END, LIBEMBD_SLIP_ESC, 0x01u };
+    static uint8 const special_slip[] = { LIBEMBD_SLIP_ESC, LIBEMBD_SLIP_ESC_END, LIBEMBD_SLIP_ESC, LIBEMBD_SLIP_ESC_ESC, 0x01u, LIBEMBD_SLIP_END };
+    static uint8 const empty_slip[] = { LIBEMBD_SLIP_END };
+
+    check_encoding(LIBEMBD_FRAMING_COBS, zero, sizeof(zero), zero_cobs, sizeof(zero_cobs));
+    check_encoding(LIBEMBD_FRAMING_COBS, zeros, sizeof(zeros), zeros_cobs, sizeof(zeros_cobs));
+    check_encoding(LIBEMBD_FRAMING_COBS, mixed, sizeof(mixed), mixed_cobs, sizeof(mixed_cobs));
+    check_encoding(LIBEMBD_FRAMING_COBS, trailing, sizeof(trailing), trailing_cobs, sizeof(trailing_cobs));
+    check_encoding(LIBEMBD_FRAMING_COBS, zero, 0u, empty_cobs, sizeof(empty_cobs));
+    check_encoding(LIBEMBD_FRAMING_SLIP, special, sizeof(special), special_slip, sizeof(special_slip));
+    check_encoding(LIBEMBD_FRAMING_SLIP, special, 0u, empty_slip, sizeof(empty_slip));
+}
+
+// Runs of 253, 254 and 255 non-zero bytes around the maximum COBS block length
+static void test_cobs_long_runs(void)
+{
+    uint8 data[MAX_FRAME_LENGTH];
+    uint8 encoded[LIBEMBD_COBS_MAX_ENCODED_LENGTH(MAX_FRAME_LENGTH)];
+    uint8 decoded[MAX_FRAME_LENGTH];
+    uint16 encoded_length;
+    uint16 decoded_length;
+    uint32 length;
+    uint32 i;
+
+    for(i = 0u; i < sizeof(data); i++){
+        data[i] = (uint8)((i % 255u) + 1u);
+    }
+    for(length = 250u; length <= 512u; length++){
+        TEST_CHECK_EQUAL(E_OK, libembd_cobs_encode(const_view(data, length), mutable_view(encoded, sizeof(encoded)), &encoded_length));
+        TEST_CHECK(encoded_length <= LIBEMBD_COBS_MAX_ENCODED_LENGTH(length));
+        TEST_CHECK(memchr(encoded, 0, encoded_length - 1u) == NULL);
+        TEST_CHECK_EQUAL(0u, encoded[encoded_length - 1u]);
+        TEST_CHECK_EQUAL(E_OK, libembd_cobs_decode(const_view(encoded, encoded_length), mutable_view(decoded, sizeof(decoded)), &decoded_length));
+        TEST_CHECK_EQUAL(length, decoded_length);
+        TEST_CHECK_BYTES(data, decoded, length);
+    }
+    TEST_CHECK_EQUAL(E_OK, libembd_cobs_encode(const_view(data, 254u), mutable_view(encoded, sizeof(encoded)), &encoded_length));
+    TEST_CHECK_EQUAL(0xFFu, encoded[0]);
+}
+
+static void test_round_trip(void)
+{
+    LibEmbd_Framing_Type_t type;
+
+    for(type = 0u; type < LIBEMBD_FRAMING_LAST_DO_NOT_USE; type++){
+        uint32 length;
+        for(length = 0u; length <= MAX_FRAME_LENGTH; length += 1u + (length / 16u)){
+            uint8 data[MAX_FRAME_LENGTH];
+            uint8 encoded[LIBEMBD_SLIP_MAX_ENCODED_LENGTH(MAX_FRAME_LENGTH)];
+            uint8 decoded[MAX_FRAME_LENGTH];
+            uint16 encoded_length;
+            uint16 decoded_length;
+            uint32 const max_encoded_length = (type == LIBEMBD_FRAMING_COBS) ? LIBEMBD_COBS_MAX_ENCODED_LENGTH(length) :
+                                                                                LIBEMBD_SLIP_MAX_ENCODED_LENGTH(length);
+
+            fill_payload(data, length);
+            TEST_CHECK_EQUAL(E_OK, encoders[type](const_view(data, length), mutable_view(encoded, sizeof(encoded)), &encoded_length));
+            TEST_CHECK(encoded_length <= max_encoded_length);
+
+            //exact capacity suffices, one byte less does not
+            TEST_CHECK_EQUAL(E_OK, decoders[type](const_view(encoded, encoded_length), mutable_view(decoded, length), &decoded_length));
+            TEST_CHECK_EQUAL(length, decoded_length);
+            TEST_CHECK_BYTES(data, decoded, length);
+            if(length > 0u){
+                TEST_CHECK_EQUAL(E_NOT_OK, decoders[type](const_view(encoded, encoded_length), mutable_view(decoded, length - 1u), &decoded_length));
+            }
+            TEST_CHECK_EQUAL(E_OK, encoders[type](const_view(data, length), mutable_view(encoded, encoded_length), &encoded_length));
+            TEST_CHECK_EQUAL(E_NOT_OK, encoders[type](const_view(data, length), mutable_view(encoded, encoded_length - 1u), &encoded_length));
+
+            //without the delimiter
+            TEST_CHECK_EQUAL(E_OK, encoders[type](const_view(data, length), mutable_view(encoded, sizeof(encoded)), &encoded_length));
+            TEST_CHECK_EQUAL(E_OK, decoders[type](const_view(encoded, encoded_length - 1u), mutable_view(decoded, sizeof(decoded)), &decoded_length));
+            TEST_CHECK_EQUAL(length, decoded_length);
+            TEST_CHECK_BYTES(data, decoded, length);
+
+            //in place
+            TEST_CHECK_EQUAL(E_OK, decoders[type](const_view(encoded, encoded_length), mutable_view(encoded, sizeof(encoded)), &decoded_length));
+            TEST_CHECK_EQUAL(length, decoded_length);
+            TEST_CHECK_BYTES(data, encoded, length);
+        }
+    }
+}
+
+static void test_malformed(void)
+{
+    static uint8 const cobs_code_past_end[] = { 0x05u, 0x11u, 0x22u, 0x00u };
+    static uint8 const cobs_zero_inside[] = { 0x03u, 0x11u, 0x00u, 0x01u, 0x00u };
+    static uint8 const cobs_zero_code[] = { 0x00u, 0x11u, 0x00u };
+    static uint8 const slip_bad_escape[] = { 0x01u, LIBEMBD_SLIP_ESC, 0x02u, LIBEMBD_SLIP_END };
+    static uint8 const slip_escape_at_end[] = { 0x01u, LIBEMBD_SLIP_ESC, LIBEMBD_SLIP_END };
+    static uint8 const slip_end_inside[] = { 0x01u, LIBEMBD_SLIP_END, 0x02u, LIBEMBD_SLIP_END };
+    uint8 decoded[16];
+    uint16 decoded_length;
+
+    TEST_CHECK_EQUAL(E_NOT_OK, libembd_cobs_decode(const_view(cobs_code_past_end, sizeof(cobs_code_past_end)), mutable_view(decoded, sizeof(decoded)), &decoded_length));
+    TEST_CHECK_EQUAL(E_NOT_OK, libembd_cobs_decode(const_view(cobs_code_past_end, 3u), mutable_view(decoded, sizeof(decoded)), &decoded_length));
+    TEST_CHECK_EQUAL(E_NOT_OK, libembd_cobs_decode(const_view(cobs_zero_inside, sizeof(cobs_zero_inside)), mutable_view(decoded, sizeof(decoded)), &decoded_length));
+    TEST_CHECK_EQUAL(E_NOT_OK, libembd_cobs_decode(const_view(cobs_zero_code, sizeof(cobs_zero_code)), mutable_view(decoded, sizeof(decoded)), &decoded_length));
+    TEST_CHECK_EQUAL(E_NOT_OK, libembd_slip_decode(const_view(slip_bad_escape, sizeof(slip_bad_escape)), mutable_view(decoded, sizeof(decoded)), &decoded_length));
+    TEST_CHECK_EQUAL(E_NOT_OK, libembd_slip_decode(const_view(slip_escape_at_end, sizeof(slip_escape_at_end)), mutable_view(decoded, sizeof(decoded)), &decoded_length));
+    TEST_CHECK_EQUAL(E_NOT_OK, libembd_slip_decode(const_view(slip_escape_at_end, 2u), mutable_view(decoded, sizeof(decoded)), &decoded_length));
+    TEST_CHECK_EQUAL(E_NOT_OK, libembd_slip_decode(const_view(slip_end_inside, sizeof(slip_end_inside)), mutable_view(decoded, sizeof(decoded)), &decoded_length));
+}
+
+// Garbage must never make a decoder write past its output or read past its input
+static void test_garbage(void)
+{
+    uint32 round;
+
+    for(round = 0u; round < 2000u; round++){
+        uint8 garbage[64];
+        uint8 decoded[sizeof(garbage)];
+        uint16 decoded_length;
+        uint32 const length = (uint8)test_random() % (sizeof(garbage) + 1u);
+        LibEmbd_Framing_Type_t type;
+
+        fill_payload(garbage, length);
+        for(type = 0u; type < LIBEMBD_FRAMING_LAST_DO_NOT_USE; type++){
+            uint32 const capacity = (uint8)test_random() % (sizeof(decoded) + 1u);
+            if(decoders[type](const_view(garbage, length), mutable_view(decoded, capacity), &decoded_length) == E_OK){
+                TEST_CHECK(decoded_length <= capacity);
+            }
+        }
+    }
+}
+
+// Several frames encoded back to back, fed in chunks of every size from 1 byte up
+static void test_incremental(void)
+{
+    static uint32 const frame_lengths[] = { 1u, 0u, 17u, 300u, 254u, 255u, 2u, 64u };
+    LibEmbd_Framing_Type_t type;
+
+    for(type = 0u; type < LIBEMBD_FRAMING_LAST_DO_NOT_USE; type++){
+        static uint8 frames[sizeof(frame_lengths) / sizeof(frame_lengths[0])][MAX_FRAME_LENGTH];
+        static uint8 stream[8u * LIBEMBD_SLIP_MAX_ENCODED_LENGTH(MAX_FRAME_LENGTH)];
+        uint32 stream_length = 0u;
+        uint32 chunk_size;
+        uint32 i;
+
+        for(i = 0u; i < sizeof(frame_lengths) / sizeof(frame_lengths[0]); i++){
+            uint16 encoded_length;
+            fill_payload(frames[i], frame_lengths[i]);
+            TEST_CHECK_EQUAL(E_OK, encoders[type](const_view(frames[i], frame_lengths[i]),
+                                                  mutable_view(&stream[stream_length], sizeof(stream) - stream_length), &encoded_length));
+            stream_length += encoded_length;
+        }
+
+        for(chunk_size = 1u; chunk_size <= 700u; chunk_size += (chunk_size < 40u) ? 1u : 37u){
+            uint8 buffer[MAX_FRAME_LENGTH];
+            LibEmbd_FrameDecoder_t dec;
+            uint32 received = 0u;
+            uint32 offset;
+
+            libembd_make_frame_decoder(&dec, type, buffer, sizeof(buffer));
+            for(offset = 0u; offset < stream_length; offset += chunk_size){
+                LibEmbd_ConstBufferView_t chunk = const_view(&stream[offset], LIBEMBD_MIN(chunk_size, stream_length - offset));
+                while(chunk.length > 0u){
+                    LibEmbd_FrameDecoder_Status_t const status = libembd_frame_decoder_feed(&dec, &chunk);
+                    TEST_CHECK(status != LIBEMBD_FRAME_DECODER_ERROR);
+                    if(status == LIBEMBD_FRAME_DECODER_FRAME_READY){
+                        LibEmbd_ConstBufferView_t const frame = libembd_frame_decoder_frame(&dec);
+                        if((frame_lengths[received] == 0u) && (frame.length != 0u)){
+                            received++; //SLIP skips empty frames, COBS encodes them as a code byte
+                        }
+                        TEST_CHECK_EQUAL(frame_lengths[received], frame.length);
+                        TEST_CHECK_BYTES(frames[received], frame.data, frame.length);
+                        received++;
+                    }
+                }
+            }
+            TEST_CHECK_EQUAL(sizeof(frame_lengths) / sizeof(frame_lengths[0]), received);
+        }
+    }
+}
+
+// An oversized or malformed frame is dropped and decoding resumes with the next frame
+static void test_incremental_errors(void)
+{
+    LibEmbd_Framing_Type_t type;
+
+    for(type = 0u; type < LIBEMBD_FRAMING_LAST_DO_NOT_USE; type++){
+        static uint8 const small[] = { 0x01u, 0x00u, LIBEMBD_SLIP_END, 0x02u };
+        uint8 large[40];
+        uint8 stream[128];
+        uint8 buffer[32];
+        uint16 encoded_length;
+        uint32 stream_length = 0u;
+        LibEmbd_FrameDecoder_t dec;
+        LibEmbd_ConstBufferView_t input;
+        LibEmbd_ConstBufferView_t frame;
+
+        fill_payload(large, sizeof(large));
+        TEST_CHECK_EQUAL(E_OK, encoders[type](const_view(large, sizeof(large)), mutable_view(stream, sizeof(stream)), &encoded_length));
+        stream_length += encoded_length;
+        //malformed: COBS code running past the delimiter, SLIP escape of a plain byte
+        stream[stream_length++] = (type == LIBEMBD_FRAMING_COBS) ? 0x05u : LIBEMBD_SLIP_ESC;
+        stream[stream_length++] = 0x11u;
+        stream[stream_length++] = (type == LIBEMBD_FRAMING_COBS) ? 0x00u : LIBEMBD_SLIP_END;
+        TEST_CHECK_EQUAL(E_OK, encoders[type](const_view(small, sizeof(small)), mutable_view(&stream[stream_length], sizeof(stream) - stream_length), &encoded_length));
+        stream_length += encoded_length;
+
+        libembd_make_frame_decoder(&dec, type, buffer, sizeof(buffer));
+        input = const_view(stream, stream_length);
+        TEST_CHECK_EQUAL(LIBEMBD_FRAME_DECODER_ERROR, libembd_frame_decoder_feed(&dec, &input));
+        TEST_CHECK_EQUAL(LIBEMBD_FRAME_DECODER_ERROR, libembd_frame_decoder_feed(&dec, &input));
+        TEST_CHECK_EQUAL(LIBEMBD_FRAME_DECODER_FRAME_READY, libembd_frame_decoder_feed(&dec, &input));
+        frame = libembd_frame_decoder_frame(&dec);
+        TEST_CHECK_EQUAL(sizeof(small), frame.length);
+        TEST_CHECK_BYTES(small, frame.data, sizeof(small));
+        TEST_CHECK_EQUAL(LIBEMBD_FRAME_DECODER_NEED_MORE, libembd_frame_decoder_feed(&dec, &input));
+        TEST_CHECK_EQUAL(0u, input.length);
+
+        //reset drops a partial frame
+        input = const_view(stream, 5u);
+        TEST_CHECK_EQUAL(LIBEMBD_FRAME_DECODER_NEED_MORE, libembd_frame_decoder_feed(&dec, &input));
+        libembd_frame_decoder_reset(&dec);
+        input = const_view(&stream[stream_length - encoded_length], encoded_length);
+        TEST_CHECK_EQUAL(LIBEMBD_FRAME_DECODER_FRAME_READY, libembd_frame_decoder_feed(&dec, &input));
+        TEST_CHECK_EQUAL(sizeof(small), libembd_frame_decoder_frame(&dec).length);
+    }
+}
+
+int main(void)
+{
+    (void)printf("%s\n", __FILE__);
+    TEST_RUN(test_known_encodings);
+    TEST_RUN(test_cobs_long_runs);
+    TEST_RUN(test_round_trip);
+    TEST_RUN(test_malformed);
+    TEST_RUN(test_garbage);
+    TEST_RUN(test_incremental);
+    TEST_RUN(test_incremental_errors);
+    return EXIT_SUCCESS;
+}
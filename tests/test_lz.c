@@ -0,0 +1,346 @@
+#include "test.h"
+#include "libembd/libembd_lz.h"
+
+#define MAX_BLOCK_LENGTH    65000u //worst case compressed size still fits the 16-bit views
+
+static LibEmbd_ConstBufferView_t const_view(uint8 const *data, uint32 length)
+{
+    LibEmbd_ConstBufferView_t view;
+    view.data = data;
+    view.length = (uint16)length;
+    return view;
+}
+
+static LibEmbd_MutableBufferView_t mutable_view(uint8 *data, uint32 length)
+{
+    LibEmbd_MutableBufferView_t view;
+    view.data = data;
+    view.length = (uint16)length;
+    return view;
+}
+
+typedef uint8 Pattern_t;
+#define PATTERN_ZEROS       ((Pattern_t)0u)
+#define PATTERN_RANDOM      ((Pattern_t)1u)
+#define PATTERN_TEXT        ((Pattern_t)2u)
+#define PATTERN_TELEMETRY   ((Pattern_t)3u)
+#define PATTERN_LAST        ((Pattern_t)4u)
+
+static void fill(uint8 *data, uint32 length, Pattern_t pattern)
+{
+    static char const words[][8] = { "sensor ", "value ", "status ", "ok ", "fault ", "12.5 ", "\n" };
+    uint32 i = 0u;
+
+    while(i < length){
+        switch(pattern){
+            case PATTERN_ZEROS:
+                data[i++] = 0u;
+                break;
+            case PATTERN_RANDOM:
+                data[i++] = (uint8)test_random();
+                break;
+            case PATTERN_TEXT: {
+                char const *word = words[test_random() % (sizeof(words) / sizeof(words[0]))];
+                for(; (*word != '\0') && (i < length); word++){
+                    data[i++] = (uint8)*word;
+                }
+                break;
+            }
+            default:
+                data[i] = (uint8)(((i % 16u) < 12u) ? (i % 16u) : test_random()); //fixed fields and changing ones
+                i++;
+                break;
+        }
+    }
+}
+
+/**
+ * Straightforward LZ4 block decoder following the format description, including its end of block rules: the last
+ * sequence consists of literals only, the last 5 bytes are literals and the last match starts at least 12 bytes
+ * before the end. Returns the decoded length or -1.
+ */
+static sint32 reference_decompress(uint8 const *src, uint32 src_length, uint8 *dst, uint32 capacity)
+{
+    uint32 in = 0u;
+    uint32 out = 0u;
+
+    for(;;){
+        uint8 token;
+        uint32 literals;
+        uint32 match;
+        uint32 offset;
+
+        if(in >= src_length){
+            return -1;
+        }
+        token = src[in++];
+        literals = (uint32)token >> 4u;
+        if(literals == 15u){
+            uint8 extra;
+            do {
+                if(in >= src_length){
+                    return -1;
+                }
+                extra = src[in++];
+                literals += extra;
+            } while(extra == 255u);
+        }
+        if((literals > src_length - in) || (literals > capacity - out)){
+            return -1;
+        }
+        memcpy(&dst[out], &src[in], literals);
+        in += literals;
+        out += literals;
+        if(in == src_length){
+            return ((token & 0x0Fu) == 0u) ? (sint32)out : -1;
+        }
+
+        if(src_length - in < 2u){
+            return -1;
+        }
+        offset = (uint32)src[in] | ((uint32)src[in + 1u] << 8u);
+        in += 2u;
+        if((offset == 0u) || (offset > out)){
+            return -1;
+        }
+        match = (token & 0x0Fu) + 4u;
+        if((token & 0x0Fu) == 15u){
+            uint8 extra;
+            do {
+                if(in >= src_length){
+                    return -1;
+                }
+                extra = src[in++];
+                match += extra;
+            } while(extra == 255u);
+        }
+        if((match > capacity - out) || (out + 12u > capacity)){
+            return -1;
+        }
+        for(; match > 0u; match--, out++){
+            dst[out] = dst[out - offset];
+        }
+        if(out + 5u > capacity){
+            return -1;
+        }
+    }
+}
+
+static void test_known_block(void)
+{
+    //"ab", match of 6 at offset 2 (overlapping copy), literals "cdefg"
+    static uint8 const block[] = { 0x22u, 'a', 'b', 0x02u, 0x00u, 0x50u, 'c', 'd', 'e', 'f', 'g' };
+    static uint8 const expected[] = { 'a', 'b', 'a', 'b', 'a', 'b', 'a', 'b', 'c', 'd', 'e', 'f', 'g' };
+    uint8 decoded[32];
+    uint16 decoded_length;
+
+    TEST_CHECK_EQUAL(E_OK, libembd_lz_decompress(const_view(block, sizeof(block)), mutable_view(decoded, sizeof(decoded)), &decoded_length));
+    TEST_CHECK_EQUAL(sizeof(expected), decoded_length);
+    TEST_CHECK_BYTES(expected, decoded, sizeof(expected));
+    TEST_CHECK_EQUAL(E_OK, libembd_lz_decompress(const_view(block, sizeof(block)), mutable_view(decoded, sizeof(expected)), &decoded_length));
+    TEST_CHECK_EQUAL(E_NOT_OK, libembd_lz_decompress(const_view(block, sizeof(block)), mutable_view(decoded, sizeof(expected) - 1u), &decoded_length));
+}
+
+// Compressed blocks decode with both decoders and meet the LZ4 end of block rules
+static void test_round_trip(void)
+{
+    static uint8 data[MAX_BLOCK_LENGTH];
+    static uint8 compressed[LIBEMBD_LZ_MAX_COMPRESSED_SIZE(MAX_BLOCK_LENGTH)];
+    static uint8 decoded[MAX_BLOCK_LENGTH];
+    static LibEmbd_LzWorkspace_t work;
+    Pattern_t pattern;
+
+    for(pattern = 0u; pattern < PATTERN_LAST; pattern++){
+        uint32 length = 0u;
+        for(;;){
+            uint16 compressed_length;
+            uint16 decoded_length;
+
+            fill(data, length, pattern);
+            TEST_CHECK_EQUAL(E_OK, libembd_lz_compress(&work, const_view(data, length), mutable_view(compressed, sizeof(compressed)), &compressed_length));
+            TEST_CHECK(compressed_length <= LIBEMBD_LZ_MAX_COMPRESSED_SIZE(length));
+            if(pattern == PATTERN_ZEROS && length >= 1000u){
+                TEST_CHECK(compressed_length < 16u + length / 200u); //LZ4 tops out at about 255:1
+            }
+
+            TEST_CHECK_EQUAL(E_OK, libembd_lz_decompress(const_view(compressed, compressed_length), mutable_view(decoded, length), &decoded_length));
+            TEST_CHECK_EQUAL(length, decoded_length);
+            TEST_CHECK_BYTES(data, decoded, length);
+            if(length > 0u){
+                TEST_CHECK_EQUAL(E_NOT_OK, libembd_lz_decompress(const_view(compressed, compressed_length), mutable_view(decoded, length - 1u), &decoded_length));
+            }
+            memset(decoded, 0, length);
+            TEST_CHECK_EQUAL((sint32)length, reference_decompress(compressed, compressed_length, decoded, length));
+            TEST_CHECK_BYTES(data, decoded, length);
+
+            //exact output capacity suffices, one byte less does not
+            TEST_CHECK_EQUAL(E_OK, libembd_lz_compress(&work, const_view(data, length), mutable_view(compressed, compressed_length), &compressed_length));
+            TEST_CHECK_EQUAL(E_NOT_OK, libembd_lz_compress(&work, const_view(data, length), mutable_view(compressed, compressed_length - 1u), &compressed_length));
+
+            if(length == MAX_BLOCK_LENGTH){
+                break;
+            }
+            length = (length < 40u) ? (length + 1u) : LIBEMBD_MIN(length * 3u + 7u, MAX_BLOCK_LENGTH);
+        }
+    }
+}
+
+// Garbage and corrupted blocks are rejected or decoded within bounds, never read or written out of bounds
+static void test_garbage(void)
+{
+    static uint8 data[4096];
+    static uint8 compressed[LIBEMBD_LZ_MAX_COMPRESSED_SIZE(sizeof(data))];
+    static LibEmbd_LzWorkspace_t work;
+    uint16 compressed_length;
+    uint32 round;
+
+    fill(data, sizeof(data), PATTERN_TEXT);
+    TEST_CHECK_EQUAL(E_OK, libembd_lz_compress(&work, const_view(data, sizeof(data)), mutable_view(compressed, sizeof(compressed)), &compressed_length));
+
+    for(round = 0u; round < 20000u; round++){
+        uint32 const src_length = 1u + (test_random() % 64u);
+        uint32 const capacity = test_random() % 256u;
+        uint8 *src = (uint8 *)malloc(src_length); //exact size so that ASan catches overreads
+        uint8 *dst = (uint8 *)malloc(capacity + 1u);
+        uint16 decoded_length;
+        uint32 i;
+
+        TEST_CHECK((src != NULL) && (dst != NULL));
+        if((round % 2u) == 0u){
+            for(i = 0u; i < src_length; i++){
+                src[i] = (uint8)test_random();
+            }
+        } else {
+            //a valid prefix with one corrupted byte
+            memcpy(src, compressed, src_length);
+            src[test_random() % src_length] ^= (uint8)(1u + test_random() % 255u);
+        }
+        if(libembd_lz_decompress(const_view(src, src_length), mutable_view(dst, capacity), &decoded_length) == E_OK){
+            TEST_CHECK(decoded_length <= capacity);
+        }
+        free(src);
+        free(dst);
+    }
+
+    //every truncation of a valid block
+    for(round = 0u; round < compressed_length; round++){
+        uint8 *src = (uint8 *)malloc(round + 1u);
+        uint16 decoded_length;
+        TEST_CHECK(src != NULL);
+        memcpy(src, compressed, round);
+        if(libembd_lz_decompress(const_view(src, round), mutable_view(data, sizeof(data)), &decoded_length) == E_OK){
+            TEST_CHECK(decoded_length < sizeof(data));
+        }
+        free(src);
+    }
+}
+
+static void test_block_framing(void)
+{
+    static uint8 data[3000];
+    static uint8 frame[LIBEMBD_LZ_BLOCK_HEADER_SIZE + LIBEMBD_LZ_MAX_COMPRESSED_SIZE(sizeof(data))];
+    static uint8 decoded[sizeof(data)];
+    static LibEmbd_LzWorkspace_t work;
+    Pattern_t pattern;
+
+    for(pattern = 0u; pattern < PATTERN_LAST; pattern++){
+        LibEmbd_Serializer_t ser;
+        LibEmbd_Deserializer_t deser;
+        uint32 frame_length;
+        uint16 length;
+
+        fill(data, sizeof(data), pattern);
+        libembd_make_serializer(&ser, frame, sizeof(frame));
+        libembd_put_lz_block_checked(&ser, &work, const_view(data, sizeof(data)));
+        TEST_CHECK(!libembd_serializer_has_overflowed(&ser));
+        frame_length = ser.position;
+        TEST_CHECK(frame_length <= LIBEMBD_LZ_BLOCK_HEADER_SIZE + sizeof(data)); //incompressible blocks are stored
+
+        libembd_make_serializer(&ser, frame, frame_length - 1u);
+        libembd_put_lz_block_checked(&ser, &work, const_view(data, sizeof(data)));
+        TEST_CHECK(libembd_serializer_has_overflowed(&ser));
+        TEST_CHECK_EQUAL(0u, ser.position);
+
+        libembd_make_serializer(&ser, frame, frame_length);
+        libembd_put_lz_block_checked(&ser, &work, const_view(data, sizeof(data)));
+        TEST_CHECK(!libembd_serializer_has_overflowed(&ser));
+
+        libembd_make_deserializer(&deser, frame, frame_length);
+        libembd_get_lz_block_checked(&deser, mutable_view(decoded, sizeof(decoded)), &length);
+        TEST_CHECK(!libembd_deserializer_has_overflowed(&deser));
+        TEST_CHECK_EQUAL(sizeof(data), length);
+        TEST_CHECK_EQUAL(frame_length, deser.position);
+        TEST_CHECK_BYTES(data, decoded, sizeof(data));
+
+        libembd_make_deserializer(&deser, frame, frame_length - 1u);
+        libembd_get_lz_block_checked(&deser, mutable_view(decoded, sizeof(decoded)), &length);
+        TEST_CHECK(libembd_deserializer_has_overflowed(&deser));
+        TEST_CHECK_EQUAL(0u, length);
+        TEST_CHECK_EQUAL(0u, deser.position);
+
+        libembd_make_deserializer(&deser, frame, frame_length);
+        libembd_get_lz_block_checked(&deser, mutable_view(decoded, sizeof(decoded) - 1u), &length);
+        TEST_CHECK(libembd_deserializer_has_overflowed(&deser));
+        TEST_CHECK_EQUAL(0u, length);
+    }
+}
+
+static void test_stream(void)
+{
+    static uint8 data[3u * LIBEMBD_LZ_BLOCK_SIZE + 123u];
+    static uint8 stream[sizeof(data) + 64u];
+    static uint8 decoded[sizeof(data)];
+    static LibEmbd_LzWorkspace_t work;
+    uint32 length;
+
+    for(length = 0u; length <= sizeof(data); length += LIBEMBD_LZ_BLOCK_SIZE / 2u - 1u){
+        LibEmbd_Serializer_t ser;
+        LibEmbd_Deserializer_t deser;
+        uint32 stream_length;
+        uint32 decoded_length;
+
+        fill(data, length, PATTERN_TELEMETRY);
+        libembd_make_serializer(&ser, stream, sizeof(stream));
+        libembd_put_lz_stream_checked(&ser, &work, data, length);
+        TEST_CHECK(!libembd_serializer_has_overflowed(&ser));
+        stream_length = ser.position;
+
+        libembd_make_serializer(&ser, stream, stream_length - 1u);
+        libembd_put_lz_stream_checked(&ser, &work, data, length);
+        TEST_CHECK(libembd_serializer_has_overflowed(&ser));
+        TEST_CHECK_EQUAL(0u, ser.position);
+
+        libembd_make_serializer(&ser, stream, stream_length);
+        libembd_put_lz_stream_checked(&ser, &work, data, length);
+        libembd_make_deserializer(&deser, stream, stream_length);
+        libembd_get_lz_stream_checked(&deser, decoded, sizeof(decoded), &decoded_length);
+        TEST_CHECK(!libembd_deserializer_has_overflowed(&deser));
+        TEST_CHECK_EQUAL(length, decoded_length);
+        TEST_CHECK_EQUAL(stream_length, deser.position);
+        TEST_CHECK_BYTES(data, decoded, length);
+
+        libembd_make_deserializer(&deser, stream, stream_length - 1u);
+        libembd_get_lz_stream_checked(&deser, decoded, sizeof(decoded), &decoded_length);
+        TEST_CHECK(libembd_deserializer_has_overflowed(&deser));
+        TEST_CHECK_EQUAL(0u, decoded_length);
+        TEST_CHECK_EQUAL(0u, deser.position);
+
+        if(length > 0u){
+            libembd_make_deserializer(&deser, stream, stream_length);
+            libembd_get_lz_stream_checked(&deser, decoded, length - 1u, &decoded_length);
+            TEST_CHECK(libembd_deserializer_has_overflowed(&deser));
+            TEST_CHECK_EQUAL(0u, decoded_length);
+        }
+    }
+}
+
+int main(void)
+{
+    (void)printf("%s\n", __FILE__);
+    TEST_RUN(test_known_block);
+    TEST_RUN(test_round_trip);
+    TEST_RUN(test_garbage);
+    TEST_RUN(test_block_framing);
+    TEST_RUN(test_stream);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,109 @@
+#include "libembd/libembd_mapped_file.h" //first, it enables the POSIX declarations strict -std=c11 hides
+#include "test.h"
+
+#ifndef TEST_TMP_DIR
+#define TEST_TMP_DIR    "build"
+#endif
+#define TEST_FILE       TEST_TMP_DIR "/test_mapped_file.bin"
+
+static void write_records(LibEmbd_Serializer_t *ser, uint32 count)
+{
+    uint32 i;
+    for(i = 0u; i < count; i++){
+        uint32 const start = libembd_begin_record_checked(ser);
+        uint32 j;
+        for(j = 0u; j < i; j++){
+            libembd_put_uint8_checked(ser, (uint8)(i + j));
+        }
+        libembd_end_record_checked(ser, start);
+    }
+}
+
+static void check_records(LibEmbd_Deserializer_t *deser, uint32 count)
+{
+    LibEmbd_Deserializer_t record;
+    uint32 i = 0u;
+
+    while(libembd_get_record_checked(deser, &record)){
+        uint32 j;
+        TEST_CHECK_EQUAL(i, record.capacity);
+        for(j = 0u; j < i; j++){
+            uint8 value;
+            libembd_get_uint8_checked(&record, &value);
+            TEST_CHECK_EQUAL((uint8)(i + j), value);
+        }
+        i++;
+    }
+    TEST_CHECK_EQUAL(count, i);
+}
+
+static void test_records(void)
+{
+    uint8 buffer[256];
+    LibEmbd_Serializer_t ser;
+    LibEmbd_Deserializer_t deser;
+    LibEmbd_Deserializer_t record;
+    uint32 length;
+
+    libembd_make_serializer(&ser, buffer, sizeof(buffer));
+    write_records(&ser, 10u);
+    TEST_CHECK(!libembd_serializer_has_overflowed(&ser));
+    length = ser.position;
+    TEST_CHECK_EQUAL(10u * LIBEMBD_RECORD_HEADER_SIZE + 45u, length);
+
+    libembd_make_deserializer(&deser, buffer, length);
+    check_records(&deser, 10u);
+    TEST_CHECK(!libembd_deserializer_has_overflowed(&deser));
+
+    //truncated last record
+    libembd_make_deserializer(&deser, buffer, length - 1u);
+    check_records(&deser, 9u);
+    TEST_CHECK(libembd_deserializer_has_overflowed(&deser));
+    TEST_CHECK_EQUAL(length - LIBEMBD_RECORD_HEADER_SIZE - 9u, deser.position);
+    TEST_CHECK(!libembd_get_record_checked(&deser, &record));
+
+    //record not fitting the serializer
+    libembd_make_serializer(&ser, buffer, length - 1u);
+    write_records(&ser, 10u);
+    TEST_CHECK(libembd_serializer_has_overflowed(&ser));
+}
+
+static void test_mapped_round_trip(void)
+{
+    LibEmbd_MappedFile_t file;
+    LibEmbd_Serializer_t ser;
+    LibEmbd_Deserializer_t deser;
+    uint32 length;
+
+    TEST_CHECK_EQUAL(E_OK, libembd_map_file_for_writing(&file, TEST_FILE, 1u << 20u, LIBEMBD_MAPPED_FILE_SEQUENTIAL, &ser));
+    write_records(&ser, 200u);
+    TEST_CHECK(!libembd_serializer_has_overflowed(&ser));
+    length = ser.position;
+    TEST_CHECK_EQUAL(E_OK, libembd_unmap_file(&file, length));
+
+    TEST_CHECK_EQUAL(E_OK, libembd_map_file_for_reading(&file, TEST_FILE, LIBEMBD_MAPPED_FILE_SEQUENTIAL | LIBEMBD_MAPPED_FILE_WILLNEED |
+                                                        LIBEMBD_MAPPED_FILE_POPULATE | LIBEMBD_MAPPED_FILE_HUGEPAGES, &deser));
+    TEST_CHECK_EQUAL(length, deser.capacity);
+    check_records(&deser, 200u);
+    TEST_CHECK(!libembd_deserializer_has_overflowed(&deser));
+    TEST_CHECK_EQUAL(E_OK, libembd_unmap_file(&file, 0u));
+
+    //empty file
+    TEST_CHECK_EQUAL(E_OK, libembd_map_file_for_writing(&file, TEST_FILE, 16u, LIBEMBD_MAPPED_FILE_DEFAULT, &ser));
+    TEST_CHECK_EQUAL(E_OK, libembd_unmap_file(&file, 0u));
+    TEST_CHECK_EQUAL(E_OK, libembd_map_file_for_reading(&file, TEST_FILE, LIBEMBD_MAPPED_FILE_DEFAULT, &deser));
+    TEST_CHECK_EQUAL(0u, deser.capacity);
+    check_records(&deser, 0u);
+    TEST_CHECK_EQUAL(E_OK, libembd_unmap_file(&file, 0u));
+
+    TEST_CHECK_EQUAL(0, remove(TEST_FILE));
+    TEST_CHECK_EQUAL(E_NOT_OK, libembd_map_file_for_reading(&file, TEST_FILE, LIBEMBD_MAPPED_FILE_DEFAULT, &deser));
+}
+
+int main(void)
+{
+    (void)printf("%s\n", __FILE__);
+    TEST_RUN(test_records);
+    TEST_RUN(test_mapped_round_trip);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,237 @@
+#include "libembd/libembd_marshalling_cpp.h"
+#include "test.h"
+
+// Built as C++17 with -Wall -Wextra -Werror, so that the C headers it includes stay warning free under C++ as well
+
+enum class Mode : uint16 { idle = 1, active = 0x1234 };
+enum Level : sint8 { low = -100, high = 100 };
+
+struct Inner {
+    sint16 x;
+    bool flag;
+    LIBEMBD_WIRE_FIELDS(x, flag)
+};
+
+struct Reading {
+    uint16 sensor_id;
+    uint64 timestamp;
+    std::array<float32, 3> xyz;
+    Mode mode;
+    Inner inner;
+    uint8 raw[2];
+    LIBEMBD_WIRE_FIELDS(sensor_id, timestamp, xyz, mode, inner, raw)
+};
+
+struct Outer {
+    Reading readings[2];
+    std::pair<Level, Inner> tagged;
+    LIBEMBD_WIRE_FIELDS(readings, tagged)
+};
+
+static_assert(libembd::wire_size_v<uint8> == 1u, "");
+static_assert(libembd::wire_size_v<bool, float64, sint16> == 1u + 8u + 2u, "");
+static_assert(libembd::wire_size_v<Mode, Level> == 2u + 1u, "");
+static_assert(libembd::wire_size_v<uint32[5], std::array<uint16, 3>> == 20u + 6u, "");
+static_assert(libembd::wire_size_v<std::tuple<uint32, float64>, std::pair<char, sint64>> == 4u + 8u + 1u + 8u, "");
+static_assert(libembd::wire_size_v<Inner> == 3u, "");
+static_assert(libembd::wire_size_v<Reading> == 2u + 8u + 12u + 2u + 3u + 2u, "");
+static_assert(libembd::wire_size_v<Outer> == 2u * 29u + 1u + 3u, "");
+static_assert(libembd::wire_size_v<Reading const &, uint8 volatile> == 30u, ""); //cv-ref qualifiers do not matter
+
+// Serializes the values with the given byte order, checks the bytes and reads them back into fresh objects
+template <libembd::ByteOrder Order, typename... Ts>
+static void check_round_trip(char const *expected, Ts const &... values)
+{
+    uint8 buffer[128];
+    LibEmbd_Serializer_t ser;
+    LibEmbd_Deserializer_t deser;
+    std::tuple<Ts...> loaded{};
+
+    libembd_make_serializer(&ser, buffer, sizeof(buffer));
+    libembd::Serializer<Order> out(ser);
+    TEST_CHECK(out.put(values...));
+    TEST_CHECK_EQUAL(libembd::wire_size_v<Ts...>, out.position());
+    TEST_CHECK_BYTES(expected, buffer, libembd::wire_size_v<Ts...>);
+
+    libembd_make_deserializer(&deser, buffer, out.position());
+    libembd::Deserializer<Order> in(deser);
+    TEST_CHECK(std::apply([&in](auto &... fields) { return in.get(fields...); }, loaded));
+    TEST_CHECK_EQUAL(out.position(), in.position());
+    TEST_CHECK(loaded == std::tie(values...));
+}
+
+static void test_arithmetic(void)
+{
+    check_round_trip<libembd::ByteOrder::network>("\xAB\x01\x02\x03\x04\xFF\xFE\x01\x02\x03\x04\x05\x06\x07\x08",
+                                                  (uint8)0xABu, (uint32)0x01020304u, (sint16)-2, (uint64)0x0102030405060708ull);
+    check_round_trip<libembd::ByteOrder::host>("\x04\x03\x02\x01\xFE\xFF", (uint32)0x01020304u, (sint16)-2);
+    check_round_trip<libembd::ByteOrder::network>("\x3F\xC0\x00\x00\xC0\x04\x00\x00\x00\x00\x00\x00", 1.5f, -2.5);
+    check_round_trip<libembd::ByteOrder::host>("\x00\x00\xC0\x3F", 1.5f);
+    check_round_trip<libembd::ByteOrder::network>("\x80\x00\x00\x00\x00\x00\x00\x00\x7F",
+                                                  (sint64)INT64_MIN, (sint8)127);
+}
+
+static void test_enum_and_bool(void)
+{
+    uint8 buffer[4] = { 0x00u, 0x02u, 0x00u, 0x00u };
+    LibEmbd_Deserializer_t deser;
+    bool flag = false;
+
+    check_round_trip<libembd::ByteOrder::network>("\x12\x34\x9C\x64", Mode::active, low, high);
+    check_round_trip<libembd::ByteOrder::host>("\x01\x00", Mode::idle);
+    check_round_trip<libembd::ByteOrder::network>("\x01\x00", true, false);
+
+    // any non-zero byte reads as true
+    libembd_make_deserializer(&deser, buffer, sizeof(buffer));
+    libembd::Deserializer<> in(deser);
+    TEST_CHECK(in.get(flag) && !flag);
+    TEST_CHECK(in.get(flag) && flag);
+}
+
+static void test_arrays_and_tuples(void)
+{
+    std::array<uint16, 3> const array = { 0x0102u, 0x0304u, 0x0506u };
+    std::tuple<uint32, float32> const tuple{ 0xDEADBEEFu, -1.0f };
+    std::pair<sint8, uint16> const pair{ -1, 0xCAFEu };
+    uint8 raw[4] = { 1u, 2u, 3u, 4u };
+    sint32 words[2] = { -1, 0x11223344 };
+    uint8 buffer[16];
+    uint8 raw_loaded[4] = { 0u };
+    sint32 words_loaded[2] = { 0, 0 };
+    LibEmbd_Serializer_t ser;
+    LibEmbd_Deserializer_t deser;
+
+    check_round_trip<libembd::ByteOrder::network>("\x01\x02\x03\x04\x05\x06", array);
+    check_round_trip<libembd::ByteOrder::host>("\x02\x01\x04\x03\x06\x05", array);
+    check_round_trip<libembd::ByteOrder::network>("\xDE\xAD\xBE\xEF\xBF\x80\x00\x00\xFF\xCA\xFE", tuple, pair);
+
+    // built-in arrays cannot be held by std::tuple, round trip them by hand
+    libembd_make_serializer(&ser, buffer, sizeof(buffer));
+    libembd::Serializer<> out(ser);
+    TEST_CHECK(out.put(raw, words));
+    TEST_CHECK_EQUAL(12u, out.position());
+    TEST_CHECK_BYTES("\x01\x02\x03\x04\xFF\xFF\xFF\xFF\x11\x22\x33\x44", buffer, 12u);
+    libembd_make_deserializer(&deser, buffer, out.position());
+    libembd::Deserializer<> in(deser);
+    TEST_CHECK(in.get(raw_loaded, words_loaded));
+    TEST_CHECK_BYTES(raw, raw_loaded, sizeof(raw));
+    TEST_CHECK_BYTES(words, words_loaded, sizeof(words));
+}
+
+static void test_nested_structs(void)
+{
+    Outer const outer = {
+        { { 0x0102u, 0x0304050607080910ull, { 1.5f, -2.0f, 3.0f }, Mode::active, { -2, true }, { 9u, 8u } },
+          { 0xA0A1u, 42u, { 0.0f, 0.5f, -0.5f }, Mode::idle, { 0x7FFF, false }, { 0u, 0xFFu } } },
+        { high, { -32768, true } }
+    };
+    uint8 buffer[64];
+    Outer loaded{};
+    LibEmbd_Serializer_t ser;
+    LibEmbd_Deserializer_t deser;
+    uint32 i;
+
+    libembd_make_serializer(&ser, buffer, sizeof(buffer));
+    libembd::Serializer<> out(ser);
+    TEST_CHECK(out.put(outer));
+    TEST_CHECK_EQUAL(libembd::wire_size_v<Outer>, out.position());
+    // the members in declaration order: sensor_id, timestamp, xyz[0]...
+    TEST_CHECK_BYTES("\x01\x02\x03\x04\x05\x06\x07\x08\x09\x10\x3F\xC0\x00\x00", buffer, 14u);
+    TEST_CHECK_BYTES("\x12\x34\xFF\xFE\x01\x09\x08", &buffer[22], 7u);
+    TEST_CHECK_BYTES("\x64\x80\x00\x01", &buffer[58], 4u);
+
+    libembd_make_deserializer(&deser, buffer, out.position());
+    libembd::Deserializer<> in(deser);
+    TEST_CHECK(in.get(loaded));
+    for(i = 0u; i < 2u; i++){
+        Reading const &expected = outer.readings[i];
+        Reading const &actual = loaded.readings[i];
+        TEST_CHECK_EQUAL(expected.sensor_id, actual.sensor_id);
+        TEST_CHECK_EQUAL(expected.timestamp, actual.timestamp);
+        TEST_CHECK(expected.xyz == actual.xyz);
+        TEST_CHECK(expected.mode == actual.mode);
+        TEST_CHECK_EQUAL(expected.inner.x, actual.inner.x);
+        TEST_CHECK_EQUAL(expected.inner.flag, actual.inner.flag);
+        TEST_CHECK_BYTES(expected.raw, actual.raw, sizeof(expected.raw));
+    }
+    TEST_CHECK(loaded.tagged.first == high);
+    TEST_CHECK_EQUAL(-32768, loaded.tagged.second.x);
+    TEST_CHECK(loaded.tagged.second.flag);
+}
+
+// put()/get() check the space for all values at once: either all of them are transferred or none
+static void test_single_bounds_check(void)
+{
+    uint8 buffer[8];
+    uint32 const first = 0x01020304u;
+    uint32 second = 0u;
+    uint16 third = 0u;
+    LibEmbd_Serializer_t ser;
+    LibEmbd_Deserializer_t deser;
+
+    memset(buffer, 0xEE, sizeof(buffer));
+    libembd_make_serializer(&ser, buffer, sizeof(buffer));
+    libembd::Serializer<> out(ser);
+    TEST_CHECK(out.put((uint8)1u));
+    TEST_CHECK(!out.put(first, (uint16)0x0506u, (uint8)7u, (uint8)8u)); //8 bytes, 7 left
+    TEST_CHECK(out.has_overflowed());
+    TEST_CHECK_EQUAL(1u, out.position());
+    TEST_CHECK_BYTES("\x01\xEE\xEE\xEE\xEE\xEE\xEE\xEE", buffer, sizeof(buffer));
+    TEST_CHECK(!out.put((uint8)2u)); //sticky
+    TEST_CHECK_EQUAL(1u, out.position());
+
+    libembd_make_serializer(&ser, buffer, sizeof(buffer));
+    TEST_CHECK(out.put(first, (uint16)0x0506u, (uint8)7u, (uint8)8u)); //exactly full
+    TEST_CHECK(!out.has_overflowed());
+
+    libembd_make_deserializer(&deser, buffer, 5u);
+    libembd::Deserializer<> in(deser);
+    second = 0xAAAAAAAAu;
+    third = 0xBBBBu;
+    TEST_CHECK(!in.get(second, third)); //6 bytes, 5 available
+    TEST_CHECK(in.has_overflowed());
+    TEST_CHECK_EQUAL(0u, in.position());
+    TEST_CHECK_EQUAL(0xAAAAAAAAu, second);
+    TEST_CHECK_EQUAL(0xBBBBu, third);
+    TEST_CHECK(!in.get(third)); //sticky
+}
+
+// The typed and the C API share one buffer and one position
+static void test_mixed_with_c_api(void)
+{
+    uint8 buffer[16];
+    LibEmbd_Serializer_t ser;
+    LibEmbd_Deserializer_t deser;
+    uint32 word = 0u;
+    uint16 half = 0u;
+    Mode mode = Mode::idle;
+
+    libembd_make_serializer(&ser, buffer, sizeof(buffer));
+    libembd::Serializer<> out(ser);
+    libembd_put_uint32_to_network_checked(&ser, 0x11223344u);
+    TEST_CHECK(out.put(Mode::active));
+    libembd_put_uint16_to_network_checked(&ser, 0x5566u);
+    TEST_CHECK_EQUAL(8u, ser.position);
+
+    libembd_make_deserializer(&deser, buffer, ser.position);
+    libembd::Deserializer<> in(deser);
+    TEST_CHECK(in.get(word));
+    libembd_get_uint16_from_network_checked(&deser, &half);
+    TEST_CHECK_EQUAL(0x11223344u, word);
+    TEST_CHECK_EQUAL(0x1234u, half);
+    TEST_CHECK(in.get(mode));
+    TEST_CHECK_EQUAL(0x5566u, static_cast<uint16>(mode));
+    TEST_CHECK_EQUAL(8u, deser.position);
+}
+
+int main(void)
+{
+    (void)printf("%s\n", __FILE__);
+    TEST_RUN(test_arithmetic);
+    TEST_RUN(test_enum_and_bool);
+    TEST_RUN(test_arrays_and_tuples);
+    TEST_RUN(test_nested_structs);
+    TEST_RUN(test_single_bounds_check);
+    TEST_RUN(test_mixed_with_c_api);
+    return EXIT_SUCCESS;
+}
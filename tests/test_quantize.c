@@ -0,0 +1,239 @@
+#include <math.h>
+#include "test.h"
+#include "libembd/libembd_quantize.h"
+
+#define ARRAY_LENGTH    67u //covers the 8 resp. 4 wide vector loops and every tail length
+
+static float32 float32_from_bits(uint32 bits)
+{
+    float32 value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+static uint32 float32_bits(float32 value)
+{
+    uint32 bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+static void test_float16_known_values(void)
+{
+    TEST_CHECK_EQUAL(0x0000u, libembd_float32_to_float16(0.0f));
+    TEST_CHECK_EQUAL(0x8000u, libembd_float32_to_float16(-0.0f));
+    TEST_CHECK_EQUAL(0x3C00u, libembd_float32_to_float16(1.0f));
+    TEST_CHECK_EQUAL(0xC000u, libembd_float32_to_float16(-2.0f));
+    TEST_CHECK_EQUAL(0x2E66u, libembd_float32_to_float16(0.1f));
+    TEST_CHECK_EQUAL(0x7BFFu, libembd_float32_to_float16(65504.0f));
+    TEST_CHECK_EQUAL(0x7BFFu, libembd_float32_to_float16(65519.0f));
+    TEST_CHECK_EQUAL(0x7C00u, libembd_float32_to_float16(65520.0f)); //rounds up to infinity
+    TEST_CHECK_EQUAL(0x7C00u, libembd_float32_to_float16(1e10f));
+    TEST_CHECK_EQUAL(0xFC00u, libembd_float32_to_float16(-INFINITY));
+    TEST_CHECK_EQUAL(0x0400u, libembd_float32_to_float16(6.103515625e-05f)); //smallest normal
+    TEST_CHECK_EQUAL(0x0001u, libembd_float32_to_float16(5.9604644775390625e-08f)); //smallest subnormal
+    TEST_CHECK_EQUAL(0x0000u, libembd_float32_to_float16(2.98023223876953125e-08f)); //half of it, tie to even
+    TEST_CHECK_EQUAL(0x0001u, libembd_float32_to_float16(2.99e-08f));
+    TEST_CHECK_EQUAL(0x3C00u, libembd_float32_to_float16(1.00048828125f)); //1 + 2^-11, tie to even
+    TEST_CHECK_EQUAL(0x3C02u, libembd_float32_to_float16(1.00146484375f)); //1 + 3 * 2^-11, tie to even
+    TEST_CHECK_EQUAL(0x7C00u, libembd_float32_to_float16(INFINITY));
+    TEST_CHECK_EQUAL(0x7C00u, 0x7C00u & libembd_float32_to_float16(NAN));
+    TEST_CHECK(0u != (0x03FFu & libembd_float32_to_float16(NAN)));
+
+    TEST_CHECK(libembd_float16_to_float32(0x3C00u) == 1.0f);
+    TEST_CHECK(libembd_float16_to_float32(0x0001u) == 5.9604644775390625e-08f);
+    TEST_CHECK(isinf(libembd_float16_to_float32(0xFC00u)) && (libembd_float16_to_float32(0xFC00u) < 0.0f));
+    TEST_CHECK(isnan(libembd_float16_to_float32(0x7E00u)));
+}
+
+// Every half value survives the round trip through float32, NaNs stay NaNs
+static void test_float16_exhaustive(void)
+{
+    uint32 half;
+
+    for(half = 0u; half <= 0xFFFFu; half++){
+        float32 const value = libembd_float16_to_float32((uint16)half);
+        if(((half & 0x7C00u) == 0x7C00u) && ((half & 0x03FFu) != 0u)){
+            TEST_CHECK(isnan(value));
+            TEST_CHECK(isnan(libembd_float16_to_float32(libembd_float32_to_float16(value))));
+        } else {
+            TEST_CHECK_EQUAL(half, libembd_float32_to_float16(value));
+        }
+    }
+}
+
+static void test_bfloat16(void)
+{
+    TEST_CHECK_EQUAL(0x3F80u, libembd_float32_to_bfloat16(1.0f));
+    TEST_CHECK_EQUAL(0xC000u, libembd_float32_to_bfloat16(-2.0f));
+    TEST_CHECK_EQUAL(0x3F80u, libembd_float32_to_bfloat16(float32_from_bits(0x3F808000u))); //tie to even
+    TEST_CHECK_EQUAL(0x3F82u, libembd_float32_to_bfloat16(float32_from_bits(0x3F818000u))); //tie to even
+    TEST_CHECK_EQUAL(0x3F81u, libembd_float32_to_bfloat16(float32_from_bits(0x3F808001u)));
+    TEST_CHECK_EQUAL(0x7F80u, libembd_float32_to_bfloat16(INFINITY));
+    TEST_CHECK_EQUAL(0x7F80u, libembd_float32_to_bfloat16(float32_from_bits(0x7F7FFFFFu))); //largest float rounds up
+    TEST_CHECK(isnan(libembd_bfloat16_to_float32(libembd_float32_to_bfloat16(float32_from_bits(0x7F800001u)))));
+    TEST_CHECK(libembd_bfloat16_to_float32(0x4049u) == 3.140625f);
+}
+
+static void test_fixed_point(void)
+{
+    TEST_CHECK_EQUAL(16384, libembd_float32_to_q15(0.5f));
+    TEST_CHECK_EQUAL(-32768, libembd_float32_to_q15(-1.0f));
+    TEST_CHECK_EQUAL(32767, libembd_float32_to_q15(1.0f));
+    TEST_CHECK_EQUAL(-32768, libembd_float32_to_q15(-7.0f));
+    TEST_CHECK_EQUAL(0, libembd_float32_to_q15(NAN));
+    TEST_CHECK(libembd_q15_to_float32(-32768) == -1.0f);
+
+    TEST_CHECK_EQUAL(12345, libembd_float32_to_scaled_int16(12.345f, 0.001f, 0.0f));
+    TEST_CHECK_EQUAL(-40, libembd_float32_to_scaled_int16(0.0f, 0.5f, 20.0f));
+    TEST_CHECK_EQUAL(32767, libembd_float32_to_scaled_int16(1e9f, 0.5f, 20.0f));
+    TEST_CHECK_EQUAL(-32768, libembd_float32_to_scaled_int16(-1e9f, 0.5f, 20.0f));
+    TEST_CHECK_EQUAL(0, libembd_float32_to_scaled_int16(NAN, 0.5f, 20.0f));
+    TEST_CHECK(libembd_scaled_int16_to_float32(-40, 0.5f, 20.0f) == 0.0f);
+}
+
+static void test_put_get(void)
+{
+    uint8 buffer[9];
+    LibEmbd_Serializer_t ser;
+    LibEmbd_Deserializer_t deser;
+    float32 value;
+
+    libembd_make_serializer(&ser, buffer, 8u);
+    libembd_put_float16_to_network_checked(&ser, 1.0f);
+    libembd_put_bfloat16_to_host_checked(&ser, 1.0f);
+    libembd_put_q15_to_network_checked(&ser, 0.5f);
+    libembd_put_scaled_int16_to_network_checked(&ser, 12.345f, 0.001f, 0.0f);
+    TEST_CHECK(!libembd_serializer_has_overflowed(&ser));
+    libembd_put_float16_to_network_checked(&ser, 1.0f);
+    TEST_CHECK(libembd_serializer_has_overflowed(&ser));
+    TEST_CHECK_EQUAL(8u, ser.position);
+    TEST_CHECK_EQUAL(0x3Cu, buffer[0]);
+    TEST_CHECK_EQUAL(0x00u, buffer[1]);
+    TEST_CHECK_EQUAL(0x80u, buffer[2]);
+    TEST_CHECK_EQUAL(0x3Fu, buffer[3]);
+    TEST_CHECK_EQUAL(0x40u, buffer[4]);
+    TEST_CHECK_EQUAL(0x30u, buffer[6]);
+
+    libembd_make_deserializer(&deser, buffer, 8u);
+    libembd_get_float16_from_network_checked(&deser, &value);
+    TEST_CHECK(value == 1.0f);
+    libembd_get_bfloat16_from_host_checked(&deser, &value);
+    TEST_CHECK(value == 1.0f);
+    libembd_get_q15_from_network_checked(&deser, &value);
+    TEST_CHECK(value == 0.5f);
+    libembd_get_scaled_int16_from_network_checked(&deser, &value, 0.001f, 0.0f);
+    TEST_CHECK(fabsf(value - 12.345f) < 0.0005f);
+    TEST_CHECK(!libembd_deserializer_has_overflowed(&deser));
+    libembd_get_float16_from_network_checked(&deser, &value);
+    TEST_CHECK(libembd_deserializer_has_overflowed(&deser));
+}
+
+static void fill_values(float32 *values, uint32 count)
+{
+    uint32 i;
+    for(i = 0u; i < count; i++){
+        uint32 const r = test_random();
+        switch(r & 7u){
+            case 0u: values[i] = float32_from_bits(test_random()); break; //anything incl. NaN, inf, subnormal
+            case 1u: values[i] = (float32)(sint32)test_random() * 1e-12f; break; //near float16 subnormals
+            case 2u: values[i] = 65504.0f + (float32)(r >> 24u); break; //around the float16 range limit
+            default: values[i] = (float32)(sint32)test_random() * 1e-6f; break;
+        }
+    }
+}
+
+static boolean same_float(float32 a, float32 b)
+{
+    return (isnan(a) && isnan(b)) || (float32_bits(a) == float32_bits(b));
+}
+
+// The vectorized array paths must produce exactly what the per-element conversions produce
+static void test_arrays(void)
+{
+    uint32 round;
+
+    for(round = 0u; round < 200u; round++){
+        float32 values[ARRAY_LENGTH];
+        float32 decoded[ARRAY_LENGTH + 1u];
+        uint8 array_network[ARRAY_LENGTH * 2u];
+        uint8 array_host[ARRAY_LENGTH * 2u];
+        uint8 bf_network[ARRAY_LENGTH * 2u];
+        uint8 expected[ARRAY_LENGTH * 2u];
+        uint32 const count = round % (ARRAY_LENGTH + 1u);
+        LibEmbd_Serializer_t ser;
+        LibEmbd_Deserializer_t deser;
+        uint32 i;
+
+        fill_values(values, count);
+
+        libembd_make_serializer(&ser, expected, sizeof(expected));
+        for(i = 0u; i < count; i++){
+            libembd_put_float16_to_network_unsafe(&ser, values[i]);
+        }
+        libembd_make_serializer(&ser, array_network, sizeof(array_network));
+        libembd_put_float16_array_to_network_checked(&ser, values, count);
+        TEST_CHECK(!libembd_serializer_has_overflowed(&ser));
+        TEST_CHECK_EQUAL(count * 2u, ser.position);
+        TEST_CHECK_BYTES(expected, array_network, count * 2u);
+
+        libembd_make_serializer(&ser, expected, sizeof(expected));
+        for(i = 0u; i < count; i++){
+            libembd_put_float16_to_host_unsafe(&ser, values[i]);
+        }
+        libembd_make_serializer(&ser, array_host, sizeof(array_host));
+        libembd_put_float16_array_to_host_unsafe(&ser, values, count);
+        TEST_CHECK_BYTES(expected, array_host, count * 2u);
+
+        libembd_make_serializer(&ser, expected, sizeof(expected));
+        for(i = 0u; i < count; i++){
+            libembd_put_bfloat16_to_network_unsafe(&ser, values[i]);
+        }
+        libembd_make_serializer(&ser, bf_network, sizeof(bf_network));
+        libembd_put_bfloat16_array_to_network_unsafe(&ser, values, count);
+        TEST_CHECK_BYTES(expected, bf_network, count * 2u);
+
+        decoded[count] = 42.0f;
+        libembd_make_deserializer(&deser, array_network, count * 2u);
+        libembd_get_float16_array_from_network_checked(&deser, decoded, count);
+        TEST_CHECK(!libembd_deserializer_has_overflowed(&deser));
+        TEST_CHECK(decoded[count] == 42.0f);
+        for(i = 0u; i < count; i++){
+            TEST_CHECK(same_float(libembd_float16_to_float32(libembd_float32_to_float16(values[i])), decoded[i]));
+        }
+        libembd_make_deserializer(&deser, array_host, count * 2u);
+        libembd_get_float16_array_from_host_unsafe(&deser, decoded, count);
+        for(i = 0u; i < count; i++){
+            TEST_CHECK(same_float(libembd_float16_to_float32(libembd_float32_to_float16(values[i])), decoded[i]));
+        }
+        libembd_make_deserializer(&deser, bf_network, count * 2u);
+        libembd_get_bfloat16_array_from_network_unsafe(&deser, decoded, count);
+        for(i = 0u; i < count; i++){
+            TEST_CHECK(same_float(libembd_bfloat16_to_float32(libembd_float32_to_bfloat16(values[i])), decoded[i]));
+        }
+
+        //one element short, nothing is processed
+        if(count > 0u){
+            libembd_make_serializer(&ser, array_network, count * 2u - 1u);
+            libembd_put_float16_array_to_network_checked(&ser, values, count);
+            TEST_CHECK(libembd_serializer_has_overflowed(&ser));
+            TEST_CHECK_EQUAL(0u, ser.position);
+            libembd_make_deserializer(&deser, array_network, count * 2u - 1u);
+            libembd_get_float16_array_from_network_checked(&deser, decoded, count);
+            TEST_CHECK(libembd_deserializer_has_overflowed(&deser));
+            TEST_CHECK_EQUAL(0u, deser.position);
+        }
+    }
+}
+
+int main(void)
+{
+    (void)printf("%s\n", __FILE__);
+    TEST_RUN(test_float16_known_values);
+    TEST_RUN(test_float16_exhaustive);
+    TEST_RUN(test_bfloat16);
+    TEST_RUN(test_fixed_point);
+    TEST_RUN(test_put_get);
+    TEST_RUN(test_arrays);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,288 @@
+#include "test.h"
+#include "libembd/libembd_segmentation.h"
+
+#define CHANNELS            8u
+#define SESSION_CAPACITY    70000u
+#define TIMEOUT_MS          100u
+#define TICK_MS             10u
+
+static uint8 g_payloads[CHANNELS][SESSION_CAPACITY];
+static uint32 g_payload_lengths[CHANNELS];
+static uint8 g_storage[LIBEMBD_REASSEMBLY_MAX_SESSIONS * SESSION_CAPACITY];
+static LibEmbd_Reassembler_t g_reasm;
+static uint32 g_delivered;
+static uint32 g_mismatched;
+
+static LibEmbd_ConstBufferView_t const_view(uint8 const *data, uint32 length)
+{
+    LibEmbd_ConstBufferView_t view;
+    view.data = data;
+    view.length = (uint16)length;
+    return view;
+}
+
+// Counts deliveries and compares them with the payload sent on the channel, channels outside the table never match
+static void on_payload(void *context, uint32 channel, LibEmbd_Deserializer_t *payload)
+{
+    (void)context;
+    g_delivered++;
+    if((channel >= CHANNELS) || (payload->capacity != g_payload_lengths[channel]) ||
+       (memcmp(payload->buffer, g_payloads[channel], payload->capacity) != 0)){
+        g_mismatched++;
+    }
+}
+
+static void reset(void)
+{
+    libembd_make_reassembler(&g_reasm, g_storage, SESSION_CAPACITY, TIMEOUT_MS, on_payload, NULL);
+    g_delivered = 0u;
+    g_mismatched = 0u;
+}
+
+// Writes the next segment into frame and returns the frame length, 0 once the payload is done
+static uint32 next_frame(LibEmbd_Segmenter_t *seg, uint8 *frame, uint16 mtu)
+{
+    LibEmbd_Segment_t segment;
+    LibEmbd_Serializer_t ser;
+
+    if(!libembd_segmenter_next(seg, &segment)){
+        return 0u;
+    }
+    TEST_CHECK(segment.header_length + segment.payload.length <= mtu);
+    libembd_make_serializer(&ser, frame, mtu);
+    libembd_put_segment_checked(&ser, &segment);
+    TEST_CHECK(!libembd_serializer_has_overflowed(&ser));
+    return ser.position;
+}
+
+static void test_segment_headers(void)
+{
+    static uint8 payload[5000];
+    uint8 const escaped_first[] = { 0x10u, 0x00u, 0x00u, 0x00u, 0x13u, 0x88u };
+    LibEmbd_Segmenter_t seg;
+    LibEmbd_Segment_t segment;
+    uint32 i;
+
+    libembd_make_segmenter(&seg, payload, 5u, 8u);
+    TEST_CHECK(libembd_segmenter_next(&seg, &segment));
+    TEST_CHECK_EQUAL(1u, segment.header_length);
+    TEST_CHECK_EQUAL(0x05u, segment.header[0]);
+    TEST_CHECK_EQUAL(5u, segment.payload.length);
+    TEST_CHECK(!libembd_segmenter_next(&seg, &segment));
+
+    //single frame with escaped length when the MTU allows it, first frame otherwise
+    libembd_make_segmenter(&seg, payload, 100u, 1500u);
+    TEST_CHECK(libembd_segmenter_next(&seg, &segment));
+    TEST_CHECK_EQUAL(2u, segment.header_length);
+    TEST_CHECK_EQUAL(0x00u, segment.header[0]);
+    TEST_CHECK_EQUAL(100u, segment.header[1]);
+    TEST_CHECK_EQUAL(100u, segment.payload.length);
+    TEST_CHECK(!libembd_segmenter_next(&seg, &segment));
+
+    libembd_make_segmenter(&seg, payload, 100u, 64u);
+    TEST_CHECK(libembd_segmenter_next(&seg, &segment));
+    TEST_CHECK_EQUAL(2u, segment.header_length);
+    TEST_CHECK_EQUAL(0x10u, segment.header[0]);
+    TEST_CHECK_EQUAL(100u, segment.header[1]);
+    TEST_CHECK_EQUAL(62u, segment.payload.length);
+    TEST_CHECK(libembd_segmenter_next(&seg, &segment));
+    TEST_CHECK_EQUAL(0x21u, segment.header[0]);
+    TEST_CHECK_EQUAL(38u, segment.payload.length);
+    TEST_CHECK(segment.payload.data == &payload[62]); //a view into the source, not a copy
+    TEST_CHECK(!libembd_segmenter_next(&seg, &segment));
+
+    //32-bit length escape above 4095 bytes, sequence numbers wrap from 15 to 0
+    libembd_make_segmenter(&seg, payload, sizeof(payload), 8u);
+    TEST_CHECK(libembd_segmenter_next(&seg, &segment));
+    TEST_CHECK_EQUAL(sizeof(escaped_first), segment.header_length);
+    TEST_CHECK_BYTES(escaped_first, segment.header, sizeof(escaped_first));
+    TEST_CHECK_EQUAL(2u, segment.payload.length);
+    for(i = 1u; i <= 17u; i++){
+        TEST_CHECK(libembd_segmenter_next(&seg, &segment));
+        TEST_CHECK_EQUAL(0x20u | (i & 0x0Fu), segment.header[0]);
+        TEST_CHECK_EQUAL(7u, segment.payload.length);
+    }
+}
+
+// Every channel sends a payload of a different length, frames of all channels interleaved
+static void test_round_trip_interleaved(void)
+{
+    uint16 const mtus[] = { 8u, 64u, 1500u };
+    uint32 const lengths[] = { 0u, 1u, 6u, 7u, 8u, 9u, 62u, 63u, 64u, 200u, 255u, 256u, 1497u, 1498u, 1499u, 4095u, 4096u,
+                               5000u, SESSION_CAPACITY };
+    uint32 const length_count = sizeof(lengths) / sizeof(lengths[0]);
+    LibEmbd_Segmenter_t segmenters[CHANNELS];
+    uint8 frame[1500];
+
+    reset();
+    for(uint32 m = 0u; m < sizeof(mtus) / sizeof(mtus[0]); m++){
+        for(uint32 l = 0u; l < length_count; l++){
+            boolean done[CHANNELS] = { FALSE };
+            uint32 active = CHANNELS;
+            uint32 channel;
+
+            g_delivered = 0u;
+            for(channel = 0u; channel < CHANNELS; channel++){
+                g_payload_lengths[channel] = lengths[(l + channel) % length_count];
+                for(uint32 i = 0u; i < g_payload_lengths[channel]; i++){
+                    g_payloads[channel][i] = (uint8)test_random();
+                }
+                libembd_make_segmenter(&segmenters[channel], g_payloads[channel], g_payload_lengths[channel], mtus[m]);
+            }
+            while(active > 0u){
+                for(channel = 0u; channel < CHANNELS; channel++){
+                    uint32 length;
+                    if(done[channel]){
+                        continue;
+                    }
+                    length = next_frame(&segmenters[channel], frame, mtus[m]);
+                    if(length == 0u){
+                        done[channel] = TRUE;
+                        active--;
+                        continue;
+                    }
+                    if((mtus[m] == 8u) && ((test_random() & 1u) != 0u)){
+                        memset(&frame[length], 0xCC, 8u - length); //CAN frames padded to full length
+                        length = 8u;
+                    }
+                    TEST_CHECK_EQUAL(E_OK, libembd_reassembler_receive(&g_reasm, channel, const_view(frame, length)));
+                }
+            }
+            TEST_CHECK_EQUAL(CHANNELS, g_delivered);
+            TEST_CHECK_EQUAL(0u, g_mismatched);
+            TEST_CHECK_EQUAL(0u, libembd_reassembler_active_sessions(&g_reasm));
+        }
+    }
+}
+
+static void test_malformed(void)
+{
+    uint8 const first[] = { 0x10u, 20u, 1u, 2u, 3u, 4u, 5u, 6u };
+    uint8 consecutive[] = { 0x21u, 7u, 8u, 9u, 10u, 11u, 12u, 13u };
+    uint8 const too_long[] = { 0x10u, 0x00u, 0x00u, 0x01u, 0x11u, 0x71u }; //70001 bytes
+    uint8 const truncated_single[] = { 0x05u, 1u, 2u };
+    uint8 const truncated_escaped_single[] = { 0x00u, 9u, 1u };
+    uint8 const flow_control[] = { 0x30u, 0x00u, 0x00u };
+    uint8 const truncated_first[] = { 0x10u };
+    uint8 const truncated_escaped_first[] = { 0x10u, 0x00u, 0x00u, 0x00u };
+
+    reset();
+    TEST_CHECK_EQUAL(E_NOT_OK, libembd_reassembler_receive(&g_reasm, 1u, const_view(first, 0u)));
+    TEST_CHECK_EQUAL(E_NOT_OK, libembd_reassembler_receive(&g_reasm, 1u, const_view(truncated_single, sizeof(truncated_single))));
+    TEST_CHECK_EQUAL(E_NOT_OK, libembd_reassembler_receive(&g_reasm, 1u, const_view(truncated_escaped_single, sizeof(truncated_escaped_single))));
+    TEST_CHECK_EQUAL(E_NOT_OK, libembd_reassembler_receive(&g_reasm, 1u, const_view(flow_control, sizeof(flow_control))));
+    TEST_CHECK_EQUAL(E_NOT_OK, libembd_reassembler_receive(&g_reasm, 1u, const_view(truncated_first, sizeof(truncated_first))));
+    TEST_CHECK_EQUAL(E_NOT_OK, libembd_reassembler_receive(&g_reasm, 1u, const_view(truncated_escaped_first, sizeof(truncated_escaped_first))));
+    TEST_CHECK_EQUAL(E_NOT_OK, libembd_reassembler_receive(&g_reasm, 1u, const_view(too_long, sizeof(too_long))));
+    TEST_CHECK_EQUAL(E_NOT_OK, libembd_reassembler_receive(&g_reasm, 1u, const_view(consecutive, sizeof(consecutive)))); //no session
+    TEST_CHECK_EQUAL(0u, libembd_reassembler_active_sessions(&g_reasm));
+
+    //out of sequence drops the session
+    TEST_CHECK_EQUAL(E_OK, libembd_reassembler_receive(&g_reasm, 1u, const_view(first, sizeof(first))));
+    TEST_CHECK_EQUAL(1u, libembd_reassembler_active_sessions(&g_reasm));
+    consecutive[0] = 0x22u;
+    TEST_CHECK_EQUAL(E_NOT_OK, libembd_reassembler_receive(&g_reasm, 1u, const_view(consecutive, sizeof(consecutive))));
+    TEST_CHECK_EQUAL(0u, libembd_reassembler_active_sessions(&g_reasm));
+
+    //a new first frame restarts the session on its channel
+    consecutive[0] = 0x21u;
+    TEST_CHECK_EQUAL(E_OK, libembd_reassembler_receive(&g_reasm, 1u, const_view(first, sizeof(first))));
+    TEST_CHECK_EQUAL(E_OK, libembd_reassembler_receive(&g_reasm, 1u, const_view(consecutive, sizeof(consecutive))));
+    TEST_CHECK_EQUAL(E_OK, libembd_reassembler_receive(&g_reasm, 1u, const_view(first, sizeof(first))));
+    TEST_CHECK_EQUAL(1u, libembd_reassembler_active_sessions(&g_reasm));
+
+    //all sessions taken
+    for(uint32 i = 2u; i <= LIBEMBD_REASSEMBLY_MAX_SESSIONS; i++){
+        TEST_CHECK_EQUAL(E_OK, libembd_reassembler_receive(&g_reasm, 100u + i, const_view(first, sizeof(first))));
+    }
+    TEST_CHECK_EQUAL(LIBEMBD_REASSEMBLY_MAX_SESSIONS, libembd_reassembler_active_sessions(&g_reasm));
+    TEST_CHECK_EQUAL(E_NOT_OK, libembd_reassembler_receive(&g_reasm, 99u, const_view(first, sizeof(first))));
+    TEST_CHECK_EQUAL(0u, g_delivered);
+}
+
+static void test_timeout(void)
+{
+    uint8 const first[] = { 0x10u, 20u, 1u, 2u, 3u, 4u, 5u, 6u };
+    uint8 const consecutive[] = { 0x21u, 7u, 8u, 9u, 10u, 11u, 12u, 13u };
+    uint32 tick;
+
+    reset();
+    TEST_CHECK_EQUAL(E_OK, libembd_reassembler_receive(&g_reasm, 5u, const_view(first, sizeof(first))));
+    for(tick = 0u; tick < (TIMEOUT_MS / TICK_MS) - 1u; tick++){
+        TEST_CHECK_EQUAL(0u, libembd_reassembler_tick(&g_reasm, TICK_MS));
+    }
+    //a consecutive frame rewinds the timer
+    TEST_CHECK_EQUAL(E_OK, libembd_reassembler_receive(&g_reasm, 5u, const_view(consecutive, sizeof(consecutive))));
+    for(tick = 0u; tick < (TIMEOUT_MS / TICK_MS) - 1u; tick++){
+        TEST_CHECK_EQUAL(0u, libembd_reassembler_tick(&g_reasm, TICK_MS));
+    }
+    TEST_CHECK_EQUAL(1u, libembd_reassembler_tick(&g_reasm, TICK_MS));
+    TEST_CHECK_EQUAL(0u, libembd_reassembler_active_sessions(&g_reasm));
+    TEST_CHECK_EQUAL(E_NOT_OK, libembd_reassembler_receive(&g_reasm, 5u, const_view(consecutive, sizeof(consecutive))));
+    TEST_CHECK_EQUAL(0u, g_delivered);
+}
+
+// Sessions opened and dropped on random channel ids, a lost hash index entry would leave a session nobody can drop
+static void test_channel_churn(void)
+{
+    uint8 const first[] = { 0x10u, 20u, 1u, 2u, 3u, 4u, 5u, 6u };
+    uint8 const consecutive[] = { 0x21u, 7u, 8u };
+    uint8 const single[] = { 0x01u, 9u };
+    uint32 channels[200];
+    uint32 i;
+
+    reset();
+    for(i = 0u; i < 200u; i++){
+        channels[i] = test_random();
+    }
+    for(i = 0u; i < 100000u; i++){
+        uint32 const channel = channels[test_random() % 200u];
+        if((test_random() & 1u) != 0u){
+            (void)libembd_reassembler_receive(&g_reasm, channel, const_view(first, sizeof(first)));
+        } else {
+            (void)libembd_reassembler_receive(&g_reasm, channel, const_view(consecutive, sizeof(consecutive)));
+        }
+        TEST_CHECK(libembd_reassembler_active_sessions(&g_reasm) <= LIBEMBD_REASSEMBLY_MAX_SESSIONS);
+    }
+    //a single frame drops the session in progress on its channel
+    for(i = 0u; i < 200u; i++){
+        TEST_CHECK_EQUAL(E_OK, libembd_reassembler_receive(&g_reasm, channels[i], const_view(single, sizeof(single))));
+    }
+    TEST_CHECK_EQUAL(0u, libembd_reassembler_active_sessions(&g_reasm));
+}
+
+static void test_random_frames(void)
+{
+    uint8 frame[16];
+    uint32 i;
+
+    reset();
+    for(i = 0u; i < 300000u; i++){
+        uint32 const length = test_random() % (sizeof(frame) + 1u);
+        for(uint32 j = 0u; j < length; j++){
+            frame[j] = (uint8)test_random();
+        }
+        if((length > 0u) && ((test_random() & 1u) != 0u)){
+            frame[0] = (uint8)((frame[0] & 0x3Fu) % 0x30u); //mostly valid frame types
+        }
+        (void)libembd_reassembler_receive(&g_reasm, test_random() % 20u, const_view(frame, length));
+        if((i % 100u) == 0u){
+            (void)libembd_reassembler_tick(&g_reasm, TIMEOUT_MS);
+        }
+    }
+    TEST_CHECK(libembd_reassembler_active_sessions(&g_reasm) <= LIBEMBD_REASSEMBLY_MAX_SESSIONS);
+    (void)libembd_reassembler_tick(&g_reasm, TIMEOUT_MS);
+    TEST_CHECK_EQUAL(0u, libembd_reassembler_active_sessions(&g_reasm));
+}
+
+int main(void)
+{
+    (void)printf("%s\n", __FILE__);
+    TEST_RUN(test_segment_headers);
+    TEST_RUN(test_round_trip_interleaved);
+    TEST_RUN(test_malformed);
+    TEST_RUN(test_timeout);
+    TEST_RUN(test_channel_churn);
+    TEST_RUN(test_random_frames);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,290 @@
+#define _XOPEN_SOURCE 700 //sigaction, setitimer and nanosleep, strict -std=c11 hides them
+#include <errno.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+#include "libembd/libembd_sg_serializer.h"
+#include "test.h"
+
+// The transfer tests push PAYLOAD_SIZE bytes through a pipe or socketpair to a reader process that drains it in small,
+// slow reads, while an interval timer interrupts the writer. The handler is installed without SA_RESTART, so a blocked
+// writev()/sendmsg() returns either a short count (some bytes already went out) or EINTR (none did), and the library
+// has to resume in the middle of an iovec.
+
+#define PIECES          7u //2 * PIECES + 1 iovecs must fit LIBEMBD_SG_MAX_IOVECS
+#define PIECE_SIZE      (128u * 1024u)
+#define PAYLOAD_SIZE    (PIECES * PIECE_SIZE)
+#define MESSAGE_LENGTH  (4u + (PIECES * (4u + PIECE_SIZE)) + 4u)
+#define READ_SIZE       700u
+
+static uint8 g_payload[PAYLOAD_SIZE];
+static uint8 g_received[MESSAGE_LENGTH + READ_SIZE];
+static volatile sig_atomic_t g_interrupts;
+
+static void on_timer(int signal_number)
+{
+    (void)signal_number;
+    g_interrupts++;
+}
+
+static void start_interrupts(void)
+{
+    struct sigaction action;
+    struct itimerval timer;
+
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = on_timer;
+    (void)sigemptyset(&action.sa_mask);
+    action.sa_flags = 0; //no SA_RESTART
+    TEST_CHECK(sigaction(SIGALRM, &action, NULL) == 0);
+
+    g_interrupts = 0;
+    timer.it_interval.tv_sec = 0;
+    timer.it_interval.tv_usec = 200;
+    timer.it_value = timer.it_interval;
+    TEST_CHECK(setitimer(ITIMER_REAL, &timer, NULL) == 0);
+}
+
+static void stop_interrupts(void)
+{
+    struct itimerval timer;
+    memset(&timer, 0, sizeof(timer));
+    TEST_CHECK(setitimer(ITIMER_REAL, &timer, NULL) == 0);
+    (void)signal(SIGALRM, SIG_DFL);
+}
+
+// Child side: reads everything in small slow reads and exits with 0 if exactly the message built by build_message()
+// arrived
+static void read_slowly(int fd)
+{
+    struct timespec const pause = { 0, 20000 };
+    LibEmbd_Deserializer_t deser;
+    uint32 received = 0u;
+    uint32 value;
+    uint32 i;
+
+    for(;;){
+        ssize_t const result = read(fd, &g_received[received], READ_SIZE);
+        if(result == 0){
+            break;
+        }
+        if(result < 0){
+            _exit((errno == EINTR) ? 2 : 3);
+        }
+        received += (uint32)result;
+        if(received > MESSAGE_LENGTH){
+            _exit(4);
+        }
+        (void)nanosleep(&pause, NULL);
+    }
+    if(received != MESSAGE_LENGTH){
+        _exit(5);
+    }
+
+    libembd_make_deserializer(&deser, g_received, received);
+    libembd_get_uint32_from_network_checked(&deser, &value);
+    if(value != MESSAGE_LENGTH){
+        _exit(6);
+    }
+    for(i = 0u; i < PIECES; i++){
+        libembd_get_uint32_from_network_checked(&deser, &value);
+        if((value != i) || libembd_deserializer_has_overflowed(&deser) ||
+           (memcmp(&g_received[deser.position], &g_payload[i * PIECE_SIZE], PIECE_SIZE) != 0)){
+            _exit(7);
+        }
+        deser.position += PIECE_SIZE;
+    }
+    libembd_get_uint32_from_network_checked(&deser, &value);
+    _exit(((value == 0xC0DEC0DEu) && (deser.position == received)) ? 0 : 8);
+}
+
+// Length header, PIECES referenced payload slices each preceded by an inline index, trailer
+static void build_message(LibEmbd_SgSerializer_t *sg, uint8 *inline_buffer, uint32 inline_capacity)
+{
+    LibEmbd_Serializer_t *ser;
+    uint32 i;
+
+    libembd_make_sg_serializer(sg, inline_buffer, inline_capacity);
+    ser = libembd_sg_serializer_inline(sg);
+    libembd_put_uint32_to_network_checked(ser, MESSAGE_LENGTH);
+    for(i = 0u; i < PIECES; i++){
+        libembd_put_uint32_to_network_checked(ser, i);
+        libembd_sg_put_buffer(sg, &g_payload[i * PIECE_SIZE], PIECE_SIZE);
+    }
+    libembd_put_uint32_to_network_checked(ser, 0xC0DEC0DEu);
+}
+
+static pid_t spawn_reader(int fds[2])
+{
+    pid_t const pid = fork();
+    TEST_CHECK(pid >= 0);
+    if(pid == 0){
+        (void)close(fds[1]);
+        read_slowly(fds[0]);
+    }
+    (void)close(fds[0]);
+    return pid;
+}
+
+static void check_reader(pid_t pid)
+{
+    int status;
+    TEST_CHECK(waitpid(pid, &status, 0) == pid);
+    TEST_CHECK(WIFEXITED(status));
+    TEST_CHECK_EQUAL(0, WEXITSTATUS(status));
+}
+
+static void test_iovec_merging(void)
+{
+    uint8 inline_buffer[64];
+    uint8 small[16];
+    LibEmbd_SgSerializer_t sg;
+    LibEmbd_IoVec_t const *iov;
+    uint32 count;
+
+    memset(small, 0x5A, sizeof(small));
+    libembd_make_sg_serializer(&sg, inline_buffer, sizeof(inline_buffer));
+    libembd_put_uint16_to_network_checked(libembd_sg_serializer_inline(&sg), 0x1234u);
+    libembd_sg_put_buffer(&sg, small, sizeof(small)); //below the threshold, copied into the same inline chunk
+    libembd_sg_put_buffer(&sg, &g_payload[0], 1000u);
+    libembd_sg_put_buffer_ref(&sg, &g_payload[1000], 24u); //contiguous with the previous reference, merged
+    libembd_sg_put_buffer_ref(&sg, &g_payload[1024], 0u); //empty, dropped
+    libembd_put_uint32_to_network_checked(libembd_sg_serializer_inline(&sg), 0xAABBCCDDu);
+    TEST_CHECK_EQUAL(2u + 16u + 1024u + 4u, libembd_sg_serializer_total_length(&sg));
+
+    iov = libembd_sg_serializer_finalize(&sg, &count);
+    TEST_CHECK_EQUAL(3u, count);
+    TEST_CHECK(iov[0].iov_base == inline_buffer);
+    TEST_CHECK_EQUAL(18u, iov[0].iov_len);
+    TEST_CHECK_BYTES(small, &inline_buffer[2], sizeof(small));
+    TEST_CHECK(iov[1].iov_base == g_payload);
+    TEST_CHECK_EQUAL(1024u, iov[1].iov_len);
+    TEST_CHECK(iov[2].iov_base == &inline_buffer[18]);
+    TEST_CHECK_EQUAL(4u, iov[2].iov_len);
+
+    // finalize again after appending to the still open inline chunk: the new bytes extend the last iovec
+    libembd_put_uint8_checked(libembd_sg_serializer_inline(&sg), 0xEEu);
+    iov = libembd_sg_serializer_finalize(&sg, &count);
+    TEST_CHECK_EQUAL(3u, count);
+    TEST_CHECK_EQUAL(5u, iov[2].iov_len);
+    TEST_CHECK_EQUAL(2u + 16u + 1024u + 5u, libembd_sg_serializer_total_length(&sg));
+    TEST_CHECK(!libembd_sg_serializer_has_overflowed(&sg));
+
+    libembd_reset_sg_serializer(&sg);
+    (void)libembd_sg_serializer_finalize(&sg, &count);
+    TEST_CHECK_EQUAL(0u, count);
+    TEST_CHECK_EQUAL(0u, libembd_sg_serializer_total_length(&sg));
+}
+
+static void test_overflow(void)
+{
+    uint8 inline_buffer[8];
+    LibEmbd_SgSerializer_t sg;
+    int fds[2];
+    uint32 i;
+
+    // every other payload byte referenced on its own, none of them contiguous
+    libembd_make_sg_serializer(&sg, inline_buffer, sizeof(inline_buffer));
+    for(i = 0u; i < LIBEMBD_SG_MAX_IOVECS; i++){
+        libembd_sg_put_buffer_ref(&sg, &g_payload[2u * i], 1u);
+    }
+    TEST_CHECK(!libembd_sg_serializer_has_overflowed(&sg));
+    libembd_sg_put_buffer_ref(&sg, &g_payload[2u * i], 1u);
+    TEST_CHECK(libembd_sg_serializer_has_overflowed(&sg));
+    TEST_CHECK_EQUAL(LIBEMBD_SG_MAX_IOVECS, libembd_sg_serializer_total_length(&sg));
+
+    // an overflowed serializer writes nothing
+    TEST_CHECK(pipe(fds) == 0);
+    TEST_CHECK_EQUAL(E_NOT_OK, libembd_sg_serializer_writev(&sg, fds[1]));
+    (void)close(fds[1]);
+    TEST_CHECK_EQUAL(0, read(fds[0], g_received, 1u));
+    (void)close(fds[0]);
+
+    libembd_make_sg_serializer(&sg, inline_buffer, sizeof(inline_buffer));
+    libembd_put_uint64_to_network_checked(libembd_sg_serializer_inline(&sg), 1u);
+    TEST_CHECK(!libembd_sg_serializer_has_overflowed(&sg));
+    libembd_sg_put_buffer(&sg, g_payload, 1u); //inline buffer full
+    TEST_CHECK(libembd_sg_serializer_has_overflowed(&sg));
+}
+
+static void test_writev_resumes_partial_writes(void)
+{
+    uint8 inline_buffer[64];
+    LibEmbd_SgSerializer_t sg;
+    int fds[2];
+    pid_t reader;
+    LibEmbd_Std_ReturnType result;
+
+    TEST_CHECK(pipe(fds) == 0);
+    reader = spawn_reader(fds);
+    build_message(&sg, inline_buffer, sizeof(inline_buffer));
+
+    start_interrupts();
+    result = libembd_sg_serializer_writev(&sg, fds[1]);
+    stop_interrupts();
+    (void)close(fds[1]);
+
+    TEST_CHECK_EQUAL(E_OK, result);
+    TEST_CHECK(g_interrupts > 0);
+    check_reader(reader);
+}
+
+static void test_sendmsg_resumes_partial_sends(void)
+{
+    uint8 inline_buffer[64];
+    LibEmbd_SgSerializer_t sg;
+    int const send_buffer = 4096;
+    int fds[2];
+    pid_t reader;
+    LibEmbd_Std_ReturnType result;
+
+    TEST_CHECK(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+    TEST_CHECK(setsockopt(fds[1], SOL_SOCKET, SO_SNDBUF, &send_buffer, sizeof(send_buffer)) == 0);
+    reader = spawn_reader(fds);
+    build_message(&sg, inline_buffer, sizeof(inline_buffer));
+
+    start_interrupts();
+    result = libembd_sg_serializer_sendmsg(&sg, fds[1], 0);
+    stop_interrupts();
+    (void)close(fds[1]);
+
+    TEST_CHECK_EQUAL(E_OK, result);
+    TEST_CHECK(g_interrupts > 0);
+    check_reader(reader);
+}
+
+static void test_write_error(void)
+{
+    uint8 inline_buffer[16];
+    LibEmbd_SgSerializer_t sg;
+    int fds[2];
+
+    // the peer is gone: sendmsg fails with EPIPE instead of raising SIGPIPE
+    TEST_CHECK(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+    (void)close(fds[0]);
+    libembd_make_sg_serializer(&sg, inline_buffer, sizeof(inline_buffer));
+    libembd_put_uint32_to_network_checked(libembd_sg_serializer_inline(&sg), 1u);
+    TEST_CHECK_EQUAL(E_NOT_OK, libembd_sg_serializer_sendmsg(&sg, fds[1], 0));
+    TEST_CHECK_EQUAL(EPIPE, errno);
+    (void)close(fds[1]);
+}
+
+int main(void)
+{
+    uint32 i;
+
+    (void)printf("%s\n", __FILE__);
+    (void)signal(SIGPIPE, SIG_IGN); //a reader exiting early fails the write instead of killing the test
+    for(i = 0u; i < PAYLOAD_SIZE; i++){
+        g_payload[i] = (uint8)((i * 7u) + (i >> 11u));
+    }
+    TEST_RUN(test_iovec_merging);
+    TEST_RUN(test_overflow);
+    TEST_RUN(test_writev_resumes_partial_writes);
+    TEST_RUN(test_sendmsg_resumes_partial_sends);
+    TEST_RUN(test_write_error);
+    return EXIT_SUCCESS;
+}
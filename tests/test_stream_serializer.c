@@ -0,0 +1,328 @@
+#include "test.h"
+#include "libembd/libembd_stream_serializer.h"
+
+// Staging buffers of 1 to MAX_STAGING bytes put every field at every offset relative to a flush or refill, the source
+// hands out at most chunk bytes per call so that refills stop short of a full staging buffer as well.
+#define MAX_STAGING     19u
+#define STREAM_SIZE     1024u
+
+typedef struct {
+    uint8 data[STREAM_SIZE];
+    uint32 length;
+    uint32 calls;
+    uint32 fail_at_call; //0: never fail
+    uint8 const *last_data;
+    uint32 last_length;
+} MemorySink_t;
+
+typedef struct {
+    uint8 const *data;
+    uint32 length;
+    uint32 position;
+    uint32 chunk;
+    uint32 calls;
+} MemorySource_t;
+
+static LibEmbd_Std_ReturnType memory_sink(void *context, uint8 const *data, uint32 length)
+{
+    MemorySink_t * const sink = (MemorySink_t *)context;
+    sink->calls++;
+    sink->last_data = data;
+    sink->last_length = length;
+    if((sink->calls == sink->fail_at_call) || (sink->length + length > sizeof(sink->data))){
+        return E_NOT_OK;
+    }
+    memcpy(&sink->data[sink->length], data, length);
+    sink->length += length;
+    return E_OK;
+}
+
+static uint32 memory_source(void *context, uint8 *buffer, uint32 capacity)
+{
+    MemorySource_t * const source = (MemorySource_t *)context;
+    uint32 const count = LIBEMBD_MIN(LIBEMBD_MIN(capacity, source->chunk), source->length - source->position);
+    source->calls++;
+    memcpy(buffer, &source->data[source->position], count);
+    source->position += count;
+    return count;
+}
+
+static void make_source(MemorySource_t *source, uint8 const *data, uint32 length, uint32 chunk)
+{
+    memset(source, 0, sizeof(*source));
+    source->data = data;
+    source->length = length;
+    source->chunk = chunk;
+}
+
+// The same record sequence through the streaming serializer and a contiguous one
+static void put_records(LibEmbd_StreamSerializer_t *sser, LibEmbd_Serializer_t *ser)
+{
+    uint32 i;
+    for(i = 0u; i < 24u; i++){
+        uint8 const bytes[3] = { (uint8)i, 0xA5u, (uint8)~i };
+        libembd_stream_put_uint8(sser, (uint8)i);
+        libembd_put_uint8_unsafe(ser, (uint8)i);
+        libembd_stream_put_uint16_to_network(sser, (uint16)(0x1234u + i));
+        libembd_put_uint16_to_network_unsafe(ser, (uint16)(0x1234u + i));
+        libembd_stream_put_sint32_to_host(sser, -(sint32)i * 100003);
+        libembd_put_sint32_to_host_unsafe(ser, -(sint32)i * 100003);
+        libembd_stream_put_uint64_to_network(sser, 0x0102030405060708ull * i);
+        libembd_put_uint64_to_network_unsafe(ser, 0x0102030405060708ull * i);
+        libembd_stream_put_float32_to_network(sser, (float32)i * 0.25f);
+        libembd_put_float32_to_network_unsafe(ser, (float32)i * 0.25f);
+        libembd_stream_put_float64_to_host(sser, (float64)i * -1.5);
+        libembd_put_float64_to_host_unsafe(ser, (float64)i * -1.5);
+        libembd_stream_put_buffer(sser, bytes, sizeof(bytes));
+        libembd_put_buffer_unsafe(ser, bytes, sizeof(bytes));
+        TEST_CHECK_EQUAL(ser->position, libembd_stream_serializer_total_length(sser));
+    }
+}
+
+static void get_records(LibEmbd_StreamDeserializer_t *sdeser)
+{
+    uint32 i;
+    for(i = 0u; i < 24u; i++){
+        uint8 u8;
+        uint16 u16;
+        sint32 s32;
+        uint64 u64;
+        float32 f32;
+        float64 f64;
+        uint8 bytes[3];
+
+        libembd_stream_get_uint8(sdeser, &u8);
+        TEST_CHECK_EQUAL(i, u8);
+        libembd_stream_get_uint16_from_network(sdeser, &u16);
+        TEST_CHECK_EQUAL(0x1234u + i, u16);
+        libembd_stream_get_sint32_from_host(sdeser, &s32);
+        TEST_CHECK(s32 == -(sint32)i * 100003);
+        libembd_stream_get_uint64_from_network(sdeser, &u64);
+        TEST_CHECK_EQUAL(0x0102030405060708ull * i, u64);
+        libembd_stream_get_float32_from_network(sdeser, &f32);
+        TEST_CHECK(f32 == (float32)i * 0.25f);
+        libembd_stream_get_float64_from_host(sdeser, &f64);
+        TEST_CHECK(f64 == (float64)i * -1.5);
+        TEST_CHECK_EQUAL(3u, libembd_stream_get_buffer(sdeser, bytes, sizeof(bytes)));
+        TEST_CHECK_EQUAL(i, bytes[0]);
+        TEST_CHECK_EQUAL(0xA5u, bytes[1]);
+        TEST_CHECK_EQUAL((uint8)~i, bytes[2]);
+    }
+}
+
+static void test_fields_straddling_flush_and_refill(void)
+{
+    uint8 staging[MAX_STAGING];
+    uint8 expected[STREAM_SIZE];
+    uint32 capacity;
+
+    for(capacity = 1u; capacity <= MAX_STAGING; capacity++){
+        MemorySink_t sink;
+        LibEmbd_StreamSerializer_t sser;
+        LibEmbd_Serializer_t ser;
+        uint32 chunk;
+
+        memset(&sink, 0, sizeof(sink));
+        libembd_make_stream_serializer(&sser, staging, capacity, memory_sink, &sink);
+        libembd_make_serializer(&ser, expected, sizeof(expected));
+        put_records(&sser, &ser);
+        TEST_CHECK_EQUAL(E_OK, libembd_stream_serializer_flush(&sser));
+        TEST_CHECK(!libembd_stream_serializer_has_failed(&sser));
+        TEST_CHECK_EQUAL(ser.position, sink.length);
+        TEST_CHECK_BYTES(expected, sink.data, ser.position);
+        TEST_CHECK_EQUAL(ser.position, libembd_stream_serializer_total_length(&sser));
+
+        for(chunk = 1u; chunk <= 5u; chunk++){
+            MemorySource_t source;
+            LibEmbd_StreamDeserializer_t sdeser;
+
+            make_source(&source, sink.data, sink.length, chunk);
+            libembd_make_stream_deserializer(&sdeser, staging, capacity, memory_source, &source);
+            get_records(&sdeser);
+            TEST_CHECK(!libembd_stream_deserializer_has_failed(&sdeser));
+            TEST_CHECK_EQUAL(sink.length, libembd_stream_deserializer_total_length(&sdeser));
+            TEST_CHECK(libembd_stream_deserializer_at_end(&sdeser));
+            TEST_CHECK(!libembd_stream_deserializer_has_failed(&sdeser)); //the end at a field boundary is no error
+        }
+    }
+}
+
+static void test_put_buffer_bypasses_staging(void)
+{
+    uint8 staging[16];
+    uint8 payload[40];
+    MemorySink_t sink;
+    LibEmbd_StreamSerializer_t sser;
+    uint32 i;
+
+    for(i = 0u; i < sizeof(payload); i++){
+        payload[i] = (uint8)(i * 3u);
+    }
+    memset(&sink, 0, sizeof(sink));
+    libembd_make_stream_serializer(&sser, staging, sizeof(staging), memory_sink, &sink);
+
+    libembd_stream_put_uint32_to_network(&sser, 0xDEADBEEFu);
+    libembd_stream_put_buffer(&sser, payload, 15u); //smaller than the staging buffer: copied
+    TEST_CHECK_EQUAL(1u, sink.calls);
+    TEST_CHECK(sink.last_data == staging);
+    TEST_CHECK_EQUAL(16u, sink.last_length);
+    TEST_CHECK_EQUAL(3u, sser.staging.position);
+
+    // as large as the staging buffer: the staged bytes go first, then the caller's buffer itself
+    libembd_stream_put_buffer(&sser, payload, sizeof(payload));
+    TEST_CHECK_EQUAL(3u, sink.calls);
+    TEST_CHECK(sink.last_data == payload);
+    TEST_CHECK_EQUAL(sizeof(payload), sink.last_length);
+    TEST_CHECK_EQUAL(4u + 15u + sizeof(payload), libembd_stream_serializer_total_length(&sser));
+    libembd_stream_put_buffer(&sser, payload, 16u);
+    TEST_CHECK_EQUAL(4u, sink.calls);
+    TEST_CHECK(sink.last_data == payload);
+
+    TEST_CHECK_EQUAL(E_OK, libembd_stream_serializer_flush(&sser));
+    TEST_CHECK_EQUAL(4u, sink.calls); //nothing staged
+    TEST_CHECK_EQUAL(4u + 15u + sizeof(payload) + 16u, sink.length);
+    TEST_CHECK_BYTES("\xDE\xAD\xBE\xEF", sink.data, 4u);
+    TEST_CHECK_BYTES(payload, &sink.data[4], 15u);
+    TEST_CHECK_BYTES(payload, &sink.data[19], sizeof(payload));
+    TEST_CHECK_BYTES(payload, &sink.data[19u + sizeof(payload)], 16u);
+}
+
+static void test_reserve(void)
+{
+    uint8 staging[8];
+    MemorySink_t sink;
+    MemorySource_t source;
+    LibEmbd_StreamSerializer_t sser;
+    LibEmbd_StreamDeserializer_t sdeser;
+    LibEmbd_Serializer_t *ser;
+    LibEmbd_Deserializer_t *deser;
+    uint32 value;
+
+    memset(&sink, 0, sizeof(sink));
+    libembd_make_stream_serializer(&sser, staging, sizeof(staging), memory_sink, &sink);
+    libembd_stream_put_uint16_to_network(&sser, 0x0102u);
+    ser = libembd_stream_serializer_reserve(&sser, 6u); //fits behind the staged bytes
+    TEST_CHECK(ser != NULL);
+    TEST_CHECK_EQUAL(0u, sink.calls);
+    libembd_put_uint32_to_network_unsafe(ser, 0x03040506u);
+    ser = libembd_stream_serializer_reserve(&sser, 8u); //needs the whole staging buffer, flushes first
+    TEST_CHECK(ser != NULL);
+    TEST_CHECK_EQUAL(1u, sink.calls);
+    TEST_CHECK_EQUAL(0u, ser->position);
+    libembd_put_uint64_to_network_unsafe(ser, 0x0708090A0B0C0D0Eull);
+    TEST_CHECK_EQUAL(14u, libembd_stream_serializer_total_length(&sser));
+    TEST_CHECK(!libembd_stream_serializer_has_failed(&sser));
+
+    // larger than the staging buffer: can never be satisfied, sticky error and nothing more reaches the sink
+    TEST_CHECK(libembd_stream_serializer_reserve(&sser, 9u) == NULL);
+    TEST_CHECK(libembd_stream_serializer_has_failed(&sser));
+    TEST_CHECK_EQUAL(E_NOT_OK, libembd_stream_serializer_flush(&sser));
+    TEST_CHECK_EQUAL(1u, sink.calls);
+    TEST_CHECK_EQUAL(6u, sink.length);
+
+    // the deserializer makes reserved bytes contiguous across a refill
+    memcpy(sink.data, "\x01\x02\x03\x04\x05\x06\x07\x08\x09\x0A", 10u);
+    make_source(&source, sink.data, 10u, 3u);
+    libembd_make_stream_deserializer(&sdeser, staging, sizeof(staging), memory_source, &source);
+    libembd_stream_get_uint32_from_network(&sdeser, &value);
+    TEST_CHECK_EQUAL(0x01020304u, value);
+    deser = libembd_stream_deserializer_reserve(&sdeser, 6u);
+    TEST_CHECK(deser != NULL);
+    libembd_get_uint32_from_network_unsafe(deser, &value);
+    TEST_CHECK_EQUAL(0x05060708u, value);
+    TEST_CHECK_EQUAL(8u, libembd_stream_deserializer_total_length(&sdeser));
+    TEST_CHECK(libembd_stream_deserializer_reserve(&sdeser, 9u) == NULL);
+    TEST_CHECK(libembd_stream_deserializer_has_failed(&sdeser));
+}
+
+static void test_source_running_dry(void)
+{
+    static uint8 const data[] = { 0x11u, 0x22u, 0x33u, 0x44u, 0x55u, 0x66u };
+    uint8 staging[4];
+    MemorySource_t source;
+    LibEmbd_StreamDeserializer_t sdeser;
+    uint8 buffer[8];
+    uint32 value;
+    uint16 half;
+
+    make_source(&source, data, sizeof(data), 4u);
+    libembd_make_stream_deserializer(&sdeser, staging, sizeof(staging), memory_source, &source);
+    TEST_CHECK(!libembd_stream_deserializer_at_end(&sdeser));
+    TEST_CHECK_EQUAL(0u, libembd_stream_deserializer_total_length(&sdeser)); //at_end consumes nothing
+    libembd_stream_get_uint32_from_network(&sdeser, &value);
+    TEST_CHECK_EQUAL(0x11223344u, value);
+    TEST_CHECK(!libembd_stream_deserializer_has_failed(&sdeser));
+
+    // only 2 of 4 bytes left
+    value = 1u;
+    libembd_stream_get_uint32_from_network(&sdeser, &value);
+    TEST_CHECK_EQUAL(0u, value);
+    TEST_CHECK(libembd_stream_deserializer_has_failed(&sdeser));
+    TEST_CHECK(libembd_stream_deserializer_at_end(&sdeser));
+
+    // sticky, even though the source would have more to give now
+    source.length = source.position + 2u;
+    half = 1u;
+    libembd_stream_get_uint16_from_network(&sdeser, &half);
+    TEST_CHECK_EQUAL(0u, half);
+    TEST_CHECK(libembd_stream_deserializer_has_failed(&sdeser));
+
+    // get_buffer reports how much it got
+    make_source(&source, data, sizeof(data), 1u);
+    libembd_make_stream_deserializer(&sdeser, staging, sizeof(staging), memory_source, &source);
+    TEST_CHECK_EQUAL(sizeof(data), libembd_stream_get_buffer(&sdeser, buffer, sizeof(buffer)));
+    TEST_CHECK_BYTES(data, buffer, sizeof(data));
+    TEST_CHECK(libembd_stream_deserializer_has_failed(&sdeser));
+
+    // an empty stream is at its end right away, without an error
+    make_source(&source, data, 0u, 4u);
+    libembd_make_stream_deserializer(&sdeser, staging, sizeof(staging), memory_source, &source);
+    TEST_CHECK(libembd_stream_deserializer_at_end(&sdeser));
+    TEST_CHECK(!libembd_stream_deserializer_has_failed(&sdeser));
+    TEST_CHECK_EQUAL(0u, libembd_stream_deserializer_total_length(&sdeser));
+}
+
+static void test_sink_failure(void)
+{
+    uint8 staging[4];
+    uint8 payload[8] = { 0u };
+    MemorySink_t sink;
+    LibEmbd_StreamSerializer_t sser;
+
+    memset(&sink, 0, sizeof(sink));
+    sink.fail_at_call = 2u;
+    libembd_make_stream_serializer(&sser, staging, sizeof(staging), memory_sink, &sink);
+    libembd_stream_put_uint32_to_network(&sser, 1u);
+    libembd_stream_put_uint32_to_network(&sser, 2u); //first flush, accepted
+    TEST_CHECK_EQUAL(1u, sink.calls);
+    libembd_stream_put_uint32_to_network(&sser, 3u); //second flush, rejected
+    TEST_CHECK_EQUAL(2u, sink.calls);
+    TEST_CHECK(libembd_stream_serializer_has_failed(&sser));
+
+    // everything after the failure is discarded without bothering the sink
+    libembd_stream_put_uint64_to_network(&sser, 4u);
+    libembd_stream_put_buffer(&sser, payload, sizeof(payload));
+    TEST_CHECK_EQUAL(E_NOT_OK, libembd_stream_serializer_flush(&sser));
+    TEST_CHECK_EQUAL(2u, sink.calls);
+    TEST_CHECK_EQUAL(4u, sink.length);
+
+    // a failing direct hand-over of a large buffer is sticky as well
+    memset(&sink, 0, sizeof(sink));
+    sink.fail_at_call = 1u;
+    libembd_make_stream_serializer(&sser, staging, sizeof(staging), memory_sink, &sink);
+    libembd_stream_put_buffer(&sser, payload, sizeof(payload));
+    TEST_CHECK(libembd_stream_serializer_has_failed(&sser));
+    TEST_CHECK_EQUAL(E_NOT_OK, libembd_stream_serializer_flush(&sser));
+    TEST_CHECK_EQUAL(0u, libembd_stream_serializer_total_length(&sser));
+}
+
+int main(void)
+{
+    (void)printf("%s\n", __FILE__);
+    TEST_RUN(test_fields_straddling_flush_and_refill);
+    TEST_RUN(test_put_buffer_bypasses_staging);
+    TEST_RUN(test_reserve);
+    TEST_RUN(test_source_running_dry);
+    TEST_RUN(test_sink_failure);
+    return EXIT_SUCCESS;
+}
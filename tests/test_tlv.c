@@ -0,0 +1,218 @@
+#include "test.h"
+#include "libembd/libembd_tlv.h"
+
+// TAG_DEVICE { TAG_NAME "ab", TAG_READING { uint32 } }, TAG_STATUS { uint8 }
+static uint8 const nested_message[] = {
+    0x00u, 0x01u, 0x00u, 0x0Eu,
+        0x00u, 0x02u, 0x00u, 0x02u, 'a', 'b',
+        0x00u, 0x03u, 0x00u, 0x04u, 0x11u, 0x22u, 0x33u, 0x44u,
+    0x00u, 0x04u, 0x00u, 0x01u, 0x7Fu
+};
+
+static uint32 build_nested(uint8 *buffer, uint32 capacity, boolean *failed)
+{
+    LibEmbd_Serializer_t ser;
+    LibEmbd_TlvBuilder_t tlv;
+
+    libembd_make_serializer(&ser, buffer, capacity);
+    libembd_make_tlv_builder(&tlv, &ser);
+    libembd_tlv_begin_field(&tlv, 0x0001u);
+        libembd_tlv_put_field(&tlv, 0x0002u, "ab", 2u);
+        libembd_tlv_begin_field(&tlv, 0x0003u);
+            libembd_put_uint32_to_network_checked(&ser, 0x11223344u);
+        libembd_tlv_end_field(&tlv);
+    libembd_tlv_end_field(&tlv);
+    libembd_tlv_begin_field(&tlv, 0x0004u);
+        libembd_put_uint8_checked(&ser, 0x7Fu);
+    libembd_tlv_end_field(&tlv);
+    TEST_CHECK_EQUAL(0u, libembd_tlv_depth(&tlv));
+    *failed = libembd_tlv_builder_has_failed(&tlv);
+    return ser.position;
+}
+
+static void test_builder_nested(void)
+{
+    uint8 buffer[64];
+    boolean failed;
+
+    TEST_CHECK_EQUAL(sizeof(nested_message), build_nested(buffer, sizeof(buffer), &failed));
+    TEST_CHECK(!failed);
+    TEST_CHECK_BYTES(nested_message, buffer, sizeof(nested_message));
+}
+
+static void test_builder_capacity(void)
+{
+    uint8 buffer[sizeof(nested_message)];
+    uint32 capacity;
+    boolean failed;
+
+    (void)build_nested(buffer, sizeof(buffer), &failed);
+    TEST_CHECK(!failed);
+    TEST_CHECK_BYTES(nested_message, buffer, sizeof(nested_message));
+
+    for(capacity = 0u; capacity < sizeof(nested_message); capacity++){
+        (void)build_nested(buffer, capacity, &failed);
+        TEST_CHECK(failed);
+    }
+}
+
+static void test_builder_nesting_errors(void)
+{
+    uint8 buffer[128];
+    LibEmbd_Serializer_t ser;
+    LibEmbd_TlvBuilder_t tlv;
+    uint32 i;
+
+    libembd_make_serializer(&ser, buffer, sizeof(buffer));
+    libembd_make_tlv_builder(&tlv, &ser);
+    libembd_tlv_end_field(&tlv);
+    TEST_CHECK(libembd_tlv_builder_has_failed(&tlv));
+
+    //one level too deep, begin/end stay balanced after the error
+    libembd_make_serializer(&ser, buffer, sizeof(buffer));
+    libembd_make_tlv_builder(&tlv, &ser);
+    for(i = 0u; i < LIBEMBD_TLV_MAX_DEPTH; i++){
+        libembd_tlv_begin_field(&tlv, (uint16)i);
+    }
+    TEST_CHECK(!libembd_tlv_builder_has_failed(&tlv));
+    libembd_tlv_begin_field(&tlv, 0xFFu);
+    TEST_CHECK(libembd_tlv_builder_has_failed(&tlv));
+    TEST_CHECK_EQUAL(LIBEMBD_TLV_MAX_DEPTH + 1u, libembd_tlv_depth(&tlv));
+    for(i = 0u; i <= LIBEMBD_TLV_MAX_DEPTH; i++){
+        libembd_tlv_end_field(&tlv);
+    }
+    TEST_CHECK_EQUAL(0u, libembd_tlv_depth(&tlv));
+    TEST_CHECK(libembd_tlv_builder_has_failed(&tlv));
+}
+
+static void test_builder_oversized_field(void)
+{
+    static uint8 buffer[LIBEMBD_TLV_MAX_VALUE_LENGTH + 16u];
+    LibEmbd_Serializer_t ser;
+    LibEmbd_TlvBuilder_t tlv;
+
+    libembd_make_serializer(&ser, buffer, sizeof(buffer));
+    libembd_make_tlv_builder(&tlv, &ser);
+    libembd_tlv_begin_field(&tlv, 0x0001u);
+    libembd_serializer_skip(&ser, LIBEMBD_TLV_MAX_VALUE_LENGTH);
+    libembd_tlv_end_field(&tlv);
+    TEST_CHECK(!libembd_tlv_builder_has_failed(&tlv));
+    TEST_CHECK_EQUAL(0xFFu, buffer[2]);
+    TEST_CHECK_EQUAL(0xFFu, buffer[3]);
+
+    libembd_make_serializer(&ser, buffer, sizeof(buffer));
+    libembd_make_tlv_builder(&tlv, &ser);
+    libembd_tlv_begin_field(&tlv, 0x0001u);
+    libembd_serializer_skip(&ser, LIBEMBD_TLV_MAX_VALUE_LENGTH + 1u);
+    libembd_tlv_end_field(&tlv);
+    TEST_CHECK(libembd_tlv_builder_has_failed(&tlv));
+}
+
+static void test_index_find(void)
+{
+    LibEmbd_TlvIndex_t index;
+    LibEmbd_TlvIndex_t device_index;
+    LibEmbd_ConstBufferView_t const message = { nested_message, sizeof(nested_message) };
+    LibEmbd_ConstBufferView_t view;
+
+    TEST_CHECK_EQUAL(E_OK, libembd_tlv_index_build(&index, message));
+    TEST_CHECK_EQUAL(2u, libembd_tlv_index_count(&index));
+
+    view = libembd_tlv_index_find(&index, 0x0004u);
+    TEST_CHECK(view.data == &nested_message[22]);
+    TEST_CHECK_EQUAL(1u, view.length);
+
+    view = libembd_tlv_index_find(&index, 0x0002u); //nested, not a top-level field
+    TEST_CHECK(view.data == NULL);
+    TEST_CHECK_EQUAL(0u, view.length);
+
+    view = libembd_tlv_index_find(&index, 0x0001u);
+    TEST_CHECK_EQUAL(14u, view.length);
+    TEST_CHECK_EQUAL(E_OK, libembd_tlv_index_build(&device_index, view));
+    TEST_CHECK_EQUAL(2u, libembd_tlv_index_count(&device_index));
+    view = libembd_tlv_index_find(&device_index, 0x0003u);
+    TEST_CHECK_EQUAL(4u, view.length);
+    TEST_CHECK_EQUAL(0x11u, view.data[0]);
+    view = libembd_tlv_index_find(&device_index, 0x0002u);
+    TEST_CHECK_BYTES("ab", view.data, 2u);
+}
+
+static void test_index_colliding_and_duplicate_tags(void)
+{
+    uint8 buffer[256];
+    LibEmbd_Serializer_t ser;
+    LibEmbd_TlvBuilder_t tlv;
+    LibEmbd_TlvIndex_t index;
+    LibEmbd_ConstBufferView_t message;
+    uint16 i;
+
+    //tags that are multiples of the capacity apart land in the same slot
+    libembd_make_serializer(&ser, buffer, sizeof(buffer));
+    libembd_make_tlv_builder(&tlv, &ser);
+    for(i = 0u; i < LIBEMBD_TLV_INDEX_CAPACITY - 1u; i++){
+        uint8 const value = (uint8)i;
+        libembd_tlv_put_field(&tlv, (uint16)(i * (LIBEMBD_TLV_INDEX_CAPACITY + 1u)), &value, 1u);
+    }
+    libembd_tlv_put_field(&tlv, 0u, "dup", 3u); //duplicate of the first tag
+    TEST_CHECK(!libembd_tlv_builder_has_failed(&tlv));
+    message.data = buffer;
+    message.length = ser.position;
+
+    TEST_CHECK_EQUAL(E_OK, libembd_tlv_index_build(&index, message));
+    TEST_CHECK_EQUAL(LIBEMBD_TLV_INDEX_CAPACITY - 1u, libembd_tlv_index_count(&index));
+    for(i = 0u; i < LIBEMBD_TLV_INDEX_CAPACITY - 1u; i++){
+        LibEmbd_ConstBufferView_t const view = libembd_tlv_index_find(&index, (uint16)(i * (LIBEMBD_TLV_INDEX_CAPACITY + 1u)));
+        TEST_CHECK_EQUAL(1u, view.length);
+        TEST_CHECK_EQUAL(i, view.data[0]);
+    }
+    TEST_CHECK(libembd_tlv_index_find(&index, 0xFFFFu).data == NULL);
+
+    //one distinct tag too many
+    libembd_tlv_put_field(&tlv, 0xFFFFu, "", 0u);
+    message.length = ser.position;
+    TEST_CHECK_EQUAL(E_NOT_OK, libembd_tlv_index_build(&index, message));
+    TEST_CHECK_EQUAL(0u, libembd_tlv_index_count(&index));
+    TEST_CHECK(libembd_tlv_index_find(&index, 0u).data == NULL);
+}
+
+static void test_index_malformed(void)
+{
+    uint8 buffer[sizeof(nested_message)];
+    LibEmbd_TlvIndex_t index;
+    LibEmbd_ConstBufferView_t message = { nested_message, 0u };
+    uint32 length;
+
+    TEST_CHECK_EQUAL(E_OK, libembd_tlv_index_build(&index, message));
+    TEST_CHECK_EQUAL(0u, libembd_tlv_index_count(&index));
+
+    //every truncation except at a top-level field boundary is malformed
+    for(length = 1u; length < sizeof(nested_message); length++){
+        message.length = length;
+        TEST_CHECK_EQUAL((length == 18u) ? E_OK : E_NOT_OK, libembd_tlv_index_build(&index, message));
+    }
+
+    //length exceeding the message by one
+    LIBEMBD_MEMCPY(buffer, nested_message, sizeof(buffer));
+    buffer[21] = 0x02u;
+    message.data = buffer;
+    message.length = sizeof(buffer);
+    TEST_CHECK_EQUAL(E_NOT_OK, libembd_tlv_index_build(&index, message));
+    TEST_CHECK_EQUAL(0u, libembd_tlv_index_count(&index));
+
+    buffer[2] = 0xFFu;
+    buffer[21] = 0x01u;
+    TEST_CHECK_EQUAL(E_NOT_OK, libembd_tlv_index_build(&index, message));
+}
+
+int main(void)
+{
+    (void)printf("%s\n", __FILE__);
+    TEST_RUN(test_builder_nested);
+    TEST_RUN(test_builder_capacity);
+    TEST_RUN(test_builder_nesting_errors);
+    TEST_RUN(test_builder_oversized_field);
+    TEST_RUN(test_index_find);
+    TEST_RUN(test_index_colliding_and_duplicate_tags);
+    TEST_RUN(test_index_malformed);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,354 @@
+#include "test.h"
+#include "libembd/libembd_varint.h"
+
+// Encodings are placed at the end of the buffer followed by up to MAX_SLACK garbage bytes. The decoder then sees 1 to 18
+// available bytes and takes the 8-byte window path or the byte-wise path depending on the distance to the end.
+#define BUFFER_SIZE     32u
+#define MAX_SLACK       8u
+#define GARBAGE         0xFFu //continuation bit set, must not be taken for part of the encoding
+
+static uint8 g_buffer[BUFFER_SIZE];
+
+// Bit by bit reference encoder, returns the encoded length
+static uint32 reference_encode(uint8 *dst, uint64 value)
+{
+    uint32 n = 0u;
+    do {
+        dst[n] = (uint8)(value & 0x7Fu);
+        value >>= 7u;
+        if(value != 0u){
+            dst[n] |= 0x80u;
+        }
+        n++;
+    } while(value != 0u);
+    return n;
+}
+
+static uint64 random64(void)
+{
+    return ((uint64)test_random() << 32u) | test_random();
+}
+
+// Values with every encoded length from 1 to 10 bytes, at and around the length boundaries
+static uint64 interesting_value(uint32 i)
+{
+    uint32 const bits = i / 4u; //0..64
+    uint64 const power = (bits < 64u) ? ((uint64)1u << bits) : 0u;
+    switch(i % 4u){
+        case 0u: return power - 1u;
+        case 1u: return power;
+        case 2u: return power + 1u;
+        default: return power | (random64() & (power - 1u)); //random low bits
+    }
+}
+
+// Places encoding at the end of the buffer followed by slack garbage bytes, returns its position
+static uint32 place(uint8 const *encoding, uint32 length, uint32 slack)
+{
+    uint32 const position = BUFFER_SIZE - slack - length;
+    memset(g_buffer, GARBAGE, sizeof(g_buffer));
+    memcpy(&g_buffer[position], encoding, length);
+    return position;
+}
+
+static void test_sizes_and_encoding(void)
+{
+    uint8 expected[LIBEMBD_VARINT_MAX_SIZE_64];
+    uint8 encoded[LIBEMBD_VARINT_MAX_SIZE_64 + 1u];
+    LibEmbd_Serializer_t ser;
+    uint32 i;
+
+    for(i = 0u; i < 4000u; i++){
+        uint64 const value = (i < 260u) ? interesting_value(i) : (random64() >> (i % 64u));
+        uint32 const length = reference_encode(expected, value);
+
+        TEST_CHECK_EQUAL(length, libembd_varint_size(value));
+        libembd_make_serializer(&ser, encoded, sizeof(encoded));
+        libembd_put_varuint64_unsafe(&ser, value);
+        TEST_CHECK_EQUAL(length, ser.position);
+        TEST_CHECK_BYTES(expected, encoded, length);
+
+        // checked put: exactly enough room succeeds, one byte less writes nothing
+        libembd_make_serializer(&ser, encoded, length - 1u);
+        libembd_put_varuint64_checked(&ser, value);
+        TEST_CHECK(libembd_serializer_has_overflowed(&ser));
+        TEST_CHECK_EQUAL(0u, ser.position);
+        libembd_make_serializer(&ser, encoded, length);
+        libembd_put_varuint64_checked(&ser, value);
+        TEST_CHECK(!libembd_serializer_has_overflowed(&ser));
+        TEST_CHECK_BYTES(expected, encoded, length);
+    }
+}
+
+static void test_decode_near_buffer_end(void)
+{
+    uint8 encoding[LIBEMBD_VARINT_MAX_SIZE_64];
+    LibEmbd_Deserializer_t deser;
+    uint32 i;
+
+    for(i = 0u; i < 260u; i++){
+        uint64 const value = interesting_value(i);
+        uint32 const length = reference_encode(encoding, value);
+        uint32 slack;
+
+        for(slack = 0u; slack <= MAX_SLACK; slack++){
+            uint32 const position = place(encoding, length, slack);
+            uint64 u64 = 0u;
+            uint32 u32 = 0u;
+            uint16 u16 = 0u;
+
+            libembd_make_deserializer(&deser, g_buffer, BUFFER_SIZE);
+            deser.position = position;
+            libembd_get_varuint64_checked(&deser, &u64);
+            TEST_CHECK(!libembd_deserializer_has_overflowed(&deser));
+            TEST_CHECK_EQUAL(value, u64);
+            TEST_CHECK_EQUAL(position + length, deser.position);
+
+            libembd_make_deserializer(&deser, g_buffer, BUFFER_SIZE);
+            deser.position = position;
+            libembd_get_varuint64_unsafe(&deser, &u64);
+            TEST_CHECK_EQUAL(value, u64);
+            TEST_CHECK_EQUAL(position + length, deser.position);
+
+            libembd_make_deserializer(&deser, g_buffer, BUFFER_SIZE);
+            deser.position = position;
+            libembd_get_varuint32_checked(&deser, &u32);
+            TEST_CHECK_EQUAL(value > 0xFFFFFFFFu, libembd_deserializer_has_overflowed(&deser));
+            TEST_CHECK_EQUAL((value > 0xFFFFFFFFu) ? 0u : value, u32);
+            TEST_CHECK_EQUAL((value > 0xFFFFFFFFu) ? position : position + length, deser.position);
+
+            libembd_make_deserializer(&deser, g_buffer, BUFFER_SIZE);
+            deser.position = position;
+            libembd_get_varuint16_checked(&deser, &u16);
+            TEST_CHECK_EQUAL(value > 0xFFFFu, libembd_deserializer_has_overflowed(&deser));
+            TEST_CHECK_EQUAL((value > 0xFFFFu) ? 0u : value, u16);
+
+            // the same encoding cut short by the end of the buffer
+            if(slack == 0u){
+                uint32 cut;
+                for(cut = 1u; cut < length; cut++){
+                    libembd_make_deserializer(&deser, g_buffer, BUFFER_SIZE - cut);
+                    deser.position = position;
+                    u64 = 1u;
+                    libembd_get_varuint64_checked(&deser, &u64);
+                    TEST_CHECK(libembd_deserializer_has_overflowed(&deser));
+                    TEST_CHECK_EQUAL(0u, u64);
+                    TEST_CHECK_EQUAL(position, deser.position);
+                }
+            }
+        }
+    }
+}
+
+// Over-long: more bytes than the type can take, even if the value would fit. Out-of-range: the right number of bytes
+// but bits beyond the type.
+static void test_rejects_over_long_and_out_of_range(void)
+{
+    static uint8 const over_long_16[] = { 0x80u, 0x80u, 0x80u, 0x00u };
+    static uint8 const max_16[] = { 0xFFu, 0xFFu, 0x03u };
+    static uint8 const out_of_range_16[] = { 0x80u, 0x80u, 0x04u };
+    static uint8 const over_long_32[] = { 0x81u, 0x80u, 0x80u, 0x80u, 0x80u, 0x00u };
+    static uint8 const max_32[] = { 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0x0Fu };
+    static uint8 const out_of_range_32[] = { 0x80u, 0x80u, 0x80u, 0x80u, 0x10u };
+    static uint8 const over_long_64[] = { 0x80u, 0x80u, 0x80u, 0x80u, 0x80u, 0x80u, 0x80u, 0x80u, 0x80u, 0x80u, 0x00u };
+    static uint8 const max_64[] = { 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0x01u };
+    static uint8 const out_of_range_64[] = { 0x80u, 0x80u, 0x80u, 0x80u, 0x80u, 0x80u, 0x80u, 0x80u, 0x80u, 0x02u };
+    LibEmbd_Deserializer_t deser;
+    uint32 slack;
+
+    for(slack = 0u; slack <= MAX_SLACK; slack++){
+        uint64 u64;
+        uint32 u32;
+        uint16 u16;
+        uint32 position;
+
+#define DECODE(ENCODING, BITS, VALUE) \
+        position = place(ENCODING, sizeof(ENCODING), slack); \
+        libembd_make_deserializer(&deser, g_buffer, BUFFER_SIZE); \
+        deser.position = position; \
+        VALUE = 1u; \
+        libembd_get_varuint##BITS##_checked(&deser, &VALUE)
+
+        DECODE(over_long_16, 16, u16);
+        TEST_CHECK(libembd_deserializer_has_overflowed(&deser));
+        TEST_CHECK_EQUAL(0u, u16);
+        TEST_CHECK_EQUAL(position, deser.position);
+        DECODE(over_long_16, 32, u32); //fine for a wider type
+        TEST_CHECK(!libembd_deserializer_has_overflowed(&deser));
+        TEST_CHECK_EQUAL(0u, u32);
+        TEST_CHECK_EQUAL(position + sizeof(over_long_16), deser.position);
+        DECODE(max_16, 16, u16);
+        TEST_CHECK(!libembd_deserializer_has_overflowed(&deser));
+        TEST_CHECK_EQUAL(0xFFFFu, u16);
+        DECODE(out_of_range_16, 16, u16);
+        TEST_CHECK(libembd_deserializer_has_overflowed(&deser));
+        TEST_CHECK_EQUAL(0u, u16);
+        TEST_CHECK_EQUAL(position, deser.position);
+
+        DECODE(over_long_32, 32, u32);
+        TEST_CHECK(libembd_deserializer_has_overflowed(&deser));
+        TEST_CHECK_EQUAL(0u, u32);
+        TEST_CHECK_EQUAL(position, deser.position);
+        DECODE(over_long_32, 64, u64);
+        TEST_CHECK(!libembd_deserializer_has_overflowed(&deser));
+        TEST_CHECK_EQUAL(1u, u64);
+        DECODE(max_32, 32, u32);
+        TEST_CHECK(!libembd_deserializer_has_overflowed(&deser));
+        TEST_CHECK_EQUAL(0xFFFFFFFFu, u32);
+        DECODE(out_of_range_32, 32, u32);
+        TEST_CHECK(libembd_deserializer_has_overflowed(&deser));
+        TEST_CHECK_EQUAL(0u, u32);
+        TEST_CHECK_EQUAL(position, deser.position);
+
+        DECODE(over_long_64, 64, u64);
+        TEST_CHECK(libembd_deserializer_has_overflowed(&deser));
+        TEST_CHECK_EQUAL(0u, u64);
+        TEST_CHECK_EQUAL(position, deser.position);
+        DECODE(max_64, 64, u64);
+        TEST_CHECK(!libembd_deserializer_has_overflowed(&deser));
+        TEST_CHECK_EQUAL(0xFFFFFFFFFFFFFFFFull, u64);
+        TEST_CHECK_EQUAL(position + sizeof(max_64), deser.position);
+        DECODE(out_of_range_64, 64, u64);
+        TEST_CHECK(libembd_deserializer_has_overflowed(&deser));
+        TEST_CHECK_EQUAL(0u, u64);
+        TEST_CHECK_EQUAL(position, deser.position);
+
+        // an overflowed deserializer decodes nothing, even a valid encoding
+        position = place(max_16, sizeof(max_16), slack);
+        deser.position = position;
+        libembd_get_varuint16_checked(&deser, &u16);
+        TEST_CHECK_EQUAL(0u, u16);
+        TEST_CHECK_EQUAL(position, deser.position);
+#undef DECODE
+    }
+}
+
+static void test_zigzag_extremes(void)
+{
+    static sint64 const values64[] = { 0, -1, 1, -2, 2, INT64_MAX, INT64_MIN, INT64_MIN + 1, INT32_MAX, INT32_MIN };
+    static sint32 const values32[] = { 0, -1, 1, -64, 63, -65, 64, INT32_MAX, INT32_MIN, INT32_MIN + 1 };
+    static sint16 const values16[] = { 0, -1, 1, INT16_MAX, INT16_MIN, INT16_MIN + 1, -8192, 8191 };
+    uint8 buffer[LIBEMBD_VARINT_MAX_SIZE_64];
+    LibEmbd_Serializer_t ser;
+    LibEmbd_Deserializer_t deser;
+    uint32 i;
+
+    TEST_CHECK_EQUAL(0u, libembd_zigzag_encode16(0));
+    TEST_CHECK_EQUAL(1u, libembd_zigzag_encode16(-1));
+    TEST_CHECK_EQUAL(2u, libembd_zigzag_encode16(1));
+    TEST_CHECK_EQUAL(0xFFFEu, libembd_zigzag_encode16(INT16_MAX));
+    TEST_CHECK_EQUAL(0xFFFFu, libembd_zigzag_encode16(INT16_MIN));
+    TEST_CHECK_EQUAL(0xFFFFFFFEu, libembd_zigzag_encode32(INT32_MAX));
+    TEST_CHECK_EQUAL(0xFFFFFFFFu, libembd_zigzag_encode32(INT32_MIN));
+    TEST_CHECK_EQUAL(0xFFFFFFFFFFFFFFFEull, libembd_zigzag_encode64(INT64_MAX));
+    TEST_CHECK_EQUAL(0xFFFFFFFFFFFFFFFFull, libembd_zigzag_encode64(INT64_MIN));
+    TEST_CHECK_EQUAL(INT64_MIN, libembd_zigzag_decode64(0xFFFFFFFFFFFFFFFFull));
+
+    for(i = 0u; i < sizeof(values64) / sizeof(values64[0]); i++){
+        sint64 decoded;
+        TEST_CHECK_EQUAL(values64[i], libembd_zigzag_decode64(libembd_zigzag_encode64(values64[i])));
+        libembd_make_serializer(&ser, buffer, sizeof(buffer));
+        libembd_put_varsint64_checked(&ser, values64[i]);
+        TEST_CHECK_EQUAL(libembd_varint_size(libembd_zigzag_encode64(values64[i])), ser.position);
+        libembd_make_deserializer(&deser, buffer, ser.position);
+        libembd_get_varsint64_checked(&deser, &decoded);
+        TEST_CHECK(!libembd_deserializer_has_overflowed(&deser));
+        TEST_CHECK_EQUAL(values64[i], decoded);
+    }
+    for(i = 0u; i < sizeof(values32) / sizeof(values32[0]); i++){
+        sint32 decoded;
+        TEST_CHECK_EQUAL(values32[i], libembd_zigzag_decode32(libembd_zigzag_encode32(values32[i])));
+        libembd_make_serializer(&ser, buffer, sizeof(buffer));
+        libembd_put_varsint32_checked(&ser, values32[i]);
+        TEST_CHECK(ser.position <= LIBEMBD_VARINT_MAX_SIZE_32);
+        libembd_make_deserializer(&deser, buffer, ser.position);
+        libembd_get_varsint32_unsafe(&deser, &decoded);
+        TEST_CHECK_EQUAL(values32[i], decoded);
+    }
+    for(i = 0u; i < sizeof(values16) / sizeof(values16[0]); i++){
+        sint16 decoded;
+        TEST_CHECK_EQUAL(values16[i], libembd_zigzag_decode16(libembd_zigzag_encode16(values16[i])));
+        libembd_make_serializer(&ser, buffer, sizeof(buffer));
+        libembd_put_varsint16_checked(&ser, values16[i]);
+        TEST_CHECK(ser.position <= LIBEMBD_VARINT_MAX_SIZE_16);
+        libembd_make_deserializer(&deser, buffer, ser.position);
+        libembd_get_varsint16_checked(&deser, &decoded);
+        TEST_CHECK(!libembd_deserializer_has_overflowed(&deser));
+        TEST_CHECK_EQUAL(values16[i], decoded);
+    }
+}
+
+static void test_array_partial_decode(void)
+{
+    uint32 values[40];
+    uint32 decoded[40];
+    uint32 ends[40]; //end position of each encoding
+    uint8 buffer[sizeof(values) * LIBEMBD_VARINT_MAX_SIZE_32];
+    LibEmbd_Serializer_t ser;
+    LibEmbd_Deserializer_t deser;
+    uint32 i;
+    uint32 bad;
+
+    for(i = 0u; i < 40u; i++){
+        values[i] = test_random() >> (test_random() % 32u);
+    }
+    libembd_make_serializer(&ser, buffer, sizeof(buffer));
+    libembd_put_varuint32_array_checked(&ser, values, 40u);
+    TEST_CHECK(!libembd_serializer_has_overflowed(&ser));
+    for(i = 0u; i < 40u; i++){
+        ends[i] = ((i > 0u) ? ends[i - 1u] : 0u) + libembd_varint_size(values[i]);
+    }
+    TEST_CHECK_EQUAL(ends[39], ser.position);
+
+    libembd_make_deserializer(&deser, buffer, ser.position);
+    TEST_CHECK_EQUAL(40u, libembd_get_varuint32_array_checked(&deser, decoded, 40u));
+    TEST_CHECK_BYTES(values, decoded, sizeof(values));
+    TEST_CHECK_EQUAL(ends[39], deser.position);
+
+    // all or nothing on the put side
+    libembd_make_serializer(&ser, buffer, ends[39] - 1u);
+    libembd_put_varuint32_array_checked(&ser, values, 40u);
+    TEST_CHECK(libembd_serializer_has_overflowed(&ser));
+    TEST_CHECK_EQUAL(0u, ser.position);
+
+    // truncated after every value: the good prefix is decoded, the rest zeroed, the position after the last good value
+    for(bad = 0u; bad < 40u; bad++){
+        libembd_make_serializer(&ser, buffer, sizeof(buffer));
+        libembd_put_varuint32_array_checked(&ser, values, 40u);
+        libembd_make_deserializer(&deser, buffer, ends[bad] - 1u);
+        memset(decoded, 0xA5, sizeof(decoded));
+        TEST_CHECK_EQUAL(bad, libembd_get_varuint32_array_checked(&deser, decoded, 40u));
+        TEST_CHECK(libembd_deserializer_has_overflowed(&deser));
+        TEST_CHECK_BYTES(values, decoded, bad * sizeof(uint32));
+        for(i = bad; i < 40u; i++){
+            TEST_CHECK_EQUAL(0u, decoded[i]);
+        }
+        TEST_CHECK_EQUAL((bad > 0u) ? ends[bad - 1u] : 0u, deser.position);
+
+        // an out of range value in the middle of a complete stream stops decoding the same way
+        if(libembd_varint_size(values[bad]) == LIBEMBD_VARINT_MAX_SIZE_32){
+            buffer[ends[bad] - 1u] |= 0x10u;
+            libembd_make_deserializer(&deser, buffer, ends[39]);
+            TEST_CHECK_EQUAL(bad, libembd_get_varuint32_array_checked(&deser, decoded, 40u));
+            TEST_CHECK_EQUAL(0u, decoded[39]);
+            TEST_CHECK_EQUAL((bad > 0u) ? ends[bad - 1u] : 0u, deser.position);
+        }
+    }
+
+    // an already overflowed deserializer decodes nothing
+    memset(decoded, 0xA5, sizeof(decoded));
+    TEST_CHECK_EQUAL(0u, libembd_get_varuint32_array_checked(&deser, decoded, 40u));
+    TEST_CHECK_EQUAL(0u, decoded[0]);
+    TEST_CHECK_EQUAL(0u, decoded[39]);
+}
+
+int main(void)
+{
+    (void)printf("%s\n", __FILE__);
+    TEST_RUN(test_sizes_and_encoding);
+    TEST_RUN(test_decode_near_buffer_end);
+    TEST_RUN(test_rejects_over_long_and_out_of_range);
+    TEST_RUN(test_zigzag_extremes);
+    TEST_RUN(test_array_partial_decode);
+    return EXIT_SUCCESS;
+}